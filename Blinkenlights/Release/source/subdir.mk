@@ -4,32 +4,83 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../source/blackbox.c \
+../source/boottime.c \
+../source/clocks.c \
+../source/console.c \
+../source/crc.c \
+../source/fault.c \
+../source/flash_async.c \
 ../source/led.c \
 ../source/main.c \
 ../source/mtb.c \
+../source/params.c \
+../source/pool.c \
+../source/power.c \
 ../source/semihost_hardfault.c \
-../source/touch.c 
+../source/serial.c \
+../source/settings.c \
+../source/shell.c \
+../source/stack.c \
+../source/telemetry.c \
+../source/touch.c \
+../source/trace.c \
+../source/update.c 
 
 C_DEPS += \
+./source/blackbox.d \
+./source/boottime.d \
+./source/clocks.d \
+./source/console.d \
+./source/crc.d \
+./source/fault.d \
+./source/flash_async.d \
 ./source/led.d \
 ./source/main.d \
 ./source/mtb.d \
+./source/params.d \
+./source/pool.d \
+./source/power.d \
 ./source/semihost_hardfault.d \
-./source/touch.d 
+./source/serial.d \
+./source/settings.d \
+./source/shell.d \
+./source/stack.d \
+./source/telemetry.d \
+./source/touch.d \
+./source/trace.d \
+./source/update.d 
 
 OBJS += \
+./source/blackbox.o \
+./source/boottime.o \
+./source/clocks.o \
+./source/console.o \
+./source/crc.o \
+./source/fault.o \
+./source/flash_async.o \
 ./source/led.o \
 ./source/main.o \
 ./source/mtb.o \
+./source/params.o \
+./source/pool.o \
+./source/power.o \
 ./source/semihost_hardfault.o \
-./source/touch.o 
+./source/serial.o \
+./source/settings.o \
+./source/shell.o \
+./source/stack.o \
+./source/telemetry.o \
+./source/touch.o \
+./source/trace.o \
+./source/update.o 
 
 
 # Each subdirectory must supply rules for building sources it contributes
 source/%.o: ../source/%.c source/subdir.mk
 	@echo 'Building file: $<'
 	@echo 'Invoking: MCU C Compiler'
-	arm-none-eabi-gcc -std=gnu99 -DCPU_MKL25Z128VLK4 -DCPU_MKL25Z128VLK4_cm0plus -DFSL_RTOS_BM -DSDK_OS_BAREMETAL -DCR_INTEGER_PRINTF -DPRINTF_FLOAT_ENABLE=0 -D__MCUXPRESSO -D__USE_CMSIS -DNDEBUG -D__REDLIB__ -DSDK_DEBUGCONSOLE=1 -I"C:\Users\dayton.flores\Documents\MCUXpressoIDE_11.6.0_8187\workspace\Blinkenlights\board" -I"C:\Users\dayton.flores\Documents\MCUXpressoIDE_11.6.0_8187\workspace\Blinkenlights\source" -I"C:\Users\dayton.flores\Documents\MCUXpressoIDE_11.6.0_8187\workspace\Blinkenlights" -I"C:\Users\dayton.flores\Documents\MCUXpressoIDE_11.6.0_8187\workspace\Blinkenlights\drivers" -I"C:\Users\dayton.flores\Documents\MCUXpressoIDE_11.6.0_8187\workspace\Blinkenlights\CMSIS" -I"C:\Users\dayton.flores\Documents\MCUXpressoIDE_11.6.0_8187\workspace\Blinkenlights\utilities" -I"C:\Users\dayton.flores\Documents\MCUXpressoIDE_11.6.0_8187\workspace\Blinkenlights\startup" -O0 -fno-common -g -Wall -Werror -c -fmessage-length=0 -fno-builtin -ffunction-sections -fdata-sections -fmerge-constants -fmacro-prefix-map="$(<D)/"= -mcpu=cortex-m0plus -mthumb -D__REDLIB__ -fstack-usage -specs=redlib.specs -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.o)" -MT"$(@:%.o=%.d)" -o "$@" "$<"
+	arm-none-eabi-gcc -std=gnu99 -DCPU_MKL25Z128VLK4 -DCPU_MKL25Z128VLK4_cm0plus -DFSL_RTOS_BM -DSDK_OS_BAREMETAL -DCR_INTEGER_PRINTF -DPRINTF_FLOAT_ENABLE=0 -D__MCUXPRESSO -D__USE_CMSIS -DNDEBUG -D__REDLIB__ -DSDK_DEBUGCONSOLE=1 -I"C:\Users\dayton.flores\Documents\MCUXpressoIDE_11.6.0_8187\workspace\Blinkenlights\board" -I"C:\Users\dayton.flores\Documents\MCUXpressoIDE_11.6.0_8187\workspace\Blinkenlights\source" -I"C:\Users\dayton.flores\Documents\MCUXpressoIDE_11.6.0_8187\workspace\Blinkenlights" -I"C:\Users\dayton.flores\Documents\MCUXpressoIDE_11.6.0_8187\workspace\Blinkenlights\drivers" -I"C:\Users\dayton.flores\Documents\MCUXpressoIDE_11.6.0_8187\workspace\Blinkenlights\CMSIS" -I"C:\Users\dayton.flores\Documents\MCUXpressoIDE_11.6.0_8187\workspace\Blinkenlights\utilities" -I"C:\Users\dayton.flores\Documents\MCUXpressoIDE_11.6.0_8187\workspace\Blinkenlights\startup" -O0 -fno-common -g -Wall -Werror -c -fmessage-length=0 -fno-builtin -ffunction-sections -fdata-sections -fcallgraph-info=su -fmerge-constants -fmacro-prefix-map="$(<D)/"= -mcpu=cortex-m0plus -mthumb -D__REDLIB__ -fstack-usage -specs=redlib.specs -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.o)" -MT"$(@:%.o=%.d)" -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
@@ -37,7 +88,7 @@ source/%.o: ../source/%.c source/subdir.mk
 clean: clean-source
 
 clean-source:
-	-$(RM) ./source/led.d ./source/led.o ./source/main.d ./source/main.o ./source/mtb.d ./source/mtb.o ./source/semihost_hardfault.d ./source/semihost_hardfault.o ./source/touch.d ./source/touch.o
+	-$(RM) ./source/blackbox.d ./source/blackbox.o ./source/boottime.d ./source/boottime.o ./source/clocks.d ./source/clocks.o ./source/console.d ./source/console.o ./source/crc.d ./source/crc.o ./source/fault.d ./source/fault.o ./source/flash_async.d ./source/flash_async.o ./source/led.d ./source/led.o ./source/main.d ./source/main.o ./source/mtb.d ./source/mtb.o ./source/params.d ./source/params.o ./source/pool.d ./source/pool.o ./source/power.d ./source/power.o ./source/semihost_hardfault.d ./source/semihost_hardfault.o ./source/serial.d ./source/serial.o ./source/settings.d ./source/settings.o ./source/shell.d ./source/shell.o ./source/stack.d ./source/stack.o ./source/telemetry.d ./source/telemetry.o ./source/touch.d ./source/touch.o ./source/trace.d ./source/trace.o ./source/update.d ./source/update.o
 
 .PHONY: clean-source
 
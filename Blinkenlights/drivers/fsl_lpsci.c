@@ -48,6 +48,11 @@ enum _lpsci_tansfer_state
 /* Typedef for interrupt handler. */
 typedef void (*lpsci_isr_t)(UART0_Type *base, lpsci_handle_t *handle);
 
+#if defined(FSL_FEATURE_LPSCI_HAS_DMA_ENABLE) && FSL_FEATURE_LPSCI_HAS_DMA_ENABLE
+/* Largest DMA byte count that can be loaded, BCR[23:20] must be written as 0. */
+#define LPSCI_DMA_BCR_MAX (0xFFFFFU)
+#endif
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -60,14 +65,6 @@ typedef void (*lpsci_isr_t)(UART0_Type *base, lpsci_handle_t *handle);
  */
 uint32_t LPSCI_GetInstance(UART0_Type *base);
 
-/*!
- * @brief Get the length of received data in RX ring buffer.
- *
- * @userData handle LPSCI handle pointer.
- * @return Length of received data in RX ring buffer.
- */
-static size_t LPSCI_TransferGetRxRingBufferLength(lpsci_handle_t *handle);
-
 /*!
  * @brief Check whether the RX ring buffer is full.
  *
@@ -77,6 +74,16 @@ static size_t LPSCI_TransferGetRxRingBufferLength(lpsci_handle_t *handle);
  */
 static bool LPSCI_TransferIsRxRingBufferFull(lpsci_handle_t *handle);
 
+#if defined(FSL_FEATURE_LPSCI_HAS_DMA_ENABLE) && FSL_FEATURE_LPSCI_HAS_DMA_ENABLE
+/*!
+ * @brief Hands the bytes the DMA received since the previous idle line to the frame callback.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle LPSCI handle pointer.
+ */
+static void LPSCI_TransferHandleRxDmaIdle(UART0_Type *base, lpsci_handle_t *handle);
+#endif
+
 /*!
  * @brief Write to TX register using non-blocking method.
  *
@@ -105,6 +112,22 @@ static void LPSCI_WriteNonBlocking(UART0_Type *base, const uint8_t *data, size_t
  */
 static void LPSCI_ReadNonBlocking(UART0_Type *base, uint8_t *data, size_t length);
 
+/*!
+ * @brief Loads the next non-empty scatter-gather segment into txData/txDataSize.
+ *
+ * @param handle LPSCI handle pointer.
+ * @return true if a segment was loaded, false if there are none left.
+ */
+static bool LPSCI_TransferLoadNextSegment(lpsci_handle_t *handle);
+
+/*!
+ * @brief Programs OSR, SBR and BOTHEDGE. TX and RX must be disabled by the caller.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param baudConfig Divisor settings from LPSCI_CalculateBaudRate().
+ */
+static void LPSCI_WriteBaudConfig(UART0_Type *base, const lpsci_baud_config_t *baudConfig);
+
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -146,7 +169,7 @@ uint32_t LPSCI_GetInstance(UART0_Type *base)
     return instance;
 }
 
-static size_t LPSCI_TransferGetRxRingBufferLength(lpsci_handle_t *handle)
+size_t LPSCI_TransferGetRxRingBufferLength(lpsci_handle_t *handle)
 {
     assert(handle);
 
@@ -210,57 +233,36 @@ static void LPSCI_WriteNonBlocking(UART0_Type *base, const uint8_t *data, size_t
     }
 }
 
+static void LPSCI_WriteBaudConfig(UART0_Type *base, const lpsci_baud_config_t *baudConfig)
+{
+    /* Check if OSR is between 4x and 7x oversampling*/
+    /* If so, then "BOTHEDGE" sampling must be turned on, otherwise leave it off */
+    if ((baudConfig->osr > 3) && (baudConfig->osr < 8))
+    {
+        base->C5 |= UART0_C5_BOTHEDGE_MASK;
+    }
+    else
+    {
+        base->C5 &= ~UART0_C5_BOTHEDGE_MASK;
+    }
+
+    /* program the osr value (bit value is one less than actual value)*/
+    base->C4 = ((base->C4 & ~UART0_C4_OSR_MASK) | (uint8_t)(baudConfig->osr - 1));
+
+    /* program the sbr (divider) value obtained above*/
+    base->BDH = ((base->BDH & ~UART0_BDH_SBR_MASK) | (uint8_t)(baudConfig->sbr >> 8));
+    base->BDL = (uint8_t)baudConfig->sbr;
+}
+
 status_t LPSCI_Init(UART0_Type *base, const lpsci_config_t *config, uint32_t srcClock_Hz)
 {
     assert(config);
     assert(config->baudRate_Bps);
 
     uint8_t temp;
-    uint16_t sbr = 0;
-    uint16_t sbrTemp;
-    uint32_t osr = 0;
-    uint32_t osrTemp;
-    uint32_t tempDiff, calculatedBaud, baudDiff;
+    lpsci_baud_config_t baudConfig;
 
-    /* This LPSCI instantiation uses a slightly different baud rate calculation
-     * The idea is to use the best OSR (over-sampling rate) possible
-     * Note, OSR is typically hard-set to 16 in other LPSCI instantiations
-     * loop to find the best OSR value possible, one that generates minimum baudDiff
-     * iterate through the rest of the supported values of OSR */
-
-    baudDiff = config->baudRate_Bps;
-    for (osrTemp = 4; osrTemp <= 32; osrTemp++)
-    {
-        /* calculate the temporary sbr value   */
-        sbrTemp = (srcClock_Hz / (config->baudRate_Bps * osrTemp));
-        /* set sbrTemp to 1 if the sourceClockInHz can not satisfy the desired baud rate */
-        if (sbrTemp == 0)
-        {
-            sbrTemp = 1;
-        }
-        /* Calculate the baud rate based on the temporary OSR and SBR values */
-        calculatedBaud = (srcClock_Hz / (osrTemp * sbrTemp));
-
-        tempDiff = calculatedBaud - config->baudRate_Bps;
-
-        /* Select the better value between srb and (sbr + 1) */
-        if (tempDiff > (config->baudRate_Bps - (srcClock_Hz / (osrTemp * (sbrTemp + 1)))))
-        {
-            tempDiff = config->baudRate_Bps - (srcClock_Hz / (osrTemp * (sbrTemp + 1)));
-            sbrTemp++;
-        }
-
-        if (tempDiff <= baudDiff)
-        {
-            baudDiff = tempDiff;
-            osr = osrTemp; /* update and store the best OSR value calculated*/
-            sbr = sbrTemp; /* update store the best SBR value calculated*/
-        }
-    }
-
-    /* next, check to see if actual baud rate is within 3% of desired baud rate
-     * based on the best calculate OSR value */
-    if (baudDiff > ((config->baudRate_Bps / 100) * 3))
+    if (kStatus_Success != LPSCI_CalculateBaudRate(config->baudRate_Bps, srcClock_Hz, &baudConfig))
     {
         /* Unacceptable baud rate difference of more than 3%*/
         return kStatus_LPSCI_BaudrateNotSupport;
@@ -274,20 +276,7 @@ status_t LPSCI_Init(UART0_Type *base, const lpsci_config_t *config, uint32_t src
     /* Disable TX RX before setting. */
     base->C2 &= ~(UART0_C2_TE_MASK | UART0_C2_RE_MASK);
 
-    /* Acceptable baud rate */
-    /* Check if OSR is between 4x and 7x oversampling*/
-    /* If so, then "BOTHEDGE" sampling must be turned on*/
-    if ((osr > 3) && (osr < 8))
-    {
-        base->C5 |= UART0_C5_BOTHEDGE_MASK;
-    }
-
-    /* program the osr value (bit value is one less than actual value)*/
-    base->C4 = ((base->C4 & ~UART0_C4_OSR_MASK) | (osr - 1));
-
-    /* program the sbr (divider) value obtained above*/
-    base->BDH = ((base->C4 & ~UART0_BDH_SBR_MASK) | (uint8_t)(sbr >> 8));
-    base->BDL = (uint8_t)sbr;
+    LPSCI_WriteBaudConfig(base, &baudConfig);
 
     /* set parity mode */
     temp = base->C1 & ~(UART0_C1_PE_MASK | UART0_C1_PT_MASK | UART0_C1_M_MASK);
@@ -347,85 +336,97 @@ void LPSCI_GetDefaultConfig(lpsci_config_t *config)
     config->enableRx = false;
 }
 
-status_t LPSCI_SetBaudRate(UART0_Type *base, uint32_t baudRate_Bps, uint32_t srcClock_Hz)
+status_t LPSCI_CalculateBaudRate(uint32_t baudRate_Bps, uint32_t srcClock_Hz, lpsci_baud_config_t *baudConfig)
 {
     assert(baudRate_Bps);
+    assert(baudConfig);
 
-    uint16_t sbrTemp;
-    uint32_t osr = 0, sbr = 0;
-    uint8_t osrTemp;
-    uint32_t tempDiff, calculatedBaud, baudDiff;
-    uint8_t oldCtrl;
+    uint32_t osrTemp;
+    uint32_t sbrTemp;
+    uint32_t sbrCandidate;
+    uint32_t i;
+    uint64_t actualClock;
+    uint64_t tempDiff;
+    uint64_t tempError;
+    uint64_t bestError = UINT64_MAX;
+
+    baudConfig->osr = 0U;
+    baudConfig->sbr = 0U;
 
     /* This LPSCI instantiation uses a slightly different baud rate calculation
      * The idea is to use the best OSR (over-sampling rate) possible
      * Note, OSR is typically hard-set to 16 in other LPSCI instantiations
-     * First calculate the baud rate using the minimum OSR possible (4). */
-    baudDiff = baudRate_Bps;
-    for (osrTemp = 4; osrTemp <= 32; osrTemp++)
+     * For each OSR, try the SBR values on both sides of the ideal divisor and keep the
+     * pair whose rate is closest to the request. */
+    for (osrTemp = 4U; osrTemp <= 32U; osrTemp++)
     {
-        /* calculate the temporary sbr value   */
-        sbrTemp = (srcClock_Hz / (baudRate_Bps * osrTemp));
-        /* set sbrTemp to 1 if the sourceClockInHz can not satisfy the desired baud rate */
-        if (sbrTemp == 0)
-        {
-            sbrTemp = 1;
-        }
-        /* Calculate the baud rate based on the temporary OSR and SBR values */
-        calculatedBaud = (srcClock_Hz / (osrTemp * sbrTemp));
-
-        tempDiff = calculatedBaud - baudRate_Bps;
+        sbrTemp = srcClock_Hz / (baudRate_Bps * osrTemp);
 
-        /* Select the better value between srb and (sbr + 1) */
-        if (tempDiff > (baudRate_Bps - (srcClock_Hz / (osrTemp * (sbrTemp + 1)))))
+        for (i = 0U; i < 2U; i++)
         {
-            tempDiff = baudRate_Bps - (srcClock_Hz / (osrTemp * (sbrTemp + 1)));
-            sbrTemp++;
-        }
+            sbrCandidate = sbrTemp + i;
+            if ((sbrCandidate == 0U) || (sbrCandidate > (UART0_BDL_SBR_MASK | (UART0_BDH_SBR_MASK << 8U))))
+            {
+                continue;
+            }
 
-        if (tempDiff <= baudDiff)
-        {
-            baudDiff = tempDiff;
-            osr = osrTemp; /* update and store the best OSR value calculated*/
-            sbr = sbrTemp; /* update store the best SBR value calculated*/
+            /* Relative error is |srcClock - baud * osr * sbr| / (baud * osr * sbr), compared here
+             * scaled to parts per million so no precision is lost to integer division. */
+            actualClock = (uint64_t)baudRate_Bps * osrTemp * sbrCandidate;
+            tempDiff = (actualClock > srcClock_Hz) ? (actualClock - srcClock_Hz) : (srcClock_Hz - actualClock);
+            tempError = (tempDiff * 1000000U) / actualClock;
+
+            if (tempError <= bestError)
+            {
+                bestError = tempError;
+                baudConfig->osr = osrTemp;
+                baudConfig->sbr = sbrCandidate;
+            }
         }
     }
 
-    /* next, check to see if actual baud rate is within 3% of desired baud rate
-     * based on the best calculate OSR value */
-    if (baudDiff < ((baudRate_Bps / 100) * 3))
+    if (baudConfig->osr == 0U)
     {
-        /* Store C2 before disable Tx and Rx */
-        oldCtrl = base->C2;
+        return kStatus_LPSCI_BaudrateNotSupport;
+    }
 
-        /* Disable LPSCI TX RX before setting. */
-        base->C2 &= ~(UART0_C2_TE_MASK | UART0_C2_RE_MASK);
+    baudConfig->baudRate_Bps = srcClock_Hz / (baudConfig->osr * baudConfig->sbr);
+    baudConfig->errorPpm = (uint32_t)bestError;
 
-        /* Acceptable baud rate */
-        /* Check if OSR is between 4x and 7x oversampling*/
-        /* If so, then "BOTHEDGE" sampling must be turned on*/
-        if ((osr > 3) && (osr < 8))
-        {
-            base->C5 |= UART0_C5_BOTHEDGE_MASK;
-        }
+    /* next, check to see if actual baud rate is within 3% of desired baud rate */
+    if (bestError > 30000U)
+    {
+        return kStatus_LPSCI_BaudrateNotSupport;
+    }
 
-        /* program the osr value (bit value is one less than actual value)*/
-        base->C4 = ((base->C4 & ~UART0_C4_OSR_MASK) | (osr - 1));
+    return kStatus_Success;
+}
 
-        /* program the sbr (divider) value obtained above*/
-        base->BDH = ((base->C4 & ~UART0_BDH_SBR_MASK) | (uint8_t)(sbr >> 8));
-        base->BDL = (uint8_t)sbr;
+status_t LPSCI_SetBaudRate(UART0_Type *base, uint32_t baudRate_Bps, uint32_t srcClock_Hz)
+{
+    assert(baudRate_Bps);
 
-        /* Restore C2. */
-        base->C2 = oldCtrl;
+    uint8_t oldCtrl;
+    lpsci_baud_config_t baudConfig;
 
-        return kStatus_Success;
-    }
-    else
+    if (kStatus_Success != LPSCI_CalculateBaudRate(baudRate_Bps, srcClock_Hz, &baudConfig))
     {
         /* Unacceptable baud rate difference of more than 3%*/
         return kStatus_LPSCI_BaudrateNotSupport;
     }
+
+    /* Store C2 before disable Tx and Rx */
+    oldCtrl = base->C2;
+
+    /* Disable LPSCI TX RX before setting. */
+    base->C2 &= ~(UART0_C2_TE_MASK | UART0_C2_RE_MASK);
+
+    LPSCI_WriteBaudConfig(base, &baudConfig);
+
+    /* Restore C2. */
+    base->C2 = oldCtrl;
+
+    return kStatus_Success;
 }
 
 void LPSCI_EnableInterrupts(UART0_Type *base, uint32_t mask)
@@ -648,6 +649,149 @@ void LPSCI_TransferStopRingBuffer(UART0_Type *base, lpsci_handle_t *handle)
     handle->rxRingBufferTail = 0U;
 }
 
+#if defined(FSL_FEATURE_LPSCI_HAS_DMA_ENABLE) && FSL_FEATURE_LPSCI_HAS_DMA_ENABLE
+status_t LPSCI_TransferStartRxDma(UART0_Type *base,
+                                  lpsci_handle_t *handle,
+                                  uint8_t *buffer,
+                                  size_t bufferSize,
+                                  uint32_t channel,
+                                  lpsci_rx_frame_callback_t callback)
+{
+    assert(handle);
+    assert(buffer);
+    assert(callback);
+    assert(channel < FSL_FEATURE_DMA_MODULE_CHANNEL);
+
+    uint32_t dmod = 1U;
+    uint8_t c2;
+
+    /* DMOD n wraps the destination address on a (16 << (n - 1)) byte boundary, n = 1..15. */
+    while ((dmod < 15U) && ((16U << (dmod - 1U)) < bufferSize))
+    {
+        dmod++;
+    }
+
+    if (((16U << (dmod - 1U)) != bufferSize) || ((uint32_t)buffer & (bufferSize - 1U)))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    if ((handle->rxRingBuffer) || (kLPSCI_RxBusy == handle->rxState))
+    {
+        return kStatus_LPSCI_RxBusy;
+    }
+
+    handle->rxDmaBuffer = buffer;
+    handle->rxDmaBufferSize = bufferSize;
+    handle->rxDmaChannel = channel;
+    handle->rxDmaReceived = 0U;
+    handle->rxDmaConsumed = 0U;
+    handle->rxFrameCallback = callback;
+
+    CLOCK_EnableClock(kCLOCK_Dmamux0);
+    CLOCK_EnableClock(kCLOCK_Dma0);
+
+    /* Byte-wide reads from the data register into an incrementing, wrapping destination. The channel stays enabled
+       until the byte count runs out, which the idle line handler prevents by reloading it. */
+    DMAMUX0->CHCFG[channel] = 0U;
+    DMA0->DMA[channel].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    DMA0->DMA[channel].SAR = LPSCI_GetDataRegisterAddress(base);
+    DMA0->DMA[channel].DAR = (uint32_t)buffer;
+    DMA0->DMA[channel].DSR_BCR = DMA_DSR_BCR_BCR(LPSCI_DMA_BCR_MAX);
+    DMA0->DMA[channel].DCR = DMA_DCR_ERQ_MASK | DMA_DCR_CS_MASK | DMA_DCR_SSIZE(1U) | DMA_DCR_DINC_MASK |
+                             DMA_DCR_DSIZE(1U) | DMA_DCR_DMOD(dmod);
+    DMAMUX0->CHCFG[channel] = DMAMUX_CHCFG_ENBL_MASK | DMAMUX_CHCFG_SOURCE(kDmaRequestMux0LPSCI0Rx & 0xFFU);
+
+    /* Count the idle time from the stop bit, so a frame only ends after a whole idle character. */
+    c2 = base->C2;
+    base->C2 &= ~(UART0_C2_TE_MASK | UART0_C2_RE_MASK);
+    base->C1 |= UART0_C1_ILT_MASK;
+    base->C2 = c2;
+
+    LPSCI_ClearStatusFlags(base, kLPSCI_IdleLineFlag);
+    LPSCI_EnableInterrupts(base, kLPSCI_IdleLineInterruptEnable | kLPSCI_RxOverrunInterruptEnable |
+                                     kLPSCI_FramingErrorInterruptEnable);
+    LPSCI_EnableRxDMA(base, true);
+
+    return kStatus_Success;
+}
+
+void LPSCI_TransferStopRxDma(UART0_Type *base, lpsci_handle_t *handle)
+{
+    assert(handle);
+
+    if (!handle->rxDmaBuffer)
+    {
+        return;
+    }
+
+    LPSCI_EnableRxDMA(base, false);
+    LPSCI_DisableInterrupts(base, kLPSCI_IdleLineInterruptEnable | kLPSCI_RxOverrunInterruptEnable |
+                                      kLPSCI_FramingErrorInterruptEnable);
+
+    DMAMUX0->CHCFG[handle->rxDmaChannel] = 0U;
+    DMA0->DMA[handle->rxDmaChannel].DCR = 0U;
+    DMA0->DMA[handle->rxDmaChannel].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+
+    handle->rxDmaBuffer = NULL;
+    handle->rxDmaBufferSize = 0U;
+    handle->rxFrameCallback = NULL;
+}
+
+static void LPSCI_TransferHandleRxDmaIdle(UART0_Type *base, lpsci_handle_t *handle)
+{
+    lpsci_segment_t frame[2];
+    size_t segmentCount = 1U;
+    uint32_t remaining;
+    uint32_t received;
+    uint32_t length;
+    uint32_t tail;
+
+    /* Bytes received so far, from how far the byte count has run down since it was last loaded. */
+    remaining = DMA0->DMA[handle->rxDmaChannel].DSR_BCR & DMA_DSR_BCR_BCR_MASK;
+    received = handle->rxDmaReceived + (LPSCI_DMA_BCR_MAX - remaining);
+
+    /* Reload the byte count long before it runs out. The line is idle, so no DMA request is pending. */
+    if (remaining < (LPSCI_DMA_BCR_MAX / 2U))
+    {
+        DMA0->DMA[handle->rxDmaChannel].DSR_BCR = DMA_DSR_BCR_BCR(LPSCI_DMA_BCR_MAX);
+        handle->rxDmaReceived = received;
+    }
+
+    length = received - handle->rxDmaConsumed;
+    tail = handle->rxDmaConsumed & (handle->rxDmaBufferSize - 1U);
+    handle->rxDmaConsumed = received;
+
+    if (!length)
+    {
+        return;
+    }
+
+    /* The DMA has already written over the start of this frame. */
+    if (length > handle->rxDmaBufferSize)
+    {
+        if (handle->callback)
+        {
+            handle->callback(base, handle, kStatus_LPSCI_RxRingBufferOverrun, handle->userData);
+        }
+        return;
+    }
+
+    frame[0].data = handle->rxDmaBuffer + tail;
+    frame[0].dataSize = MIN(length, handle->rxDmaBufferSize - tail);
+
+    /* The frame wraps around the end of the buffer. */
+    if (frame[0].dataSize < length)
+    {
+        frame[1].data = handle->rxDmaBuffer;
+        frame[1].dataSize = length - frame[0].dataSize;
+        segmentCount = 2U;
+    }
+
+    handle->rxFrameCallback(base, handle, frame, segmentCount, handle->userData);
+}
+#endif /* defined(FSL_FEATURE_LPSCI_HAS_DMA_ENABLE) && FSL_FEATURE_LPSCI_HAS_DMA_ENABLE */
+
 status_t LPSCI_TransferSendNonBlocking(UART0_Type *base, lpsci_handle_t *handle, lpsci_transfer_t *xfer)
 {
     assert(handle);
@@ -667,6 +811,8 @@ status_t LPSCI_TransferSendNonBlocking(UART0_Type *base, lpsci_handle_t *handle,
         handle->txData = xfer->data;
         handle->txDataSize = xfer->dataSize;
         handle->txDataSizeAll = xfer->dataSize;
+        handle->txSegmentCount = 0U;
+        handle->txSegmentsSize = 0U;
         handle->txState = kLPSCI_TxBusy;
 
         /* Enable transmiter interrupt. */
@@ -678,6 +824,69 @@ status_t LPSCI_TransferSendNonBlocking(UART0_Type *base, lpsci_handle_t *handle,
     return status;
 }
 
+static bool LPSCI_TransferLoadNextSegment(lpsci_handle_t *handle)
+{
+    const lpsci_segment_t *segment;
+
+    while (handle->txSegmentCount)
+    {
+        segment = handle->txSegments;
+        handle->txSegments = segment + 1;
+        handle->txSegmentCount--;
+        handle->txSegmentsSize -= segment->dataSize;
+
+        if (segment->dataSize)
+        {
+            handle->txData = (uint8_t *)segment->data;
+            handle->txDataSize = segment->dataSize;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+status_t LPSCI_TransferSendSegmentsNonBlocking(UART0_Type *base,
+                                               lpsci_handle_t *handle,
+                                               const lpsci_segment_t *segments,
+                                               size_t segmentCount)
+{
+    assert(handle);
+    assert(segments);
+    assert(segmentCount);
+
+    size_t i;
+    size_t totalSize = 0U;
+
+    /* Return error if current TX busy. */
+    if (kLPSCI_TxBusy == handle->txState)
+    {
+        return kStatus_LPSCI_TxBusy;
+    }
+
+    for (i = 0U; i < segmentCount; i++)
+    {
+        totalSize += segments[i].dataSize;
+    }
+
+    if (!totalSize)
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    handle->txSegments = segments;
+    handle->txSegmentCount = segmentCount;
+    handle->txSegmentsSize = totalSize;
+    LPSCI_TransferLoadNextSegment(handle);
+    handle->txDataSizeAll = totalSize;
+    handle->txState = kLPSCI_TxBusy;
+
+    /* Enable transmiter interrupt. */
+    LPSCI_EnableInterrupts(base, kLPSCI_TxDataRegEmptyInterruptEnable);
+
+    return kStatus_Success;
+}
+
 void LPSCI_TransferAbortSend(UART0_Type *base, lpsci_handle_t *handle)
 {
     assert(handle);
@@ -685,6 +894,8 @@ void LPSCI_TransferAbortSend(UART0_Type *base, lpsci_handle_t *handle)
     LPSCI_DisableInterrupts(base, kLPSCI_TxDataRegEmptyInterruptEnable | kLPSCI_TransmissionCompleteInterruptEnable);
 
     handle->txDataSize = 0;
+    handle->txSegmentCount = 0U;
+    handle->txSegmentsSize = 0U;
     handle->txState = kLPSCI_TxIdle;
 }
 
@@ -698,7 +909,7 @@ status_t LPSCI_TransferGetSendCount(UART0_Type *base, lpsci_handle_t *handle, ui
         return kStatus_NoTransferInProgress;
     }
 
-    *count = handle->txDataSizeAll - handle->txDataSize;
+    *count = handle->txDataSizeAll - handle->txDataSize - handle->txSegmentsSize;
 
     return kStatus_Success;
 }
@@ -868,6 +1079,8 @@ void LPSCI_TransferHandleIRQ(UART0_Type *base, lpsci_handle_t *handle)
     uint8_t count;
     uint8_t tempCount;
 
+    handle->irqCount++;
+
     /* If RX parity error */
     if (UART0_S1_PF_MASK & base->S1)
     {
@@ -909,8 +1122,21 @@ void LPSCI_TransferHandleIRQ(UART0_Type *base, lpsci_handle_t *handle)
         }
     }
 
-    /* Receive data register full */
-    if ((UART0_S1_RDRF_MASK & base->S1) && (UART0_C2_RIE_MASK & base->C2))
+#if defined(FSL_FEATURE_LPSCI_HAS_DMA_ENABLE) && FSL_FEATURE_LPSCI_HAS_DMA_ENABLE
+    /* Idle line after a frame received by DMA. */
+    if ((UART0_S1_IDLE_MASK & base->S1) && (UART0_C2_ILIE_MASK & base->C2))
+    {
+        LPSCI_ClearStatusFlags(base, kLPSCI_IdleLineFlag);
+
+        if (handle->rxDmaBuffer)
+        {
+            LPSCI_TransferHandleRxDmaIdle(base, handle);
+        }
+    }
+#endif
+
+    /* Receive data register full, and the DMA is not the one reading it */
+    if ((UART0_S1_RDRF_MASK & base->S1) && (UART0_C2_RIE_MASK & base->C2) && (!(UART0_C5_RDMAE_MASK & base->C5)))
     {
 /* Get the size that can be stored into buffer for this interrupt. */
 #if defined(FSL_FEATURE_LPSCI_HAS_FIFO) && FSL_FEATURE_LPSCI_HAS_FIFO
@@ -1006,7 +1232,11 @@ void LPSCI_TransferHandleIRQ(UART0_Type *base, lpsci_handle_t *handle)
     }
     /* If framing error or parity error happened, stop the RX interrupt when ues no ring buffer */
     if (((handle->rxState == kLPSCI_RxFramingError) || (handle->rxState == kLPSCI_RxParityError)) &&
-        (!handle->rxRingBuffer))
+        (!handle->rxRingBuffer)
+#if defined(FSL_FEATURE_LPSCI_HAS_DMA_ENABLE) && FSL_FEATURE_LPSCI_HAS_DMA_ENABLE
+        && (!handle->rxDmaBuffer)
+#endif
+            )
     {
         LPSCI_DisableInterrupts(base, kLPSCI_RxDataRegFullInterruptEnable | kLPSCI_RxOverrunInterruptEnable |
                                           kLPSCI_FramingErrorInterruptEnable);
@@ -1045,6 +1275,12 @@ void LPSCI_TransferHandleIRQ(UART0_Type *base, lpsci_handle_t *handle)
             /* If all the data are written to data register, enable TX complete interrupt. */
             if (!handle->txDataSize)
             {
+                /* Continue with the next scatter-gather segment, if any. */
+                if (LPSCI_TransferLoadNextSegment(handle))
+                {
+                    continue;
+                }
+
                 handle->txState = kLPSCI_TxIdle;
 
                 /* Disable TX register empty interrupt. */
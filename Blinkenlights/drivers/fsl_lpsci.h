@@ -162,6 +162,15 @@ typedef struct _lpsci_config
     bool enableRx; /*!< Enable RX */
 } lpsci_config_t;
 
+/*! @brief LPSCI baud rate divisor settings and the rate they achieve. */
+typedef struct _lpsci_baud_config
+{
+    uint32_t osr;          /*!< Over-sampling ratio, 4 to 32 */
+    uint32_t sbr;          /*!< Baud rate modulo divisor, 1 to 8191 */
+    uint32_t baudRate_Bps; /*!< Baud rate actually produced by osr and sbr */
+    uint32_t errorPpm;     /*!< Magnitude of the error against the requested rate, in parts per million */
+} lpsci_baud_config_t;
+
 /*! @brief LPSCI transfer structure. */
 typedef struct _lpsci_transfer
 {
@@ -169,12 +178,32 @@ typedef struct _lpsci_transfer
     size_t dataSize; /*!< The byte count to be transfer. */
 } lpsci_transfer_t;
 
+/*! @brief LPSCI scatter-gather segment, one piece of a vectored send. */
+typedef struct _lpsci_segment
+{
+    const uint8_t *data; /*!< Start of the segment.*/
+    size_t dataSize;     /*!< The byte count of the segment. May be 0. */
+} lpsci_segment_t;
+
 /* Forward declaration of the handle typedef. */
 typedef struct _lpsci_handle lpsci_handle_t;
 
 /*! @brief LPSCI transfer callback function. */
 typedef void (*lpsci_transfer_callback_t)(UART0_Type *base, lpsci_handle_t *handle, status_t status, void *userData);
 
+#if defined(FSL_FEATURE_LPSCI_HAS_DMA_ENABLE) && FSL_FEATURE_LPSCI_HAS_DMA_ENABLE
+/*! @brief LPSCI DMA receive frame callback function.
+ *
+ * Called from the idle line interrupt with the frame as one segment, or two if it wraps around the end of the
+ * DMA buffer. The segments point into the DMA buffer and are only valid until the callback returns.
+ */
+typedef void (*lpsci_rx_frame_callback_t)(UART0_Type *base,
+                                          lpsci_handle_t *handle,
+                                          const lpsci_segment_t *frame,
+                                          size_t segmentCount,
+                                          void *userData);
+#endif /* defined(FSL_FEATURE_LPSCI_HAS_DMA_ENABLE) && FSL_FEATURE_LPSCI_HAS_DMA_ENABLE */
+
 /*<! @brief LPSCI handle used for storing the state among transactional APIs' calling. This structure is only used for
  * transactional APIs. */
 struct _lpsci_handle
@@ -182,6 +211,9 @@ struct _lpsci_handle
     uint8_t *volatile txData;   /*!< Address of remaining data to send. */
     volatile size_t txDataSize; /*!< Size of the remaining data to send. */
     size_t txDataSizeAll;       /*!< Size of the data to send out. */
+    const lpsci_segment_t *volatile txSegments; /*!< Segments still to be sent after the current one. */
+    volatile size_t txSegmentCount;            /*!< Number of segments left in txSegments. */
+    volatile size_t txSegmentsSize;            /*!< Bytes in txSegments not yet loaded into txData. */
     uint8_t *volatile rxData;   /*!< Address of remaining data to receive. */
     volatile size_t rxDataSize; /*!< Size of the remaining data to receive. */
     size_t rxDataSizeAll;       /*!< Size of the data to receive. */
@@ -191,11 +223,22 @@ struct _lpsci_handle
     volatile uint16_t rxRingBufferHead; /*!< Index for the driver to store received data into ring buffer. */
     volatile uint16_t rxRingBufferTail; /*!< Index for the user to get data from the ring buffer. */
 
+#if defined(FSL_FEATURE_LPSCI_HAS_DMA_ENABLE) && FSL_FEATURE_LPSCI_HAS_DMA_ENABLE
+    uint8_t *rxDmaBuffer;                      /*!< Start address of the DMA receive buffer. */
+    size_t rxDmaBufferSize;                    /*!< Size of the DMA receive buffer. */
+    uint32_t rxDmaChannel;                     /*!< DMA channel moving received data into rxDmaBuffer. */
+    volatile uint32_t rxDmaReceived;           /*!< Bytes received when the DMA byte count was last reloaded. */
+    volatile uint32_t rxDmaConsumed;           /*!< Bytes already handed to rxFrameCallback. */
+    lpsci_rx_frame_callback_t rxFrameCallback; /*!< DMA receive frame callback function. */
+#endif
+
     lpsci_transfer_callback_t callback; /*!< Callback function. */
     void *userData;                     /*!< LPSCI callback function parameter.*/
 
     volatile uint8_t txState; /*!< TX transfer state. */
     volatile uint8_t rxState; /*!< RX transfer state */
+
+    volatile uint32_t irqCount; /*!< Number of times LPSCI_TransferHandleIRQ() has run. */
 };
 
 /*******************************************************************************
@@ -257,6 +300,22 @@ void LPSCI_Deinit(UART0_Type *base);
  */
 void LPSCI_GetDefaultConfig(lpsci_config_t *config);
 
+/*!
+ * @brief Calculates the OSR and SBR values that best approximate a baud rate.
+ *
+ * Every over-sampling ratio from 4 to 32 is tried with the two SBR values bracketing the ideal
+ * divisor, and the pair with the smallest error is kept. On a tie the higher OSR wins because it
+ * samples each bit more often. No registers are touched, so this can be used to check a rate
+ * before switching to it.
+ *
+ * @param baudRate_Bps LPSCI baudrate to be set.
+ * @param srcClock_Hz LPSCI clock source frequency in HZ.
+ * @param baudConfig Filled with the selected divisors, the achieved rate and its error.
+ * @retval kStatus_LPSCI_BaudrateNotSupport The best achievable rate is more than 3% off.
+ * @retval kStatus_Success A rate within 3% was found.
+ */
+status_t LPSCI_CalculateBaudRate(uint32_t baudRate_Bps, uint32_t srcClock_Hz, lpsci_baud_config_t *baudConfig);
+
 /*!
  * @brief Sets the LPSCI instance baudrate.
  *
@@ -613,6 +672,58 @@ void LPSCI_TransferStartRingBuffer(UART0_Type *base,
  */
 void LPSCI_TransferStopRingBuffer(UART0_Type *base, lpsci_handle_t *handle);
 
+/*!
+ * @brief Gets the length of received data in the RX ring buffer.
+ *
+ * @param handle LPSCI handle pointer.
+ * @return Length of received data in RX ring buffer.
+ */
+size_t LPSCI_TransferGetRxRingBufferLength(lpsci_handle_t *handle);
+
+#if defined(FSL_FEATURE_LPSCI_HAS_DMA_ENABLE) && FSL_FEATURE_LPSCI_HAS_DMA_ENABLE
+/*!
+ * @brief Starts receiving variable-length frames by DMA.
+ *
+ * A DMA channel copies every received byte into @p buffer, which it treats as a circular buffer. When the line goes
+ * idle for one character time, the idle line interrupt hands the bytes received since the previous frame to
+ * @p callback without copying them. The driver does not wait for the application, so the callback must finish with
+ * a frame before @p bufferSize more bytes arrive. If more than @p bufferSize bytes arrive between two idle lines,
+ * the frame is dropped and the transfer callback is called with @ref kStatus_LPSCI_RxRingBufferOverrun.
+ *
+ * The DMA wraps the buffer with the DCR[DMOD] address modulo, so @p bufferSize must be a power of 2 from 16 to
+ * 256K and @p buffer must be aligned to @p bufferSize.
+ *
+ * @note The DMA receive mode and the RX ring buffer cannot be used at the same time, and
+ * LPSCI_TransferReceiveNonBlocking() must not be used while it is running.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle LPSCI handle pointer.
+ * @param buffer Start address of the DMA receive buffer.
+ * @param bufferSize Size of the DMA receive buffer.
+ * @param channel DMA channel to use, from 0 to FSL_FEATURE_DMA_MODULE_CHANNEL - 1.
+ * @param callback Called with every received frame.
+ * @retval kStatus_Success The DMA receive mode has started.
+ * @retval kStatus_InvalidArgument @p bufferSize is not a supported size or @p buffer is not aligned to it.
+ * @retval kStatus_LPSCI_RxBusy The RX ring buffer or a non-blocking receive is using the receiver.
+ */
+status_t LPSCI_TransferStartRxDma(UART0_Type *base,
+                                  lpsci_handle_t *handle,
+                                  uint8_t *buffer,
+                                  size_t bufferSize,
+                                  uint32_t channel,
+                                  lpsci_rx_frame_callback_t callback);
+
+/*!
+ * @brief Stops the DMA receive mode and releases its DMA channel.
+ *
+ * Bytes received after the last idle line are discarded.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle LPSCI handle pointer.
+ */
+void LPSCI_TransferStopRxDma(UART0_Type *base, lpsci_handle_t *handle);
+#endif /* defined(FSL_FEATURE_LPSCI_HAS_DMA_ENABLE) && FSL_FEATURE_LPSCI_HAS_DMA_ENABLE */
+
 /*!
  * @brief Transmits a buffer of data using the interrupt method.
  *
@@ -633,6 +744,28 @@ void LPSCI_TransferStopRingBuffer(UART0_Type *base, lpsci_handle_t *handle);
  */
 status_t LPSCI_TransferSendNonBlocking(UART0_Type *base, lpsci_handle_t *handle, lpsci_transfer_t *xfer);
 
+/*!
+ * @brief Transmits several buffers back to back using the interrupt method, without copying them.
+ *
+ * The TX interrupt walks the segment list in order, so a header, a payload and a trailer can be
+ * sent from where they already are in memory. Zero-length segments are skipped. The callback is
+ * called once, with @ref kStatus_LPSCI_TxIdle, after the last byte of the last segment is written to
+ * the TX register. The segment array and every buffer it points to must stay valid and unchanged
+ * until then.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle LPSCI handle pointer.
+ * @param segments Array of segments to send, in order.
+ * @param segmentCount Number of entries in segments.
+ * @retval kStatus_Success Successfully start the data transmission.
+ * @retval kStatus_LPSCI_TxBusy Previous transmission still not finished, data not all written to the TX register.
+ * @retval kStatus_InvalidArgument All segments are empty.
+ */
+status_t LPSCI_TransferSendSegmentsNonBlocking(UART0_Type *base,
+                                               lpsci_handle_t *handle,
+                                               const lpsci_segment_t *segments,
+                                               size_t segmentCount);
+
 /*!
  * @brief Aborts the interrupt-driven data transmit.
  *
@@ -60,14 +60,6 @@ typedef void (*uart_isr_t)(UART_Type *base, uart_handle_t *handle);
  */
 uint32_t UART_GetInstance(UART_Type *base);
 
-/*!
- * @brief Get the length of received data in RX ring buffer.
- *
- * @param handle UART handle pointer.
- * @return Length of received data in RX ring buffer.
- */
-static size_t UART_TransferGetRxRingBufferLength(uart_handle_t *handle);
-
 /*!
  * @brief Check whether the RX ring buffer is full.
  *
@@ -89,6 +81,14 @@ static bool UART_TransferIsRxRingBufferFull(uart_handle_t *handle);
  */
 static void UART_ReadNonBlocking(UART_Type *base, uint8_t *data, size_t length);
 
+/*!
+ * @brief Loads the next non-empty scatter-gather segment into txData/txDataSize.
+ *
+ * @param handle UART handle pointer.
+ * @return true if a segment was loaded, false if there are none left.
+ */
+static bool UART_TransferLoadNextSegment(uart_handle_t *handle);
+
 /*!
  * @brief Write to TX register using non-blocking method.
  *
@@ -171,7 +171,7 @@ uint32_t UART_GetInstance(UART_Type *base)
     return instance;
 }
 
-static size_t UART_TransferGetRxRingBufferLength(uart_handle_t *handle)
+size_t UART_TransferGetRxRingBufferLength(uart_handle_t *handle)
 {
     assert(handle);
 
@@ -727,6 +727,8 @@ status_t UART_TransferSendNonBlocking(UART_Type *base, uart_handle_t *handle, ua
         handle->txData = xfer->data;
         handle->txDataSize = xfer->dataSize;
         handle->txDataSizeAll = xfer->dataSize;
+        handle->txSegmentCount = 0U;
+        handle->txSegmentsSize = 0U;
         handle->txState = kUART_TxBusy;
 
         /* Enable transmiter interrupt. */
@@ -738,6 +740,69 @@ status_t UART_TransferSendNonBlocking(UART_Type *base, uart_handle_t *handle, ua
     return status;
 }
 
+static bool UART_TransferLoadNextSegment(uart_handle_t *handle)
+{
+    const uart_segment_t *segment;
+
+    while (handle->txSegmentCount)
+    {
+        segment = handle->txSegments;
+        handle->txSegments = segment + 1;
+        handle->txSegmentCount--;
+        handle->txSegmentsSize -= segment->dataSize;
+
+        if (segment->dataSize)
+        {
+            handle->txData = (uint8_t *)segment->data;
+            handle->txDataSize = segment->dataSize;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+status_t UART_TransferSendSegmentsNonBlocking(UART_Type *base,
+                                              uart_handle_t *handle,
+                                              const uart_segment_t *segments,
+                                              size_t segmentCount)
+{
+    assert(handle);
+    assert(segments);
+    assert(segmentCount);
+
+    size_t i;
+    size_t totalSize = 0U;
+
+    /* Return error if current TX busy. */
+    if (kUART_TxBusy == handle->txState)
+    {
+        return kStatus_UART_TxBusy;
+    }
+
+    for (i = 0U; i < segmentCount; i++)
+    {
+        totalSize += segments[i].dataSize;
+    }
+
+    if (!totalSize)
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    handle->txSegments = segments;
+    handle->txSegmentCount = segmentCount;
+    handle->txSegmentsSize = totalSize;
+    UART_TransferLoadNextSegment(handle);
+    handle->txDataSizeAll = totalSize;
+    handle->txState = kUART_TxBusy;
+
+    /* Enable transmiter interrupt. */
+    UART_EnableInterrupts(base, kUART_TxDataRegEmptyInterruptEnable);
+
+    return kStatus_Success;
+}
+
 void UART_TransferAbortSend(UART_Type *base, uart_handle_t *handle)
 {
     assert(handle);
@@ -745,6 +810,8 @@ void UART_TransferAbortSend(UART_Type *base, uart_handle_t *handle)
     UART_DisableInterrupts(base, kUART_TxDataRegEmptyInterruptEnable | kUART_TransmissionCompleteInterruptEnable);
 
     handle->txDataSize = 0;
+    handle->txSegmentCount = 0U;
+    handle->txSegmentsSize = 0U;
     handle->txState = kUART_TxIdle;
 }
 
@@ -758,7 +825,7 @@ status_t UART_TransferGetSendCount(UART_Type *base, uart_handle_t *handle, uint3
         return kStatus_NoTransferInProgress;
     }
 
-    *count = handle->txDataSizeAll - handle->txDataSize;
+    *count = handle->txDataSizeAll - handle->txDataSize - handle->txSegmentsSize;
 
     return kStatus_Success;
 }
@@ -933,6 +1000,8 @@ void UART_TransferHandleIRQ(UART_Type *base, uart_handle_t *handle)
     uint8_t count;
     uint8_t tempCount;
 
+    handle->irqCount++;
+
     /* If RX framing error */
     if (UART_S1_FE_MASK & base->S1)
     {
@@ -1134,6 +1203,12 @@ void UART_TransferHandleIRQ(UART_Type *base, uart_handle_t *handle)
             /* If all the data are written to data register, TX finished. */
             if (!handle->txDataSize)
             {
+                /* Continue with the next scatter-gather segment, if any. */
+                if (UART_TransferLoadNextSegment(handle))
+                {
+                    continue;
+                }
+
                 handle->txState = kUART_TxIdle;
 
                 /* Disable TX register empty interrupt. */
@@ -187,6 +187,13 @@ typedef struct _uart_transfer
     size_t dataSize; /*!< The byte count to be transfer. */
 } uart_transfer_t;
 
+/*! @brief UART scatter-gather segment, one piece of a vectored send. */
+typedef struct _uart_segment
+{
+    const uint8_t *data; /*!< Start of the segment.*/
+    size_t dataSize;     /*!< The byte count of the segment. May be 0. */
+} uart_segment_t;
+
 /* Forward declaration of the handle typedef. */
 typedef struct _uart_handle uart_handle_t;
 
@@ -199,6 +206,9 @@ struct _uart_handle
     uint8_t *volatile txData;   /*!< Address of remaining data to send. */
     volatile size_t txDataSize; /*!< Size of the remaining data to send. */
     size_t txDataSizeAll;       /*!< Size of the data to send out. */
+    const uart_segment_t *volatile txSegments; /*!< Segments still to be sent after the current one. */
+    volatile size_t txSegmentCount;            /*!< Number of segments left in txSegments. */
+    volatile size_t txSegmentsSize;            /*!< Bytes in txSegments not yet loaded into txData. */
     uint8_t *volatile rxData;   /*!< Address of remaining data to receive. */
     volatile size_t rxDataSize; /*!< Size of the remaining data to receive. */
     size_t rxDataSizeAll;       /*!< Size of the data to receive. */
@@ -213,6 +223,8 @@ struct _uart_handle
 
     volatile uint8_t txState; /*!< TX transfer state. */
     volatile uint8_t rxState; /*!< RX transfer state */
+
+    volatile uint32_t irqCount; /*!< Number of times UART_TransferHandleIRQ() has run. */
 };
 
 /*******************************************************************************
@@ -643,6 +655,14 @@ void UART_TransferStartRingBuffer(UART_Type *base, uart_handle_t *handle, uint8_
  */
 void UART_TransferStopRingBuffer(UART_Type *base, uart_handle_t *handle);
 
+/*!
+ * @brief Gets the length of received data in the RX ring buffer.
+ *
+ * @param handle UART handle pointer.
+ * @return Length of received data in RX ring buffer.
+ */
+size_t UART_TransferGetRxRingBufferLength(uart_handle_t *handle);
+
 /*!
  * @brief Transmits a buffer of data using the interrupt method.
  *
@@ -664,6 +684,28 @@ void UART_TransferStopRingBuffer(UART_Type *base, uart_handle_t *handle);
  */
 status_t UART_TransferSendNonBlocking(UART_Type *base, uart_handle_t *handle, uart_transfer_t *xfer);
 
+/*!
+ * @brief Transmits several buffers back to back using the interrupt method, without copying them.
+ *
+ * The TX interrupt walks the segment list in order, so a header, a payload and a trailer can be
+ * sent from where they already are in memory. Zero-length segments are skipped. The callback is
+ * called once, with @ref kStatus_UART_TxIdle, after the last byte of the last segment is written to
+ * the TX register. The segment array and every buffer it points to must stay valid and unchanged
+ * until then.
+ *
+ * @param base UART peripheral base address.
+ * @param handle UART handle pointer.
+ * @param segments Array of segments to send, in order.
+ * @param segmentCount Number of entries in segments.
+ * @retval kStatus_Success Successfully start the data transmission.
+ * @retval kStatus_UART_TxBusy Previous transmission still not finished, data not all written to the TX register.
+ * @retval kStatus_InvalidArgument All segments are empty.
+ */
+status_t UART_TransferSendSegmentsNonBlocking(UART_Type *base,
+                                              uart_handle_t *handle,
+                                              const uart_segment_t *segments,
+                                              size_t segmentCount);
+
 /*!
  * @brief Aborts the interrupt-driven data transmit.
  *
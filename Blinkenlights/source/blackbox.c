@@ -0,0 +1,284 @@
+/**
+ * \file    blackbox.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for the black-box event recorder in a flash ring log
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "MKL25Z4.h"
+#include "fsl_flash.h"
+#include "blackbox.h"
+#include "crc.h"
+#include "clocks.h"
+
+/**
+ * \def BLACKBOX_SLOTS
+ *  Records the ring holds
+ */
+#define BLACKBOX_SLOTS\
+	(BLACKBOX_SECTOR_COUNT * BLACKBOX_SECTOR_RECORDS)
+
+/**
+ * \def BLACKBOX_ERASED
+ *  An erased flash word
+ */
+#define BLACKBOX_ERASED\
+	(0xFFFFFFFFUL)
+
+/**
+ *  Flash driver state, and whether FLASH_Init() succeeded
+ */
+static flash_config_t blackbox_flash;
+static bool blackbox_ready;
+
+/**
+ *  Slot the next record goes to, and the sequence number it gets
+ */
+static uint32_t blackbox_head;
+static uint32_t blackbox_sequence;
+
+/**
+ *  Time stamp for new records
+ */
+static volatile uint32_t blackbox_ticks;
+
+/**
+ *  Records not in flash yet, oldest first. Written from interrupts, so only touched with interrupts masked
+ */
+static blackbox_record_t blackbox_buffer[BLACKBOX_BUFFER];
+static uint32_t blackbox_buffered;
+
+static uint32_t blackbox_dropped;
+static uint32_t blackbox_programs;
+static uint32_t blackbox_erases;
+
+/**
+ * \fn static const blackbox_record_t *blackbox_slot
+ * \brief Get a slot of the ring in flash
+ * \param slot 0 to BLACKBOX_SLOTS - 1
+ * \return The slot
+ */
+static const blackbox_record_t *blackbox_slot(uint32_t slot){
+	return (const blackbox_record_t *)(BLACKBOX_FLASH_START + (slot * sizeof(blackbox_record_t)));
+}
+
+/**
+ * \fn static uint32_t blackbox_next_sector
+ * \brief Get the first slot of the sector after the one a slot is in
+ * \param slot The slot
+ * \return The first slot of the next sector, wrapping around the ring
+ */
+static uint32_t blackbox_next_sector(uint32_t slot){
+	return (((slot / BLACKBOX_SECTOR_RECORDS) + 1) % BLACKBOX_SECTOR_COUNT) * BLACKBOX_SECTOR_RECORDS;
+}
+
+/**
+ * \fn static uint16_t blackbox_crc
+ * \brief CRC-16 of a record, crc field excluded
+ * \param record The record
+ * \return The CRC
+ */
+static uint16_t blackbox_crc(const blackbox_record_t *record){
+	uint16_t crc;
+
+	crc = crc16_update(crc16_init(), record, offsetof(blackbox_record_t, crc));
+	crc = crc16_update(crc, &record->value, sizeof(record->value));
+
+	return crc16_final(crc);
+}
+
+/**
+ * \fn static bool blackbox_valid
+ * \brief Check whether a slot holds a whole record
+ * \param record The slot
+ * \return true if it does
+ */
+static bool blackbox_valid(const blackbox_record_t *record){
+	return (record->sequence != BLACKBOX_ERASED) && (record->crc == blackbox_crc(record));
+}
+
+/**
+ * \fn static bool blackbox_blank
+ * \brief Check whether the slots from one up to the end of its sector are erased
+ * \param slot The first slot
+ * \return true if they are
+ */
+static bool blackbox_blank(uint32_t slot){
+	const uint32_t *word;
+	const uint32_t *end;
+
+	word = (const uint32_t *)blackbox_slot(slot);
+	end = (const uint32_t *)blackbox_slot(((slot / BLACKBOX_SECTOR_RECORDS) + 1) * BLACKBOX_SECTOR_RECORDS);
+	for(; word < end; word++){
+		if(*word != BLACKBOX_ERASED){
+			return false;
+		}
+	}
+
+	return true;
+}
+
+status_t blackbox_init(void){
+	const blackbox_record_t *record;
+	uint32_t slot;
+	bool found;
+
+	memset(&blackbox_flash, 0, sizeof(blackbox_flash));
+	blackbox_ready = (FLASH_Init(&blackbox_flash) == kStatus_FLASH_Success);
+
+	/**
+	 *  The record with the highest sequence number is the newest; appending continues right after it
+	 */
+	found = false;
+	blackbox_head = 0;
+	blackbox_sequence = 0;
+	for(slot = 0; slot < BLACKBOX_SLOTS; slot++){
+		record = blackbox_slot(slot);
+		if(blackbox_valid(record) && (!found || (record->sequence >= blackbox_sequence))){
+			found = true;
+			blackbox_head = (slot + 1) % BLACKBOX_SLOTS;
+			blackbox_sequence = record->sequence + 1;
+		}
+	}
+
+	/**
+	 *  A batch torn by a reset leaves programmed words after the newest record; continue in the next sector
+	 */
+	if(((blackbox_head % BLACKBOX_SECTOR_RECORDS) != 0) && !blackbox_blank(blackbox_head)){
+		blackbox_head = blackbox_next_sector(blackbox_head);
+	}
+
+	blackbox_record(blackbox_reset, RCM->SRS0, RCM->SRS1);
+
+	return blackbox_ready ? kStatus_Success : kStatus_Fail;
+}
+
+void blackbox_record(blackbox_type_t type, uint8_t code, uint32_t value){
+	blackbox_record_t *record;
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	if(blackbox_buffered == BLACKBOX_BUFFER){
+		blackbox_dropped++;
+	}
+	else{
+		record = &blackbox_buffer[blackbox_buffered++];
+		record->sequence = blackbox_sequence++;
+		record->tick = blackbox_ticks;
+		record->type = (uint8_t)type;
+		record->code = code;
+		record->value = value;
+		record->crc = blackbox_crc(record);
+	}
+	EnableGlobalIRQ(primask);
+}
+
+void blackbox_tick(void){
+	blackbox_ticks++;
+	if(blackbox_buffered >= BLACKBOX_BATCH){
+		blackbox_flush();
+	}
+}
+
+status_t blackbox_flush(void){
+	blackbox_record_t batch[BLACKBOX_BUFFER];
+	uint32_t count;
+	uint32_t first;
+	uint32_t room;
+	uint32_t primask;
+	status_t status;
+
+	if(!blackbox_ready){
+		return kStatus_Fail;
+	}
+
+	primask = DisableGlobalIRQ();
+	count = blackbox_buffered;
+	memcpy(batch, blackbox_buffer, count * sizeof(blackbox_record_t));
+	blackbox_buffered = 0;
+	EnableGlobalIRQ(primask);
+
+	/**
+	 *  One FLASH_Program() per sector the batch lands in; a sector is erased just before its first slot is written
+	 */
+	status = kStatus_FLASH_Success;
+	first = 0;
+	if(count == 0){
+		return kStatus_Success;
+	}
+
+	(void)clocks_burst_begin();
+	while((count != 0) && (status == kStatus_FLASH_Success)){
+		primask = DisableGlobalIRQ();
+		if((blackbox_head % BLACKBOX_SECTOR_RECORDS) == 0){
+			status = FLASH_Erase(&blackbox_flash, (uint32_t)blackbox_slot(blackbox_head), BLACKBOX_SECTOR_SIZE,
+					kFLASH_ApiEraseKey);
+			blackbox_erases++;
+		}
+
+		/**
+		 *  The head only moves past slots that were erased: a failed program may have left words behind them, but a
+		 *  sector that failed to erase is erased again by the next flush
+		 */
+		room = MIN(count, BLACKBOX_SECTOR_RECORDS - (blackbox_head % BLACKBOX_SECTOR_RECORDS));
+		if(status == kStatus_FLASH_Success){
+			status = FLASH_Program(&blackbox_flash, (uint32_t)blackbox_slot(blackbox_head),
+					(uint32_t *)&batch[first], room * sizeof(blackbox_record_t));
+			blackbox_programs++;
+			blackbox_head = (blackbox_head + room) % BLACKBOX_SLOTS;
+		}
+		EnableGlobalIRQ(primask);
+
+		first += room;
+		count -= room;
+	}
+	clocks_burst_end();
+
+	if(status != kStatus_FLASH_Success){
+		blackbox_dropped += room + count;
+		return kStatus_Fail;
+	}
+
+	return kStatus_Success;
+}
+
+const blackbox_record_t *blackbox_at(uint32_t index, bool *valid){
+	uint32_t oldest;
+	uint32_t span;
+	const blackbox_record_t *record;
+
+	/**
+	 *  The oldest slot starts the sector after the one being filled, or is the head itself at a sector boundary
+	 */
+	if((blackbox_head % BLACKBOX_SECTOR_RECORDS) == 0){
+		oldest = blackbox_head;
+		span = BLACKBOX_SLOTS;
+	}
+	else{
+		oldest = blackbox_next_sector(blackbox_head);
+		span = (blackbox_head + BLACKBOX_SLOTS - oldest) % BLACKBOX_SLOTS;
+	}
+
+	if(index >= span){
+		return NULL;
+	}
+
+	record = blackbox_slot((oldest + index) % BLACKBOX_SLOTS);
+	*valid = blackbox_valid(record);
+
+	return record;
+}
+
+void blackbox_get_stats(blackbox_stats_t *stats){
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	stats->sequence = blackbox_sequence;
+	stats->buffered = blackbox_buffered;
+	EnableGlobalIRQ(primask);
+	stats->dropped = blackbox_dropped;
+	stats->programs = blackbox_programs;
+	stats->erases = blackbox_erases;
+}
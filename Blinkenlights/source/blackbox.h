@@ -0,0 +1,180 @@
+/**
+ * \file    blackbox.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for the black-box event recorder in a flash ring log
+ *
+ *  Events are buffered in RAM and appended BLACKBOX_BATCH at a time, with one FLASH_Program() call, to a ring of
+ *  BLACKBOX_SECTOR_COUNT sectors just below the settings store. The sector ahead of the write position is erased when
+ *  the log reaches it, dropping its oldest BLACKBOX_SECTOR_RECORDS records. The log survives resets; read it with the
+ *  shell command "blackbox", or "blackbox raw" and tools/blackbox_dump.py.
+ *
+ *  Record layout (16 bytes, little endian):
+ *  	sequence	u32, counts every record ever appended, so the newest record is the one with the highest
+ *  	tick		u32, 100 msec ticks since the reset that logged it
+ *  	type		u8, blackbox_type_t
+ *  	code		u8
+ *  	crc			u16, CRC-16 of the other 14 bytes, so records torn by a reset are skipped
+ *  	value		u32
+ *
+ *  Cost, from the KL25 datasheet typicals (65 usec per longword, 14 msec per sector erase, 50000 erase cycles) and a
+ *  simulation of the append path at a steady event rate (tests/test_blackbox.c):
+ *  	event rate		FLASH_Program calls/day	erases/day, each sector	sector lifetime
+ *  	1 per minute	383						5.6						24 years
+ *  	1 per second	22950					338						5 months
+ *  One FLASH_Program() per batch, and a second one each time a batch runs into the next sector, which the reset
+ *  record logged at boot makes the usual case. A batch is 16 longwords, about 1 msec with interrupts masked, plus a
+ *  14 msec erase every BLACKBOX_SECTOR_RECORDS records. Flushing once per blink tick sustains up to BLACKBOX_BUFFER
+ *  records per 100 msec; a larger burst is counted as dropped. Blinkenlights logs touch-driven color changes,
+ *  parameter changes and resets, well under 1 per minute
+ */
+
+#ifndef BLACKBOX_H_
+#define BLACKBOX_H_
+
+#include "fsl_common.h"
+#include "settings.h"
+
+/**
+ * \def BLACKBOX_SECTOR_COUNT
+ *  Sectors in the ring. The linker scripts end PROGRAM_FLASH below them
+ */
+#define BLACKBOX_SECTOR_COUNT\
+	(4)
+
+/**
+ * \def BLACKBOX_SECTOR_SIZE
+ *  Flash erase unit
+ */
+#define BLACKBOX_SECTOR_SIZE\
+	(FSL_FEATURE_FLASH_PFLASH_BLOCK_SECTOR_SIZE)
+
+/**
+ * \def BLACKBOX_SECTOR_RECORDS
+ *  Records per sector
+ */
+#define BLACKBOX_SECTOR_RECORDS\
+	(BLACKBOX_SECTOR_SIZE / sizeof(blackbox_record_t))
+
+/**
+ * \def BLACKBOX_FLASH_START
+ *  Address of the first sector of the ring, right below the settings store
+ */
+#define BLACKBOX_FLASH_START\
+	(SETTINGS_FLASH_START - (BLACKBOX_SECTOR_COUNT * BLACKBOX_SECTOR_SIZE))
+
+/**
+ * \def BLACKBOX_BATCH
+ *  Buffered records that make blackbox_tick() flush
+ */
+#define BLACKBOX_BATCH\
+	(4)
+
+/**
+ * \def BLACKBOX_BUFFER
+ *  Records the RAM buffer holds
+ */
+#define BLACKBOX_BUFFER\
+	(16)
+
+/**
+ * \typedef blackbox_type_t
+ *  What a record is about
+ */
+typedef enum {
+	blackbox_reset = 1,	/* code RCM_SRS0, value RCM_SRS1: why the device last reset */
+	blackbox_led = 2,	/* code new color_t, value previous color_t */
+	blackbox_param = 3,	/* code params_t word index, value new value */
+	blackbox_save = 4,	/* code 0 on success or 1 on failure, value settings sequence number */
+	blackbox_fault = 5	/* code fault type, value faulting PC */
+} blackbox_type_t;
+
+/**
+ * \typedef blackbox_fault_t
+ *  Code of a blackbox_fault record
+ */
+typedef enum {
+	blackbox_fault_stack = 1,			/* value: lowest stack guard word found written (source/stack.h) */
+	blackbox_fault_pool_pointer = 2,	/* value: pointer given to pool_free() that is no block (source/pool.h) */
+	blackbox_fault_pool_double_free = 3,	/* value: block freed twice */
+	blackbox_fault_pool_overrun = 4,	/* value: block whose tag or canary was overwritten */
+	blackbox_fault_hard = 5				/* value: PC of a HardFault before the last reset (source/fault.h) */
+} blackbox_fault_t;
+
+/**
+ * \typedef blackbox_record_t
+ *  One record, as stored in flash
+ */
+typedef struct {
+	uint32_t sequence;
+	uint32_t tick;
+	uint8_t type;
+	uint8_t code;
+	uint16_t crc;
+	uint32_t value;
+} blackbox_record_t;
+
+/**
+ * \typedef blackbox_stats_t
+ *  Where the log stands
+ */
+typedef struct {
+	uint32_t sequence;	/* Sequence number the next record gets */
+	uint32_t buffered;	/* Records waiting in RAM */
+	uint32_t dropped;	/* Records lost to a full buffer or a failed flash write since reset */
+	uint32_t programs;	/* FLASH_Program() calls since reset */
+	uint32_t erases;	/* Sectors erased since reset */
+} blackbox_stats_t;
+
+/**
+ * \fn status_t blackbox_init
+ * \brief Find the end of the log and record why the device reset. Call once at boot, before anything is recorded
+ * \param N/A
+ * \return kStatus_Success, or kStatus_Fail if the flash driver could not be set up, in which case records stay in RAM
+ */
+status_t blackbox_init(void);
+
+/**
+ * \fn void blackbox_record
+ * \brief Buffer a record. Safe to call from an interrupt
+ * \param type What the record is about
+ * \param code Type-specific code
+ * \param value Type-specific value
+ * \return N/A
+ */
+void blackbox_record(blackbox_type_t type, uint8_t code, uint32_t value);
+
+/**
+ * \fn void blackbox_tick
+ * \brief Advance the record time stamp and flush once BLACKBOX_BATCH records are buffered. Call every blink tick
+ * \param N/A
+ * \return N/A
+ */
+void blackbox_tick(void);
+
+/**
+ * \fn status_t blackbox_flush
+ * \brief Append every buffered record to flash. Not from an interrupt
+ * \param N/A
+ * \return kStatus_Success, or kStatus_Fail if programming failed; the records that could not be written are dropped
+ */
+status_t blackbox_flush(void);
+
+/**
+ * \fn const blackbox_record_t *blackbox_at
+ * \brief Get a slot of the ring by age
+ * \param index 0 for the oldest slot
+ * \param valid Where to store whether the slot holds a whole record; erased slots and records torn by a reset do not
+ * \return The slot, or NULL past the newest one
+ */
+const blackbox_record_t *blackbox_at(uint32_t index, bool *valid);
+
+/**
+ * \fn void blackbox_get_stats
+ * \brief Describe the log
+ * \param stats Where to store the description
+ * \return N/A
+ */
+void blackbox_get_stats(blackbox_stats_t *stats);
+
+#endif /* BLACKBOX_H_ */
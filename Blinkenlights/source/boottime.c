@@ -0,0 +1,195 @@
+/**
+ * \file    boottime.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for the boot phase trace and the persisted fast-boot flags
+ */
+
+#include "MKL25Z4.h"
+#include "boottime.h"
+#include "settings.h"
+#include "power.h"
+#include "clocks.h"
+#include "sections.h"
+
+/**
+ * \def BOOTTIME_TPMSRC_MCGIRCLK
+ *  SOPT2[TPMSRC]: MCGIRCLK
+ */
+#define BOOTTIME_TPMSRC_MCGIRCLK\
+	(3U)
+
+/**
+ * \def BOOTTIME_TIMER_MOD
+ *  TPM0 modulo: the full 16 bits, so the overflows extend the counter
+ */
+#define BOOTTIME_TIMER_MOD\
+	(0xFFFFU)
+
+/**
+ * \def BOOTTIME_WARM_MAGIC
+ *  Marks the warm reset counter as written by this firmware
+ */
+#define BOOTTIME_WARM_MAGIC\
+	(0x5741524DUL)
+
+/**
+ * \typedef boottime_warm_t
+ *  Resets since the last power-on, kept in .noinit. Valid only with the magic and check = ~resets
+ */
+typedef struct {
+	uint32_t magic;
+	uint32_t resets;
+	uint32_t check;
+} boottime_warm_t;
+
+static boottime_trace_t boottime_trace;
+static boottime_warm_t boottime_warm NOINIT;
+
+/**
+ *  TPM0 overflows since boottime_start(): bits 31:16 of the time
+ */
+static volatile uint32_t boottime_overflows;
+
+void boottime_start(void){
+	SIM->SCGC6 |= SIM_SCGC6_TPM0_MASK;
+	SIM->SOPT2 = (SIM->SOPT2 & ~SIM_SOPT2_TPMSRC_MASK) | SIM_SOPT2_TPMSRC(BOOTTIME_TPMSRC_MCGIRCLK);
+
+	/**
+	 *  IRCS is the slow IRC out of reset, and BOARD_BootClockRUN() keeps it
+	 */
+	MCG->C1 |= MCG_C1_IRCLKEN_MASK;
+
+	TPM0->SC = 0;
+	TPM0->CNT = 0;
+	TPM0->MOD = BOOTTIME_TIMER_MOD;
+	TPM0->SC = TPM_SC_CMOD(1) | TPM_SC_TOIE_MASK;
+}
+
+/**
+ * \fn static uint32_t boottime_now
+ * \brief Read the 32-bit time
+ * \param N/A
+ * \return Ticks since boottime_start()
+ */
+static uint32_t boottime_now(void){
+	uint32_t primask;
+	uint32_t high;
+	uint32_t low;
+
+	primask = DisableGlobalIRQ();
+	high = boottime_overflows;
+	low = TPM0->CNT;
+
+	/**
+	 *  An overflow not serviced yet belongs to this reading if the counter has already wrapped
+	 */
+	if(TPM0->SC & TPM_SC_TOF_MASK){
+		high++;
+		low = TPM0->CNT;
+	}
+	EnableGlobalIRQ(primask);
+
+	return (high << 16) | low;
+}
+
+/**
+ * \fn static status_t boottime_clock_notifier
+ * \brief End the trace before a profile switch changes MCGIRCLK, the timer's clock
+ * \param event Before or after the switch
+ * \param from The profile being left
+ * \param to The profile being entered
+ * \return kStatus_Success: the switch is never refused
+ *
+ *  VLPR selects the fast 4 MHz IRC for MCGIRCLK, so ticks counted across a switch would not be slow IRC periods.
+ *  The marks taken so far stay, and those after are dropped as after boottime_end()
+ */
+static status_t boottime_clock_notifier(clocks_event_t event, clocks_profile_t from, clocks_profile_t to){
+	if((event == clocks_before) && (from != to)){
+		boottime_end();
+	}
+
+	return kStatus_Success;
+}
+
+void boottime_init(void){
+
+	/**
+	 *  A power-on or low-voltage reset leaves SRAM undefined even when the check happens to pass
+	 */
+	if((RCM->SRS0 & (RCM_SRS0_POR_MASK | RCM_SRS0_LVD_MASK)) || (boottime_warm.magic != BOOTTIME_WARM_MAGIC) ||
+			(boottime_warm.check != ~boottime_warm.resets)){
+		boottime_warm.magic = BOOTTIME_WARM_MAGIC;
+		boottime_warm.resets = 0;
+	}
+	else{
+		boottime_warm.resets++;
+	}
+	boottime_warm.check = ~boottime_warm.resets;
+	boottime_trace.warm_resets = boottime_warm.resets;
+
+	power_constrain(power_wait);
+	NVIC_EnableIRQ(TPM0_IRQn);
+	(void)clocks_register(boottime_clock_notifier);
+	boottime_mark(boottime_crt0);
+}
+
+void boottime_mark(boottime_phase_t phase){
+	uint32_t now;
+
+	if(boottime_trace.done || (boottime_trace.count >= boottime_phase_count)){
+		return;
+	}
+
+	now = boottime_now();
+	boottime_trace.marks[boottime_trace.count].phase = phase;
+	boottime_trace.marks[boottime_trace.count].ticks = now;
+	boottime_trace.count++;
+	if(phase == boottime_leds){
+		boottime_trace.first_led = now;
+	}
+}
+
+void boottime_end(void){
+	if(boottime_trace.done){
+		return;
+	}
+
+	TPM0->SC = 0;
+	NVIC_DisableIRQ(TPM0_IRQn);
+	SIM->SCGC6 &= ~SIM_SCGC6_TPM0_MASK;
+	boottime_trace.done = true;
+	power_release(power_wait);
+}
+
+uint32_t boottime_load_flags(void){
+	uint32_t flags;
+
+	if(settings_read(settings_key_boot, &flags, sizeof(flags), NULL) != kStatus_Success){
+		flags = 0;
+	}
+	boottime_trace.flags = flags & BOOTTIME_FLAGS_FAST;
+
+	return boottime_trace.flags;
+}
+
+status_t boottime_save_flags(uint32_t flags){
+	flags &= BOOTTIME_FLAGS_FAST;
+
+	return settings_write(settings_key_boot, &flags, sizeof(flags));
+}
+
+void boottime_get_trace(boottime_trace_t *trace){
+	*trace = boottime_trace;
+}
+
+/**
+ * \fn void TPM0_DriverIRQHandler
+ * \brief Count a timer overflow
+ * \param N/A
+ * \return N/A
+ */
+void TPM0_DriverIRQHandler(void){
+	TPM0->SC |= TPM_SC_TOF_MASK;
+	boottime_overflows++;
+}
@@ -0,0 +1,170 @@
+/**
+ * \file    boottime.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for the boot phase trace and the persisted fast-boot flags
+ *
+ *  ResetISR starts TPM0 from the slow IRC (MCGIRCLK, 32.768 kHz, factory trimmed) right after SystemInit(). That clock
+ *  runs the same through every MCG mode the boot passes through, so phases that change the core clock are timed as
+ *  well as the others. main() marks the end of every phase; the shell command "boot" prints the trace. The time from
+ *  reset to SystemInit() (a few instructions) is not counted, and the resolution is one slow IRC period, 30.5 usec.
+ *  A clock profile switch (clocks.h) would move MCGIRCLK to the fast IRC, so the trace registers a clocks notifier
+ *  that ends it, as boottime_end() does, before the first switch; the boot itself makes none.
+ *
+ *  Boot order without flags (the full boot):
+ *  	crt0 settings pins clocks peripherals pll console power leds(first LED edge) selftest storage touch
+ *  With all flags (the fast boot):
+ *  	crt0 settings pins clocks peripherals power leds(first LED edge) storage touch pll console
+ *  where clocks only starts the crystal and the PLL, which lock while the rest of the boot runs, and pll hands the
+ *  MCG over to PEE once they have (clocks_boot_finish()). The flags are read from the settings store before anything
+ *  else is set up, and take effect at the next reset
+ */
+
+#ifndef BOOTTIME_H_
+#define BOOTTIME_H_
+
+#include "fsl_common.h"
+
+/**
+ * \def BOOTTIME_TIMER_HZ
+ *  TPM0 counter clock: the slow IRC
+ */
+#define BOOTTIME_TIMER_HZ\
+	(32768U)
+
+/**
+ * \def BOOTTIME_TICKS_TO_USEC(x)
+ * \param x Timer ticks
+ *  Convert ticks to usec without a division: 1000000 / 32768 = 15625 / 512
+ */
+#define BOOTTIME_TICKS_TO_USEC(x)\
+	((uint32_t)(((uint64_t)(x) * 15625U) >> 9))
+
+/**
+ * \def BOOTTIME_FLAG_FAST_CLOCKS
+ *  Boot in FEI and lock the PLL in the background instead of waiting for it in BOARD_InitBootClocks()
+ */
+#define BOOTTIME_FLAG_FAST_CLOCKS\
+	(1UL << 0)
+
+/**
+ * \def BOOTTIME_FLAG_SKIP_SELFTEST
+ *  Leave out the 2.2 sec LED self test
+ */
+#define BOOTTIME_FLAG_SKIP_SELFTEST\
+	(1UL << 1)
+
+/**
+ * \def BOOTTIME_FLAG_DEFER_CONSOLE
+ *  Bring the console up last instead of before the LEDs
+ */
+#define BOOTTIME_FLAG_DEFER_CONSOLE\
+	(1UL << 2)
+
+/**
+ * \def BOOTTIME_FLAGS_FAST
+ *  Every flag: the fast boot
+ */
+#define BOOTTIME_FLAGS_FAST\
+	(BOOTTIME_FLAG_FAST_CLOCKS | BOOTTIME_FLAG_SKIP_SELFTEST | BOOTTIME_FLAG_DEFER_CONSOLE)
+
+/**
+ * \typedef boottime_phase_t
+ *  Boot phases, each named after the work done since the previous mark
+ */
+typedef enum {
+	boottime_crt0 = 0,		/* ResetISR: data copy and bss fill */
+	boottime_settings,		/* settings_init() and the boot flags */
+	boottime_pins,			/* BOARD_InitBootPins() */
+	boottime_clocks,		/* BOARD_InitBootClocks(), or clocks_boot_start() */
+	boottime_peripherals,	/* BOARD_InitBootPeripherals() */
+	boottime_console,		/* Debug console and console_init() */
+	boottime_power,			/* power_init() */
+	boottime_leds,			/* init_onboard_leds(); the first LED edge is the end of this phase */
+	boottime_selftest,		/* test_onboard_leds() */
+	boottime_storage,		/* params_load(), blackbox_init(), flash_async_init() */
+	boottime_touch,			/* init_onboard_touch_sensor() */
+	boottime_pll,			/* clocks_boot_finish(): what is left of the PLL lock, and the switch to PEE */
+	boottime_phase_count
+} boottime_phase_t;
+
+/**
+ * \typedef boottime_mark_t
+ *  End of one phase
+ */
+typedef struct {
+	boottime_phase_t phase;
+	uint32_t ticks;			/* Timer ticks since boottime_start() */
+} boottime_mark_t;
+
+/**
+ * \typedef boottime_trace_t
+ *  The marks of the last boot, in the order they were taken
+ */
+typedef struct {
+	boottime_mark_t marks[boottime_phase_count];
+	uint32_t count;			/* Marks taken */
+	uint32_t first_led;		/* Ticks at the first LED edge, 0 if not reached */
+	uint32_t flags;			/* BOOTTIME_FLAG_ bits the boot ran with */
+	uint32_t warm_resets;	/* Resets since the last power-on, counted in .noinit */
+	bool done;				/* boottime_end() was called */
+} boottime_trace_t;
+
+/**
+ * \fn void boottime_start
+ * \brief Start the timer. Called by ResetISR before the data and bss sections are set up, so it touches registers only
+ * \param N/A
+ * \return N/A
+ */
+void boottime_start(void);
+
+/**
+ * \fn void boottime_init
+ * \brief Mark the end of crt0, count the reset in .noinit, hold WAIT until boottime_end(), since the timer's clock
+ *  stops in the stop modes, and register the clocks notifier that ends the trace. First thing in main()
+ * \param N/A
+ * \return N/A
+ */
+void boottime_init(void);
+
+/**
+ * \fn void boottime_mark
+ * \brief Mark the end of a phase
+ * \param phase The phase that just ended
+ * \return N/A
+ */
+void boottime_mark(boottime_phase_t phase);
+
+/**
+ * \fn void boottime_end
+ * \brief Stop the timer and give back the WAIT constraint. The trace stays readable, and later calls do nothing
+ * \param N/A
+ * \return N/A
+ */
+void boottime_end(void);
+
+/**
+ * \fn uint32_t boottime_load_flags
+ * \brief Read the boot flags from the settings store. Call after settings_init()
+ * \param N/A
+ * \return BOOTTIME_FLAG_ bits, 0 if none were saved
+ */
+uint32_t boottime_load_flags(void);
+
+/**
+ * \fn status_t boottime_save_flags
+ * \brief Store the boot flags for the next reset
+ * \param flags BOOTTIME_FLAG_ bits
+ * \return kStatus_Success or the settings store's error
+ */
+status_t boottime_save_flags(uint32_t flags);
+
+/**
+ * \fn void boottime_get_trace
+ * \brief Get the trace of this boot
+ * \param trace Where to store it
+ * \return N/A
+ */
+void boottime_get_trace(boottime_trace_t *trace);
+
+#endif /* BOOTTIME_H_ */
@@ -0,0 +1,267 @@
+/**
+ * \file    clocks.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for switching between the RUN and VLPR clock profiles at runtime
+ */
+
+#include "board.h"
+#include "clock_config.h"
+#include "fsl_smc.h"
+#include "clocks.h"
+
+/**
+ * \def CLOCKS_UART0_SRC_PLLFLL
+ *  SOPT2[UART0SRC]: MCGFLLCLK or MCGPLLCLK/2, as SOPT2[PLLFLLSEL] selects
+ */
+#define CLOCKS_UART0_SRC_PLLFLL\
+	(1U)
+
+/**
+ * \def CLOCKS_UART0_SRC_MCGIRCLK
+ *  SOPT2[UART0SRC]: MCGIRCLK
+ */
+#define CLOCKS_UART0_SRC_MCGIRCLK\
+	(3U)
+
+/**
+ * \def CLOCKS_OSC_RANGE
+ *  C2[RANGE0] for the 8 MHz crystal: high frequency range, as CLOCK_InitOsc0() picks it
+ */
+#define CLOCKS_OSC_RANGE\
+	(1U)
+
+/**
+ *  UART0 clock per profile: MCGPLLCLK/2 in RUN, the fast IRC divided by 1 in VLPR (board/clock_config.c)
+ */
+static const uint32_t clocks_uart0_freq[clocks_profile_count] = {48000000U, 4000000U};
+
+static clocks_notifier_t clocks_notifiers[CLOCKS_MAX_NOTIFIERS];
+static uint32_t clocks_notifier_count;
+
+/**
+ *  BOARD_InitBootClocks() leaves the device in RUN
+ */
+static clocks_profile_t clocks_profile = clocks_run;
+static clocks_profile_t clocks_base = clocks_run;
+static volatile uint32_t clocks_bursts;
+static uint32_t clocks_switches;
+static uint32_t clocks_refused;
+
+/**
+ *  clocks_boot_start() was called and clocks_boot_finish() has not been yet
+ */
+static bool clocks_boot_pending;
+
+/**
+ * \fn static void clocks_enter_vlpr
+ * \brief PEE to BLPI through the MCG mode graph, then VLPR. Same end state as BOARD_BootClockVLPR()
+ * \param N/A
+ * \return N/A
+ */
+static void clocks_enter_vlpr(void){
+	CLOCK_SetSimSafeDivs();
+	(void)CLOCK_SetMcgConfig(&mcgConfig_BOARD_BootClockVLPR);
+	CLOCK_SetSimConfig(&simConfig_BOARD_BootClockVLPR);
+	CLOCK_SetLpsci0Clock(CLOCKS_UART0_SRC_MCGIRCLK);
+
+	SMC_SetPowerModeVlpr(SMC);
+	while(SMC_GetPowerModeState(SMC) != kSMC_PowerStateVlpr){
+	}
+	SystemCoreClock = BOARD_BOOTCLOCKVLPR_CORE_CLOCK;
+}
+
+/**
+ * \fn static void clocks_enter_run
+ * \brief Back to RUN, then BLPI to PEE. The crystal oscillator was left running, so only the PLL has to lock
+ * \param N/A
+ * \return N/A
+ */
+static void clocks_enter_run(void){
+	SMC_SetPowerModeRun(SMC);
+	while(SMC_GetPowerModeState(SMC) != kSMC_PowerStateRun){
+	}
+
+	CLOCK_SetSimSafeDivs();
+	(void)CLOCK_SetMcgConfig(&mcgConfig_BOARD_BootClockRUN);
+	CLOCK_SetSimConfig(&simConfig_BOARD_BootClockRUN);
+	CLOCK_SetLpsci0Clock(CLOCKS_UART0_SRC_PLLFLL);
+	SystemCoreClock = BOARD_BOOTCLOCKRUN_CORE_CLOCK;
+}
+
+/**
+ * \fn static status_t clocks_switch
+ * \brief Switch profile with the notifiers around it
+ * \param to The profile
+ * \return kStatus_Success or the error a notifier refused the switch with
+ */
+static status_t clocks_switch(clocks_profile_t to){
+	clocks_profile_t from;
+	uint32_t primask;
+	uint32_t i;
+	status_t status;
+
+	from = clocks_profile;
+	if(to == from){
+		return kStatus_Success;
+	}
+
+	for(i = 0; i < clocks_notifier_count; i++){
+		status = clocks_notifiers[i](clocks_before, from, to);
+		if(status != kStatus_Success){
+			while(i-- > 0){
+				(void)clocks_notifiers[i](clocks_after, from, from);
+			}
+			clocks_refused++;
+			return status;
+		}
+	}
+
+	/**
+	 *  No handler may run while the dividers are half way
+	 */
+	primask = DisableGlobalIRQ();
+	if(to == clocks_vlpr){
+		clocks_enter_vlpr();
+	}
+	else{
+		clocks_enter_run();
+	}
+	clocks_profile = to;
+	EnableGlobalIRQ(primask);
+	clocks_switches++;
+
+	for(i = clocks_notifier_count; i-- > 0;){
+		(void)clocks_notifiers[i](clocks_after, from, to);
+	}
+
+	return kStatus_Success;
+}
+
+void clocks_boot_start(void){
+	const mcg_pll_config_t *pll;
+
+	CLOCK_SetXtal0Freq(oscConfig_BOARD_BootClockRUN.freq);
+	OSC_SetCapLoad(OSC0, oscConfig_BOARD_BootClockRUN.capLoad);
+	OSC_SetExtRefClkConfig(OSC0, &oscConfig_BOARD_BootClockRUN.oscerConfig);
+	MCG->C2 = (MCG->C2 & ~(MCG_C2_RANGE0_MASK | MCG_C2_HGO0_MASK | MCG_C2_EREFS0_MASK)) |
+			MCG_C2_RANGE0(CLOCKS_OSC_RANGE) | (uint8_t)oscConfig_BOARD_BootClockRUN.workMode;
+
+	/**
+	 *  The PLL locks to the crystal as soon as it is stable; both happen in hardware from here on
+	 */
+	pll = &mcgConfig_BOARD_BootClockRUN.pll0Config;
+	MCG->C5 = MCG_C5_PRDIV0(pll->prdiv) | MCG_C5_PLLCLKEN0_MASK;
+	MCG->C6 = (MCG->C6 & ~(MCG_C6_VDIV0_MASK | MCG_C6_PLLS_MASK)) | MCG_C6_VDIV0(pll->vdiv);
+
+	clocks_boot_pending = true;
+}
+
+void clocks_boot_finish(void){
+	if(!clocks_boot_pending){
+		return;
+	}
+
+	while((MCG->S & (MCG_S_OSCINIT0_MASK | MCG_S_LOCK0_MASK)) != (MCG_S_OSCINIT0_MASK | MCG_S_LOCK0_MASK)){
+	}
+
+	/**
+	 *  CLOCK_BootToPeeMode() would turn the PLL off and lock it again, so walk FEI, FBE, PBE, PEE by hand
+	 */
+	CLOCK_SetSimSafeDivs();
+	MCG->C1 = (MCG->C1 & ~(MCG_C1_CLKS_MASK | MCG_C1_FRDIV_MASK | MCG_C1_IREFS_MASK)) | MCG_C1_CLKS(2) |
+			MCG_C1_FRDIV(mcgConfig_BOARD_BootClockRUN.frdiv);
+	while((MCG->S & (MCG_S_IREFST_MASK | MCG_S_CLKST_MASK)) != MCG_S_CLKST(2)){
+	}
+	MCG->C6 |= MCG_C6_PLLS_MASK;
+	while(!(MCG->S & MCG_S_PLLST_MASK)){
+	}
+	MCG->C1 &= ~MCG_C1_CLKS_MASK;
+	while((MCG->S & MCG_S_CLKST_MASK) != MCG_S_CLKST(3)){
+	}
+
+	/**
+	 *  PLLS keeps the PLL on from here. Left set, PLLCLKEN0 would keep it running in BLPI as well
+	 */
+	MCG->C5 &= ~MCG_C5_PLLCLKEN0_MASK;
+
+	CLOCK_SetInternalRefClkConfig(mcgConfig_BOARD_BootClockRUN.irclkEnableMode, mcgConfig_BOARD_BootClockRUN.ircs,
+			mcgConfig_BOARD_BootClockRUN.fcrdiv);
+	CLOCK_SetSimConfig(&simConfig_BOARD_BootClockRUN);
+	SystemCoreClock = BOARD_BOOTCLOCKRUN_CORE_CLOCK;
+	clocks_boot_pending = false;
+}
+
+status_t clocks_register(clocks_notifier_t notifier){
+	if(clocks_notifier_count >= CLOCKS_MAX_NOTIFIERS){
+		return kStatus_Clocks_Full;
+	}
+	clocks_notifiers[clocks_notifier_count++] = notifier;
+
+	return kStatus_Success;
+}
+
+status_t clocks_set_base(clocks_profile_t profile){
+	status_t status;
+
+	if(profile >= clocks_profile_count){
+		return kStatus_InvalidArgument;
+	}
+
+	clocks_base = profile;
+	if(clocks_bursts != 0){
+		return kStatus_Success;
+	}
+
+	status = clocks_switch(profile);
+	if(status != kStatus_Success){
+		clocks_base = clocks_profile;
+	}
+
+	return status;
+}
+
+clocks_profile_t clocks_get_profile(void){
+	return clocks_profile;
+}
+
+status_t clocks_burst_begin(void){
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	clocks_bursts++;
+	EnableGlobalIRQ(primask);
+
+	return clocks_switch(clocks_run);
+}
+
+void clocks_burst_end(void){
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	if(clocks_bursts != 0){
+		clocks_bursts--;
+	}
+	EnableGlobalIRQ(primask);
+}
+
+void clocks_poll(void){
+	/**
+	 *  A refusal does not go away by asking again every tick, so settle for the profile running now
+	 */
+	if((clocks_bursts == 0) && (clocks_profile != clocks_base) && (clocks_switch(clocks_base) != kStatus_Success)){
+		clocks_base = clocks_profile;
+	}
+}
+
+uint32_t clocks_get_uart0_freq(clocks_profile_t profile){
+	return clocks_uart0_freq[profile];
+}
+
+void clocks_get_stats(clocks_stats_t *stats){
+	stats->profile = clocks_profile;
+	stats->base = clocks_base;
+	stats->bursts = clocks_bursts;
+	stats->switches = clocks_switches;
+	stats->refused = clocks_refused;
+}
@@ -0,0 +1,173 @@
+/**
+ * \file    clocks.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for switching between the RUN and VLPR clock profiles at runtime
+ *
+ *  The two profiles are the ones of board/clock_config.c:
+ *  	clocks_run		PEE from the 8 MHz crystal, 48 MHz core, 24 MHz bus, UART0 from the PLL
+ *  	clocks_vlpr		BLPI from the 4 MHz IRC, 4 MHz core, 800 kHz bus, VLPR power mode, UART0 from MCGIRCLK
+ *
+ *  Code that depends on a clock frequency registers a notifier. Before a switch every notifier is called with
+ *  clocks_before, in registration order, and may refuse the switch by returning an error; after it they are called
+ *  with clocks_after, in reverse order, to recompute their dividers from the new frequencies. A refused switch calls
+ *  clocks_after with from == to on the notifiers already asked, so they can undo what clocks_before did.
+ *
+ *  The base profile is where the device sits; work that needs RUN (flash programming is not possible in VLPR, and
+ *  anything heavy is faster) takes a burst around it. clocks_burst_begin() switches to RUN right away, and
+ *  clocks_poll() goes back to the base profile from the main loop once no burst is held.
+ *
+ *  Retimed on a switch: the console baud rate (console.c), and SystemCoreClock and with it the delay.h loops and the
+ *  power.c current estimates. serial.c lets sends finish first, and refuses VLPR while UART1/UART2 are open since the
+ *  800 kHz bus clock cannot make their baud rates. The LPTMR of power.c runs from the LPO and the TSI from its own
+ *  oscillator, so neither changes, and nothing in Blinkenlights reloads SysTick. The boot trace (boottime.c) times
+ *  the boot with TPM0 from MCGIRCLK, which VLPR moves from the slow to the fast IRC; its notifier ends the trace and
+ *  stops TPM0 before the first switch. The console refuses VLPR at a baud rate the 4 MHz IRC cannot make
+ *
+ *  The fast boot (boottime.h) skips BOARD_InitBootClocks() and stays in FEI, the reset mode (20.97 MHz FLL from the
+ *  slow IRC), while clocks_boot_start() starts the crystal and the PLL: C5[PLLCLKEN0] runs the PLL from the crystal
+ *  without selecting it. The MCG has no lock interrupt (only loss of lock), so main() calls clocks_boot_finish() once
+ *  the rest of the boot is done, by when the PLL has normally locked, and it switches FEI to FBE, PBE and PEE without
+ *  waiting. Nothing that depends on a clock frequency may be set up between the two
+ */
+
+#ifndef CLOCKS_H_
+#define CLOCKS_H_
+
+#include "fsl_common.h"
+
+/**
+ * \def CLOCKS_MAX_NOTIFIERS
+ *  Notifiers clocks_register() takes
+ */
+#define CLOCKS_MAX_NOTIFIERS\
+	(4)
+
+/**
+ *  Error codes for the clock profile manager
+ */
+enum {
+	kStatus_Clocks_Full = MAKE_STATUS(kStatusGroup_ApplicationRangeStart + 3, 0)	/* No room for another notifier */
+};
+
+/**
+ * \typedef clocks_profile_t
+ *  Clock and power mode combinations
+ */
+typedef enum {
+	clocks_run = 0,
+	clocks_vlpr = 1,
+	clocks_profile_count
+} clocks_profile_t;
+
+/**
+ * \typedef clocks_event_t
+ *  Why a notifier is called
+ */
+typedef enum {
+	clocks_before = 0,	/* The clocks are about to change: stop using them */
+	clocks_after = 1	/* The clocks have changed, or stayed if from == to: recompute and carry on */
+} clocks_event_t;
+
+/**
+ * \typedef clocks_notifier_t
+ *  Called around a profile switch from the main loop. Return kStatus_Success, or an error from clocks_before to refuse
+ */
+typedef status_t (*clocks_notifier_t)(clocks_event_t event, clocks_profile_t from, clocks_profile_t to);
+
+/**
+ * \typedef clocks_stats_t
+ *  Where the manager stands
+ */
+typedef struct {
+	clocks_profile_t profile;	/* Running now */
+	clocks_profile_t base;		/* Running when no burst is held */
+	uint32_t bursts;			/* Bursts held now */
+	uint32_t switches;			/* Profile switches since reset */
+	uint32_t refused;			/* Switches a notifier refused */
+} clocks_stats_t;
+
+/**
+ * \fn void clocks_boot_start
+ * \brief Start the crystal oscillator and the PLL of the RUN profile without waiting for them. Fast boot only,
+ *  instead of BOARD_InitBootClocks()
+ * \param N/A
+ * \return N/A
+ */
+void clocks_boot_start(void);
+
+/**
+ * \fn void clocks_boot_finish
+ * \brief Wait for whatever is left of the PLL lock and switch from FEI to the RUN profile. Does nothing unless
+ *  clocks_boot_start() was called
+ * \param N/A
+ * \return N/A
+ */
+void clocks_boot_finish(void);
+
+/**
+ * \fn status_t clocks_register
+ * \brief Add a notifier
+ * \param notifier The notifier
+ * \return kStatus_Success or kStatus_Clocks_Full
+ */
+status_t clocks_register(clocks_notifier_t notifier);
+
+/**
+ * \fn status_t clocks_set_base
+ * \brief Choose the profile to run in when no burst is held, and switch to it unless a burst is held
+ * \param profile The profile
+ * \return kStatus_Success, kStatus_InvalidArgument, or the error a notifier refused the switch with
+ */
+status_t clocks_set_base(clocks_profile_t profile);
+
+/**
+ * \fn clocks_profile_t clocks_get_profile
+ * \brief Get the profile running now
+ * \param N/A
+ * \return The profile
+ */
+clocks_profile_t clocks_get_profile(void);
+
+/**
+ * \fn status_t clocks_burst_begin
+ * \brief Hold RUN, switching to it now if needed. Main loop only
+ * \param N/A
+ * \return kStatus_Success, or the error a notifier refused the switch with; the burst is held either way
+ */
+status_t clocks_burst_begin(void);
+
+/**
+ * \fn void clocks_burst_end
+ * \brief Give back a burst. Safe from interrupts; the switch back to the base profile waits for clocks_poll()
+ * \param N/A
+ * \return N/A
+ */
+void clocks_burst_end(void);
+
+/**
+ * \fn void clocks_poll
+ * \brief Go back to the base profile once no burst is held. Call from the main loop. If a notifier refuses, the
+ *  profile running now becomes the base
+ * \param N/A
+ * \return N/A
+ */
+void clocks_poll(void);
+
+/**
+ * \fn uint32_t clocks_get_uart0_freq
+ * \brief Get the UART0 (LPSCI) clock of a profile
+ * \param profile The profile, usually clocks_get_profile() or the one a notifier is told about
+ * \return The frequency in Hz
+ */
+uint32_t clocks_get_uart0_freq(clocks_profile_t profile);
+
+/**
+ * \fn void clocks_get_stats
+ * \brief Get where the manager stands
+ * \param stats Where to store it
+ * \return N/A
+ */
+void clocks_get_stats(clocks_stats_t *stats);
+
+#endif /* CLOCKS_H_ */
@@ -0,0 +1,265 @@
+/**
+ * \file    console.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for the debug console link (UART0)
+ */
+
+#include <string.h>
+#include "board.h"
+#include "fsl_lpsci.h"
+#include "fsl_debug_console.h"
+#include "console.h"
+#include "serial.h"
+#include "delay.h"
+#include "clocks.h"
+
+/**
+ * \def CONSOLE_LPSCI
+ *  The LPSCI instance the debug console runs on
+ */
+#define CONSOLE_LPSCI\
+	((UART0_Type *)BOARD_DEBUG_UART_BASEADDR)
+
+/**
+ *  Baud rate the console was last asked to run at
+ */
+static uint32_t console_baud = BOARD_DEBUG_UART_BAUDRATE;
+
+/**
+ *  Ring buffer for interrupt-driven reception
+ */
+static uint8_t console_rx_ring[CONSOLE_RX_RING_SIZE];
+
+/**
+ *  Line editor state
+ */
+static console_line_callback_t console_line_callback;
+static char console_line[CONSOLE_LINE_MAX + 1];
+static uint32_t console_line_length;
+static char console_line_ending;
+
+static status_t console_clock_notifier(clocks_event_t event, clocks_profile_t from, clocks_profile_t to);
+
+/**
+ * \fn static void console_echo
+ * \brief Echo a string back to the terminal if CONSOLE_ECHO_ENABLE is set
+ * \param s The string to echo
+ * \return N/A
+ */
+static void console_echo(const char *s){
+#if CONSOLE_ECHO_ENABLE
+	serial_write_blocking(serial_port0, (const uint8_t *)s, strlen(s));
+#endif
+}
+
+/**
+ * \fn static void console_edit
+ * \brief Run one received byte through the line editor
+ * \param c The received byte
+ * \return N/A
+ *
+ *  	- CR, LF or CR LF ends a line (an LF right after a CR is ignored)
+ *  	- Backspace (0x08) or DEL (0x7F) removes the last character
+ *  	- Other control characters are ignored
+ */
+static void console_edit(char c){
+	char echo[2];
+
+	if((c == '\r') || (c == '\n')){
+		if((c == '\n') && (console_line_ending == '\r')){
+			console_line_ending = 0;
+			return;
+		}
+		console_line_ending = c;
+		console_echo("\r\n");
+
+		console_line[console_line_length] = '\0';
+		if(console_line_callback != NULL){
+			console_line_callback(console_line, console_line_length);
+		}
+		console_line_length = 0;
+		return;
+	}
+	console_line_ending = 0;
+
+	if((c == '\b') || (c == 0x7F)){
+		if(console_line_length > 0){
+			console_line_length--;
+			console_echo("\b \b");
+		}
+		return;
+	}
+
+	if(((uint8_t)c < ' ') || (console_line_length >= CONSOLE_LINE_MAX)){
+		return;
+	}
+
+	console_line[console_line_length++] = c;
+	echo[0] = c;
+	echo[1] = '\0';
+	console_echo(echo);
+}
+
+void console_init(console_line_callback_t callback){
+	serial_config_t config;
+
+	console_line_callback = callback;
+	console_line_length = 0;
+	console_line_ending = 0;
+
+	/**
+	 *  Keep the baud rate the debug console was set up with
+	 */
+	config.baud_rate = 0;
+	config.rx_mode = serial_rx_ring;
+	config.rx_buffer = console_rx_ring;
+	config.rx_buffer_size = sizeof(console_rx_ring);
+	config.dma_channel = 0;
+	config.frame_callback = NULL;
+	(void)serial_open(serial_port0, &config);
+	(void)clocks_register(console_clock_notifier);
+}
+
+void console_poll(void){
+	uint8_t chunk[16];
+	size_t received;
+	size_t i;
+
+	while((received = serial_read(serial_port0, chunk, sizeof(chunk))) != 0){
+		for(i = 0; i < received; i++){
+			console_edit((char)chunk[i]);
+		}
+	}
+}
+
+uint32_t console_get_rx_overruns(void){
+	serial_stats_t stats;
+
+	serial_get_stats(serial_port0, &stats);
+
+	return stats.rx_overruns;
+}
+
+/**
+ * \fn static void console_drain_tx
+ * \brief Wait until the last queued byte has completely left the transmit shifter
+ * \param N/A
+ * \return N/A
+ */
+static void console_drain_tx(void){
+	while(!(LPSCI_GetStatusFlags(CONSOLE_LPSCI) & kLPSCI_TransmissionCompleteFlag)){
+	}
+}
+
+/**
+ * \fn static status_t console_clock_notifier
+ * \brief Let the last byte out before the UART0 clock changes, and set the baud rate again from the new clock
+ * \param event clocks_before or clocks_after
+ * \param from The profile running before
+ * \param to The profile running after
+ * \return kStatus_LPSCI_BaudrateNotSupport to refuse a profile that cannot make the console baud rate
+ */
+static status_t console_clock_notifier(clocks_event_t event, clocks_profile_t from, clocks_profile_t to){
+	lpsci_baud_config_t baud_config;
+
+	if(event == clocks_before){
+		if(LPSCI_CalculateBaudRate(console_baud, clocks_get_uart0_freq(to), &baud_config) != kStatus_Success){
+			return kStatus_LPSCI_BaudrateNotSupport;
+		}
+		console_drain_tx();
+	}
+	else{
+		(void)LPSCI_SetBaudRate(CONSOLE_LPSCI, console_baud, clocks_get_uart0_freq(to));
+	}
+
+	return kStatus_Success;
+}
+
+/**
+ * \fn static bool console_wait_sync
+ * \brief Poll the receiver for CONSOLE_BAUD_SYNC_CHAR for roughly CONSOLE_BAUD_SYNC_TIMEOUT_TICKS * 100 msec
+ * \param N/A
+ * \return true if the sync byte arrived
+ */
+static bool console_wait_sync(void){
+	uint32_t i;
+	uint32_t timeout;
+	uint32_t flags;
+	bool found;
+	uint32_t rx_irq;
+
+	/**
+	 *  Poll the receiver directly during the handshake so the RX interrupt does not take the sync byte
+	 */
+	rx_irq = LPSCI_GetEnabledInterrupts(CONSOLE_LPSCI) & kLPSCI_RxDataRegFullInterruptEnable;
+	LPSCI_DisableInterrupts(CONSOLE_LPSCI, kLPSCI_RxDataRegFullInterruptEnable);
+	found = false;
+
+	/**
+	 *  Anything received before the switch was sampled at the wrong rate
+	 */
+	LPSCI_ClearStatusFlags(CONSOLE_LPSCI, kLPSCI_RxOverrunFlag | kLPSCI_NoiseErrorFlag | kLPSCI_FramingErrorFlag);
+
+	timeout = (uint32_t)CONSOLE_BAUD_SYNC_TIMEOUT_TICKS * ITERATIONS_FOR_100_MSEC;
+	for(i = 0; (i < timeout) && !found; i++){
+		flags = LPSCI_GetStatusFlags(CONSOLE_LPSCI);
+		if(flags & kLPSCI_RxDataRegFullFlag){
+			found = (LPSCI_ReadByte(CONSOLE_LPSCI) == CONSOLE_BAUD_SYNC_CHAR);
+		}
+		if(flags & (kLPSCI_RxOverrunFlag | kLPSCI_FramingErrorFlag)){
+			LPSCI_ClearStatusFlags(CONSOLE_LPSCI, kLPSCI_RxOverrunFlag | kLPSCI_FramingErrorFlag);
+		}
+	}
+
+	LPSCI_EnableInterrupts(CONSOLE_LPSCI, rx_irq);
+
+	return found;
+}
+
+status_t console_set_baud(uint32_t baud_rate){
+	lpsci_baud_config_t baud_config;
+	uint32_t clk_freq;
+	uint32_t baud_prev;
+
+	clk_freq = clocks_get_uart0_freq(clocks_get_profile());
+	if(LPSCI_CalculateBaudRate(baud_rate, clk_freq, &baud_config) != kStatus_Success){
+		PRINTF("BAUD %u NOT SUPPORTED\r\n", baud_rate);
+		return kStatus_LPSCI_BaudrateNotSupport;
+	}
+
+	baud_prev = console_baud;
+
+	PRINTF("BAUD %u\r\n", baud_rate);
+	console_drain_tx();
+	LPSCI_SetBaudRate(CONSOLE_LPSCI, baud_rate, clk_freq);
+
+	if(!console_wait_sync()){
+		LPSCI_SetBaudRate(CONSOLE_LPSCI, baud_prev, clk_freq);
+		PRINTF("BAUD %u TIMEOUT\r\n", baud_rate);
+		return kStatus_Timeout;
+	}
+
+	console_baud = baud_rate;
+	PRINTF("BAUD OK\r\n");
+
+	return kStatus_Success;
+}
+
+uint32_t console_get_baud(void){
+	return console_baud;
+}
+
+void console_print_baud(void){
+	lpsci_baud_config_t baud_config;
+
+	LPSCI_CalculateBaudRate(console_baud, clocks_get_uart0_freq(clocks_get_profile()), &baud_config);
+
+	PRINTF("BAUD REQUESTED %u ACHIEVED %u (OSR %u SBR %u) ERROR %u PPM THROUGHPUT %u B/S\r\n",
+			console_baud,
+			baud_config.baudRate_Bps,
+			baud_config.osr,
+			baud_config.sbr,
+			baud_config.errorPpm,
+			baud_config.baudRate_Bps / CONSOLE_BITS_PER_FRAME);
+}
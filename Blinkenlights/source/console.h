@@ -0,0 +1,147 @@
+/**
+ * \file    console.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for the debug console link (UART0)
+ */
+
+#ifndef CONSOLE_H_
+#define CONSOLE_H_
+
+#include "fsl_common.h"
+
+/**
+ * \def CONSOLE_HIGH_SPEED_ENABLE
+ *  Set to 1 to switch the console to CONSOLE_HIGH_SPEED_BAUDRATE at boot. If the host tool does not follow within
+ *  CONSOLE_BAUD_SYNC_TIMEOUT_TICKS the console stays at BOARD_DEBUG_UART_BAUDRATE
+ */
+#ifndef CONSOLE_HIGH_SPEED_ENABLE
+#define CONSOLE_HIGH_SPEED_ENABLE\
+	(0)
+#endif
+
+/**
+ * \def CONSOLE_HIGH_SPEED_BAUDRATE
+ *  High-speed console baud rate. 1000000 is exact from the 48 MHz LPSCI clock (OSR 24, SBR 2)
+ */
+#ifndef CONSOLE_HIGH_SPEED_BAUDRATE
+#define CONSOLE_HIGH_SPEED_BAUDRATE\
+	(1000000UL)
+#endif
+
+/**
+ * \def CONSOLE_BAUD_SYNC_CHAR
+ *  Byte the host sends at the new baud rate to confirm it has followed a switch. 0x55 alternates every bit, so a host
+ *  that is still at the wrong rate cannot produce it by accident
+ */
+#define CONSOLE_BAUD_SYNC_CHAR\
+	('U')
+
+/**
+ * \def CONSOLE_BAUD_SYNC_TIMEOUT_TICKS
+ *  How many 100 msec ticks to wait for CONSOLE_BAUD_SYNC_CHAR before reverting to the previous baud rate
+ */
+#define CONSOLE_BAUD_SYNC_TIMEOUT_TICKS\
+	(10)
+
+/**
+ * \def CONSOLE_BITS_PER_FRAME
+ *  Bits on the wire for each byte: 1 start bit, 8 data bits, no parity, 1 stop bit
+ */
+#define CONSOLE_BITS_PER_FRAME\
+	(10UL)
+
+/**
+ * \def CONSOLE_RX_RING_SIZE
+ *  Size of the receive ring buffer filled by the UART0 RX interrupt. One byte is reserved by the driver, and the ring
+ *  must hold everything that arrives between two console_poll() calls (100 msec in blink_sequence)
+ */
+#ifndef CONSOLE_RX_RING_SIZE
+#define CONSOLE_RX_RING_SIZE\
+	(128U)
+#endif
+
+/**
+ * \def CONSOLE_LINE_MAX
+ *  Longest line the line editor assembles, not counting the terminating '\0'. Further characters are dropped until
+ *  the line is ended
+ */
+#ifndef CONSOLE_LINE_MAX
+#define CONSOLE_LINE_MAX\
+	(64U)
+#endif
+
+/**
+ * \def CONSOLE_ECHO_ENABLE
+ *  Set to 1 to echo typed characters and backspaces back to the terminal
+ */
+#ifndef CONSOLE_ECHO_ENABLE
+#define CONSOLE_ECHO_ENABLE\
+	(1)
+#endif
+
+/**
+ * \typedef console_line_callback_t
+ *  Called from console_poll() with each completed line. The line is '\0' terminated, has its line ending removed, and
+ *  may be modified by the callback; it is only valid until the callback returns
+ */
+typedef void (*console_line_callback_t)(char *line, uint32_t length);
+
+/**
+ * \fn void console_init
+ * \brief Start interrupt-driven reception on the debug console and register the line callback
+ * \param callback Called with every completed line, or NULL to discard input
+ * \return N/A
+ *
+ *  After this, DbgConsole_Getchar() and DbgConsole_Scanf() must not be used since the RX interrupt owns the receiver
+ */
+void console_init(console_line_callback_t callback);
+
+/**
+ * \fn void console_poll
+ * \brief Feed every byte received since the last call through the line editor. Never waits on the serial port
+ * \param N/A
+ * \return N/A
+ */
+void console_poll(void);
+
+/**
+ * \fn uint32_t console_get_rx_overruns
+ * \brief Get how many received bytes were lost because the ring buffer was full
+ * \param N/A
+ * \return The amount of bytes lost
+ */
+uint32_t console_get_rx_overruns(void);
+
+/**
+ * \fn status_t console_set_baud
+ * \brief Switch the console to a new baud rate and wait for the host to follow
+ * \param baud_rate The requested baud rate in bits per second
+ * \return kStatus_Success if the host confirmed the new rate, kStatus_LPSCI_BaudrateNotSupport if the rate cannot be
+ *  produced within 3%, kStatus_Timeout if the host did not follow (the previous rate is restored)
+ *
+ *  Handshake:
+ * 		- Firmware prints "BAUD <rate>" at the current rate and waits for it to leave the shifter
+ * 		- Firmware reprograms the LPSCI divisors
+ * 		- Host switches its port and sends CONSOLE_BAUD_SYNC_CHAR
+ * 		- Firmware prints "BAUD OK" at the new rate
+ */
+status_t console_set_baud(uint32_t baud_rate);
+
+/**
+ * \fn uint32_t console_get_baud
+ * \brief Get the baud rate the console was last asked to run at
+ * \param N/A
+ * \return The requested baud rate in bits per second
+ */
+uint32_t console_get_baud(void);
+
+/**
+ * \fn void console_print_baud
+ * \brief Print the requested and achieved baud rate, the divisor error and the effective throughput
+ * \param N/A
+ * \return N/A
+ */
+void console_print_baud(void);
+
+#endif /* CONSOLE_H_ */
@@ -0,0 +1,138 @@
+/**
+ * \file    crc.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for the software CRC-16 and CRC-32 library
+ *
+ *  	- CRC-32: reflected, polynomial 0xEDB88320, initial value and final XOR 0xFFFFFFFF (IEEE 802.3, zlib)
+ *  	- CRC-16/CCITT-FALSE: not reflected, polynomial 0x1021, initial value 0xFFFF, no final XOR
+ *
+ *  Every CRC can be computed in one call, or in pieces:
+ *
+ *  	crc = crc32_init();
+ *  	crc = crc32_update(crc, first, first_length);
+ *  	crc = crc32_update(crc, second, second_length);
+ *  	crc = crc32_final(crc);
+ */
+
+#ifndef CRC_H_
+#define CRC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * \def CRC_NIBBLE
+ *  16-entry tables, two lookups per byte. Smallest (96 bytes of tables), slowest
+ */
+#define CRC_NIBBLE\
+	(0)
+
+/**
+ * \def CRC_BYTEWISE
+ *  256-entry tables, one lookup per byte (1.5 KB of tables)
+ */
+#define CRC_BYTEWISE\
+	(1)
+
+/**
+ * \def CRC_SLICE4
+ *  Four 256-entry tables, four independent lookups per 4 bytes. Fastest, largest (6 KB of tables)
+ */
+#define CRC_SLICE4\
+	(2)
+
+/**
+ * \def CRC_IMPLEMENTATION
+ *  Which table layout is compiled in, trading flash for speed. All give the same results
+ */
+#ifndef CRC_IMPLEMENTATION
+#define CRC_IMPLEMENTATION\
+	(CRC_BYTEWISE)
+#endif
+
+/**
+ * \def CRC32_CHECK
+ *  CRC-32 of the nine ASCII bytes "123456789"
+ */
+#define CRC32_CHECK\
+	(0xCBF43926UL)
+
+/**
+ * \def CRC16_CHECK
+ *  CRC-16/CCITT-FALSE of the nine ASCII bytes "123456789"
+ */
+#define CRC16_CHECK\
+	(0x29B1U)
+
+/**
+ * \fn uint32_t crc32_init
+ * \brief Start a CRC-32
+ * \param N/A
+ * \return The initial CRC value
+ */
+uint32_t crc32_init(void);
+
+/**
+ * \fn uint32_t crc32_update
+ * \brief Add bytes to a CRC-32
+ * \param crc The value from crc32_init() or the previous crc32_update()
+ * \param data The bytes, any alignment
+ * \param length Amount of bytes
+ * \return The updated CRC value
+ */
+uint32_t crc32_update(uint32_t crc, const void *data, size_t length);
+
+/**
+ * \fn uint32_t crc32_final
+ * \brief Finish a CRC-32
+ * \param crc The value from the last crc32_update()
+ * \return The CRC-32
+ */
+uint32_t crc32_final(uint32_t crc);
+
+/**
+ * \fn uint32_t crc32_buffer
+ * \brief CRC-32 of one buffer
+ * \param data The bytes, any alignment
+ * \param length Amount of bytes
+ * \return The CRC-32
+ */
+uint32_t crc32_buffer(const void *data, size_t length);
+
+/**
+ * \fn uint16_t crc16_init
+ * \brief Start a CRC-16/CCITT-FALSE
+ * \param N/A
+ * \return The initial CRC value
+ */
+uint16_t crc16_init(void);
+
+/**
+ * \fn uint16_t crc16_update
+ * \brief Add bytes to a CRC-16/CCITT-FALSE
+ * \param crc The value from crc16_init() or the previous crc16_update()
+ * \param data The bytes
+ * \param length Amount of bytes
+ * \return The updated CRC value
+ */
+uint16_t crc16_update(uint16_t crc, const void *data, size_t length);
+
+/**
+ * \fn uint16_t crc16_final
+ * \brief Finish a CRC-16/CCITT-FALSE
+ * \param crc The value from the last crc16_update()
+ * \return The CRC-16
+ */
+uint16_t crc16_final(uint16_t crc);
+
+/**
+ * \fn uint16_t crc16_buffer
+ * \brief CRC-16/CCITT-FALSE of one buffer
+ * \param data The bytes
+ * \param length Amount of bytes
+ * \return The CRC-16
+ */
+uint16_t crc16_buffer(const void *data, size_t length);
+
+#endif /* CRC_H_ */
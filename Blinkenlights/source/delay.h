@@ -8,12 +8,14 @@
 #ifndef DELAY_H_
 #define DELAY_H_
 
+#include "MKL25Z4.h"
+
 /**
  * \def CLK_FREQ_IN_HZ
- *  The operating frequency in Hz
+ *  The operating frequency in Hz, read at run time since clocks.c can switch the core clock
  */
 #define CLK_FREQ_IN_HZ\
-	(48000000/5)
+	(SystemCoreClock/5)
 
 /**
  * \def CLK_CYCLES_PER_ITERATION
@@ -42,11 +44,12 @@
 
 /**
  * \def DELAY_100_MSEC()
- *  Invokes the wait loop to wait for approximately 100 ms
+ *  Invokes the wait loop to wait for approximately 100 ms. The count is taken once so the division stays out of the loop
  */
 #define DELAY_100_MSEC()\
 	do{\
-		for(int i_delay = 0; i_delay < ITERATIONS_FOR_100_MSEC; i_delay++){\
+		uint32_t n_delay = ITERATIONS_FOR_100_MSEC;\
+		for(uint32_t i_delay = 0; i_delay < n_delay; i_delay++){\
 			__asm volatile ("nop");\
 		}\
 	}while(0)
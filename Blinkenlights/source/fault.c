@@ -0,0 +1,133 @@
+/**
+ * \file    fault.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for the HardFault post-mortem record
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "MKL25Z4.h"
+#include "fsl_debug_console.h"
+#include "fault.h"
+#include "blackbox.h"
+#include "crc.h"
+#include "sections.h"
+
+/**
+ * \def FAULT_XPSR_ALIGNED
+ *  Stacked xPSR bit 9: the core added a word to align the frame to 8 bytes
+ */
+#define FAULT_XPSR_ALIGNED\
+	(1UL << 9)
+
+/**
+ * \def FAULT_FRAME_WORDS
+ *  Words in the exception frame: R0-R3, R12, LR, PC, xPSR
+ */
+#define FAULT_FRAME_WORDS\
+	(8U)
+
+/**
+ *  SRAM bounds from the linker script
+ */
+extern uint32_t __base_SRAM[];
+extern uint32_t _vStackTop[];
+
+static fault_record_t fault_record NOINIT;
+
+/**
+ * \fn static uint32_t fault_crc
+ * \brief CRC-32 of the record, crc field excluded
+ * \param N/A
+ * \return The CRC-32
+ */
+static uint32_t fault_crc(void){
+	return crc32_buffer(&fault_record, offsetof(fault_record_t, crc));
+}
+
+/**
+ * \fn static bool fault_valid
+ * \brief Check the record is whole and was written by fault_capture()
+ * \param N/A
+ * \return true if it is
+ */
+static bool fault_valid(void){
+	return (fault_record.magic == FAULT_MAGIC) && (fault_record.crc == fault_crc());
+}
+
+void fault_capture(uint32_t *frame, uint32_t exc_return){
+	uint32_t *sp;
+	uint32_t i;
+
+	__disable_irq();
+	trace_stop();
+	fault_record.trace_packets = trace_read(fault_record.trace, TRACE_SAVE_PACKETS);
+	fault_record.count = fault_valid() ? (fault_record.count + 1) : 1;
+	fault_record.magic = FAULT_MAGIC;
+	fault_record.reported = 0;
+	fault_record.exc_return = exc_return;
+	fault_record.icsr = SCB->ICSR;
+	fault_record.shcsr = SCB->SHCSR;
+	fault_record.stack_words = 0;
+
+	/**
+	 *  A frame outside SRAM means the stack pointer itself was bad; reading it would only fault again
+	 */
+	if((frame >= __base_SRAM) && (&frame[FAULT_FRAME_WORDS] <= _vStackTop)){
+		fault_record.r0 = frame[0];
+		fault_record.r1 = frame[1];
+		fault_record.r2 = frame[2];
+		fault_record.r3 = frame[3];
+		fault_record.r12 = frame[4];
+		fault_record.lr = frame[5];
+		fault_record.pc = frame[6];
+		fault_record.xpsr = frame[7];
+		sp = &frame[FAULT_FRAME_WORDS + ((fault_record.xpsr & FAULT_XPSR_ALIGNED) ? 1 : 0)];
+		for(i = 0; (i < FAULT_STACK_WORDS) && (&sp[i] < _vStackTop); i++){
+			fault_record.stack[i] = sp[i];
+		}
+		fault_record.stack_words = i;
+	}
+	else{
+		memset(&fault_record.r0, 0, offsetof(fault_record_t, sp) - offsetof(fault_record_t, r0));
+		sp = frame;
+	}
+	fault_record.sp = (uint32_t)sp;
+	fault_record.crc = fault_crc();
+
+	/**
+	 *  This CMSIS NVIC_SystemReset() is not declared noreturn, and the reset takes a few cycles to land
+	 */
+	NVIC_SystemReset();
+	for(;;){
+	}
+}
+
+void fault_report(void){
+
+	/**
+	 *  A power-on or low-voltage reset leaves SRAM undefined even when the check happens to pass
+	 */
+	if((RCM->SRS0 & (RCM_SRS0_POR_MASK | RCM_SRS0_LVD_MASK)) || !fault_valid()){
+		fault_record.magic = 0;
+		return;
+	}
+	if(fault_record.reported){
+		return;
+	}
+
+	blackbox_record(blackbox_fault, blackbox_fault_hard, fault_record.pc);
+	PRINTF("HARDFAULT %u PC 0x%08x LR 0x%08x XPSR 0x%08x SP 0x%08x BRANCHES %u\r\n", fault_record.count,
+			fault_record.pc, fault_record.lr, fault_record.xpsr, fault_record.sp, fault_record.trace_packets);
+	fault_record.reported = 1;
+	fault_record.crc = fault_crc();
+}
+
+const fault_record_t *fault_get(void){
+	return fault_valid() ? &fault_record : NULL;
+}
+
+void fault_clear(void){
+	fault_record.magic = 0;
+}
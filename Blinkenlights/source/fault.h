@@ -0,0 +1,99 @@
+/**
+ * \file    fault.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for the HardFault post-mortem record
+ *
+ *  A HardFault that is not a semihosting call (source/semihost_hardfault.c) ends in fault_capture(). It freezes the
+ *  MTB trace (source/trace.h), then saves the registers the core stacked, the stack pointer before stacking,
+ *  EXC_RETURN, ICSR and SHCSR, the FAULT_STACK_WORDS words above the frame and the last TRACE_SAVE_PACKETS branches into
+ *  a record in .noinit, seals it with a CRC-32 and resets the device. The Cortex-M0+ has no CFSR, HFSR or fault address
+ *  registers, so the stacked PC and xPSR are the rest of the story: IPSR in xPSR tells thread code (0) from an
+ *  interrupt, and the stack words usually hold the return addresses of the callers.
+ *
+ *  fault_report() runs once the console and the black box are up. A record left by the reset before is printed,
+ *  logged in the black box as a blackbox_fault_hard record with the faulting PC, and marked reported so the next warm
+ *  reset does not print it again. It stays in .noinit for the shell command "fault" until "fault clear" or a power-on
+ */
+
+#ifndef FAULT_H_
+#define FAULT_H_
+
+#include "fsl_common.h"
+#include "trace.h"
+
+/**
+ * \def FAULT_MAGIC
+ *  Marks a fault record as written by fault_capture()
+ */
+#define FAULT_MAGIC\
+	(0x48415244UL)
+
+/**
+ * \def FAULT_STACK_WORDS
+ *  Words of the faulting stack saved above the exception frame
+ */
+#define FAULT_STACK_WORDS\
+	(16U)
+
+/**
+ * \typedef fault_record_t
+ *  One HardFault, as kept in .noinit. The CRC covers every word before it
+ */
+typedef struct {
+	uint32_t magic;
+	uint32_t count;			/* HardFaults since the last power-on, this one included */
+	uint32_t reported;		/* Nonzero once fault_report() has printed it */
+	uint32_t r0;			/* Exception frame the core stacked */
+	uint32_t r1;
+	uint32_t r2;
+	uint32_t r3;
+	uint32_t r12;
+	uint32_t lr;
+	uint32_t pc;
+	uint32_t xpsr;
+	uint32_t sp;			/* Stack pointer of the faulting code, before the frame was stacked */
+	uint32_t exc_return;	/* LR on entry to the handler: which stack and mode faulted */
+	uint32_t icsr;			/* SCB->ICSR: pending exceptions at the time */
+	uint32_t shcsr;			/* SCB->SHCSR: SVCall pending */
+	uint32_t stack_words;	/* Words of stack below _vStackTop that were saved, 0 if the frame was not in SRAM */
+	uint32_t stack[FAULT_STACK_WORDS];
+	uint32_t trace_packets;	/* Branches saved from the MTB, the last one into HardFault_Handler */
+	trace_packet_t trace[TRACE_SAVE_PACKETS];
+	uint32_t crc;
+} fault_record_t;
+
+/**
+ * \fn void fault_capture
+ * \brief Save a record of the HardFault and reset. Jumped to by HardFault_Handler, never called from C
+ * \param frame The exception frame on the faulting stack
+ * \param exc_return LR on entry to HardFault_Handler
+ * \return Never
+ */
+void fault_capture(uint32_t *frame, uint32_t exc_return) __attribute__((noreturn));
+
+/**
+ * \fn void fault_report
+ * \brief Print and log the record of a HardFault before the last reset, once. Call after the console and black box
+ * \param N/A
+ * \return N/A
+ */
+void fault_report(void);
+
+/**
+ * \fn const fault_record_t *fault_get
+ * \brief Get the saved record
+ * \param N/A
+ * \return The record, or NULL if there is none
+ */
+const fault_record_t *fault_get(void);
+
+/**
+ * \fn void fault_clear
+ * \brief Forget the saved record
+ * \param N/A
+ * \return N/A
+ */
+void fault_clear(void);
+
+#endif /* FAULT_H_ */
@@ -0,0 +1,297 @@
+/**
+ * \file    flash_async.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for the non-blocking flash erase/program driver
+ */
+
+#include "MKL25Z4.h"
+#include "fsl_flash.h"
+#include "flash_async.h"
+#include "power.h"
+#include "clocks.h"
+#include "sections.h"
+
+/**
+ * \def FLASH_ASYNC_ERASE_SECTOR
+ *  FTFA command: erase flash sector
+ */
+#define FLASH_ASYNC_ERASE_SECTOR\
+	(0x09U)
+
+/**
+ * \def FLASH_ASYNC_PROGRAM_LONGWORD
+ *  FTFA command: program longword
+ */
+#define FLASH_ASYNC_PROGRAM_LONGWORD\
+	(0x06U)
+
+/**
+ * \def FLASH_ASYNC_ERRORS
+ *  FSTAT bits that mean a command failed
+ */
+#define FLASH_ASYNC_ERRORS\
+	(FTFA_FSTAT_ACCERR_MASK | FTFA_FSTAT_FPVIOL_MASK | FTFA_FSTAT_MGSTAT0_MASK)
+
+/**
+ * \def FLASH_ASYNC_SECTOR_SIZE
+ *  Flash erase unit
+ */
+#define FLASH_ASYNC_SECTOR_SIZE\
+	(FSL_FEATURE_FLASH_PFLASH_BLOCK_SECTOR_SIZE)
+
+/**
+ * \def FLASH_ASYNC_END
+ *  One past the last flash byte
+ */
+#define FLASH_ASYNC_END\
+	(FSL_FEATURE_FLASH_PFLASH_BLOCK_COUNT * FSL_FEATURE_FLASH_PFLASH_BLOCK_SIZE)
+
+/**
+ *  Memory regions and sections from the linker script
+ */
+extern uint8_t __top_PROGRAM_FLASH[];
+extern uint8_t __start_ramfunc[];
+extern uint8_t __end_ramfunc[];
+
+/**
+ * \typedef flash_async_t
+ *  The queued operation. words is NULL for an erase
+ */
+typedef struct {
+	volatile bool busy;
+	volatile bool running;		/* A step has been launched and the FTFA interrupt has not handled it yet */
+	volatile bool burst;		/* A clocks.h burst is held: the FTFA does not run commands in VLPR */
+	uint32_t address;
+	const uint32_t *words;
+	uint32_t remaining;			/* Sectors to erase or longwords to program */
+	uint32_t launched;			/* Sectors or longwords in the running step */
+	flash_async_callback_t callback;
+	void *user_data;
+} flash_async_t;
+
+static flash_async_t flash_async;
+
+/**
+ * \fn static uint8_t flash_async_run
+ * \brief Run FTFA commands back to back. Executes from SRAM and touches nothing in flash while a command runs: the
+ *  register addresses are in its own literal pool, and each word is read before its command is launched
+ * \param command FLASH_ASYNC_ERASE_SECTOR or FLASH_ASYNC_PROGRAM_LONGWORD
+ * \param address Address of the first command
+ * \param words Data to program, NULL for an erase
+ * \param count Amount of commands
+ * \return FSTAT after the last command that ran
+ *
+ *  Must be called with interrupts masked, since every handler is in flash
+ */
+RAMFUNC static uint8_t flash_async_run(uint8_t command, uint32_t address, const uint32_t *words,
+		uint32_t count){
+	uint32_t word;
+	uint8_t fstat;
+
+	do{
+		FTFA->FCCOB0 = command;
+		FTFA->FCCOB1 = (uint8_t)(address >> 16);
+		FTFA->FCCOB2 = (uint8_t)(address >> 8);
+		FTFA->FCCOB3 = (uint8_t)address;
+		if(words != NULL){
+			word = *words++;
+			FTFA->FCCOB4 = (uint8_t)(word >> 24);
+			FTFA->FCCOB5 = (uint8_t)(word >> 16);
+			FTFA->FCCOB6 = (uint8_t)(word >> 8);
+			FTFA->FCCOB7 = (uint8_t)word;
+			address += 4;
+		}
+		else{
+			address += FLASH_ASYNC_SECTOR_SIZE;
+		}
+
+		FTFA->FSTAT = FTFA_FSTAT_CCIF_MASK;
+		while(!(FTFA->FSTAT & FTFA_FSTAT_CCIF_MASK)){
+		}
+		fstat = FTFA->FSTAT;
+	} while((--count != 0) && !(fstat & FLASH_ASYNC_ERRORS));
+
+	return fstat;
+}
+
+/**
+ * \fn static status_t flash_async_queue
+ * \brief Check an operation and queue it
+ * \param address First byte
+ * \param words Data to program, NULL for an erase
+ * \param length Amount of bytes
+ * \param unit Sector size for an erase, 4 to program
+ * \param callback Called when done
+ * \param user_data Passed to callback
+ * \return See flash_async_erase()
+ */
+static status_t flash_async_queue(uint32_t address, const uint32_t *words, uint32_t length, uint32_t unit,
+		flash_async_callback_t callback, void *user_data){
+	uint32_t primask;
+
+	if((length == 0) || ((address % unit) != 0) || ((length % unit) != 0)){
+		return kStatus_FLASH_AlignmentError;
+	}
+	if((address < (uint32_t)__top_PROGRAM_FLASH) || (length > FLASH_ASYNC_END - address)){
+		return kStatus_FLASH_AddressError;
+	}
+
+	primask = DisableGlobalIRQ();
+	if(flash_async.busy){
+		EnableGlobalIRQ(primask);
+		return kStatus_FlashAsync_Busy;
+	}
+	flash_async.busy = true;
+	flash_async.running = false;
+	power_constrain(power_wait);
+	flash_async.address = address;
+	flash_async.words = words;
+	flash_async.remaining = length / unit;
+	flash_async.callback = callback;
+	flash_async.user_data = user_data;
+	EnableGlobalIRQ(primask);
+
+	return kStatus_Success;
+}
+
+/**
+ * \fn static void flash_async_finish
+ * \brief End the operation and report it
+ * \param status kStatus_FLASH_Success or the error
+ * \return N/A
+ */
+static void flash_async_finish(status_t status){
+	flash_async.busy = false;
+	power_release(power_wait);
+	if(flash_async.callback != NULL){
+		flash_async.callback(status, flash_async.user_data);
+	}
+
+	/**
+	 *  An operation the callback queued keeps the burst, so a chain does not drop to VLPR between its links
+	 */
+	if(flash_async.burst && !flash_async.busy){
+		flash_async.burst = false;
+		clocks_burst_end();
+	}
+}
+
+status_t flash_async_init(void){
+	uint32_t run;
+
+	/**
+	 *  Thumb function pointers have bit 0 set
+	 */
+	run = (uint32_t)flash_async_run & ~1UL;
+	if((run < (uint32_t)__start_ramfunc) || (run >= (uint32_t)__end_ramfunc)){
+		return kStatus_FlashAsync_NotInRam;
+	}
+
+	FTFA->FCNFG &= ~FTFA_FCNFG_CCIE_MASK;
+	NVIC_ClearPendingIRQ(FTFA_IRQn);
+	EnableIRQ(FTFA_IRQn);
+
+	return kStatus_Success;
+}
+
+status_t flash_async_erase(uint32_t address, uint32_t length, flash_async_callback_t callback, void *user_data){
+	return flash_async_queue(address, NULL, length, FLASH_ASYNC_SECTOR_SIZE, callback, user_data);
+}
+
+status_t flash_async_program(uint32_t address, const uint32_t *words, uint32_t length, flash_async_callback_t callback,
+		void *user_data){
+	if(words == NULL){
+		return kStatus_InvalidArgument;
+	}
+
+	return flash_async_queue(address, words, length, 4, callback, user_data);
+}
+
+bool flash_async_busy(void){
+	return flash_async.busy;
+}
+
+void flash_async_poll(void){
+	uint32_t primask;
+
+	if(!flash_async.busy || flash_async.running){
+		return;
+	}
+	if(!flash_async.burst){
+		flash_async.burst = true;
+		(void)clocks_burst_begin();
+	}
+	if(clocks_get_profile() != clocks_run){
+		return;
+	}
+
+	if(flash_async.words == NULL){
+		flash_async.launched = 1;
+	}
+	else{
+		flash_async.launched = MIN(flash_async.remaining, FLASH_ASYNC_PROGRAM_WORDS);
+	}
+
+	/**
+	 *  Nothing in flash may run until flash_async_run() returns. The command-complete interrupt is enabled afterwards,
+	 *  with CCIF already set, so it is taken as soon as interrupts are unmasked
+	 */
+	primask = DisableGlobalIRQ();
+	flash_async.running = true;
+	FTFA->FSTAT = FTFA_FSTAT_ACCERR_MASK | FTFA_FSTAT_FPVIOL_MASK;
+	flash_async_run((flash_async.words == NULL) ? FLASH_ASYNC_ERASE_SECTOR : FLASH_ASYNC_PROGRAM_LONGWORD,
+			flash_async.address, flash_async.words, flash_async.launched);
+	FTFA->FCNFG |= FTFA_FCNFG_CCIE_MASK;
+	EnableGlobalIRQ(primask);
+}
+
+/**
+ * \fn void FTFA_DriverIRQHandler
+ * \brief Command-complete interrupt: check the step that just ran, then finish the operation or leave the next step
+ *  to flash_async_poll()
+ * \param N/A
+ * \return N/A
+ */
+void FTFA_DriverIRQHandler(void){
+	uint8_t fstat;
+
+	/**
+	 *  CCIE stays asserted while CCIF is set, which it is whenever no command runs
+	 */
+	FTFA->FCNFG &= ~FTFA_FCNFG_CCIE_MASK;
+	if(!flash_async.running){
+		return;
+	}
+	flash_async.running = false;
+
+	/**
+	 *  Drop flash cache lines that may hold the old contents
+	 */
+	MCM->PLACR |= MCM_PLACR_CFCC_MASK;
+
+	fstat = FTFA->FSTAT;
+	if(fstat & FTFA_FSTAT_ACCERR_MASK){
+		flash_async_finish(kStatus_FLASH_AccessError);
+	}
+	else if(fstat & FTFA_FSTAT_FPVIOL_MASK){
+		flash_async_finish(kStatus_FLASH_ProtectionViolation);
+	}
+	else if(fstat & FTFA_FSTAT_MGSTAT0_MASK){
+		flash_async_finish(kStatus_FLASH_CommandFailure);
+	}
+	else{
+		flash_async.remaining -= flash_async.launched;
+		if(flash_async.words == NULL){
+			flash_async.address += flash_async.launched * FLASH_ASYNC_SECTOR_SIZE;
+		}
+		else{
+			flash_async.address += flash_async.launched * 4;
+			flash_async.words += flash_async.launched;
+		}
+
+		if(flash_async.remaining == 0){
+			flash_async_finish(kStatus_FLASH_Success);
+		}
+	}
+}
@@ -0,0 +1,107 @@
+/**
+ * \file    flash_async.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for the non-blocking flash erase/program driver
+ *
+ *  The KL25Z has one flash block and cannot read it while an FTFA command runs, so the CPU has to execute from RAM
+ *  with interrupts masked for as long as one command takes (about 65 usec per longword, up to ~20 msec per sector
+ *  erase). A command can therefore not run in the background; what this driver does instead is split an operation
+ *  into steps of one sector erase or FLASH_ASYNC_PROGRAM_WORDS longwords:
+ *  	- flash_async_erase() and flash_async_program() only check and queue the operation, and return at once
+ *  	- flash_async_poll(), called from the main loop, launches one step from RAM-resident code
+ *  	- the FTFA command-complete interrupt checks the result, moves on to the next step and calls the callback
+ *  	  once the operation has finished or failed
+ *  Between steps interrupts are serviced and the main loop runs, so blinking and touch scanning only stall for one
+ *  step instead of a whole operation.
+ *
+ *  Each step still spins in SRAM with interrupts masked until the FTFA is done. That is up to ~20 msec for a sector
+ *  erase and ~4 msec for a full program step. In that time nothing is serviced:
+ *  	- UART0 has a single receive register, so only the first byte arriving during a step is kept and the rest are
+ *  	  lost to a hardware overrun (some 230 bytes in an erase at 115200 baud). The shell command "serial" counts
+ *  	  the overruns
+ *  	- the LED tick that follows the step, and with it every main loop task, starts late by the length of the step.
+ *  	  The LPTMR keeps counting, so the time and the power.c residency stay right
+ *  	- any other pending interrupt waits until the step is over
+ *  Leaving interrupts enabled while the command runs is not possible on this part: the vector table and every handler
+ *  but LPTMR0_IRQHandler() are in flash, and a read of the flash block during a command is a read collision
+ *  (FSTAT[RDCOLERR]) that returns undefined data. Queue flash work only when lost console input is acceptable
+ */
+
+#ifndef FLASH_ASYNC_H_
+#define FLASH_ASYNC_H_
+
+#include "fsl_common.h"
+
+/**
+ * \def FLASH_ASYNC_PROGRAM_WORDS
+ *  Most longwords programmed in one step, about 4 msec
+ */
+#define FLASH_ASYNC_PROGRAM_WORDS\
+	(64U)
+
+/**
+ *  Error codes for the non-blocking flash driver. Flash errors are reported with the kStatus_FLASH_ codes of fsl_flash.h
+ */
+enum {
+	kStatus_FlashAsync_Busy = MAKE_STATUS(kStatusGroup_ApplicationRangeStart + 1, 0),		/* An operation is queued */
+	kStatus_FlashAsync_NotInRam = MAKE_STATUS(kStatusGroup_ApplicationRangeStart + 1, 1)	/* Linker script lost .ramfunc */
+};
+
+/**
+ * \typedef flash_async_callback_t
+ *  Called from the FTFA interrupt when an operation has finished, with kStatus_FLASH_Success or the first error
+ */
+typedef void (*flash_async_callback_t)(status_t status, void *user_data);
+
+/**
+ * \fn status_t flash_async_init
+ * \brief Check that the command launcher really is in .ramfunc and enable the FTFA interrupt
+ * \param N/A
+ * \return kStatus_Success or kStatus_FlashAsync_NotInRam
+ */
+status_t flash_async_init(void);
+
+/**
+ * \fn status_t flash_async_erase
+ * \brief Queue erasing whole sectors
+ * \param address First byte, sector aligned
+ * \param length Amount of bytes, a non-zero multiple of the sector size
+ * \param callback Called when done. May be NULL
+ * \param user_data Passed to callback
+ * \return kStatus_Success, kStatus_FlashAsync_Busy, kStatus_FLASH_AlignmentError, or kStatus_FLASH_AddressError if the
+ *  range is not entirely above PROGRAM_FLASH, i.e. would erase the running image
+ */
+status_t flash_async_erase(uint32_t address, uint32_t length, flash_async_callback_t callback, void *user_data);
+
+/**
+ * \fn status_t flash_async_program
+ * \brief Queue programming erased flash
+ * \param address First byte, longword aligned
+ * \param words The data. Must stay unchanged until the callback; may itself be in flash
+ * \param length Amount of bytes, a non-zero multiple of 4
+ * \param callback Called when done. May be NULL
+ * \param user_data Passed to callback
+ * \return Same as flash_async_erase()
+ */
+status_t flash_async_program(uint32_t address, const uint32_t *words, uint32_t length, flash_async_callback_t callback,
+		void *user_data);
+
+/**
+ * \fn bool flash_async_busy
+ * \brief Get whether an operation is queued or running
+ * \param N/A
+ * \return true until just before the callback runs
+ */
+bool flash_async_busy(void);
+
+/**
+ * \fn void flash_async_poll
+ * \brief Run the next step of the queued operation, if any, with interrupts masked until it is done. Call from the
+ *  main loop
+ * \param N/A
+ * \return N/A
+ */
+void flash_async_poll(void);
+
+#endif /* FLASH_ASYNC_H_ */
@@ -5,30 +5,99 @@
  * \brief   Function definitions for the on-board LED
  */
 
-#ifdef DEBUG
-#include "fsl_debug_console.h"
 #include "board.h"
 #include "MKL25Z4.h"
 #include "led.h"
 #include "touch.h"
-#include "delay.h"
-#endif
+#include "params.h"
+#include "log.h"
+#include "console.h"
+#include "telemetry.h"
+#include "flash_async.h"
+#include "blackbox.h"
+#include "power.h"
+#include "clocks.h"
+#include "sections.h"
+#include "stack.h"
 
-#ifdef NDEBUG
-#include "board.h"
-#include "MKL25Z4.h"
-#include "led.h"
-#include "touch.h"
-#include "delay.h"
-#endif
+/**
+ *  Color the on-board LED is currently showing during blink_sequence, and the color it showed before the last touch scan
+ */
+static color_t onboard_led;
+static color_t onboard_led_prev;
 
-void init_onboard_leds(void){
+/**
+ *  To keep track of scanned value from TSI (after subtracting TOUCH_OFFSET)
+ */
+static unsigned int scanned_value;
+
+/**
+ * \fn static void led_hold
+ * \brief Leave the on-board LED in its current state for a number of 100 msec ticks, idling in the deepest allowed
+ *  power mode
+ * \param ticks The amount of 100 msec delays to wait
+ * \return N/A
+ */
+static void led_hold(int ticks){
 
 	/**
 	 *  Force the counter to be placed into memory
 	 */
 	volatile static int i;
 
+	for(i = 0; i < ticks; i++){
+		power_idle(LED_TICK_MSEC);
+	}
+}
+
+/**
+ * \fn static void update_led_color
+ * \brief Scan the touch sensor and change the color of the on-board LED if the user's touch selects a new color. Runs
+ *  every tick, from SRAM
+ * \param N/A
+ * \return N/A
+ */
+RAMFUNC static void update_led_color(void){
+	GET_TOUCH();
+	PRINTF_TOUCH(scanned_value);
+	telemetry_record(telemetry_touch, (uint16_t)(scanned_value + params.touch_offset), (uint16_t)scanned_value);
+	GET_LED_COLOR();
+	if(onboard_led != onboard_led_prev){
+		PRINTF_LED_COLOR_CHANGE(onboard_led);
+		telemetry_record(telemetry_led, (uint16_t)onboard_led, (uint16_t)onboard_led_prev);
+		blackbox_record(blackbox_led, (uint8_t)onboard_led, onboard_led_prev);
+	}
+}
+
+/**
+ * \fn static void blink_hold
+ * \brief Leave the on-board LED in its current state for a number of 100 msec ticks, scanning the touch sensor,
+ *  servicing console input, checking the stack and running a step of any queued flash operation after every tick. The
+ *  ticks are spent in power_idle()
+ * \param ticks The amount of 100 msec delays to wait
+ * \return N/A
+ */
+static void blink_hold(uint32_t ticks){
+
+	/**
+	 *  Force the counter to be placed into memory
+	 */
+	volatile static uint32_t i;
+
+	for(i = 0; i < ticks; i++){
+		power_idle(LED_TICK_MSEC);
+		stack_poll();
+		telemetry_tick();
+		blackbox_tick();
+		update_led_color();
+		console_poll();
+		clocks_poll();
+		flash_async_poll();
+	}
+}
+
+void init_onboard_leds(void){
+
 	/**
      * Enable clock to Port B for red + green on-board LEDs
      * Enable clock to Port D for blue on-board LED
@@ -63,6 +132,9 @@ void init_onboard_leds(void){
     LED_OFF(red);
     LED_OFF(green);
     LED_OFF(blue);
+}
+
+void test_onboard_leds(void){
 
     /**
      * Turn red LED on for 500 msec, and then off for 100 msec
@@ -71,100 +143,49 @@ void init_onboard_leds(void){
      * Turn white LED (red + green + blue) on for 100 msec, and then off for 100 msec
      * Turn white LED (red + green + blue) on for 100 msec, and then off for 100 msec
      */
-#ifdef DEBUG
-	PRINTF("START TIMER 500\r\n");
-    LED_ON(red);
-	for(i = 0; i < 5; i++){
-		DELAY_100_MSEC();
-	}
+	LOG_DEBUG(LED, "START TIMER 500\r\n");
+	LED_ON(red);
+	led_hold(5);
 
-	PRINTF("START TIMER 100\r\n");
+	LOG_DEBUG(LED, "START TIMER 100\r\n");
 	LED_OFF(red);
-	DELAY_100_MSEC();
+	led_hold(1);
 
-	PRINTF("START TIMER 500\r\n");
-    LED_ON(green);
-	for(i = 0; i < 5; i++){
-		DELAY_100_MSEC();
-	}
+	LOG_DEBUG(LED, "START TIMER 500\r\n");
+	LED_ON(green);
+	led_hold(5);
 
-	PRINTF("START TIMER 100\r\n");
-    LED_OFF(green);
-	DELAY_100_MSEC();
+	LOG_DEBUG(LED, "START TIMER 100\r\n");
+	LED_OFF(green);
+	led_hold(1);
 
-	PRINTF("START TIMER 500\r\n");
-    LED_ON(blue);
-	for(i = 0; i < 5; i++){
-		DELAY_100_MSEC();
-	}
+	LOG_DEBUG(LED, "START TIMER 500\r\n");
+	LED_ON(blue);
+	led_hold(5);
 
-	PRINTF("START TIMER 100\r\n");
-    LED_OFF(blue);
-	DELAY_100_MSEC();
+	LOG_DEBUG(LED, "START TIMER 100\r\n");
+	LED_OFF(blue);
+	led_hold(1);
 
-	PRINTF("START TIMER 100\r\n");
+	LOG_DEBUG(LED, "START TIMER 100\r\n");
 	LED_ON(white);
-	DELAY_100_MSEC();
+	led_hold(1);
 
-	PRINTF("START TIMER 100\r\n");
+	LOG_DEBUG(LED, "START TIMER 100\r\n");
 	LED_OFF(white);
-	DELAY_100_MSEC();
+	led_hold(1);
 
-	PRINTF("START TIMER 100\r\n");
+	LOG_DEBUG(LED, "START TIMER 100\r\n");
 	LED_ON(white);
-	DELAY_100_MSEC();
+	led_hold(1);
 
-	PRINTF("START TIMER 100\r\n");
+	LOG_DEBUG(LED, "START TIMER 100\r\n");
 	LED_OFF(white);
-	DELAY_100_MSEC();
-#endif
-
-#ifdef NDEBUG
-    LED_ON(red);
-	for(i = 0; i < 5; i++){
-		DELAY_100_MSEC();
-	}
-
-	LED_OFF(red);
-	DELAY_100_MSEC();
-
-    LED_ON(green);
-	for(i = 0; i < 5; i++){
-		DELAY_100_MSEC();
-	}
-
-    LED_OFF(green);
-	DELAY_100_MSEC();
-
-    LED_ON(blue);
-	for(i = 0; i < 5; i++){
-		DELAY_100_MSEC();
-	}
-
-    LED_OFF(blue);
-	DELAY_100_MSEC();
-
-	LED_ON(white);
-	DELAY_100_MSEC();
-
-	LED_OFF(white);
-	DELAY_100_MSEC();
-
-	LED_ON(white);
-	DELAY_100_MSEC();
-
-	LED_OFF(white);
-	DELAY_100_MSEC();
-#endif
+	led_hold(1);
 }
 
 void init_blink_sequence(void){
 
-	/**
-	 *  Force the counter to be placed into memory
-	 */
-	volatile static int i;
-
 	/**
 	 * ON for 500 msec, OFF for 500 msec
 	 * ON for 1000 msec, OFF for 500 msec
@@ -172,299 +193,72 @@ void init_blink_sequence(void){
 	 * ON for 3000 msec, OFF for 500 msec
 	 *
 	 */
+	LOG_DEBUG(LED, "START TIMER 500\r\n");
+	LED_ON(INIT_LED_COLOR);
+	led_hold(5);
 
-#ifdef DEBUG
-		PRINTF("START TIMER 500\r\n");
-		LED_ON(INIT_LED_COLOR);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-		}
-
-		PRINTF("START TIMER 500\r\n");
-		LED_OFF(INIT_LED_COLOR);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-		}
-
-		PRINTF("START TIMER 1000\r\n");
-		LED_ON(INIT_LED_COLOR);
-		for(i = 0; i < 10; i++){
-			DELAY_100_MSEC();
-		}
-
-		PRINTF("START TIMER 500\r\n");
-		LED_OFF(INIT_LED_COLOR);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-		}
-
-		PRINTF("START TIMER 2000\r\n");
-		LED_ON(INIT_LED_COLOR);
-		for(i = 0; i < 20; i++){
-			DELAY_100_MSEC();
-		}
-
-		PRINTF("START TIMER 500\r\n");
-		LED_OFF(INIT_LED_COLOR);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-		}
+	LOG_DEBUG(LED, "START TIMER 500\r\n");
+	LED_OFF(INIT_LED_COLOR);
+	led_hold(5);
 
-		PRINTF("START TIMER 3000\r\n");
-		LED_ON(INIT_LED_COLOR);
-		for(i = 0; i < 30; i++){
-			DELAY_100_MSEC();
-		}
+	LOG_DEBUG(LED, "START TIMER 1000\r\n");
+	LED_ON(INIT_LED_COLOR);
+	led_hold(10);
 
-		PRINTF("START TIMER 500\r\n");
-		LED_OFF(INIT_LED_COLOR);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-		}
-#endif
+	LOG_DEBUG(LED, "START TIMER 500\r\n");
+	LED_OFF(INIT_LED_COLOR);
+	led_hold(5);
 
-#ifdef NDEBUG
-		LED_ON(INIT_LED_COLOR);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-		}
+	LOG_DEBUG(LED, "START TIMER 2000\r\n");
+	LED_ON(INIT_LED_COLOR);
+	led_hold(20);
 
-		LED_OFF(INIT_LED_COLOR);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-		}
+	LOG_DEBUG(LED, "START TIMER 500\r\n");
+	LED_OFF(INIT_LED_COLOR);
+	led_hold(5);
 
-		LED_ON(INIT_LED_COLOR);
-		for(i = 0; i < 10; i++){
-			DELAY_100_MSEC();
-		}
+	LOG_DEBUG(LED, "START TIMER 3000\r\n");
+	LED_ON(INIT_LED_COLOR);
+	led_hold(30);
 
-		LED_OFF(INIT_LED_COLOR);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-		}
-
-		LED_ON(INIT_LED_COLOR);
-		for(i = 0; i < 20; i++){
-			DELAY_100_MSEC();
-		}
-
-		LED_OFF(INIT_LED_COLOR);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-		}
-
-		LED_ON(INIT_LED_COLOR);
-		for(i = 0; i < 30; i++){
-			DELAY_100_MSEC();
-		}
-
-		LED_OFF(INIT_LED_COLOR);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-		}
-#endif
+	LOG_DEBUG(LED, "START TIMER 500\r\n");
+	LED_OFF(INIT_LED_COLOR);
+	led_hold(5);
 }
 
 void blink_sequence(void){
-	/**
-	 *  Force the counter to be placed into memory
-	 */
-	volatile static int i;
 
 	/**
-	 *  To keep track of scanned value from TSI (after subtracting TOUCH_OFFSET)
+	 *  Index of the ON/OFF pair being shown
 	 */
-	static unsigned int scanned_value;
-
-	/**
-	 *
-	 */
-	color_t onboard_led;
-	color_t onboard_led_prev;
+	int step;
 
 	onboard_led = white;
 	onboard_led_prev = white;
 
+	update_led_color();
+
 	/**
+	 * ON/OFF durations come from params.blink_on and params.blink_off, which default to:
 	 * ON for 500 msec, OFF for 500 msec
 	 * ON for 1000 msec, OFF for 500 msec
 	 * ON for 2000 msec, OFF for 500 msec
 	 * ON for 3000 msec, OFF for 500 msec
 	 *
 	 */
-
-
-
-#ifdef DEBUG
-
-	GET_TOUCH();
-	PRINTF_TOUCH(scanned_value);
-	GET_LED_COLOR();
-	if(onboard_led != onboard_led_prev){
-		PRINTF_LED_COLOR_CHANGE(onboard_led);
-	}
-
 	while(1){
-		PRINTF("START TIMER 500\r\n");
-		LED_ON(onboard_led);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-			GET_TOUCH();
-			PRINTF_TOUCH(scanned_value);
-			GET_LED_COLOR();
-			if(onboard_led != onboard_led_prev){
-				PRINTF_LED_COLOR_CHANGE(onboard_led);
-			}
-		}
-
-		PRINTF("START TIMER 500\r\n");
-		LED_OFF(onboard_led);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-			GET_TOUCH();
-			PRINTF_TOUCH(scanned_value);
-			GET_LED_COLOR();
-			if(onboard_led != onboard_led_prev){
-				PRINTF_LED_COLOR_CHANGE(onboard_led);
-			}
-		}
+		for(step = 0; step < BLINK_STEPS; step++){
+			LOG_DEBUG(LED, "START TIMER %u\r\n", params.blink_on[step] * 100);
+			LED_ON(onboard_led);
+			blink_hold(params.blink_on[step]);
 
-		PRINTF("START TIMER 1000\r\n");
-		LED_ON(onboard_led);
-		for(i = 0; i < 10; i++){
-			DELAY_100_MSEC();
-			GET_TOUCH();
-			PRINTF_TOUCH(scanned_value);
-			GET_LED_COLOR();
-			if(onboard_led != onboard_led_prev){
-				PRINTF_LED_COLOR_CHANGE(onboard_led);
-			}
-		}
-
-		PRINTF("START TIMER 500\r\n");
-		LED_OFF(onboard_led);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-			GET_TOUCH();
-			PRINTF_TOUCH(scanned_value);
-			GET_LED_COLOR();
-			if(onboard_led != onboard_led_prev){
-				PRINTF_LED_COLOR_CHANGE(onboard_led);
-			}
-		}
-
-		PRINTF("START TIMER 2000\r\n");
-		LED_ON(onboard_led);
-		for(i = 0; i < 20; i++){
-			DELAY_100_MSEC();
-			GET_TOUCH();
-			PRINTF_TOUCH(scanned_value);
-			GET_LED_COLOR();
-			if(onboard_led != onboard_led_prev){
-				PRINTF_LED_COLOR_CHANGE(onboard_led);
-			}
-		}
-
-		PRINTF("START TIMER 500\r\n");
-		LED_OFF(onboard_led);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-			GET_TOUCH();
-			PRINTF_TOUCH(scanned_value);
-			GET_LED_COLOR();
-			if(onboard_led != onboard_led_prev){
-				PRINTF_LED_COLOR_CHANGE(onboard_led);
-			}
-		}
-
-		PRINTF("START TIMER 3000\r\n");
-		LED_ON(onboard_led);
-		for(i = 0; i < 30; i++){
-			DELAY_100_MSEC();
-			GET_TOUCH();
-			PRINTF_TOUCH(scanned_value);
-			GET_LED_COLOR();
-			if(onboard_led != onboard_led_prev){
-				PRINTF_LED_COLOR_CHANGE(onboard_led);
-			}
-		}
-
-		PRINTF("START TIMER 500\r\n");
-		LED_OFF(onboard_led);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-			GET_TOUCH();
-			PRINTF_TOUCH(scanned_value);
-			GET_LED_COLOR();
-			if(onboard_led != onboard_led_prev){
-				PRINTF_LED_COLOR_CHANGE(onboard_led);
-			}
+			LOG_DEBUG(LED, "START TIMER %u\r\n", params.blink_off[step] * 100);
+			LED_OFF(onboard_led);
+			blink_hold(params.blink_off[step]);
 		}
 	}
-#endif
-
-#ifdef NDEBUG
-
-	GET_TOUCH();
-	GET_LED_COLOR();
-
-	while(1){
-		LED_ON(onboard_led);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-			GET_TOUCH();
-			GET_LED_COLOR();
-		}
-
-		LED_OFF(onboard_led);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-			GET_TOUCH();
-			GET_LED_COLOR();
-		}
-
-		LED_ON(onboard_led);
-		for(i = 0; i < 10; i++){
-			DELAY_100_MSEC();
-			GET_TOUCH();
-			GET_LED_COLOR();
-		}
-
-		LED_OFF(onboard_led);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-			GET_TOUCH();
-			GET_LED_COLOR();
-		}
-
-		LED_ON(onboard_led);
-		for(i = 0; i < 20; i++){
-			DELAY_100_MSEC();
-			GET_TOUCH();
-			GET_LED_COLOR();
-		}
-
-		LED_OFF(onboard_led);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-			GET_TOUCH();
-			GET_LED_COLOR();
-		}
-
-		LED_ON(onboard_led);
-		for(i = 0; i < 30; i++){
-			DELAY_100_MSEC();
-			GET_TOUCH();
-			GET_LED_COLOR();
-		}
+}
 
-		LED_OFF(onboard_led);
-		for(i = 0; i < 5; i++){
-			DELAY_100_MSEC();
-			GET_TOUCH();
-			GET_LED_COLOR();
-		}
-	}
-#endif
+color_t get_onboard_led_color(void){
+	return onboard_led;
 }
@@ -144,6 +144,13 @@ typedef enum {
 		}\
 	}while(0)
 
+/**
+ * \def LED_TICK_MSEC
+ *  Length of one blink tick, the unit of the blink_on/blink_off parameters
+ */
+#define LED_TICK_MSEC\
+	(100U)
+
 /**
  * \def INIT_LED_COLOR
  *  The color that the on-board LED should be during initial blink sequence, before entering the infinite loop
@@ -152,19 +159,19 @@ typedef enum {
 	(white)
 /**
  * \def GET_LED_COLOR()
- * Based on the scanned value from TSI module, calculate and store the color that the on-board LED should display
+ * Based on the scanned value from TSI module and the thresholds in params, calculate and store the color that the on-board LED should display
  */
 #define GET_LED_COLOR()\
 	do{\
 		onboard_led_prev = onboard_led;\
 		\
-		if(scanned_value < TOUCH_UNTOUCHED_MAX){\
+		if(scanned_value < params.touch_untouched_max){\
 			onboard_led = onboard_led_prev;\
 		}\
-		else if(scanned_value < TOUCH_LEFT_MAX){\
+		else if(scanned_value < params.touch_left_max){\
 			onboard_led = red;\
 		}\
-		else if(scanned_value < TOUCH_RIGHT_MIN){\
+		else if(scanned_value < params.touch_right_min){\
 			onboard_led = green;\
 		}\
 		else{\
@@ -181,10 +188,10 @@ typedef enum {
 /**
  * \def PRINTF_LED_COLOR_CHANGE(x)
  * \param The new color LED is being changed to
- * Print the new color that on-board LED is being changed to
+ * Log (at LOG_LEVEL_INFO) the new color that on-board LED is being changed to
  */
 #define PRINTF_LED_COLOR_CHANGE(x)\
-	(PRINTF("CHANGE LED TO %s\r\n", (x == red) ? "RED" : ((x == green) ? "GREEN" : ((x == blue) ? "BLUE" : "?"))));
+	LOG_INFO(LED, "CHANGE LED TO %s\r\n", (x == red) ? "RED" : ((x == green) ? "GREEN" : ((x == blue) ? "BLUE" : "?")))
 
 /**
  * \fn void init_onboard_leds
@@ -207,6 +214,15 @@ typedef enum {
  */
 void init_onboard_leds(void);
 
+/**
+ * \fn void test_onboard_leds
+ * \brief Show each color in turn so a dead LED is seen at power-on: red, green and blue for 500 msec each, then
+ *  white twice for 100 msec, with 100 msec off in between. Takes 2.2 sec
+ * \param N/A
+ * \return N/A
+ */
+void test_onboard_leds(void);
+
 /**
  * \fn void init_blink_sequence
  * \brief Blink LED in specific sequence. Color of LED will be white
@@ -237,4 +253,12 @@ void init_blink_sequence(void);
  */
 void blink_sequence(void);
 
+/**
+ * \fn color_t get_onboard_led_color
+ * \brief Get the color blink_sequence is currently using for the on-board LED
+ * \param N/A
+ * \return The current color
+ */
+color_t get_onboard_led_color(void);
+
 #endif /* LED_H_ */
@@ -0,0 +1,160 @@
+/**
+ * \file    log.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Compile-time filtered logging front end for the debug console
+ *
+ *  Every LOG_x() call is resolved entirely by the preprocessor. A call whose level is above LOG_LEVEL, or whose module
+ *  is disabled, expands to an empty statement, so neither the format string nor the arguments are compiled in.
+ */
+
+#ifndef LOG_H_
+#define LOG_H_
+
+#include "fsl_debug_console.h"
+
+/**
+ * \def LOG_LEVEL_NONE
+ *  No logging at all
+ */
+#define LOG_LEVEL_NONE\
+	(0)
+
+/**
+ * \def LOG_LEVEL_ERROR
+ *  Only unrecoverable conditions
+ */
+#define LOG_LEVEL_ERROR\
+	(1)
+
+/**
+ * \def LOG_LEVEL_WARN
+ *  Recoverable but unexpected conditions
+ */
+#define LOG_LEVEL_WARN\
+	(2)
+
+/**
+ * \def LOG_LEVEL_INFO
+ *  State changes worth seeing in the field (e.g. LED color changes)
+ */
+#define LOG_LEVEL_INFO\
+	(3)
+
+/**
+ * \def LOG_LEVEL_DEBUG
+ *  Everything, including per-sample touch values and timer starts
+ */
+#define LOG_LEVEL_DEBUG\
+	(4)
+
+/**
+ * \def LOG_LEVEL
+ *  The most verbose level compiled in. Can be overridden on the command line (e.g. -DLOG_LEVEL=3).
+ *  Defaults to LOG_LEVEL_DEBUG for the Debug configuration (-DDEBUG) and LOG_LEVEL_NONE otherwise
+ */
+#ifndef LOG_LEVEL
+#ifdef DEBUG
+#define LOG_LEVEL\
+	(LOG_LEVEL_DEBUG)
+#else
+#define LOG_LEVEL\
+	(LOG_LEVEL_NONE)
+#endif
+#endif
+
+/**
+ * \def LOG_ENABLE_LED
+ *  Per-module enable for the on-board LED module. Must be a literal 0 or 1
+ */
+#ifndef LOG_ENABLE_LED
+#define LOG_ENABLE_LED 1
+#endif
+
+/**
+ * \def LOG_ENABLE_TOUCH
+ *  Per-module enable for the on-board touch sensor module. Must be a literal 0 or 1
+ */
+#ifndef LOG_ENABLE_TOUCH
+#define LOG_ENABLE_TOUCH 1
+#endif
+
+/**
+ * \def LOG_ENABLE_STACK
+ *  Per-module enable for the stack high-water module. Must be a literal 0 or 1
+ */
+#ifndef LOG_ENABLE_STACK
+#define LOG_ENABLE_STACK 1
+#endif
+
+/**
+ * \def LOG_MODULE(module, ...)
+ * \param module The module name (e.g. LED, TOUCH), which selects LOG_ENABLE_<module>
+ *  Print through the debug console if the module is enabled, otherwise expand to nothing
+ */
+#define LOG_MODULE(module, ...)\
+	LOG_MODULE_SELECT(LOG_ENABLE_##module, __VA_ARGS__)
+#define LOG_MODULE_SELECT(enable, ...)\
+	LOG_MODULE_EXPAND(enable, __VA_ARGS__)
+#define LOG_MODULE_EXPAND(enable, ...)\
+	LOG_MODULE_##enable(__VA_ARGS__)
+#define LOG_MODULE_0(...)\
+	do{}while(0)
+#define LOG_MODULE_1(...)\
+	do{\
+		(void)PRINTF(__VA_ARGS__);\
+	}while(0)
+
+/**
+ * \def LOG_ERROR(module, ...)
+ * \param module The module name (e.g. LED, TOUCH)
+ *  Log a printf-style message at LOG_LEVEL_ERROR
+ */
+#if (LOG_LEVEL >= LOG_LEVEL_ERROR)
+#define LOG_ERROR(module, ...)\
+	LOG_MODULE(module, __VA_ARGS__)
+#else
+#define LOG_ERROR(module, ...)\
+	do{}while(0)
+#endif
+
+/**
+ * \def LOG_WARN(module, ...)
+ * \param module The module name (e.g. LED, TOUCH)
+ *  Log a printf-style message at LOG_LEVEL_WARN
+ */
+#if (LOG_LEVEL >= LOG_LEVEL_WARN)
+#define LOG_WARN(module, ...)\
+	LOG_MODULE(module, __VA_ARGS__)
+#else
+#define LOG_WARN(module, ...)\
+	do{}while(0)
+#endif
+
+/**
+ * \def LOG_INFO(module, ...)
+ * \param module The module name (e.g. LED, TOUCH)
+ *  Log a printf-style message at LOG_LEVEL_INFO
+ */
+#if (LOG_LEVEL >= LOG_LEVEL_INFO)
+#define LOG_INFO(module, ...)\
+	LOG_MODULE(module, __VA_ARGS__)
+#else
+#define LOG_INFO(module, ...)\
+	do{}while(0)
+#endif
+
+/**
+ * \def LOG_DEBUG(module, ...)
+ * \param module The module name (e.g. LED, TOUCH)
+ *  Log a printf-style message at LOG_LEVEL_DEBUG
+ */
+#if (LOG_LEVEL >= LOG_LEVEL_DEBUG)
+#define LOG_DEBUG(module, ...)\
+	LOG_MODULE(module, __VA_ARGS__)
+#else
+#define LOG_DEBUG(module, ...)\
+	do{}while(0)
+#endif
+
+#endif /* LOG_H_ */
@@ -48,6 +48,18 @@
 #include "led.h"
 #include "touch.h"
 #include "delay.h"
+#include "console.h"
+#include "shell.h"
+#include "settings.h"
+#include "params.h"
+#include "flash_async.h"
+#include "blackbox.h"
+#include "power.h"
+#include "clocks.h"
+#include "boottime.h"
+#include "pool.h"
+#include "fault.h"
+#include "trace.h"
 
  /**
   * \fn void blink_sequence
@@ -64,29 +76,125 @@
   */
 
 
+/**
+ * \fn static void init_console
+ * \brief Finish the clocks if the fast boot left the PLL locking, then bring up the debug console and the shell
+ * \param N/A
+ * \return N/A
+ */
+static void init_console(void){
+    clocks_boot_finish();
+    boottime_mark(boottime_pll);
+
+#ifndef BOARD_INIT_DEBUG_CONSOLE_PERIPHERAL
+    /* Init FSL debug console. */
+    BOARD_InitDebugConsole();
+#endif
+
+#if CONSOLE_HIGH_SPEED_ENABLE
+    /**
+     * Move the console to the high-speed rate if the host tool follows, and report what was achieved
+     */
+    console_set_baud(CONSOLE_HIGH_SPEED_BAUDRATE);
+    console_print_baud();
+#endif
+
+    /**
+     * Start interrupt-driven console reception. Completed lines are run as shell commands from console_poll()
+     */
+    console_init(shell_execute);
+    boottime_mark(boottime_console);
+}
+
 /*
  * @brief   Application entry point.
  */
 int main(void) {
+    uint32_t boot_flags;
+    status_t settings_status;
+
+    boottime_init();
+
+    /**
+     * Link the block pools before anything can allocate from them
+     */
+    pool_init();
+
+    /**
+     * Trace branches into the MTB buffer from here on, so a HardFault can save the last ones
+     */
+    if(trace_configure(TRACE_BUFFER_SIZE, 0) == kStatus_Success){
+        trace_start();
+    }
+
+    /**
+     * The settings store is only read here, so it can come first and tell how to boot
+     */
+    settings_status = settings_init();
+    boot_flags = (settings_status == kStatus_Success) ? boottime_load_flags() : 0;
+    boottime_mark(boottime_settings);
 
     /* Init board hardware. */
     BOARD_InitBootPins();
-    BOARD_InitBootClocks();
+    boottime_mark(boottime_pins);
+    if(boot_flags & BOOTTIME_FLAG_FAST_CLOCKS){
+        clocks_boot_start();
+    }
+    else{
+        BOARD_InitBootClocks();
+    }
+    boottime_mark(boottime_clocks);
     BOARD_InitBootPeripherals();
-#ifndef BOARD_INIT_DEBUG_CONSOLE_PERIPHERAL
-    /* Init FSL debug console. */
-    BOARD_InitDebugConsole();
-#endif
+    boottime_mark(boottime_peripherals);
+
+    if(!(boot_flags & BOOTTIME_FLAG_DEFER_CONSOLE)){
+        init_console();
+    }
 
     /**
-     * Initialize all 3 on-board LEDs (red, green, blue)
+     * Start the idle power manager; the blink ticks sleep in the deepest mode the drivers' constraints allow
+     */
+    power_init();
+    boottime_mark(boottime_power);
+
+    /**
+     * Initialize all 3 on-board LEDs (red, green, blue). Without the self test the first blink starts right away
      */
     init_onboard_leds();
+    if(boot_flags & BOOTTIME_FLAG_SKIP_SELFTEST){
+        LED_ON(INIT_LED_COLOR);
+    }
+    boottime_mark(boottime_leds);
+    if(!(boot_flags & BOOTTIME_FLAG_SKIP_SELFTEST)){
+        test_onboard_leds();
+        boottime_mark(boottime_selftest);
+    }
+
+    /**
+     * Restore the parameters saved with the shell's save command, before the TSI is set up with them, and log the reset
+     */
+    if(settings_status == kStatus_Success){
+        params_load();
+    }
+    blackbox_init();
+    flash_async_init();
+    boottime_mark(boottime_storage);
 
     /**
      * Initialize on-board TSI
      */
     init_onboard_touch_sensor();
+    boottime_mark(boottime_touch);
+
+    if(boot_flags & BOOTTIME_FLAG_DEFER_CONSOLE){
+        init_console();
+    }
+    boottime_end();
+
+    /**
+     * Report a HardFault that caused the last reset, now that the console and the black box are up
+     */
+    fault_report();
 
     /**
      *  Enter init_blink_sequence which will do exactly 1 entire sequence with the white LED (color change via touch sensor will be ignored here)
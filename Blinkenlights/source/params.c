@@ -0,0 +1,179 @@
+/**
+ * \file    params.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Run-time tunable parameters for blinking and touch sensing
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "board.h"
+#include "params.h"
+#include "touch.h"
+#include "settings.h"
+#include "blackbox.h"
+
+params_t params = {
+	.touch_offset = TOUCH_OFFSET,
+	.touch_untouched_max = TOUCH_UNTOUCHED_MAX,
+	.touch_left_max = TOUCH_LEFT_MAX,
+	.touch_right_min = TOUCH_RIGHT_MIN,
+	.gencs_nscn = GENCS_NSCN,
+	.blink_on = {5, 10, 20, 30},
+	.blink_off = {5, 5, 5, 5},
+};
+
+/**
+ * \def PARAM(field, min, max)
+ *  Describe the params_t member called field
+ */
+#define PARAM(field, min, max)\
+	{#field, offsetof(params_t, field), (min), (max)}
+
+/**
+ *  Sorted by name so params_find() can binary search
+ */
+static const param_info_t param_table[] = {
+	PARAM(blink_off[0], 1, 600),
+	PARAM(blink_off[1], 1, 600),
+	PARAM(blink_off[2], 1, 600),
+	PARAM(blink_off[3], 1, 600),
+	PARAM(blink_on[0], 1, 600),
+	PARAM(blink_on[1], 1, 600),
+	PARAM(blink_on[2], 1, 600),
+	PARAM(blink_on[3], 1, 600),
+	PARAM(gencs_nscn, 0, 31),
+	PARAM(touch_left_max, 0, 0xFFFF),
+	PARAM(touch_offset, 0, 0xFFFF),
+	PARAM(touch_right_min, 0, 0xFFFF),
+	PARAM(touch_untouched_max, 0, 0xFFFF),
+};
+
+/**
+ * \fn static uint32_t *param_field
+ * \brief Locate a parameter inside a params_t
+ * \param p The parameter set
+ * \param info The parameter description
+ * \return Pointer to the parameter's value
+ */
+static uint32_t *param_field(params_t *p, const param_info_t *info){
+	return (uint32_t *)((uint8_t *)p + info->offset);
+}
+
+const param_info_t *params_find(const char *name){
+	uint32_t low;
+	uint32_t high;
+	uint32_t mid;
+	int cmp;
+
+	low = 0;
+	high = ARRAY_SIZE(param_table);
+	while(low < high){
+		mid = (low + high) / 2;
+		cmp = strcmp(name, param_table[mid].name);
+		if(cmp == 0){
+			return &param_table[mid];
+		}
+		if(cmp < 0){
+			high = mid;
+		}
+		else{
+			low = mid + 1;
+		}
+	}
+
+	return NULL;
+}
+
+const param_info_t *params_at(uint32_t index){
+	if(index >= ARRAY_SIZE(param_table)){
+		return NULL;
+	}
+	return &param_table[index];
+}
+
+uint32_t params_get(const param_info_t *info){
+	return *param_field(&params, info);
+}
+
+/**
+ * \fn static bool params_ordered
+ * \brief Check that the touch thresholds of a parameter set are in increasing order
+ * \param p The parameter set
+ * \return true if they are
+ */
+static bool params_ordered(const params_t *p){
+	return (p->touch_untouched_max < p->touch_left_max) && (p->touch_left_max < p->touch_right_min);
+}
+
+status_t params_set(const param_info_t *info, uint32_t value){
+	params_t next;
+	uint32_t primask;
+
+	if((value < info->min) || (value > info->max)){
+		return kStatus_OutOfRange;
+	}
+
+	next = params;
+	*param_field(&next, info) = value;
+
+	if(!params_ordered(&next)){
+		return kStatus_InvalidArgument;
+	}
+
+	primask = DisableGlobalIRQ();
+	params = next;
+	EnableGlobalIRQ(primask);
+
+	blackbox_record(blackbox_param, (uint8_t)(info->offset / sizeof(uint32_t)), value);
+
+	if(info->offset == offsetof(params_t, gencs_nscn)){
+		set_touch_scan_count(next.gencs_nscn);
+	}
+
+	return kStatus_Success;
+}
+
+status_t params_load(void){
+	params_t saved;
+	size_t length;
+	uint32_t i;
+	uint32_t value;
+	status_t status;
+
+	status = settings_read(settings_key_params, &saved, sizeof(saved), &length);
+	if(status != kStatus_Success){
+		return status;
+	}
+
+	/**
+	 *  A set saved by a build with a different params_t is ignored rather than misread
+	 */
+	if(length != sizeof(saved)){
+		return kStatus_InvalidArgument;
+	}
+	for(i = 0; i < ARRAY_SIZE(param_table); i++){
+		value = *param_field(&saved, &param_table[i]);
+		if((value < param_table[i].min) || (value > param_table[i].max)){
+			return kStatus_InvalidArgument;
+		}
+	}
+	if(!params_ordered(&saved)){
+		return kStatus_InvalidArgument;
+	}
+
+	params = saved;
+
+	return kStatus_Success;
+}
+
+status_t params_save(void){
+	params_t current;
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	current = params;
+	EnableGlobalIRQ(primask);
+
+	return settings_write(settings_key_params, &current, sizeof(current));
+}
@@ -0,0 +1,111 @@
+/**
+ * \file    params.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Run-time tunable parameters for blinking and touch sensing
+ *
+ *  The compile-time macros in led.h and touch.h (TOUCH_OFFSET, TOUCH_UNTOUCHED_MAX, GENCS_NSCN, ...) are the defaults.
+ *  The values actually used are read from params, which the command shell can change while the board is running.
+ */
+
+#ifndef PARAMS_H_
+#define PARAMS_H_
+
+#include <stdint.h>
+#include "fsl_common.h"
+
+/**
+ * \def BLINK_STEPS
+ *  Amount of ON/OFF pairs in one pass of blink_sequence
+ */
+#define BLINK_STEPS\
+	(4)
+
+/**
+ * \typedef params_t
+ *  Every tunable parameter. Blink durations are in 100 msec ticks
+ */
+typedef struct {
+	uint32_t touch_offset;
+	uint32_t touch_untouched_max;
+	uint32_t touch_left_max;
+	uint32_t touch_right_min;
+	uint32_t gencs_nscn;
+	uint32_t blink_on[BLINK_STEPS];
+	uint32_t blink_off[BLINK_STEPS];
+} params_t;
+
+/**
+ * \typedef param_info_t
+ *  Name, location and valid range of one parameter
+ */
+typedef struct {
+	const char *name;
+	uint32_t offset;
+	uint32_t min;
+	uint32_t max;
+} param_info_t;
+
+/**
+ *  Parameters in use. Read freely from the main loop; change only through params_set()
+ */
+extern params_t params;
+
+/**
+ * \fn const param_info_t *params_find
+ * \brief Look up a parameter by name with a binary search over the sorted parameter table
+ * \param name The parameter name (e.g. "touch_left_max")
+ * \return The parameter description, or NULL if there is no such parameter
+ */
+const param_info_t *params_find(const char *name);
+
+/**
+ * \fn const param_info_t *params_at
+ * \brief Get the parameter at a position in the sorted parameter table, for listing
+ * \param index Position in the table
+ * \return The parameter description, or NULL if index is past the end
+ */
+const param_info_t *params_at(uint32_t index);
+
+/**
+ * \fn uint32_t params_get
+ * \brief Read the current value of a parameter
+ * \param info The parameter description from params_find() or params_at()
+ * \return The current value
+ */
+uint32_t params_get(const param_info_t *info);
+
+/**
+ * \fn status_t params_set
+ * \brief Change one parameter
+ * \param info The parameter description from params_find() or params_at()
+ * \param value The new value
+ * \return kStatus_Success, kStatus_OutOfRange if value is outside the parameter's range, or kStatus_InvalidArgument if the
+ *  touch thresholds would no longer be in increasing order
+ *
+ *  The new value is validated on a copy and then committed with a single structure copy with interrupts masked, so a
+ *  reader never sees a half-applied change. Blink timing is not paused; thresholds apply from the next touch scan and
+ *  durations from the next ON/OFF step
+ */
+status_t params_set(const param_info_t *info, uint32_t value);
+
+/**
+ * \fn status_t params_load
+ * \brief Replace the defaults with the parameter set saved by params_save(), if there is a valid one
+ * \param N/A
+ * \return kStatus_Success, kStatus_Settings_NotFound if nothing was saved, or kStatus_InvalidArgument if the saved
+ *  set does not match params_t or fails validation, in which case the defaults stay
+ *
+ *  Call after settings_init() and before init_onboard_touch_sensor(), which programs the saved scan count
+ */
+status_t params_load(void);
+
+/**
+ * \fn status_t params_save
+ * \brief Store the current parameter set in the settings store so params_load() restores it at the next boot
+ * \param N/A
+ * \return kStatus_Success or the settings store's error
+ */
+status_t params_save(void);
+
+#endif /* PARAMS_H_ */
@@ -0,0 +1,210 @@
+/**
+ * \file    pool.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for the fixed-size block pools
+ */
+
+#include "pool.h"
+#include "blackbox.h"
+
+/**
+ * \def POOL_HEADER_WORDS
+ *  Words in front of each block: the POOL_DEBUG tag
+ */
+#define POOL_HEADER_WORDS\
+	(POOL_DEBUG ? 1U : 0U)
+
+/**
+ * \def POOL_STRIDE_WORDS(size)
+ * \param size Bytes per block
+ *  Words each block takes in its pool, POOL_DEBUG tag and canary included
+ */
+#define POOL_STRIDE_WORDS(size)\
+	((((size) + 3U) / 4U) + (POOL_DEBUG ? 2U : 0U))
+
+/**
+ * \typedef pool_layout_t
+ *  Where the blocks of one pool are
+ */
+typedef struct {
+	uint32_t *blocks;		/* First word of the first block */
+	uint32_t stride;		/* Words per block, POOL_DEBUG words included */
+	uint32_t size;			/* Bytes per block */
+	uint32_t count;			/* Blocks in the pool */
+} pool_layout_t;
+
+/**
+ * \typedef pool_state_t
+ *  Free list and counters of one pool
+ */
+typedef struct {
+	uint32_t *free;			/* First free block, its first word being the next; NULL when the pool is empty */
+	uint32_t used;
+	uint32_t high_water;
+	uint32_t failures;
+	uint32_t errors;
+} pool_state_t;
+
+static uint32_t pool_event_blocks[POOL_STRIDE_WORDS(POOL_EVENT_SIZE) * POOL_EVENT_COUNT];
+static uint32_t pool_log_blocks[POOL_STRIDE_WORDS(POOL_LOG_SIZE) * POOL_LOG_COUNT];
+static uint32_t pool_transfer_blocks[POOL_STRIDE_WORDS(POOL_TRANSFER_SIZE) * POOL_TRANSFER_COUNT];
+
+/**
+ *  In pool_id_t order
+ */
+static const pool_layout_t pool_layouts[pool_count] = {
+	{pool_event_blocks, POOL_STRIDE_WORDS(POOL_EVENT_SIZE), POOL_EVENT_SIZE, POOL_EVENT_COUNT},
+	{pool_log_blocks, POOL_STRIDE_WORDS(POOL_LOG_SIZE), POOL_LOG_SIZE, POOL_LOG_COUNT},
+	{pool_transfer_blocks, POOL_STRIDE_WORDS(POOL_TRANSFER_SIZE), POOL_TRANSFER_SIZE, POOL_TRANSFER_COUNT},
+};
+
+static pool_state_t pool_states[pool_count];
+
+/**
+ * \fn static uint32_t pool_owner
+ * \brief Find the pool a pointer lies in
+ * \param word The pointer
+ * \return The pool, or pool_count if it is in none of them
+ */
+static uint32_t pool_owner(const uint32_t *word){
+	uint32_t pool;
+
+	for(pool = 0; pool < pool_count; pool++){
+		if((word >= pool_layouts[pool].blocks) &&
+				(word < &pool_layouts[pool].blocks[pool_layouts[pool].stride * pool_layouts[pool].count])){
+			break;
+		}
+	}
+
+	return pool;
+}
+
+/**
+ * \fn static void pool_error
+ * \brief Count a misuse of a pool and log it in the black box
+ * \param state The pool's state, or NULL if the pointer is in no pool
+ * \param code What went wrong
+ * \param block The pointer given to pool_free()
+ * \return N/A
+ */
+static void pool_error(pool_state_t *state, blackbox_fault_t code, const void *block){
+	if(state != NULL){
+		state->errors++;
+	}
+	blackbox_record(blackbox_fault, code, (uint32_t)block);
+}
+
+void pool_init(void){
+	const pool_layout_t *layout;
+	uint32_t *word;
+	uint32_t pool;
+	uint32_t i;
+
+	/**
+	 *  Linked from the last block down, so blocks are handed out in address order
+	 */
+	for(pool = 0; pool < pool_count; pool++){
+		layout = &pool_layouts[pool];
+		pool_states[pool].free = NULL;
+		for(i = layout->count; i > 0; i--){
+			word = &layout->blocks[(i - 1) * layout->stride];
+#if POOL_DEBUG
+			word[0] = POOL_TAG_FREE;
+			word[layout->stride - 1] = POOL_CANARY;
+#endif
+			word[POOL_HEADER_WORDS] = (uint32_t)pool_states[pool].free;
+			pool_states[pool].free = word;
+		}
+	}
+}
+
+void *pool_alloc(pool_id_t pool){
+	pool_state_t *state;
+	uint32_t *word;
+	uint32_t primask;
+
+	state = &pool_states[pool];
+	primask = DisableGlobalIRQ();
+	word = state->free;
+	if(word == NULL){
+		state->failures++;
+	}
+	else{
+		state->free = (uint32_t *)word[POOL_HEADER_WORDS];
+		state->used++;
+		if(state->used > state->high_water){
+			state->high_water = state->used;
+		}
+#if POOL_DEBUG
+		word[0] = POOL_TAG_USED;
+#endif
+	}
+	EnableGlobalIRQ(primask);
+
+	return (word != NULL) ? &word[POOL_HEADER_WORDS] : NULL;
+}
+
+void pool_free(void *block){
+	const pool_layout_t *layout;
+	pool_state_t *state;
+	uint32_t *word;
+	uint32_t pool;
+	uint32_t primask;
+
+	if(block == NULL){
+		return;
+	}
+
+	word = (uint32_t *)block - POOL_HEADER_WORDS;
+	pool = pool_owner(word);
+	if(pool == pool_count){
+		pool_error(NULL, blackbox_fault_pool_pointer, block);
+		return;
+	}
+	layout = &pool_layouts[pool];
+	state = &pool_states[pool];
+
+	primask = DisableGlobalIRQ();
+#if POOL_DEBUG
+	if((((uint32_t)(word - layout->blocks)) % layout->stride) != 0){
+		pool_error(state, blackbox_fault_pool_pointer, block);
+		EnableGlobalIRQ(primask);
+		return;
+	}
+	if(word[0] != POOL_TAG_USED){
+		pool_error(state, (word[0] == POOL_TAG_FREE) ? blackbox_fault_pool_double_free : blackbox_fault_pool_overrun,
+				block);
+		EnableGlobalIRQ(primask);
+		return;
+	}
+
+	/**
+	 *  The block is still the caller's to give back; only the canary needs putting right
+	 */
+	if(word[layout->stride - 1] != POOL_CANARY){
+		pool_error(state, blackbox_fault_pool_overrun, block);
+		word[layout->stride - 1] = POOL_CANARY;
+	}
+	word[0] = POOL_TAG_FREE;
+#else
+	(void)layout;
+#endif
+	word[POOL_HEADER_WORDS] = (uint32_t)state->free;
+	state->free = word;
+	state->used--;
+	EnableGlobalIRQ(primask);
+}
+
+void pool_get_stats(pool_id_t pool, pool_stats_t *stats){
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	stats->size = pool_layouts[pool].size;
+	stats->count = pool_layouts[pool].count;
+	stats->used = pool_states[pool].used;
+	stats->high_water = pool_states[pool].high_water;
+	stats->failures = pool_states[pool].failures;
+	stats->errors = pool_states[pool].errors;
+	EnableGlobalIRQ(primask);
+}
@@ -0,0 +1,162 @@
+/**
+ * \file    pool.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for the fixed-size block pools
+ *
+ *  Each pool is a static array of equal blocks threaded on a free list: pool_alloc() takes the head of the list and
+ *  pool_free() puts the block back, a handful of instructions either way however full the pool is, and a pool never
+ *  fragments. Use them instead of malloc() for anything created at run time (touch events, LED commands, log records,
+ *  UART transfer descriptors), so the heap stays empty. Sizes and counts are fixed here at compile time; a pool that
+ *  runs dry makes pool_alloc() return NULL and counts a failure, and the shell command "pool" shows the high-water
+ *  mark to size it by. The shell command "bench pool" times pool_alloc()/pool_free() against malloc()/free() in core
+ *  clock cycles, and tests/test_pool.c runs the same pattern on the host.
+ *
+ *  Both calls are safe from an interrupt. The Cortex-M0+ has no exclusive load and store to build a lock-free list
+ *  with, so each one masks interrupts for the few instructions that unlink or link a block.
+ *
+ *  With POOL_DEBUG each block carries a tag word in front and a canary word behind. pool_free() then catches a
+ *  double free, a pointer that is not a block, and a write past the end of the block; each is counted as an error,
+ *  logged in the black box, and the block is left alone rather than freed twice
+ */
+
+#ifndef POOL_H_
+#define POOL_H_
+
+#include "fsl_common.h"
+
+/**
+ * \def POOL_DEBUG
+ *  1 to check every free with tags and canaries. Defaults to 1 for the Debug configuration (-DDEBUG), 0 otherwise
+ */
+#ifndef POOL_DEBUG
+#ifdef DEBUG
+#define POOL_DEBUG\
+	(1)
+#else
+#define POOL_DEBUG\
+	(0)
+#endif
+#endif
+
+/**
+ * \def POOL_EVENT_SIZE
+ *  Bytes per block of pool_event: a touch event or an LED command
+ */
+#define POOL_EVENT_SIZE\
+	(16U)
+
+/**
+ * \def POOL_EVENT_COUNT
+ *  Blocks in pool_event
+ */
+#define POOL_EVENT_COUNT\
+	(16U)
+
+/**
+ * \def POOL_LOG_SIZE
+ *  Bytes per block of pool_log: one formatted log line or telemetry frame
+ */
+#define POOL_LOG_SIZE\
+	(64U)
+
+/**
+ * \def POOL_LOG_COUNT
+ *  Blocks in pool_log
+ */
+#define POOL_LOG_COUNT\
+	(4U)
+
+/**
+ * \def POOL_TRANSFER_SIZE
+ *  Bytes per block of pool_transfer: a UART transfer descriptor with its callback context
+ */
+#define POOL_TRANSFER_SIZE\
+	(32U)
+
+/**
+ * \def POOL_TRANSFER_COUNT
+ *  Blocks in pool_transfer
+ */
+#define POOL_TRANSFER_COUNT\
+	(8U)
+
+/**
+ * \def POOL_TAG_FREE
+ *  POOL_DEBUG tag of a block on the free list
+ */
+#define POOL_TAG_FREE\
+	(0xF4EEB10CUL)
+
+/**
+ * \def POOL_TAG_USED
+ *  POOL_DEBUG tag of an allocated block
+ */
+#define POOL_TAG_USED\
+	(0xA110CA7EUL)
+
+/**
+ * \def POOL_CANARY
+ *  POOL_DEBUG word right after each block; anything else there means the block was overrun
+ */
+#define POOL_CANARY\
+	(0xCA7A11E5UL)
+
+/**
+ * \typedef pool_id_t
+ *  The pools
+ */
+typedef enum {
+	pool_event = 0,
+	pool_log = 1,
+	pool_transfer = 2,
+	pool_count = 3
+} pool_id_t;
+
+/**
+ * \typedef pool_stats_t
+ *  Where one pool stands
+ */
+typedef struct {
+	uint32_t size;			/* Bytes per block */
+	uint32_t count;			/* Blocks in the pool */
+	uint32_t used;			/* Blocks allocated now */
+	uint32_t high_water;	/* Most blocks ever allocated at once */
+	uint32_t failures;		/* pool_alloc() calls that found the pool empty */
+	uint32_t errors;		/* POOL_DEBUG: double frees, overruns and bad pointers */
+} pool_stats_t;
+
+/**
+ * \fn void pool_init
+ * \brief Put every block of every pool on its free list. Call once at boot, before anything allocates
+ * \param N/A
+ * \return N/A
+ */
+void pool_init(void);
+
+/**
+ * \fn void *pool_alloc
+ * \brief Take a block from a pool. Safe to call from an interrupt
+ * \param pool The pool
+ * \return The block, 4-byte aligned and not cleared, or NULL if the pool is empty
+ */
+void *pool_alloc(pool_id_t pool);
+
+/**
+ * \fn void pool_free
+ * \brief Give a block back to the pool it came from. Safe to call from an interrupt
+ * \param block A block from pool_alloc(), or NULL to do nothing
+ * \return N/A
+ */
+void pool_free(void *block);
+
+/**
+ * \fn void pool_get_stats
+ * \brief Describe one pool
+ * \param pool The pool
+ * \param stats Where to store the description
+ * \return N/A
+ */
+void pool_get_stats(pool_id_t pool, pool_stats_t *stats);
+
+#endif /* POOL_H_ */
@@ -0,0 +1,280 @@
+/**
+ * \file    power.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for the idle power-mode manager over fsl_smc
+ */
+
+#include "MKL25Z4.h"
+#include "fsl_smc.h"
+#include "power.h"
+#include "clocks.h"
+#include "sections.h"
+
+/**
+ * \def POWER_TIMER_FREE_RUN
+ *  LPTMR compare value while the main loop runs: the longest period, so the counter measures time in RUN
+ */
+#define POWER_TIMER_FREE_RUN\
+	(0xFFFFU)
+
+/**
+ * \def POWER_UAMS_PER_UAH
+ *  micro amp msec in a micro amp hour
+ */
+#define POWER_UAMS_PER_UAH\
+	(3600000ULL)
+
+/**
+ *  Typical supply current per mode in micro amps, KL25 datasheet at 3 V, 25 C: RUN and WAIT at 48 MHz core and 24 MHz
+ *  bus from flash, STOP, VLPS and LLS with the LPO running
+ */
+static const uint32_t power_current_ua[power_mode_count] = {6400, 3700, 306, 4, 2};
+
+/**
+ *  The same in VLPR at 4 MHz core and 800 kHz bus: only RUN and WAIT (VLPW) change
+ */
+static const uint32_t power_current_vlpr_ua[power_mode_count] = {188, 112, 306, 4, 2};
+
+/**
+ *  Constraints taken per mode
+ */
+static volatile uint8_t power_constraints[power_mode_count];
+
+/**
+ *  Set by the LPTMR or LLWU interrupt when the time given to power_idle() is up
+ */
+static volatile bool power_expired;
+
+static power_stats_t power_stats;
+static uint64_t power_charge_uams;
+
+void power_constrain(power_mode_t deepest){
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	power_constraints[deepest]++;
+	EnableGlobalIRQ(primask);
+}
+
+void power_release(power_mode_t deepest){
+	uint32_t primask;
+
+	primask = DisableGlobalIRQ();
+	if(power_constraints[deepest] != 0){
+		power_constraints[deepest]--;
+	}
+	EnableGlobalIRQ(primask);
+}
+
+power_mode_t power_allowed(void){
+	uint32_t mode;
+
+	for(mode = power_run; mode < POWER_DEEPEST_MODE; mode++){
+		if(power_constraints[mode] != 0){
+			return (power_mode_t)mode;
+		}
+	}
+
+	return POWER_DEEPEST_MODE;
+}
+
+/**
+ * \fn static uint32_t power_timer
+ * \brief Read the LPTMR counter; writing CNR latches it
+ * \param N/A
+ * \return msec since the counter last started
+ */
+static uint32_t power_timer(void){
+	LPTMR0->CNR = 0;
+
+	return LPTMR0->CNR & LPTMR_CNR_COUNTER_MASK;
+}
+
+/**
+ * \fn static void power_timer_start
+ * \brief Restart the LPTMR from 0
+ * \param compare Compare value; the period is compare + 1 msec
+ * \param interrupt Whether the compare match interrupts
+ * \return N/A
+ */
+static void power_timer_start(uint32_t compare, bool interrupt){
+	LPTMR0->CSR = 0;
+	LPTMR0->CMR = compare;
+	LPTMR0->CSR = LPTMR_CSR_TEN_MASK | (interrupt ? LPTMR_CSR_TIE_MASK : 0);
+}
+
+/**
+ * \fn static void power_account
+ * \brief Add time to a mode's residency and charge
+ * \param mode The mode
+ * \param ms Time spent in it
+ * \return N/A
+ */
+static void power_account(power_mode_t mode, uint32_t ms){
+	const uint32_t *current_ua;
+
+	current_ua = (clocks_get_profile() == clocks_vlpr) ? power_current_vlpr_ua : power_current_ua;
+	power_stats.residency_ms[mode] += ms;
+	power_charge_uams += (uint64_t)current_ua[mode] * ms;
+}
+
+/**
+ * \fn static void power_restore_clocks
+ * \brief A stop mode turns the PLL off and leaves the MCG in PBE; wait for the PLL to lock again and go back to PEE
+ * \param N/A
+ * \return N/A
+ */
+static void power_restore_clocks(void){
+	if(((MCG->S & MCG_S_CLKST_MASK) == MCG_S_CLKST(2)) && (MCG->C6 & MCG_C6_PLLS_MASK)){
+		while(!(MCG->S & MCG_S_LOCK0_MASK)){
+		}
+		MCG->C1 &= ~MCG_C1_CLKS_MASK;
+		while((MCG->S & MCG_S_CLKST_MASK) != MCG_S_CLKST(3)){
+		}
+	}
+}
+
+/**
+ * \fn static void power_enter
+ * \brief Enter a low power mode once, with the SMC driver's entry and exit hooks, and return after the wake-up
+ *  interrupt has been serviced
+ * \param mode power_wait or deeper
+ * \return N/A
+ */
+static void power_enter(power_mode_t mode){
+	status_t status;
+
+	/**
+	 *  Normal stop cannot be entered from VLPR; staying in WAIT (VLPW) keeps to the constraint
+	 */
+	if((mode == power_stop) && (clocks_get_profile() == clocks_vlpr)){
+		mode = power_wait;
+	}
+
+	/**
+	 *  power_idle() tested power_expired with interrupts enabled. Once the entry hook has masked them it is tested
+	 *  again: a compare match in between would otherwise leave WFI waiting a whole extra period for the next one
+	 */
+	if(mode == power_wait){
+		SMC_PreEnterWaitModes();
+		if(!power_expired){
+			power_stats.entries[mode]++;
+			(void)SMC_SetPowerModeWait(SMC);
+		}
+		SMC_PostExitWaitModes();
+		return;
+	}
+
+	/**
+	 *  Interrupts stay masked until the clocks are back, so handlers never run from the 4 MHz PBE fallback
+	 */
+	SMC_PreEnterStopModes();
+	if(power_expired){
+		status = kStatus_Success;
+	}
+	else if(mode == power_stop){
+		power_stats.entries[mode]++;
+		status = SMC_SetPowerModeStop(SMC, kSMC_PartialStop);
+	}
+	else if(mode == power_vlps){
+		power_stats.entries[mode]++;
+		status = SMC_SetPowerModeVlps(SMC);
+	}
+	else{
+		power_stats.entries[mode]++;
+		status = SMC_SetPowerModeLls(SMC);
+	}
+	power_restore_clocks();
+	SMC_PostExitStopModes();
+
+	if(status == kStatus_SMC_StopAbort){
+		power_stats.aborted++;
+	}
+}
+
+void power_init(void){
+
+	/**
+	 *  PMPROT is write-once after reset
+	 */
+	SMC_SetPowerModeProtection(SMC, kSMC_AllowPowerModeAll);
+
+	SIM->SCGC5 |= SIM_SCGC5_LPTMR_MASK;
+	LPTMR0->CSR = 0;
+	LPTMR0->PSR = LPTMR_PSR_PCS(1) | LPTMR_PSR_PBYP_MASK;
+	power_timer_start(POWER_TIMER_FREE_RUN, false);
+
+	/**
+	 *  The LPTMR is LLWU internal module 0, the only way out of LLS here
+	 */
+	LLWU->ME |= LLWU_ME_WUME0_MASK;
+	NVIC_EnableIRQ(LPTMR0_IRQn);
+	NVIC_EnableIRQ(LLWU_IRQn);
+}
+
+void power_idle(uint32_t ms){
+	power_mode_t mode;
+	uint32_t mark;
+	uint32_t now;
+
+	if(ms == 0){
+		return;
+	}
+	if(ms > (POWER_TIMER_FREE_RUN + 1U)){
+		ms = POWER_TIMER_FREE_RUN + 1U;
+	}
+
+	power_account(power_run, power_timer());
+	power_expired = false;
+	power_timer_start(ms - 1U, true);
+
+	/**
+	 *  Each early wake-up may have changed the constraints, so pick the mode again every time
+	 */
+	mark = 0;
+	do{
+		mode = power_allowed();
+		if(mode != power_run){
+			power_enter(mode);
+			power_stats.entries[power_run]++;
+		}
+		now = power_expired ? ms : power_timer();
+		power_account(mode, now - mark);
+		mark = now;
+	} while(!power_expired);
+
+	power_timer_start(POWER_TIMER_FREE_RUN, false);
+}
+
+void power_get_stats(power_stats_t *stats){
+	*stats = power_stats;
+	stats->charge_uah = (uint32_t)(power_charge_uams / POWER_UAMS_PER_UAH);
+	stats->allowed = power_allowed();
+}
+
+/**
+ * \fn void LPTMR0_IRQHandler
+ * \brief The time given to power_idle() is up. Every tick wakes up through here, so it runs from SRAM, and takes the
+ *  vector itself so the startup file's LPTMR0_IRQHandler (in flash) is not called on the way
+ * \param N/A
+ * \return N/A
+ */
+RAMFUNC void LPTMR0_IRQHandler(void){
+	LPTMR0->CSR |= LPTMR_CSR_TCF_MASK;
+	power_expired = true;
+}
+
+/**
+ * \fn void LLWU_DriverIRQHandler
+ * \brief Wake-up from LLS. The LPTMR flag is the LLWU flag for that module, so clear it here or this interrupt
+ *  would keep coming back before the LPTMR one can run
+ * \param N/A
+ * \return N/A
+ */
+void LLWU_DriverIRQHandler(void){
+	if(LLWU->F3 & LLWU_F3_MWUF0_MASK){
+		LPTMR0->CSR |= LPTMR_CSR_TCF_MASK;
+		power_expired = true;
+	}
+}
@@ -0,0 +1,110 @@
+/**
+ * \file    power.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for the idle power-mode manager over fsl_smc
+ *
+ *  Code that needs the clocks or the CPU to keep running while the main loop idles holds a constraint: the deepest
+ *  mode it can live with, taken with power_constrain() and given back with power_release(). power_idle() replaces the
+ *  busy-wait delay of the main loop: it sleeps for the requested time in the deepest mode every constraint allows,
+ *  with the LPTMR (1 kHz LPO, running in every mode up to LLS) as the wake-up timer and time base, and it enters that
+ *  mode again after each interrupt that wakes it early, re-reading the constraints each time.
+ *
+ *  Constraints held by Blinkenlights:
+ *  	serial port open for reception	power_wait	UART0 runs from the PLL, which stops in every stop mode
+ *  	serial send in progress			power_wait	Same, for the transmitter
+ *  	flash_async operation queued	power_wait	An FTFA command must not meet a stop mode
+ *  Since the console always listens, Blinkenlights idles in WAIT; the stop modes are taken once nothing holds one.
+ *
+ *  Residency is counted per mode in msec from the LPTMR, RUN being the time outside power_idle(), and multiplied by
+ *  the typical supply current of the mode from the KL25 datasheet (3 V, 25 C, 48 MHz core, or 4 MHz in the VLPR
+ *  profile of clocks.h) for an estimate of the charge drawn. Time is charged at the profile running when it is
+ *  accounted, so a switch in the middle of a period is rounded to one side. The estimate leaves out the LEDs and whatever the board draws besides the MCU
+ */
+
+#ifndef POWER_H_
+#define POWER_H_
+
+#include "fsl_common.h"
+
+/**
+ * \def POWER_DEEPEST_MODE
+ *  Deepest mode power_idle() takes even when nothing is constrained. VLLS modes wake through reset and are never used
+ */
+#define POWER_DEEPEST_MODE\
+	(power_lls)
+
+/**
+ * \typedef power_mode_t
+ *  Modes from the shallowest to the deepest
+ */
+typedef enum {
+	power_run = 0,	/* Core running */
+	power_wait = 1,	/* Core clock gated, peripherals running */
+	power_stop = 2,	/* Normal stop: all clocks but the LPO off, register and RAM contents kept */
+	power_vlps = 3,	/* Very low power stop: like stop with the voltage regulator in standby */
+	power_lls = 4,	/* Low leakage stop: most peripherals powered down, wake-up only through the LLWU */
+	power_mode_count
+} power_mode_t;
+
+/**
+ * \typedef power_stats_t
+ *  Counters since power_init()
+ */
+typedef struct {
+	uint32_t residency_ms[power_mode_count];	/* Time spent in each mode */
+	uint32_t entries[power_mode_count];			/* Times each mode was entered (RUN: wake-ups) */
+	uint32_t charge_uah;						/* Estimated charge drawn, micro amp hours */
+	uint32_t aborted;							/* Stop mode entries the SMC aborted */
+	power_mode_t allowed;						/* Deepest mode the current constraints allow */
+} power_stats_t;
+
+/**
+ * \fn void power_init
+ * \brief Allow every power mode, start the LPTMR as the time base and enable its wake-up through the LLWU
+ * \param N/A
+ * \return N/A
+ */
+void power_init(void);
+
+/**
+ * \fn void power_constrain
+ * \brief Take a constraint. Safe from interrupts
+ * \param deepest The deepest mode the caller can live with until power_release()
+ * \return N/A
+ */
+void power_constrain(power_mode_t deepest);
+
+/**
+ * \fn void power_release
+ * \brief Give back a constraint taken with power_constrain(). Safe from interrupts
+ * \param deepest The mode passed to power_constrain()
+ * \return N/A
+ */
+void power_release(power_mode_t deepest);
+
+/**
+ * \fn power_mode_t power_allowed
+ * \brief Arbitrate the constraints
+ * \param N/A
+ * \return The shallowest mode any constraint asks for, or POWER_DEEPEST_MODE if there are none
+ */
+power_mode_t power_allowed(void);
+
+/**
+ * \fn void power_idle
+ * \brief Sleep in the deepest allowed mode until ms msec have passed. Interrupts are serviced as they come
+ * \param ms The time, 1 to 65536 msec
+ * \return N/A
+ */
+void power_idle(uint32_t ms);
+
+/**
+ * \fn void power_get_stats
+ * \brief Get the residency and charge counters
+ * \param stats Where to store them
+ * \return N/A
+ */
+void power_get_stats(power_stats_t *stats);
+
+#endif /* POWER_H_ */
@@ -0,0 +1,35 @@
+/**
+ * \file    sections.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros for placing variables and functions in the special sections of the linker scripts
+ *
+ *  .noinit is the first section in SRAM and is neither copied nor zeroed by ResetISR, so what is stored there
+ *  survives a warm reset (reset pin, watchdog, software reset, lockup) and is garbage after a power-on. Anything kept
+ *  there must carry its own check. The section holds at most 512 bytes: the window the bootloader leaves alone
+ *
+ *  .ramfunc sits right after it, at the bottom of SRAM_L, and ResetISR copies it from flash along with .data. Code
+ *  there runs without flash wait states (one at 48 MHz), and keeps running while the flash is busy programming. It
+ *  costs its size twice, in flash and in SRAM; "make -C Debug ramfunc-report" lists what is there. SRAM is out of
+ *  BL range of flash both ways: calls into a RAMFUNC are long calls, and calls from one back to flash go through
+ *  veneers the linker adds, so keep them off the hot path
+ */
+
+#ifndef SECTIONS_H_
+#define SECTIONS_H_
+
+/**
+ * \def NOINIT
+ *  Place a variable in .noinit. Give it no initializer
+ */
+#define NOINIT\
+	__attribute__((section(".noinit")))
+
+/**
+ * \def RAMFUNC
+ *  Place a function in .ramfunc. noinline, or an inlined copy would run from flash
+ */
+#define RAMFUNC\
+	__attribute__((section(".ramfunc"), noinline, long_call))
+
+#endif /* SECTIONS_H_ */
@@ -68,16 +68,46 @@ void HardFault_Handler(void){
             "B  _process      \n"
             "_MSP:  \n"
             "MRS    R0, MSP \n"
-        // Load the instruction that triggered hard fault
+        // A frame outside SRAM, or a stacked PC that is odd or outside
+        // flash and SRAM, would make the loads below fault again in
+        // here and lock up the core: save the record straight away
         "_process:     \n"
+            "LDR    R2,=__base_SRAM \n"
+            "CMP    R0,R2 \n"
+            "BLO    _capture \n"
+            "LDR    R2,=_vStackTop - 32 \n"
+            "CMP    R0,R2 \n"
+            "BHI    _capture \n"
             "LDR    R1,[R0,#24] \n"
+            "MOVS   R2,#1 \n"
+            "TST    R1,R2 \n"
+            "BNE    _capture \n"
+            "LDR    R2,=__base_PROGRAM_FLASH \n"
+            "CMP    R1,R2 \n"
+            "BLO    _capture \n"
+            "LDR    R2,=__top_PROGRAM_FLASH \n"
+            "CMP    R1,R2 \n"
+            "BLO    _fetch \n"
+            "LDR    R2,=__base_SRAM \n"
+            "CMP    R1,R2 \n"
+            "BLO    _capture \n"
+            "LDR    R2,=__top_SRAM - 2 \n"
+            "CMP    R1,R2 \n"
+            "BHI    _capture \n"
+        // Load the instruction that triggered hard fault
+        "_fetch:     \n"
             "LDRH    R2,[r1] \n"
         // Semihosting instruction is "BKPT 0xAB" (0xBEAB)
             "LDR    R3,=0xBEAB \n"
             "CMP     R2,R3 \n"
             "BEQ    _semihost_return \n"
-        // Wasn't semihosting instruction so enter infinite loop
-            "B . \n"
+        // Wasn't semihosting instruction so save a post-mortem record
+        // and reset (source/fault.h), with the frame in R0 and
+        // EXC_RETURN in R1. Through a register: B only reaches 2KB
+        "_capture:     \n"
+            "MOV    R1, LR \n"
+            "LDR    R2,=fault_capture \n"
+            "BX     R2 \n"
         // Was semihosting instruction, so adjust location to
         // return to by 1 instruction (2 bytes), then exit function
         "_semihost_return: \n"
@@ -0,0 +1,454 @@
+/**
+ * \file    serial.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for the byte-stream interface over UART0 (LPSCI) and UART1/UART2
+ */
+
+#include "board.h"
+#include "fsl_lpsci.h"
+#include "fsl_uart.h"
+#include "fsl_port.h"
+#include "serial.h"
+#include "power.h"
+#include "clocks.h"
+
+/**
+ * \def SERIAL_UART_ENABLE
+ *  Whether any port needs the UART driver
+ */
+#define SERIAL_UART_ENABLE\
+	(SERIAL_PORT1_ENABLE || SERIAL_PORT2_ENABLE)
+
+/**
+ * \def SERIAL_PORT_ENABLED(port)
+ * \param port The port
+ *  Whether a port is compiled in
+ */
+#define SERIAL_PORT_ENABLED(port)\
+	(((port) == serial_port0) || (((port) == serial_port1) && SERIAL_PORT1_ENABLE) ||\
+	(((port) == serial_port2) && SERIAL_PORT2_ENABLE))
+
+/**
+ * \def SERIAL_LPSCI
+ *  UART0, the only LPSCI instance
+ */
+#define SERIAL_LPSCI\
+	((UART0_Type *)BOARD_DEBUG_UART_BASEADDR)
+
+/**
+ * \def SERIAL_UART(port)
+ * \param port serial_port1 or serial_port2
+ *  The UART instance behind a port
+ */
+#define SERIAL_UART(port)\
+	(((port) == serial_port1) ? UART1 : UART2)
+
+/**
+ * \typedef serial_state_t
+ *  Bookkeeping for one port
+ */
+typedef struct {
+	bool open;
+	serial_rx_mode_t rx_mode;
+	serial_frame_callback_t frame_callback;
+	volatile uint32_t tx_bytes;
+	volatile uint32_t rx_bytes;
+	volatile uint32_t rx_overruns;
+	bool rx_held;			/* Holds a power_wait constraint while receiving */
+	volatile bool tx_held;	/* Holds a power_wait constraint while a serial_write() send is in progress */
+} serial_state_t;
+
+static serial_state_t serial_state[SERIAL_PORT_COUNT];
+static bool serial_notifier_registered;
+
+/**
+ *  Driver handles. UART handles are indexed by port, so serial_uart_handle[0] is unused
+ */
+static lpsci_handle_t serial_lpsci_handle;
+#if SERIAL_UART_ENABLE
+static uart_handle_t serial_uart_handle[SERIAL_PORT_COUNT];
+#endif
+
+/**
+ * \fn static void serial_count_status
+ * \brief Update the counters from a driver callback status, and give back the send's power constraint once it is done
+ * \param state The port's bookkeeping
+ * \param status The LPSCI or UART callback status
+ * \return N/A
+ */
+static void serial_count_status(serial_state_t *state, status_t status){
+	if(((status == kStatus_LPSCI_TxIdle)
+#if SERIAL_UART_ENABLE
+			|| (status == kStatus_UART_TxIdle)
+#endif
+			) && state->tx_held){
+		state->tx_held = false;
+		power_release(power_wait);
+	}
+	if((status == kStatus_LPSCI_RxRingBufferOverrun) || (status == kStatus_LPSCI_RxHardwareOverrun)
+#if SERIAL_UART_ENABLE
+			|| (status == kStatus_UART_RxRingBufferOverrun) || (status == kStatus_UART_RxHardwareOverrun)
+#endif
+			){
+		state->rx_overruns++;
+	}
+}
+
+/**
+ * \fn static void serial_lpsci_callback
+ * \brief LPSCI driver callback, runs in the UART0 interrupt
+ * \param base LPSCI peripheral base address
+ * \param handle LPSCI handle pointer
+ * \param status Reason for the callback
+ * \param user_data Unused
+ * \return N/A
+ */
+static void serial_lpsci_callback(UART0_Type *base, lpsci_handle_t *handle, status_t status, void *user_data){
+	serial_count_status(&serial_state[serial_port0], status);
+}
+
+/**
+ * \fn static void serial_lpsci_frame_callback
+ * \brief LPSCI DMA frame callback, runs in the UART0 interrupt
+ * \param base LPSCI peripheral base address
+ * \param handle LPSCI handle pointer
+ * \param frame The frame segments
+ * \param count Amount of segments
+ * \param user_data Unused
+ * \return N/A
+ */
+static void serial_lpsci_frame_callback(UART0_Type *base, lpsci_handle_t *handle, const lpsci_segment_t *frame,
+		size_t count, void *user_data){
+	serial_segment_t segments[2];
+	size_t i;
+
+	for(i = 0; i < count; i++){
+		segments[i].data = frame[i].data;
+		segments[i].length = frame[i].dataSize;
+		serial_state[serial_port0].rx_bytes += frame[i].dataSize;
+	}
+
+	serial_state[serial_port0].frame_callback(serial_port0, segments, count);
+}
+
+#if SERIAL_UART_ENABLE
+/**
+ * \fn static void serial_uart_callback
+ * \brief UART driver callback, runs in the UART1 or UART2 interrupt
+ * \param base UART peripheral base address
+ * \param handle UART handle pointer
+ * \param status Reason for the callback
+ * \param user_data The port's bookkeeping
+ * \return N/A
+ */
+static void serial_uart_callback(UART_Type *base, uart_handle_t *handle, status_t status, void *user_data){
+	serial_count_status((serial_state_t *)user_data, status);
+}
+
+/**
+ * \fn static status_t serial_open_uart
+ * \brief Route the pins and set up UART1 or UART2
+ * \param port serial_port1 or serial_port2
+ * \param config The settings
+ * \return kStatus_Success or the UART driver's error
+ */
+static status_t serial_open_uart(serial_port_t port, const serial_config_t *config){
+	uart_config_t uart_config;
+	status_t status;
+
+	if(port == serial_port1){
+		CLOCK_EnableClock(kCLOCK_PortE);
+		PORT_SetPinMux(PORTE, 0U, kPORT_MuxAlt3);
+		PORT_SetPinMux(PORTE, 1U, kPORT_MuxAlt3);
+	}
+	else{
+		CLOCK_EnableClock(kCLOCK_PortD);
+		PORT_SetPinMux(PORTD, 3U, kPORT_MuxAlt3);
+		PORT_SetPinMux(PORTD, 2U, kPORT_MuxAlt3);
+	}
+
+	UART_GetDefaultConfig(&uart_config);
+	uart_config.baudRate_Bps = config->baud_rate;
+	uart_config.enableTx = true;
+	uart_config.enableRx = (config->rx_mode != serial_rx_none);
+	status = UART_Init(SERIAL_UART(port), &uart_config, CLOCK_GetBusClkFreq());
+	if(status != kStatus_Success){
+		return status;
+	}
+
+	UART_TransferCreateHandle(SERIAL_UART(port), &serial_uart_handle[port], serial_uart_callback, &serial_state[port]);
+	if(config->rx_mode == serial_rx_ring){
+		UART_TransferStartRingBuffer(SERIAL_UART(port), &serial_uart_handle[port], config->rx_buffer,
+				config->rx_buffer_size);
+	}
+
+	return kStatus_Success;
+}
+#endif
+
+/**
+ * \fn static status_t serial_clock_notifier
+ * \brief Let sends in progress finish before the clocks change. UART1 and UART2 run from the bus clock, which is
+ *  800 kHz in VLPR, so an open one refuses VLPR. The console retimes UART0 itself
+ * \param event clocks_before or clocks_after
+ * \param from The profile running before
+ * \param to The profile running after
+ * \return kStatus_Success, or kStatus_UART_BaudrateNotSupport to refuse VLPR
+ */
+static status_t serial_clock_notifier(clocks_event_t event, clocks_profile_t from, clocks_profile_t to){
+	uint32_t port;
+
+	if(event != clocks_before){
+		return kStatus_Success;
+	}
+
+	for(port = 0; port < SERIAL_PORT_COUNT; port++){
+		if((port != serial_port0) && (to == clocks_vlpr) && serial_is_open((serial_port_t)port)){
+			return kStatus_UART_BaudrateNotSupport;
+		}
+	}
+	for(port = 0; port < SERIAL_PORT_COUNT; port++){
+		while(serial_tx_busy((serial_port_t)port)){
+		}
+	}
+
+	return kStatus_Success;
+}
+
+status_t serial_open(serial_port_t port, const serial_config_t *config){
+	serial_state_t *state;
+	status_t status;
+
+	if(!SERIAL_PORT_ENABLED(port) || ((config->rx_mode != serial_rx_none) && (config->rx_buffer == NULL))){
+		return kStatus_InvalidArgument;
+	}
+
+	state = &serial_state[port];
+	if(!serial_notifier_registered){
+		serial_notifier_registered = (clocks_register(serial_clock_notifier) == kStatus_Success);
+	}
+
+	state->open = false;
+	state->rx_mode = config->rx_mode;
+	state->frame_callback = config->frame_callback;
+	state->tx_bytes = 0;
+	state->rx_bytes = 0;
+	state->rx_overruns = 0;
+
+	if(port == serial_port0){
+		if(config->baud_rate != 0){
+			status = LPSCI_SetBaudRate(SERIAL_LPSCI, config->baud_rate, clocks_get_uart0_freq(clocks_get_profile()));
+			if(status != kStatus_Success){
+				return status;
+			}
+		}
+
+		LPSCI_TransferCreateHandle(SERIAL_LPSCI, &serial_lpsci_handle, serial_lpsci_callback, NULL);
+		if(config->rx_mode == serial_rx_ring){
+			LPSCI_TransferStartRingBuffer(SERIAL_LPSCI, &serial_lpsci_handle, config->rx_buffer,
+					config->rx_buffer_size);
+		}
+		else if(config->rx_mode == serial_rx_dma){
+			if(config->frame_callback == NULL){
+				return kStatus_InvalidArgument;
+			}
+			status = LPSCI_TransferStartRxDma(SERIAL_LPSCI, &serial_lpsci_handle, config->rx_buffer,
+					config->rx_buffer_size, config->dma_channel, serial_lpsci_frame_callback);
+			if(status != kStatus_Success){
+				return status;
+			}
+		}
+	}
+#if SERIAL_UART_ENABLE
+	else{
+		/**
+		 *  The UART driver has no DMA receive mode yet
+		 */
+		if((config->rx_mode == serial_rx_dma) || (config->baud_rate == 0)){
+			return kStatus_InvalidArgument;
+		}
+		status = serial_open_uart(port, config);
+		if(status != kStatus_Success){
+			return status;
+		}
+	}
+#endif
+
+	/**
+	 *  The receiver has to keep its clock for as long as the port is open
+	 */
+	if((config->rx_mode != serial_rx_none) && !state->rx_held){
+		state->rx_held = true;
+		power_constrain(power_wait);
+	}
+	state->open = true;
+
+	return kStatus_Success;
+}
+
+bool serial_is_open(serial_port_t port){
+	return SERIAL_PORT_ENABLED(port) && serial_state[port].open;
+}
+
+status_t serial_write(serial_port_t port, const uint8_t *data, size_t length){
+	uint32_t primask;
+	status_t status;
+
+	if(!serial_is_open(port)){
+		return kStatus_InvalidArgument;
+	}
+
+	/**
+	 *  Taken before the send starts, since a short one can finish before the driver returns
+	 */
+	primask = DisableGlobalIRQ();
+	if(!serial_state[port].tx_held){
+		serial_state[port].tx_held = true;
+		power_constrain(power_wait);
+	}
+	EnableGlobalIRQ(primask);
+
+	if(port == serial_port0){
+		lpsci_transfer_t xfer;
+
+		xfer.data = (uint8_t *)data;
+		xfer.dataSize = length;
+		status = LPSCI_TransferSendNonBlocking(SERIAL_LPSCI, &serial_lpsci_handle, &xfer);
+	}
+#if SERIAL_UART_ENABLE
+	else{
+		uart_transfer_t xfer;
+
+		xfer.data = (uint8_t *)data;
+		xfer.dataSize = length;
+		status = UART_TransferSendNonBlocking(SERIAL_UART(port), &serial_uart_handle[port], &xfer);
+	}
+#else
+	else{
+		status = kStatus_InvalidArgument;
+	}
+#endif
+
+	if(status == kStatus_Success){
+		serial_state[port].tx_bytes += length;
+	}
+	else{
+		primask = DisableGlobalIRQ();
+		if(!serial_tx_busy(port) && serial_state[port].tx_held){
+			serial_state[port].tx_held = false;
+			power_release(power_wait);
+		}
+		EnableGlobalIRQ(primask);
+	}
+
+	return status;
+}
+
+void serial_write_blocking(serial_port_t port, const uint8_t *data, size_t length){
+	if(!serial_is_open(port)){
+		return;
+	}
+
+	while(serial_tx_busy(port)){
+	}
+
+	if(port == serial_port0){
+		LPSCI_WriteBlocking(SERIAL_LPSCI, data, length);
+	}
+#if SERIAL_UART_ENABLE
+	else{
+		UART_WriteBlocking(SERIAL_UART(port), data, length);
+	}
+#endif
+
+	serial_state[port].tx_bytes += length;
+}
+
+bool serial_tx_busy(serial_port_t port){
+	uint32_t count;
+
+	if(!serial_is_open(port)){
+		return false;
+	}
+
+	/**
+	 *  The drivers only report a send count while a send is in progress
+	 */
+	if(port == serial_port0){
+		return LPSCI_TransferGetSendCount(SERIAL_LPSCI, &serial_lpsci_handle, &count) == kStatus_Success;
+	}
+#if SERIAL_UART_ENABLE
+	return UART_TransferGetSendCount(SERIAL_UART(port), &serial_uart_handle[port], &count) == kStatus_Success;
+#else
+	return false;
+#endif
+}
+
+size_t serial_rx_available(serial_port_t port){
+	if(!serial_is_open(port) || (serial_state[port].rx_mode != serial_rx_ring)){
+		return 0;
+	}
+
+	if(port == serial_port0){
+		return LPSCI_TransferGetRxRingBufferLength(&serial_lpsci_handle);
+	}
+#if SERIAL_UART_ENABLE
+	return UART_TransferGetRxRingBufferLength(&serial_uart_handle[port]);
+#else
+	return 0;
+#endif
+}
+
+size_t serial_read(serial_port_t port, uint8_t *data, size_t length){
+	size_t received;
+
+	/**
+	 *  Only ask for what is already in the ring, so the driver never queues a pending receive
+	 */
+	length = MIN(length, serial_rx_available(port));
+	if(length == 0){
+		return 0;
+	}
+
+	received = 0;
+	if(port == serial_port0){
+		lpsci_transfer_t xfer;
+
+		xfer.data = data;
+		xfer.dataSize = length;
+		LPSCI_TransferReceiveNonBlocking(SERIAL_LPSCI, &serial_lpsci_handle, &xfer, &received);
+	}
+#if SERIAL_UART_ENABLE
+	else{
+		uart_transfer_t xfer;
+
+		xfer.data = data;
+		xfer.dataSize = length;
+		UART_TransferReceiveNonBlocking(SERIAL_UART(port), &serial_uart_handle[port], &xfer, &received);
+	}
+#endif
+
+	serial_state[port].rx_bytes += received;
+
+	return received;
+}
+
+void serial_get_stats(serial_port_t port, serial_stats_t *stats){
+	memset(stats, 0, sizeof(*stats));
+	if(!serial_is_open(port)){
+		return;
+	}
+
+	stats->tx_bytes = serial_state[port].tx_bytes;
+	stats->rx_bytes = serial_state[port].rx_bytes;
+	stats->rx_overruns = serial_state[port].rx_overruns;
+	if(port == serial_port0){
+		stats->irqs = serial_lpsci_handle.irqCount;
+	}
+#if SERIAL_UART_ENABLE
+	else{
+		stats->irqs = serial_uart_handle[port].irqCount;
+	}
+#endif
+}
@@ -0,0 +1,179 @@
+/**
+ * \file    serial.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for the byte-stream interface over UART0 (LPSCI) and UART1/UART2
+ *
+ *  Every function takes a serial_port_t and dispatches on it directly to the LPSCI or UART driver, so there is no
+ *  function pointer table. UART1 and UART2 are only compiled in when SERIAL_PORT1_ENABLE or SERIAL_PORT2_ENABLE is
+ *  set. UART0 is always present since the debug console runs on it
+ *
+ *  Only UART0 can receive by DMA (serial_rx_dma): the idle-line DMA path lives in the LPSCI driver, and fsl_uart.c has
+ *  no DMA receive mode. UART1 and UART2 receive with serial_rx_ring, one interrupt per byte, and serial_open() rejects
+ *  serial_rx_dma on them with kStatus_InvalidArgument
+ */
+
+#ifndef SERIAL_H_
+#define SERIAL_H_
+
+#include "fsl_common.h"
+
+/**
+ * \def SERIAL_PORT1_ENABLE
+ *  Set to 1 to compile in UART1 on PTE0 (TX) and PTE1 (RX)
+ */
+#ifndef SERIAL_PORT1_ENABLE
+#define SERIAL_PORT1_ENABLE\
+	(0)
+#endif
+
+/**
+ * \def SERIAL_PORT2_ENABLE
+ *  Set to 1 to compile in UART2 on PTD3 (TX) and PTD2 (RX)
+ */
+#ifndef SERIAL_PORT2_ENABLE
+#define SERIAL_PORT2_ENABLE\
+	(0)
+#endif
+
+/**
+ * \typedef serial_port_t
+ *  The serial ports, numbered like the UART instances
+ */
+typedef enum {
+	serial_port0,	/* UART0 (LPSCI), shared with the debug console. serial_rx_ring or serial_rx_dma */
+	serial_port1,	/* UART1. serial_rx_ring only, no DMA receive */
+	serial_port2	/* UART2. serial_rx_ring only, no DMA receive */
+} serial_port_t;
+
+/**
+ * \def SERIAL_PORT_COUNT
+ *  Number of serial_port_t values
+ */
+#define SERIAL_PORT_COUNT\
+	(3)
+
+/**
+ * \typedef serial_rx_mode_t
+ *  How a port receives
+ */
+typedef enum {
+	serial_rx_none,	/* Transmit only */
+	serial_rx_ring,	/* The RX interrupt fills rx_buffer as a ring, read with serial_read() */
+	serial_rx_dma	/* DMA fills rx_buffer and every idle-line delimited frame goes to frame_callback. UART0 only */
+} serial_rx_mode_t;
+
+/**
+ * \typedef serial_segment_t
+ *  A piece of a received frame, pointing into the port's rx_buffer
+ */
+typedef struct {
+	const uint8_t *data;
+	size_t length;
+} serial_segment_t;
+
+/**
+ * \typedef serial_frame_callback_t
+ *  Called from the port's interrupt with a frame received by DMA, as one segment or two if it wraps around the end
+ *  of rx_buffer. The segments are only valid until the callback returns
+ */
+typedef void (*serial_frame_callback_t)(serial_port_t port, const serial_segment_t *frame, size_t count);
+
+/**
+ * \typedef serial_config_t
+ *  Settings for serial_open()
+ */
+typedef struct {
+	uint32_t baud_rate;						/* Bits per second, or 0 to keep UART0 as the debug console set it up */
+	serial_rx_mode_t rx_mode;
+	uint8_t *rx_buffer;						/* Ring or DMA buffer, unused for serial_rx_none */
+	size_t rx_buffer_size;					/* For serial_rx_dma, a power of 2 and rx_buffer aligned to it */
+	uint32_t dma_channel;					/* serial_rx_dma only */
+	serial_frame_callback_t frame_callback;	/* serial_rx_dma only */
+} serial_config_t;
+
+/**
+ * \typedef serial_stats_t
+ *  Per-port counters, all counting since serial_open()
+ */
+typedef struct {
+	uint32_t tx_bytes;		/* Bytes written by serial_write() and serial_write_blocking() */
+	uint32_t rx_bytes;		/* Bytes handed to serial_read() callers or frame_callback */
+	uint32_t rx_overruns;	/* Times received data was lost to a full buffer or a hardware overrun */
+	uint32_t irqs;			/* Times the port's interrupt handler has run */
+} serial_stats_t;
+
+/**
+ * \fn status_t serial_open
+ * \brief Set up a port and start receiving as configured
+ * \param port The port
+ * \param config The settings
+ * \return kStatus_Success, kStatus_InvalidArgument if the port is not compiled in or the settings are not supported
+ *  by it, or the driver's error if the baud rate or DMA buffer is rejected
+ */
+status_t serial_open(serial_port_t port, const serial_config_t *config);
+
+/**
+ * \fn bool serial_is_open
+ * \brief Get whether serial_open() has succeeded on a port
+ * \param port The port
+ * \return true if the port is open
+ */
+bool serial_is_open(serial_port_t port);
+
+/**
+ * \fn status_t serial_write
+ * \brief Start sending a buffer in the background
+ * \param port The port
+ * \param data The bytes to send. Must stay unchanged until serial_tx_busy() returns false
+ * \param length Amount of bytes
+ * \return kStatus_Success, or the driver's TX busy status if the previous write has not finished
+ */
+status_t serial_write(serial_port_t port, const uint8_t *data, size_t length);
+
+/**
+ * \fn void serial_write_blocking
+ * \brief Send a buffer, waiting for any background write first and until the last byte is in the transmitter
+ * \param port The port
+ * \param data The bytes to send
+ * \param length Amount of bytes
+ * \return N/A
+ */
+void serial_write_blocking(serial_port_t port, const uint8_t *data, size_t length);
+
+/**
+ * \fn bool serial_tx_busy
+ * \brief Get whether a background write is still in progress
+ * \param port The port
+ * \return true if serial_write() would return busy
+ */
+bool serial_tx_busy(serial_port_t port);
+
+/**
+ * \fn size_t serial_rx_available
+ * \brief Get how many received bytes are waiting in the ring
+ * \param port The port
+ * \return Amount of bytes serial_read() can return right away
+ */
+size_t serial_rx_available(serial_port_t port);
+
+/**
+ * \fn size_t serial_read
+ * \brief Copy received bytes out of the ring. Never waits
+ * \param port The port
+ * \param data Where to store the bytes
+ * \param length Most bytes to copy
+ * \return Amount of bytes copied
+ */
+size_t serial_read(serial_port_t port, uint8_t *data, size_t length);
+
+/**
+ * \fn void serial_get_stats
+ * \brief Get a port's counters
+ * \param port The port
+ * \param stats Where to store the counters
+ * \return N/A
+ */
+void serial_get_stats(serial_port_t port, serial_stats_t *stats);
+
+#endif /* SERIAL_H_ */
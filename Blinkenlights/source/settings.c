@@ -0,0 +1,422 @@
+/**
+ * \file    settings.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for the wear-levelled settings store in the last flash sectors
+ */
+
+#include <string.h>
+#include "fsl_flash.h"
+#include "settings.h"
+#include "crc.h"
+#include "clocks.h"
+
+/**
+ * \def SETTINGS_HEADER_SIZE
+ *  Sequence number and SETTINGS_SECTOR_MAGIC at the start of every sector
+ */
+#define SETTINGS_HEADER_SIZE\
+	(8U)
+
+/**
+ * \def SETTINGS_RECORD_SIZE(length)
+ * \param length Value length in bytes
+ *  Bytes a record takes in flash: key/length word, CRC, padded value and commit word
+ */
+#define SETTINGS_RECORD_SIZE(length)\
+	(8U + (((length) + 3U) & ~3U) + 4U)
+
+/**
+ * \def SETTINGS_ERASED
+ *  An erased flash word
+ */
+#define SETTINGS_ERASED\
+	(0xFFFFFFFFUL)
+
+/**
+ * \def SETTINGS_NO_SECTOR
+ *  settings_active before the first complete sector exists
+ */
+#define SETTINGS_NO_SECTOR\
+	(0xFFFFFFFFUL)
+
+/**
+ *  Flash driver state
+ */
+static flash_config_t settings_flash;
+
+/**
+ *  Active sector, its sequence number, and the offset of its first erased byte. settings_free is SETTINGS_SECTOR_SIZE
+ *  when the rest of the sector cannot be appended to
+ */
+static uint32_t settings_active = SETTINGS_NO_SECTOR;
+static uint32_t settings_sequence;
+static uint32_t settings_free = SETTINGS_SECTOR_SIZE;
+
+/**
+ *  Offset of the newest record of every key in the active sector, 0 if the key has no value
+ */
+static uint16_t settings_index[settings_key_count];
+
+/**
+ *  A record is assembled here before it is programmed, since FLASH_Program() takes whole words from RAM
+ */
+static uint32_t settings_buffer[SETTINGS_RECORD_SIZE(SETTINGS_VALUE_MAX) / 4];
+
+/**
+ * \fn static uint32_t settings_address
+ * \brief Get the flash address of a location in a settings sector
+ * \param sector The sector
+ * \param offset Offset in the sector
+ * \return The address
+ */
+static uint32_t settings_address(uint32_t sector, uint32_t offset){
+	return SETTINGS_FLASH_START + (sector * SETTINGS_SECTOR_SIZE) + offset;
+}
+
+/**
+ * \fn static uint32_t settings_word
+ * \brief Read one word of a settings sector
+ * \param sector The sector
+ * \param offset Offset in the sector, a multiple of 4
+ * \return The word
+ */
+static uint32_t settings_word(uint32_t sector, uint32_t offset){
+	return *(const volatile uint32_t *)settings_address(sector, offset);
+}
+
+/**
+ * \fn static status_t settings_erase
+ * \brief Erase one settings sector with interrupts masked, in RUN
+ * \param sector The sector
+ * \return kStatus_Success or kStatus_Settings_FlashError
+ */
+static status_t settings_erase(uint32_t sector){
+	uint32_t primask;
+	status_t status;
+
+	(void)clocks_burst_begin();
+	primask = DisableGlobalIRQ();
+	status = FLASH_Erase(&settings_flash, settings_address(sector, 0), SETTINGS_SECTOR_SIZE, kFLASH_ApiEraseKey);
+	EnableGlobalIRQ(primask);
+	clocks_burst_end();
+
+	return (status == kStatus_FLASH_Success) ? kStatus_Success : kStatus_Settings_FlashError;
+}
+
+/**
+ * \fn static status_t settings_program
+ * \brief Program whole words into a settings sector with interrupts masked, in RUN
+ * \param sector The sector
+ * \param offset Offset in the sector, a multiple of 4
+ * \param words The words to program
+ * \param length Amount of bytes, a multiple of 4
+ * \return kStatus_Success or kStatus_Settings_FlashError
+ */
+static status_t settings_program(uint32_t sector, uint32_t offset, const uint32_t *words, uint32_t length){
+	uint32_t primask;
+	status_t status;
+
+	(void)clocks_burst_begin();
+	primask = DisableGlobalIRQ();
+	status = FLASH_Program(&settings_flash, settings_address(sector, offset), (uint32_t *)words, length);
+	EnableGlobalIRQ(primask);
+	clocks_burst_end();
+
+	return (status == kStatus_FLASH_Success) ? kStatus_Success : kStatus_Settings_FlashError;
+}
+
+/**
+ * \fn static uint32_t settings_record_crc
+ * \brief CRC-32 of a record's key/length word and value
+ * \param head The key/length word
+ * \param value The value
+ * \param length Value length in bytes
+ * \return The CRC
+ */
+static uint32_t settings_record_crc(uint32_t head, const void *value, uint32_t length){
+	uint8_t bytes[4];
+
+	bytes[0] = (uint8_t)head;
+	bytes[1] = (uint8_t)(head >> 8);
+	bytes[2] = (uint8_t)(head >> 16);
+	bytes[3] = (uint8_t)(head >> 24);
+
+	return crc32_final(crc32_update(crc32_update(crc32_init(), bytes, sizeof(bytes)), value, length));
+}
+
+/**
+ * \fn static uint32_t settings_record_length
+ * \brief Get the value length of a record in the active sector
+ * \param offset Offset of the record
+ * \return Value length in bytes
+ */
+static uint32_t settings_record_length(uint32_t offset){
+	return settings_word(settings_active, offset) >> 16;
+}
+
+/**
+ * \fn static void settings_scan
+ * \brief Make a sector active: index the newest committed record of every key and find where the log ends
+ * \param sector The sector
+ * \return N/A
+ */
+static void settings_scan(uint32_t sector){
+	uint32_t offset;
+	uint32_t head;
+	uint32_t key;
+	uint32_t length;
+
+	settings_active = sector;
+	memset(settings_index, 0, sizeof(settings_index));
+
+	offset = SETTINGS_HEADER_SIZE;
+	while(offset + SETTINGS_RECORD_SIZE(0) <= SETTINGS_SECTOR_SIZE){
+		head = settings_word(sector, offset);
+		if(head == SETTINGS_ERASED){
+			break;
+		}
+
+		key = head & 0xFFFF;
+		length = head >> 16;
+		if((key >= settings_key_count) || (length > SETTINGS_VALUE_MAX) ||
+				(offset + SETTINGS_RECORD_SIZE(length) > SETTINGS_SECTOR_SIZE)){
+			/**
+			 *  A torn key/length word: nothing after it can be trusted
+			 */
+			offset = SETTINGS_SECTOR_SIZE;
+			break;
+		}
+
+		/**
+		 *  A record without its commit word or with a bad CRC was cut short, and the previous record of the key stands
+		 */
+		if((settings_word(sector, offset + SETTINGS_RECORD_SIZE(length) - 4) == SETTINGS_RECORD_COMMIT) &&
+				(settings_word(sector, offset + 4) ==
+				settings_record_crc(head, (const void *)settings_address(sector, offset + 8), length))){
+			settings_index[key] = (length != 0) ? (uint16_t)offset : 0;
+		}
+
+		offset += SETTINGS_RECORD_SIZE(length);
+	}
+
+	settings_free = offset;
+
+	/**
+	 *  Appending is only possible if everything after the log is still erased
+	 */
+	for(; offset < SETTINGS_SECTOR_SIZE; offset += 4){
+		if(settings_word(sector, offset) != SETTINGS_ERASED){
+			settings_free = SETTINGS_SECTOR_SIZE;
+			break;
+		}
+	}
+}
+
+/**
+ * \fn static status_t settings_append
+ * \brief Program one record and then its commit word
+ * \param sector The sector
+ * \param offset Where the record goes
+ * \param key The key
+ * \param value The value
+ * \param length Value length in bytes
+ * \return kStatus_Success or kStatus_Settings_FlashError
+ */
+static status_t settings_append(uint32_t sector, uint32_t offset, uint32_t key, const void *value, uint32_t length){
+	uint32_t size;
+	status_t status;
+
+	size = SETTINGS_RECORD_SIZE(length);
+	memset(settings_buffer, 0xFF, size);
+	settings_buffer[0] = key | (length << 16);
+	settings_buffer[1] = settings_record_crc(settings_buffer[0], value, length);
+	memcpy(&settings_buffer[2], value, length);
+	settings_buffer[(size / 4) - 1] = SETTINGS_RECORD_COMMIT;
+
+	status = settings_program(sector, offset, settings_buffer, size - 4);
+	if(status == kStatus_Success){
+		status = settings_program(sector, offset + size - 4, &settings_buffer[(size / 4) - 1], 4);
+	}
+
+	return status;
+}
+
+/**
+ * \fn static status_t settings_rotate
+ * \brief Move the newest record of every other key and the new record into the next sector, then commit that sector
+ * \param key The key being written
+ * \param value The new value
+ * \param length New value length in bytes, 0 to delete the key
+ * \return kStatus_Success, kStatus_Settings_Full or kStatus_Settings_FlashError
+ *
+ *  Until the new sector's magic word is programmed the old sector stays active, so a reset at any point leaves either
+ *  the old or the new state
+ */
+static status_t settings_rotate(uint32_t key, const void *value, uint32_t length){
+	uint16_t moved[settings_key_count];
+	uint32_t next;
+	uint32_t offset;
+	uint32_t size;
+	uint32_t k;
+	uint32_t word;
+	status_t status;
+
+	/**
+	 *  Check it all fits before erasing anything
+	 */
+	offset = SETTINGS_HEADER_SIZE + ((length != 0) ? SETTINGS_RECORD_SIZE(length) : 0);
+	for(k = 0; k < settings_key_count; k++){
+		if((k != key) && (settings_index[k] != 0)){
+			offset += SETTINGS_RECORD_SIZE(settings_record_length(settings_index[k]));
+		}
+	}
+	if(offset > SETTINGS_SECTOR_SIZE){
+		return kStatus_Settings_Full;
+	}
+
+	next = (settings_active == SETTINGS_NO_SECTOR) ? 0 : ((settings_active + 1) % SETTINGS_SECTOR_COUNT);
+	status = settings_erase(next);
+	word = settings_sequence + 1;
+	if(status == kStatus_Success){
+		status = settings_program(next, 0, &word, 4);
+	}
+
+	memset(moved, 0, sizeof(moved));
+	offset = SETTINGS_HEADER_SIZE;
+	for(k = 0; (k < settings_key_count) && (status == kStatus_Success); k++){
+		if((k == key) || (settings_index[k] == 0)){
+			continue;
+		}
+
+		/**
+		 *  Records are copied whole, commit word included; they only count once the sector is committed
+		 */
+		size = SETTINGS_RECORD_SIZE(settings_record_length(settings_index[k]));
+		memcpy(settings_buffer, (const void *)settings_address(settings_active, settings_index[k]), size);
+		status = settings_program(next, offset, settings_buffer, size);
+		moved[k] = (uint16_t)offset;
+		offset += size;
+	}
+
+	if((status == kStatus_Success) && (length != 0)){
+		status = settings_append(next, offset, key, value, length);
+		moved[key] = (uint16_t)offset;
+		offset += SETTINGS_RECORD_SIZE(length);
+	}
+
+	word = SETTINGS_SECTOR_MAGIC;
+	if(status == kStatus_Success){
+		status = settings_program(next, 4, &word, 4);
+	}
+	if(status != kStatus_Success){
+		return status;
+	}
+
+	settings_active = next;
+	settings_sequence++;
+	settings_free = offset;
+	memcpy(settings_index, moved, sizeof(settings_index));
+
+	return kStatus_Success;
+}
+
+status_t settings_init(void){
+	uint32_t sector;
+	uint32_t sequence;
+	uint32_t newest;
+
+	memset(&settings_flash, 0, sizeof(settings_flash));
+	if(FLASH_Init(&settings_flash) != kStatus_FLASH_Success){
+		return kStatus_Settings_FlashError;
+	}
+
+	/**
+	 *  The newest committed sector is the active one. Sequence numbers are compared with wraparound
+	 */
+	newest = SETTINGS_NO_SECTOR;
+	settings_sequence = 0;
+	for(sector = 0; sector < SETTINGS_SECTOR_COUNT; sector++){
+		if(settings_word(sector, 4) != SETTINGS_SECTOR_MAGIC){
+			continue;
+		}
+		sequence = settings_word(sector, 0);
+		if((newest == SETTINGS_NO_SECTOR) || ((int32_t)(sequence - settings_sequence) > 0)){
+			newest = sector;
+			settings_sequence = sequence;
+		}
+	}
+
+	if(newest == SETTINGS_NO_SECTOR){
+		settings_active = SETTINGS_NO_SECTOR;
+		settings_free = SETTINGS_SECTOR_SIZE;
+		memset(settings_index, 0, sizeof(settings_index));
+	}
+	else{
+		settings_scan(newest);
+	}
+
+	return kStatus_Success;
+}
+
+status_t settings_read(settings_key_t key, void *value, size_t size, size_t *length){
+	uint32_t stored;
+
+	if((uint32_t)key >= settings_key_count){
+		return kStatus_InvalidArgument;
+	}
+	if(settings_index[key] == 0){
+		return kStatus_Settings_NotFound;
+	}
+
+	stored = settings_record_length(settings_index[key]);
+	memcpy(value, (const void *)settings_address(settings_active, settings_index[key] + 8), MIN(size, stored));
+	if(length != NULL){
+		*length = stored;
+	}
+
+	return kStatus_Success;
+}
+
+status_t settings_write(settings_key_t key, const void *value, size_t length){
+	status_t status;
+
+	if(((uint32_t)key >= settings_key_count) || (length > SETTINGS_VALUE_MAX)){
+		return kStatus_InvalidArgument;
+	}
+	if((length == 0) && (settings_index[key] == 0)){
+		return kStatus_Success;
+	}
+
+	if(settings_free + SETTINGS_RECORD_SIZE(length) > SETTINGS_SECTOR_SIZE){
+		return settings_rotate(key, value, length);
+	}
+
+	status = settings_append(settings_active, settings_free, key, value, length);
+	if(status != kStatus_Success){
+		/**
+		 *  The sector may now hold a partial record; continue in a fresh one next time
+		 */
+		settings_free = SETTINGS_SECTOR_SIZE;
+		return status;
+	}
+
+	settings_index[key] = (length != 0) ? (uint16_t)settings_free : 0;
+	settings_free += SETTINGS_RECORD_SIZE(length);
+
+	return kStatus_Success;
+}
+
+void settings_get_stats(settings_stats_t *stats){
+	uint32_t k;
+
+	stats->sector = settings_active;
+	stats->sequence = settings_sequence;
+	stats->used = (settings_active == SETTINGS_NO_SECTOR) ? 0 : settings_free;
+	stats->keys = 0;
+	for(k = 0; k < settings_key_count; k++){
+		if(settings_index[k] != 0){
+			stats->keys++;
+		}
+	}
+}
@@ -0,0 +1,149 @@
+/**
+ * \file    settings.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for the wear-levelled settings store in the last flash sectors
+ *
+ *  The store is a log: every write appends a record to the active sector, and the newest record of a key wins. When
+ *  the active sector is full, the newest record of every key is copied into the next sector, so erases rotate over all
+ *  SETTINGS_SECTOR_COUNT sectors.
+ *
+ *  Sector layout (all words little endian):
+ *  	word 0		sequence number, one more than the sector it replaced
+ *  	word 1		SETTINGS_SECTOR_MAGIC, programmed last, after the live records were copied in
+ *  	records...	up to the first erased (0xFFFFFFFF) word
+ *
+ *  Record layout:
+ *  	word 0		key (bits 15:0) and value length in bytes (bits 31:16). Length 0 deletes the key
+ *  	word 1		CRC-32 of word 0 and the value
+ *  	value		padded with 0xFF to a whole word
+ *  	commit		SETTINGS_RECORD_COMMIT, programmed last
+ *
+ *  A record only counts if its commit word and CRC are both right, so a write cut short by a reset is ignored and the
+ *  previous value of the key stays in effect
+ */
+
+#ifndef SETTINGS_H_
+#define SETTINGS_H_
+
+#include "fsl_common.h"
+
+/**
+ * \def SETTINGS_SECTOR_SIZE
+ *  Flash erase unit
+ */
+#define SETTINGS_SECTOR_SIZE\
+	(FSL_FEATURE_FLASH_PFLASH_BLOCK_SECTOR_SIZE)
+
+/**
+ * \def SETTINGS_SECTOR_COUNT
+ *  Sectors the store rotates over. The linker scripts end PROGRAM_FLASH below them
+ */
+#define SETTINGS_SECTOR_COUNT\
+	(4)
+
+/**
+ * \def SETTINGS_FLASH_START
+ *  Address of the first settings sector: the last SETTINGS_SECTOR_COUNT sectors of the program flash
+ */
+#ifndef SETTINGS_FLASH_START
+#define SETTINGS_FLASH_START\
+	((FSL_FEATURE_FLASH_PFLASH_BLOCK_COUNT * FSL_FEATURE_FLASH_PFLASH_BLOCK_SIZE) -\
+	(SETTINGS_SECTOR_COUNT * SETTINGS_SECTOR_SIZE))
+#endif
+
+/**
+ * \def SETTINGS_VALUE_MAX
+ *  Longest value in bytes
+ */
+#define SETTINGS_VALUE_MAX\
+	(128U)
+
+/**
+ * \def SETTINGS_SECTOR_MAGIC
+ *  Marks a sector whose records are complete
+ */
+#define SETTINGS_SECTOR_MAGIC\
+	(0x53455431UL)
+
+/**
+ * \def SETTINGS_RECORD_COMMIT
+ *  Marks a record that was completely programmed
+ */
+#define SETTINGS_RECORD_COMMIT\
+	(0xC0FFEE00UL)
+
+/**
+ * \typedef settings_key_t
+ *  Every key in the store. Keys index the in-RAM table directly, so keep them small and dense
+ */
+typedef enum {
+	settings_key_params,	/* params_t, see params_save() */
+	settings_key_boot,		/* uint32_t BOOTTIME_FLAG_ bits, see boottime_save_flags() */
+	settings_key_count
+} settings_key_t;
+
+/**
+ *  Error codes for the settings store
+ */
+enum {
+	kStatus_Settings_NotFound = MAKE_STATUS(kStatusGroup_ApplicationRangeStart, 0),	/* Key has no value */
+	kStatus_Settings_Full = MAKE_STATUS(kStatusGroup_ApplicationRangeStart, 1),		/* Live values do not fit a sector */
+	kStatus_Settings_FlashError = MAKE_STATUS(kStatusGroup_ApplicationRangeStart, 2)	/* Erase or program failed */
+};
+
+/**
+ * \typedef settings_stats_t
+ *  Where the store stands
+ */
+typedef struct {
+	uint32_t sector;	/* Active sector, 0 to SETTINGS_SECTOR_COUNT - 1 */
+	uint32_t sequence;	/* Sequence number of the active sector, i.e. sector rotations since the store was created */
+	uint32_t used;		/* Bytes used in the active sector, header included */
+	uint32_t keys;		/* Keys with a value */
+} settings_stats_t;
+
+/**
+ * \fn status_t settings_init
+ * \brief Find the newest complete sector and index the newest record of every key. Call once at boot
+ * \param N/A
+ * \return kStatus_Success, or kStatus_Settings_FlashError if the flash driver could not be set up. An empty or
+ *  unreadable store is not an error; it starts over on the next write
+ */
+status_t settings_init(void);
+
+/**
+ * \fn status_t settings_read
+ * \brief Copy the value of a key
+ * \param key The key
+ * \param value Where to store the value
+ * \param size Size of value in bytes
+ * \param length Where to store the length of the stored value, which may differ from size. May be NULL
+ * \return kStatus_Success, kStatus_Settings_NotFound, or kStatus_InvalidArgument for an unknown key
+ *
+ *  Copies at most size bytes
+ */
+status_t settings_read(settings_key_t key, void *value, size_t size, size_t *length);
+
+/**
+ * \fn status_t settings_write
+ * \brief Store a new value for a key, or delete the key if length is 0
+ * \param key The key
+ * \param value The value
+ * \param length Length of value in bytes, at most SETTINGS_VALUE_MAX
+ * \return kStatus_Success, kStatus_InvalidArgument, kStatus_Settings_Full or kStatus_Settings_FlashError
+ *
+ *  Interrupts are masked while flash is being erased or programmed, since the vector table and handlers are in flash.
+ *  A sector rotation (one erase) masks them for tens of milliseconds
+ */
+status_t settings_write(settings_key_t key, const void *value, size_t length);
+
+/**
+ * \fn void settings_get_stats
+ * \brief Describe the active sector
+ * \param stats Where to store the description
+ * \return N/A
+ */
+void settings_get_stats(settings_stats_t *stats);
+
+#endif /* SETTINGS_H_ */
@@ -0,0 +1,690 @@
+/**
+ * \file    shell.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for the console command shell
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "board.h"
+#include "MKL25Z4.h"
+#include "fsl_debug_console.h"
+#include "shell.h"
+#include "console.h"
+#include "params.h"
+#include "led.h"
+#include "touch.h"
+#include "delay.h"
+#include "telemetry.h"
+#include "serial.h"
+#include "crc.h"
+#include "settings.h"
+#include "blackbox.h"
+#include "update.h"
+#include "power.h"
+#include "clocks.h"
+#include "boottime.h"
+#include "stack.h"
+#include "pool.h"
+#include "fault.h"
+#include "trace.h"
+
+/**
+ * \typedef shell_command_t
+ *  One entry of the command table
+ */
+typedef struct {
+	const char *name;
+	void (*handler)(int argc, char *argv[]);
+	const char *usage;
+} shell_command_t;
+
+static void shell_baud(int argc, char *argv[]);
+static void shell_bench(int argc, char *argv[]);
+static void shell_blackbox(int argc, char *argv[]);
+static void shell_boot(int argc, char *argv[]);
+static void shell_clock(int argc, char *argv[]);
+static void shell_fault(int argc, char *argv[]);
+static void shell_get(int argc, char *argv[]);
+static void shell_help(int argc, char *argv[]);
+static void shell_led(int argc, char *argv[]);
+static void shell_pool(int argc, char *argv[]);
+static void shell_power(int argc, char *argv[]);
+static void shell_save(int argc, char *argv[]);
+static void shell_serial(int argc, char *argv[]);
+static void shell_set(int argc, char *argv[]);
+static void shell_stack(int argc, char *argv[]);
+static void shell_telemetry(int argc, char *argv[]);
+static void shell_touch(int argc, char *argv[]);
+static void shell_trace(int argc, char *argv[]);
+static void shell_update(int argc, char *argv[]);
+
+/**
+ *  Sorted by name so shell_find() can binary search
+ */
+static const shell_command_t shell_commands[] = {
+	{"baud", shell_baud, "baud [rate]"},
+	{"bench", shell_bench, "bench cobs|crc|delay|gpio|pool|tsi"},
+	{"blackbox", shell_blackbox, "blackbox [raw]"},
+	{"boot", shell_boot, "boot [fast|full]"},
+	{"clock", shell_clock, "clock [run|vlpr]"},
+	{"fault", shell_fault, "fault [clear]"},
+	{"get", shell_get, "get [name]"},
+	{"help", shell_help, "help"},
+	{"led", shell_led, "led"},
+	{"pool", shell_pool, "pool"},
+	{"power", shell_power, "power"},
+	{"save", shell_save, "save"},
+	{"serial", shell_serial, "serial"},
+	{"set", shell_set, "set name value"},
+	{"stack", shell_stack, "stack"},
+	{"telemetry", shell_telemetry, "telemetry [on|off]"},
+	{"touch", shell_touch, "touch [count]"},
+	{"trace", shell_trace, "trace [on|off|dump|size bytes [packets]]"},
+	{"update", shell_update, "update"},
+};
+
+/**
+ * \fn static const shell_command_t *shell_find
+ * \brief Look up a command by name
+ * \param name The command name
+ * \return The command, or NULL if there is no such command
+ */
+static const shell_command_t *shell_find(const char *name){
+	uint32_t low;
+	uint32_t high;
+	uint32_t mid;
+	int cmp;
+
+	low = 0;
+	high = ARRAY_SIZE(shell_commands);
+	while(low < high){
+		mid = (low + high) / 2;
+		cmp = strcmp(name, shell_commands[mid].name);
+		if(cmp == 0){
+			return &shell_commands[mid];
+		}
+		if(cmp < 0){
+			high = mid;
+		}
+		else{
+			low = mid + 1;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * \fn static bool shell_parse_u32
+ * \brief Parse a decimal or 0x-prefixed hexadecimal number
+ * \param s The text to parse
+ * \param value Where to store the number
+ * \return true if all of s was a number
+ */
+static bool shell_parse_u32(const char *s, uint32_t *value){
+	char *end;
+
+	*value = strtoul(s, &end, 0);
+
+	return (*s != '\0') && (*end == '\0');
+}
+
+/**
+ * \fn static void cycles_start
+ * \brief Run SysTick freely from the core clock so it can be used as a 24-bit down-counting cycle counter
+ * \param N/A
+ * \return N/A
+ *
+ *  The Cortex-M0+ has no DWT cycle counter. Intervals must stay below 2^24 cycles (about 349 msec at 48 MHz)
+ */
+static void cycles_start(void){
+	SysTick->CTRL = 0;
+	SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+	SysTick->VAL = 0;
+	SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+}
+
+/**
+ * \fn static uint32_t cycles_elapsed
+ * \brief Get the core clock cycles since cycles_start() and stop SysTick
+ * \param N/A
+ * \return Elapsed cycles
+ */
+static uint32_t cycles_elapsed(void){
+	uint32_t now;
+
+	now = SysTick->VAL;
+	SysTick->CTRL = 0;
+
+	return SysTick_LOAD_RELOAD_Msk - now;
+}
+
+/**
+ * \fn static void shell_print_param
+ * \brief Print one parameter as "name = value"
+ * \param info The parameter description
+ * \return N/A
+ */
+static void shell_print_param(const param_info_t *info){
+	PRINTF("%s = %u\r\n", info->name, params_get(info));
+}
+
+/**
+ * \fn static void shell_bench_pool
+ * \brief Time pool_alloc()/pool_free() against malloc()/free() of the same size, average and worst case
+ * \param N/A
+ * \return N/A
+ *
+ *  Each round takes SHELL_BENCH_POOL_BLOCKS blocks and gives them back in a scrambled order, so the heap has holes to
+ *  search by the next round. This is the only caller of malloc(); nothing else uses the heap
+ */
+static void shell_bench_pool(void){
+	void *blocks[SHELL_BENCH_POOL_BLOCKS];
+	uint32_t total[2];
+	uint32_t worst[2];
+	uint32_t cycles;
+	uint32_t round;
+	uint32_t i;
+	uint32_t j;
+
+	for(j = 0; j < 2; j++){
+		total[j] = 0;
+		worst[j] = 0;
+		for(round = 0; round < SHELL_BENCH_POOL_ROUNDS; round++){
+			for(i = 0; i < SHELL_BENCH_POOL_BLOCKS; i++){
+				cycles_start();
+				blocks[i] = (j == 0) ? pool_alloc(pool_event) : malloc(POOL_EVENT_SIZE);
+				cycles = cycles_elapsed();
+				total[j] += cycles;
+				worst[j] = MAX(worst[j], cycles);
+			}
+			for(i = 0; i < SHELL_BENCH_POOL_BLOCKS; i++){
+				/* 5 is coprime to SHELL_BENCH_POOL_BLOCKS, so every block is freed once */
+				cycles_start();
+				if(j == 0){
+					pool_free(blocks[(i * 5U) % SHELL_BENCH_POOL_BLOCKS]);
+				}
+				else{
+					free(blocks[(i * 5U) % SHELL_BENCH_POOL_BLOCKS]);
+				}
+				cycles = cycles_elapsed();
+				total[j] += cycles;
+				worst[j] = MAX(worst[j], cycles);
+			}
+		}
+	}
+
+	PRINTF("POOL %u CYCLES PER ALLOC+FREE WORST CALL %u\r\n",
+			total[0] / (SHELL_BENCH_POOL_BLOCKS * SHELL_BENCH_POOL_ROUNDS), worst[0]);
+	PRINTF("MALLOC %u CYCLES PER ALLOC+FREE WORST CALL %u\r\n",
+			total[1] / (SHELL_BENCH_POOL_BLOCKS * SHELL_BENCH_POOL_ROUNDS), worst[1]);
+}
+
+/**
+ * \fn static void shell_print_packet
+ * \brief Print one MTB packet as "MTB source destination" for tools/mtb_decode.py
+ * \param packet The packet
+ * \return N/A
+ */
+static void shell_print_packet(const trace_packet_t *packet){
+	PRINTF("MTB %08x %08x\r\n", packet->source, packet->destination);
+}
+
+static void shell_baud(int argc, char *argv[]){
+	uint32_t baud;
+
+	if(argc < 2){
+		console_print_baud();
+		return;
+	}
+	if(!shell_parse_u32(argv[1], &baud) || (baud == 0)){
+		PRINTF("BAD RATE %s\r\n", argv[1]);
+		return;
+	}
+	if(console_set_baud(baud) == kStatus_Success){
+		console_print_baud();
+	}
+}
+
+static void shell_bench(int argc, char *argv[]){
+	uint8_t frame[TELEMETRY_FRAME_MAX];
+	uint8_t data[SHELL_BENCH_CRC_BYTES];
+	uint32_t cycles;
+	uint32_t i;
+
+	if(argc < 2){
+		PRINTF("USAGE bench cobs|crc|delay|gpio|pool|tsi\r\n");
+		return;
+	}
+
+	if(strcmp(argv[1], "cobs") == 0){
+		cycles_start();
+		for(i = 0; i < SHELL_BENCH_TELEMETRY_RECORDS; i++){
+			(void)telemetry_encode(telemetry_touch, (uint16_t)i, (uint16_t)i, 0x1234, frame);
+		}
+		cycles = cycles_elapsed();
+		PRINTF("TELEMETRY ENCODE %u CYCLES PER RECORD (CRC + COBS)\r\n", cycles / SHELL_BENCH_TELEMETRY_RECORDS);
+	}
+	else if(strcmp(argv[1], "crc") == 0){
+		for(i = 0; i < SHELL_BENCH_CRC_BYTES; i++){
+			data[i] = (uint8_t)i;
+		}
+		PRINTF("CRC32 CHECK %s CRC16 CHECK %s\r\n", (crc32_buffer("123456789", 9) == CRC32_CHECK) ? "OK" : "FAIL",
+				(crc16_buffer("123456789", 9) == CRC16_CHECK) ? "OK" : "FAIL");
+		cycles_start();
+		(void)crc32_buffer(data, SHELL_BENCH_CRC_BYTES);
+		cycles = cycles_elapsed();
+		PRINTF("CRC32 %u CYCLES PER %u BYTES\r\n", cycles, SHELL_BENCH_CRC_BYTES);
+		cycles_start();
+		(void)crc16_buffer(data, SHELL_BENCH_CRC_BYTES);
+		cycles = cycles_elapsed();
+		PRINTF("CRC16 %u CYCLES PER %u BYTES\r\n", cycles, SHELL_BENCH_CRC_BYTES);
+	}
+	else if(strcmp(argv[1], "delay") == 0){
+		cycles_start();
+		DELAY_100_MSEC();
+		cycles = cycles_elapsed();
+		PRINTF("DELAY_100_MSEC %u CYCLES %u USEC (EXPECTED 100000)\r\n", cycles, cycles / (SystemCoreClock / 1000000U));
+	}
+	else if(strcmp(argv[1], "gpio") == 0){
+		cycles_start();
+		for(i = 0; i < SHELL_BENCH_GPIO_WRITES; i++){
+			PTB->PTOR = MASK(PORTB_RED_LED_PIN);
+		}
+		cycles = cycles_elapsed();
+		PRINTF("GPIO WRITE %u CYCLES PER %u WRITES (LOOP INCLUDED)\r\n", cycles, SHELL_BENCH_GPIO_WRITES);
+	}
+	else if(strcmp(argv[1], "pool") == 0){
+		shell_bench_pool();
+	}
+	else if(strcmp(argv[1], "tsi") == 0){
+		cycles_start();
+		(void)scan_onboard_touch_sensor();
+		cycles = cycles_elapsed();
+		PRINTF("TSI SCAN %u CYCLES %u USEC\r\n", cycles, cycles / (SystemCoreClock / 1000000U));
+	}
+	else{
+		PRINTF("UNKNOWN BENCHMARK %s\r\n", argv[1]);
+	}
+}
+
+static void shell_blackbox(int argc, char *argv[]){
+	static const char *const names[] = {"?", "RESET", "LED", "PARAM", "SAVE", "FAULT"};
+	const blackbox_record_t *record;
+	const uint32_t *words;
+	blackbox_stats_t stats;
+	uint32_t i;
+	bool raw;
+	bool valid;
+
+	raw = (argc >= 2) && (strcmp(argv[1], "raw") == 0);
+	(void)blackbox_flush();
+
+	/**
+	 *  raw prints every slot as four hex words for tools/blackbox_dump.py, torn ones included
+	 */
+	for(i = 0; (record = blackbox_at(i, &valid)) != NULL; i++){
+		if(raw){
+			words = (const uint32_t *)record;
+			PRINTF("BB %08x %08x %08x %08x\r\n", words[0], words[1], words[2], words[3]);
+		}
+		else if(valid){
+			PRINTF("%u %u.%u %s %u %u\r\n", record->sequence, record->tick / 10, record->tick % 10,
+					names[(record->type < ARRAY_SIZE(names)) ? record->type : 0], record->code, record->value);
+		}
+	}
+
+	blackbox_get_stats(&stats);
+	PRINTF("BLACKBOX NEXT %u DROPPED %u PROGRAMS %u ERASES %u\r\n", stats.sequence, stats.dropped, stats.programs,
+			stats.erases);
+}
+
+static void shell_boot(int argc, char *argv[]){
+	static const char *const names[] = {"CRT0", "SETTINGS", "PINS", "CLOCKS", "PERIPHERALS", "CONSOLE", "POWER", "LEDS",
+			"SELFTEST", "STORAGE", "TOUCH", "PLL"};
+	boottime_trace_t trace;
+	uint32_t previous;
+	uint32_t i;
+	status_t status;
+
+	if(argc > 1){
+		if(strcmp(argv[1], "fast") == 0){
+			status = boottime_save_flags(BOOTTIME_FLAGS_FAST);
+		}
+		else if(strcmp(argv[1], "full") == 0){
+			status = boottime_save_flags(0);
+		}
+		else{
+			PRINTF("USAGE boot [fast|full]\r\n");
+			return;
+		}
+		PRINTF((status == kStatus_Success) ? "BOOT %s FROM NEXT RESET\r\n" : "BOOT %s NOT SAVED\r\n", argv[1]);
+		return;
+	}
+
+	boottime_get_trace(&trace);
+	PRINTF("BOOT FLAGS 0x%x WARM RESETS %u\r\n", trace.flags, trace.warm_resets);
+	previous = 0;
+	for(i = 0; i < trace.count; i++){
+		PRINTF("%s %u USEC AT %u\r\n", names[trace.marks[i].phase],
+				BOOTTIME_TICKS_TO_USEC(trace.marks[i].ticks - previous), BOOTTIME_TICKS_TO_USEC(trace.marks[i].ticks));
+		previous = trace.marks[i].ticks;
+	}
+	PRINTF("FIRST LED AT %u USEC\r\n", BOOTTIME_TICKS_TO_USEC(trace.first_led));
+}
+
+static void shell_clock(int argc, char *argv[]){
+	static const char *const names[] = {"RUN", "VLPR"};
+	clocks_stats_t stats;
+	status_t status;
+
+	if(argc > 1){
+		if(strcmp(argv[1], "run") == 0){
+			status = clocks_set_base(clocks_run);
+		}
+		else if(strcmp(argv[1], "vlpr") == 0){
+			status = clocks_set_base(clocks_vlpr);
+		}
+		else{
+			PRINTF("USAGE clock [run|vlpr]\r\n");
+			return;
+		}
+		if(status != kStatus_Success){
+			PRINTF("CLOCK SWITCH REFUSED %d\r\n", status);
+		}
+	}
+
+	clocks_get_stats(&stats);
+	PRINTF("CLOCK %s BASE %s CORE %u BUS %u HZ\r\n", names[stats.profile], names[stats.base], SystemCoreClock,
+			CLOCK_GetBusClkFreq());
+	PRINTF("SWITCHES %u REFUSED %u BURSTS %u\r\n", stats.switches, stats.refused, stats.bursts);
+}
+
+static void shell_fault(int argc, char *argv[]){
+	const fault_record_t *record;
+	uint32_t i;
+
+	if(argc > 1){
+		if(strcmp(argv[1], "clear") == 0){
+			fault_clear();
+		}
+		else{
+			PRINTF("USAGE fault [clear]\r\n");
+			return;
+		}
+	}
+
+	record = fault_get();
+	if(record == NULL){
+		PRINTF("NO FAULT RECORDED\r\n");
+		return;
+	}
+	PRINTF("HARDFAULT %u EXC_RETURN 0x%08x ICSR 0x%08x SHCSR 0x%08x\r\n", record->count, record->exc_return,
+			record->icsr, record->shcsr);
+	PRINTF("R0 0x%08x R1 0x%08x R2 0x%08x R3 0x%08x R12 0x%08x\r\n", record->r0, record->r1, record->r2, record->r3,
+			record->r12);
+	PRINTF("LR 0x%08x PC 0x%08x XPSR 0x%08x SP 0x%08x\r\n", record->lr, record->pc, record->xpsr, record->sp);
+	for(i = 0; i < record->stack_words; i++){
+		PRINTF("SP+%02u 0x%08x\r\n", i * 4, record->stack[i]);
+	}
+	for(i = 0; i < record->trace_packets; i++){
+		shell_print_packet(&record->trace[i]);
+	}
+	PRINTF("FAULT TRACE %u PACKETS\r\n", record->trace_packets);
+}
+
+static void shell_get(int argc, char *argv[]){
+	const param_info_t *info;
+	uint32_t i;
+
+	if(argc < 2){
+		for(i = 0; (info = params_at(i)) != NULL; i++){
+			shell_print_param(info);
+		}
+		return;
+	}
+
+	info = params_find(argv[1]);
+	if(info == NULL){
+		PRINTF("UNKNOWN PARAMETER %s\r\n", argv[1]);
+		return;
+	}
+	shell_print_param(info);
+}
+
+static void shell_help(int argc, char *argv[]){
+	uint32_t i;
+
+	for(i = 0; i < ARRAY_SIZE(shell_commands); i++){
+		PRINTF("%s\r\n", shell_commands[i].usage);
+	}
+}
+
+static void shell_led(int argc, char *argv[]){
+	color_t color;
+
+	color = get_onboard_led_color();
+	PRINTF("LED %s\r\n", (color == red) ? "RED" : ((color == green) ? "GREEN" : ((color == blue) ? "BLUE" : "WHITE")));
+}
+
+static void shell_power(int argc, char *argv[]){
+	static const char *const names[] = {"RUN", "WAIT", "STOP", "VLPS", "LLS"};
+	power_stats_t stats;
+	uint32_t mode;
+
+	power_get_stats(&stats);
+	for(mode = 0; mode < power_mode_count; mode++){
+		PRINTF("%s %u MSEC %u ENTRIES\r\n", names[mode], stats.residency_ms[mode], stats.entries[mode]);
+	}
+	PRINTF("ALLOWED %s CHARGE %u UAH ABORTED %u\r\n", names[stats.allowed], stats.charge_uah, stats.aborted);
+}
+
+static void shell_save(int argc, char *argv[]){
+	settings_stats_t stats;
+	status_t status;
+
+	status = params_save();
+	settings_get_stats(&stats);
+	blackbox_record(blackbox_save, (uint8_t)(status != kStatus_Success), stats.sequence);
+	if(status != kStatus_Success){
+		PRINTF("SAVE FAILED %d\r\n", status);
+		return;
+	}
+
+	PRINTF("SAVED SECTOR %u SEQUENCE %u USED %u/%u KEYS %u\r\n", stats.sector, stats.sequence, stats.used,
+			SETTINGS_SECTOR_SIZE, stats.keys);
+}
+
+static void shell_serial(int argc, char *argv[]){
+	serial_stats_t stats;
+	uint32_t port;
+
+	for(port = 0; port < SERIAL_PORT_COUNT; port++){
+		if(serial_is_open((serial_port_t)port)){
+			serial_get_stats((serial_port_t)port, &stats);
+			PRINTF("UART%u TX %u RX %u OVERRUNS %u IRQS %u\r\n", port, stats.tx_bytes, stats.rx_bytes,
+					stats.rx_overruns, stats.irqs);
+		}
+	}
+}
+
+static void shell_set(int argc, char *argv[]){
+	const param_info_t *info;
+	uint32_t value;
+	status_t status;
+
+	if(argc < 3){
+		PRINTF("USAGE set name value\r\n");
+		return;
+	}
+
+	info = params_find(argv[1]);
+	if(info == NULL){
+		PRINTF("UNKNOWN PARAMETER %s\r\n", argv[1]);
+		return;
+	}
+	if(!shell_parse_u32(argv[2], &value)){
+		PRINTF("BAD VALUE %s\r\n", argv[2]);
+		return;
+	}
+
+	status = params_set(info, value);
+	if(status == kStatus_OutOfRange){
+		PRINTF("OUT OF RANGE %u..%u\r\n", info->min, info->max);
+		return;
+	}
+	if(status == kStatus_InvalidArgument){
+		PRINTF("THRESHOLDS MUST INCREASE: UNTOUCHED < LEFT < RIGHT\r\n");
+		return;
+	}
+	shell_print_param(info);
+}
+
+static void shell_pool(int argc, char *argv[]){
+	static const char *const names[] = {"EVENT", "LOG", "TRANSFER"};
+	pool_stats_t stats;
+	uint32_t pool;
+
+	for(pool = 0; pool < pool_count; pool++){
+		pool_get_stats((pool_id_t)pool, &stats);
+		PRINTF("%s %u x %u BYTES USED %u PEAK %u FAILED %u ERRORS %u\r\n", names[pool], stats.count, stats.size,
+				stats.used, stats.high_water, stats.failures, stats.errors);
+	}
+}
+
+static void shell_stack(int argc, char *argv[]){
+	stack_stats_t stats;
+
+	stack_get_stats(&stats);
+	PRINTF("STACK %u BYTES USED %u FREE %u NOW %u\r\n", stats.size, stats.used, stats.size - stats.used, stats.current);
+	PRINTF("SCANS %u GUARD %s\r\n", stats.passes, stats.guard_hit ? "WRITTEN" : "INTACT");
+}
+
+static void shell_telemetry(int argc, char *argv[]){
+	if(argc >= 2){
+		if(strcmp(argv[1], "on") == 0){
+			if(telemetry_enable(true) != kStatus_Success){
+				PRINTF("TELEMETRY PORT %u UNAVAILABLE\r\n", (uint32_t)TELEMETRY_PORT);
+				return;
+			}
+		}
+		else if(strcmp(argv[1], "off") == 0){
+			(void)telemetry_enable(false);
+		}
+		else{
+			PRINTF("USAGE telemetry [on|off]\r\n");
+			return;
+		}
+	}
+
+	PRINTF("TELEMETRY %s SENT %u DROPPED %u\r\n", telemetry_is_enabled() ? "ON" : "OFF", telemetry_get_sent(),
+			telemetry_get_dropped());
+}
+
+static void shell_touch(int argc, char *argv[]){
+	uint32_t count;
+	uint32_t i;
+
+	count = SHELL_TOUCH_SAMPLES;
+	if((argc >= 2) && !shell_parse_u32(argv[1], &count)){
+		PRINTF("BAD COUNT %s\r\n", argv[1]);
+		return;
+	}
+
+	for(i = 0; i < count; i++){
+		PRINTF("SLIDER VALUE %d\r\n", scan_onboard_touch_sensor());
+	}
+}
+
+static void shell_trace(int argc, char *argv[]){
+	trace_packet_t packet;
+	trace_stats_t stats;
+	uint32_t size;
+	uint32_t watermark;
+	uint32_t i;
+
+	if(argc >= 2){
+		if(strcmp(argv[1], "on") == 0){
+			trace_start();
+		}
+		else if(strcmp(argv[1], "off") == 0){
+			trace_stop();
+		}
+		else if(strcmp(argv[1], "dump") == 0){
+
+			/**
+			 *  Stopped for good: printing would push the packets of interest out. "trace on" carries on
+			 */
+			trace_stop();
+			for(i = 0; trace_at(i, &packet); i++){
+				shell_print_packet(&packet);
+			}
+			PRINTF("TRACE DUMP %u PACKETS\r\n", i);
+			return;
+		}
+		else if((strcmp(argv[1], "size") == 0) && (argc >= 3) && shell_parse_u32(argv[2], &size)){
+			watermark = 0;
+			if((argc >= 4) && !shell_parse_u32(argv[3], &watermark)){
+				PRINTF("BAD PACKETS %s\r\n", argv[3]);
+				return;
+			}
+			if(trace_configure(size, watermark) != kStatus_Success){
+				PRINTF("TRACE SIZE REFUSED, BUFFER %u BYTES\r\n", (uint32_t)TRACE_BUFFER_SIZE);
+				return;
+			}
+		}
+		else{
+			PRINTF("USAGE trace [on|off|dump|size bytes [packets]]\r\n");
+			return;
+		}
+	}
+
+	trace_get_stats(&stats);
+	PRINTF("TRACE %s SIZE %u WATERMARK %u PACKETS %u\r\n", stats.running ? "ON" : "OFF", stats.size, stats.watermark,
+			stats.packets);
+}
+
+static void shell_update(int argc, char *argv[]){
+	status_t status;
+
+	/**
+	 *  Let the line go out before the reset cuts it off
+	 */
+	PRINTF("UPDATE\r\n");
+	while(!(UART0->S1 & UART0_S1_TC_MASK)){
+	}
+
+	status = update_request();
+	PRINTF("UPDATE FAILED %d\r\n", status);
+}
+
+void shell_execute(char *line, uint32_t length){
+	char *argv[SHELL_MAX_ARGS];
+	int argc;
+	char *word;
+	const shell_command_t *command;
+
+	/**
+	 *  Split on spaces in place
+	 */
+	argc = 0;
+	word = strtok(line, " \t");
+	while((word != NULL) && (argc < SHELL_MAX_ARGS)){
+		argv[argc++] = word;
+		word = strtok(NULL, " \t");
+	}
+
+	if(argc == 0){
+		return;
+	}
+
+	command = shell_find(argv[0]);
+	if(command == NULL){
+		PRINTF("UNKNOWN COMMAND %s (try help)\r\n", argv[0]);
+		return;
+	}
+
+	command->handler(argc, argv);
+}
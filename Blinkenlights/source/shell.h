@@ -0,0 +1,87 @@
+/**
+ * \file    shell.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function headers for the console command shell
+ *
+ *  Commands (one per line, arguments separated by spaces):
+ * 		baud [rate]			Show the console baud rate, or switch to a new one
+ * 		bench delay|gpio|tsi	Measure DELAY_100_MSEC accuracy, GPIO write cost or TSI scan time in core clock cycles
+ * 		bench pool			Compare block pool and malloc() latency in core clock cycles
+ * 		boot [fast|full]	Show where the last boot spent its time, or choose how the next one runs
+ * 		clock [run|vlpr]	Show the clock profile, or choose the one to run in when no flash write needs RUN
+ * 		fault [clear]		Show the HardFault record kept from before the last reset, or forget it
+ * 		get [name]			Show one parameter, or all of them
+ * 		help				List the commands
+ * 		led					Show the on-board LED color
+ * 		pool				Show how full each block pool is and has been
+ * 		power				Show time spent in each power mode and the estimated charge drawn
+ * 		set name value		Change a parameter (see params.h)
+ * 		touch [count]		Print count live touch samples (default 10)
+ * 		trace [on|off|dump|size bytes [packets]]	Start, stop or print the MTB branch trace, or set its size and watermark
+ */
+
+#ifndef SHELL_H_
+#define SHELL_H_
+
+#include <stdint.h>
+
+/**
+ * \def SHELL_MAX_ARGS
+ *  Most words (command name included) a command line is split into
+ */
+#define SHELL_MAX_ARGS\
+	(4)
+
+/**
+ * \def SHELL_TOUCH_SAMPLES
+ *  How many samples the touch command prints when no count is given
+ */
+#define SHELL_TOUCH_SAMPLES\
+	(10)
+
+/**
+ * \def SHELL_BENCH_GPIO_WRITES
+ *  How many GPIO writes the gpio benchmark averages over
+ */
+#define SHELL_BENCH_GPIO_WRITES\
+	(64)
+
+/**
+ * \def SHELL_BENCH_TELEMETRY_RECORDS
+ *  How many records the cobs benchmark encodes
+ */
+#define SHELL_BENCH_TELEMETRY_RECORDS\
+	(64)
+
+/**
+ * \def SHELL_BENCH_CRC_BYTES
+ *  How many bytes the crc benchmark checksums
+ */
+#define SHELL_BENCH_CRC_BYTES\
+	(256)
+
+/**
+ * \def SHELL_BENCH_POOL_BLOCKS
+ *  Blocks the pool benchmark holds at once. At most POOL_EVENT_COUNT, and not a multiple of 5
+ */
+#define SHELL_BENCH_POOL_BLOCKS\
+	(8)
+
+/**
+ * \def SHELL_BENCH_POOL_ROUNDS
+ *  How many times the pool benchmark takes and gives back SHELL_BENCH_POOL_BLOCKS blocks
+ */
+#define SHELL_BENCH_POOL_ROUNDS\
+	(8)
+
+/**
+ * \fn void shell_execute
+ * \brief Run one command line. Registered with console_init() as the line callback
+ * \param line The command line, modified in place while it is split into words
+ * \param length Length of line
+ * \return N/A
+ */
+void shell_execute(char *line, uint32_t length);
+
+#endif /* SHELL_H_ */
@@ -0,0 +1,131 @@
+/**
+ * \file    stack.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for the main stack high-water mark and overflow guard
+ */
+
+#include "stack.h"
+#include "blackbox.h"
+#include "telemetry.h"
+#include "log.h"
+
+/**
+ *  Stack bounds from the linker script: _vStackBase is the lowest word, _vStackTop the initial SP
+ */
+extern uint32_t _vStackBase[];
+extern uint32_t _vStackTop[];
+
+/**
+ *  Lowest word found written, and the next word the scan checks. Set up by stack_paint()
+ */
+static uint32_t *stack_mark;
+static uint32_t *stack_cursor;
+
+static uint32_t stack_passes;
+static bool stack_guard_hit;
+
+/**
+ * \fn static void stack_fill
+ * \brief Write the pattern from start up to the current SP, 16 bytes per STM like bss_init()
+ * \param start First word, 4-byte aligned
+ * \param pattern The word to write
+ * \return N/A
+ *
+ *  Naked, so it reads SP itself and nothing of its own lies below: the three words it pushes are left alone
+ */
+__attribute__((naked)) static void stack_fill(uint32_t *start, uint32_t pattern){
+	__asm volatile(
+		"	push	{r4, r5, lr}\n"
+		"	mov		r5, sp\n"
+		"	subs	r5, r5, r0\n"
+		"	lsrs	r5, r5, #4\n"
+		"	lsls	r5, r5, #4\n"
+		"	adds	r5, r0, r5\n"		/* End of the 16-byte blocks */
+		"	movs	r2, r1\n"
+		"	movs	r3, r1\n"
+		"	movs	r4, r1\n"
+		"	b		2f\n"
+		"1:	stmia	r0!, {r1, r2, r3, r4}\n"
+		"2:	cmp		r0, r5\n"
+		"	bne		1b\n"
+		"	mov		r5, sp\n"			/* End of the free stack */
+		"	b		4f\n"
+		"3:	stmia	r0!, {r1}\n"
+		"4:	cmp		r0, r5\n"
+		"	bne		3b\n"
+		"	pop		{r4, r5, pc}\n"
+	);
+}
+
+/**
+ * \fn static uint32_t stack_bytes_below_top
+ * \brief Convert a stack address to the bytes in use down to it
+ * \param word The lowest word in use
+ * \return Bytes from word to _vStackTop
+ */
+static uint32_t stack_bytes_below_top(const uint32_t *word){
+	return (uint32_t)_vStackTop - (uint32_t)word;
+}
+
+/**
+ * \fn static void stack_lower_mark
+ * \brief Record a new high-water mark and send it as telemetry
+ * \param word The lowest word found written
+ * \return N/A
+ */
+static void stack_lower_mark(uint32_t *word){
+	stack_mark = word;
+	telemetry_record(telemetry_stack, (uint16_t)stack_bytes_below_top(word),
+			(uint16_t)stack_bytes_below_top(_vStackBase));
+}
+
+void stack_paint(void){
+	stack_mark = _vStackTop;
+	stack_cursor = &_vStackBase[STACK_GUARD_WORDS];
+	stack_fill(_vStackBase, STACK_PAINT);
+}
+
+void stack_poll(void){
+	uint32_t *word;
+	uint32_t i;
+
+	for(word = _vStackBase; word < &_vStackBase[STACK_GUARD_WORDS]; word++){
+		if(*word != STACK_PAINT){
+			break;
+		}
+	}
+	if(word < &_vStackBase[STACK_GUARD_WORDS]){
+		if(!stack_guard_hit){
+			stack_guard_hit = true;
+			blackbox_record(blackbox_fault, blackbox_fault_stack, (uint32_t)word);
+			LOG_ERROR(STACK, "STACK GUARD WRITTEN AT 0x%x\r\n", (uint32_t)word);
+		}
+		if(word < stack_mark){
+			stack_lower_mark(word);
+		}
+	}
+
+	/**
+	 *  Everything from the mark up has been written already; only the painted words below it can tell anything new
+	 */
+	for(i = 0; (i < STACK_SCAN_WORDS) && (stack_cursor < stack_mark); i++){
+		if(*stack_cursor != STACK_PAINT){
+			stack_lower_mark(stack_cursor);
+			break;
+		}
+		stack_cursor++;
+	}
+	if(stack_cursor >= stack_mark){
+		stack_cursor = &_vStackBase[STACK_GUARD_WORDS];
+		stack_passes++;
+	}
+}
+
+void stack_get_stats(stack_stats_t *stats){
+	stats->size = stack_bytes_below_top(_vStackBase);
+	stats->used = stack_bytes_below_top(stack_mark);
+	stats->current = stack_bytes_below_top((const uint32_t *)__get_MSP());
+	stats->passes = stack_passes;
+	stats->guard_hit = stack_guard_hit;
+}
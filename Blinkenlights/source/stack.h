@@ -0,0 +1,82 @@
+/**
+ * \file    stack.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for the main stack high-water mark and overflow guard
+ *
+ *  ResetISR paints the unused part of the stack (_vStackBase up to its own frame) with STACK_PAINT. Every word a
+ *  function or an interrupt writes loses the pattern, so the lowest word that has lost it is the deepest the stack has
+ *  been. stack_poll() looks for it from the bottom up, STACK_SCAN_WORDS words per call, and starts over once it
+ *  reaches the mark found so far; a full pass over the 1 KB stack takes a couple of seconds of blink ticks and never
+ *  more than a few microseconds at a time. Scanning from the bottom is not fooled by a local array that was never
+ *  written, which leaves a painted hole higher up.
+ *
+ *  The lowest STACK_GUARD_WORDS words are the guard, checked in full on every call. A write there means the stack is
+ *  about to run into the heap: it is logged once in the black box as a blackbox_fault_stack record, and sent as a
+ *  telemetry_stack record like every new mark. Interrupts run on the same stack, so the mark includes their frames.
+ *  The shell command "stack" prints the state; tools/stack_report.py gives the static bound to compare it with
+ */
+
+#ifndef STACK_H_
+#define STACK_H_
+
+#include "fsl_common.h"
+
+/**
+ * \def STACK_PAINT
+ *  Pattern of an unused stack word: not a plausible address, count or return value
+ */
+#define STACK_PAINT\
+	(0xA5A5A5A5UL)
+
+/**
+ * \def STACK_GUARD_WORDS
+ *  Words at the bottom of the stack checked on every stack_poll()
+ */
+#define STACK_GUARD_WORDS\
+	(8U)
+
+/**
+ * \def STACK_SCAN_WORDS
+ *  Words above the guard checked per stack_poll()
+ */
+#define STACK_SCAN_WORDS\
+	(16U)
+
+/**
+ * \typedef stack_stats_t
+ *  Where the main stack stands
+ */
+typedef struct {
+	uint32_t size;			/* Stack size, bytes (_StackSize) */
+	uint32_t used;			/* High-water mark: bytes below _vStackTop that have been written */
+	uint32_t current;		/* Bytes in use by the caller of stack_get_stats() */
+	uint32_t passes;		/* Complete scans */
+	bool guard_hit;			/* A guard word was written */
+} stack_stats_t;
+
+/**
+ * \fn void stack_paint
+ * \brief Paint the stack below the caller's frame. Called by ResetISR with interrupts masked, after the bss fill
+ * \param N/A
+ * \return N/A
+ */
+void stack_paint(void);
+
+/**
+ * \fn void stack_poll
+ * \brief Check the guard and scan the next few words for the high-water mark. Call once per idle pass
+ * \param N/A
+ * \return N/A
+ */
+void stack_poll(void);
+
+/**
+ * \fn void stack_get_stats
+ * \brief Get the high-water mark and the guard state
+ * \param stats Where to store them
+ * \return N/A
+ */
+void stack_get_stats(stack_stats_t *stats);
+
+#endif /* STACK_H_ */
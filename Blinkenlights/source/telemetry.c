@@ -0,0 +1,155 @@
+/**
+ * \file    telemetry.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for the binary telemetry stream
+ */
+
+#include "telemetry.h"
+#include "crc.h"
+#include "sections.h"
+
+/**
+ *  Whether records are sent, and the rate limiter's remaining records (a token bucket refilled every tick)
+ */
+static bool telemetry_on;
+static uint32_t telemetry_tokens;
+
+/**
+ *  Record header state
+ */
+static uint16_t telemetry_sequence;
+static uint32_t telemetry_ticks;
+
+/**
+ *  Statistics
+ */
+static uint32_t telemetry_sent;
+static uint32_t telemetry_dropped;
+
+/**
+ * \fn static size_t telemetry_cobs_encode
+ * \brief Consistent Overhead Byte Stuffing: rewrite data so it contains no 0x00
+ * \param in The bytes to encode
+ * \param length Amount of bytes, at most 254 so one code byte covers each run
+ * \param out Where to store the encoded bytes, at least length + 1 bytes
+ * \return Amount of encoded bytes
+ *
+ *  Each 0x00 is replaced by the distance to the next one, and a leading code byte holds the distance to the first.
+ *  Runs for every frame, from SRAM
+ */
+RAMFUNC static size_t telemetry_cobs_encode(const uint8_t *in, size_t length, uint8_t *out){
+	uint8_t *code;
+	uint8_t *dst;
+
+	code = out;
+	dst = out + 1;
+	*code = 1;
+	while(length--){
+		if(*in == 0){
+			code = dst++;
+			*code = 1;
+		}
+		else{
+			*dst++ = *in;
+			(*code)++;
+		}
+		in++;
+	}
+
+	return (size_t)(dst - out);
+}
+
+status_t telemetry_enable(bool enable){
+	serial_config_t config;
+	status_t status;
+
+	if(enable && !serial_is_open(TELEMETRY_PORT)){
+		config.baud_rate = (TELEMETRY_PORT == serial_port0) ? 0 : TELEMETRY_BAUDRATE;
+		config.rx_mode = serial_rx_none;
+		config.rx_buffer = NULL;
+		config.rx_buffer_size = 0;
+		config.dma_channel = 0;
+		config.frame_callback = NULL;
+		status = serial_open(TELEMETRY_PORT, &config);
+		if(status != kStatus_Success){
+			return status;
+		}
+	}
+
+	telemetry_on = enable;
+	telemetry_tokens = TELEMETRY_BURST;
+
+	return kStatus_Success;
+}
+
+bool telemetry_is_enabled(void){
+	return telemetry_on;
+}
+
+void telemetry_tick(void){
+	telemetry_ticks++;
+	telemetry_tokens += TELEMETRY_RECORDS_PER_TICK;
+	if(telemetry_tokens > TELEMETRY_BURST){
+		telemetry_tokens = TELEMETRY_BURST;
+	}
+}
+
+size_t telemetry_encode(telemetry_type_t type, uint16_t sequence, uint16_t value0, uint16_t value1, uint8_t *frame){
+	uint8_t record[TELEMETRY_RECORD_SIZE + TELEMETRY_CRC_SIZE];
+	uint16_t crc;
+	size_t length;
+
+	record[0] = (uint8_t)type;
+	record[1] = 0;
+	record[2] = (uint8_t)sequence;
+	record[3] = (uint8_t)(sequence >> 8);
+	record[4] = (uint8_t)telemetry_ticks;
+	record[5] = (uint8_t)(telemetry_ticks >> 8);
+	record[6] = (uint8_t)(telemetry_ticks >> 16);
+	record[7] = (uint8_t)(telemetry_ticks >> 24);
+	record[8] = (uint8_t)value0;
+	record[9] = (uint8_t)(value0 >> 8);
+	record[10] = (uint8_t)value1;
+	record[11] = (uint8_t)(value1 >> 8);
+
+	crc = crc16_buffer(record, TELEMETRY_RECORD_SIZE);
+	record[12] = (uint8_t)crc;
+	record[13] = (uint8_t)(crc >> 8);
+
+	frame[0] = 0;
+	length = 1 + telemetry_cobs_encode(record, sizeof(record), &frame[1]);
+	frame[length++] = 0;
+
+	return length;
+}
+
+void telemetry_record(telemetry_type_t type, uint16_t value0, uint16_t value1){
+	uint8_t frame[TELEMETRY_FRAME_MAX];
+	uint16_t sequence;
+
+	if(!telemetry_on){
+		return;
+	}
+
+	/**
+	 *  A dropped record still takes a sequence number, so the host sees the gap
+	 */
+	sequence = telemetry_sequence++;
+	if(telemetry_tokens == 0){
+		telemetry_dropped++;
+		return;
+	}
+	telemetry_tokens--;
+
+	serial_write_blocking(TELEMETRY_PORT, frame, telemetry_encode(type, sequence, value0, value1, frame));
+	telemetry_sent++;
+}
+
+uint32_t telemetry_get_sent(void){
+	return telemetry_sent;
+}
+
+uint32_t telemetry_get_dropped(void){
+	return telemetry_dropped;
+}
@@ -0,0 +1,161 @@
+/**
+ * \file    telemetry.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for the binary telemetry stream
+ *
+ *  Each record is sent as one frame on TELEMETRY_PORT, interleaved with the console text if that is serial_port0:
+ *
+ *  	0x00 | COBS( record (TELEMETRY_RECORD_SIZE bytes) | CRC-16 (little endian) ) | 0x00
+ *
+ *  Record layout, all fields little endian:
+ *
+ *  	offset 0	type		telemetry_type_t
+ *  	offset 1	reserved	0
+ *  	offset 2	sequence	uint16_t, incremented for every record, sent or dropped
+ *  	offset 4	tick		uint32_t, 100 msec ticks since boot
+ *  	offset 8	value0		uint16_t, see telemetry_type_t
+ *  	offset 10	value1		uint16_t, see telemetry_type_t
+ *
+ *  The CRC is CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF) over the record. Console text never
+ *  contains 0x00, so the leading delimiter separates a frame from any text before it
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "serial.h"
+
+/**
+ * \def TELEMETRY_PORT
+ *  Serial port the records are sent on. serial_port0 shares the debug console
+ */
+#ifndef TELEMETRY_PORT
+#define TELEMETRY_PORT\
+	(serial_port0)
+#endif
+
+/**
+ * \def TELEMETRY_BAUDRATE
+ *  Baud rate for TELEMETRY_PORT when it is not serial_port0 (which keeps the console's rate)
+ */
+#ifndef TELEMETRY_BAUDRATE
+#define TELEMETRY_BAUDRATE\
+	(115200UL)
+#endif
+
+/**
+ * \def TELEMETRY_RECORDS_PER_TICK
+ *  Rate limit: how many records may be sent per 100 msec tick on average
+ */
+#ifndef TELEMETRY_RECORDS_PER_TICK
+#define TELEMETRY_RECORDS_PER_TICK\
+	(4U)
+#endif
+
+/**
+ * \def TELEMETRY_BURST
+ *  Rate limit: how many records may be sent back to back after a quiet period
+ */
+#ifndef TELEMETRY_BURST
+#define TELEMETRY_BURST\
+	(8U)
+#endif
+
+/**
+ * \def TELEMETRY_RECORD_SIZE
+ *  Size of one encoded record, before the CRC and the COBS framing
+ */
+#define TELEMETRY_RECORD_SIZE\
+	(12U)
+
+/**
+ * \def TELEMETRY_CRC_SIZE
+ *  Size of the CRC-16 that follows the record
+ */
+#define TELEMETRY_CRC_SIZE\
+	(2U)
+
+/**
+ * \def TELEMETRY_FRAME_MAX
+ *  Largest frame on the wire: COBS adds one byte per started 254 bytes, plus both 0x00 delimiters
+ */
+#define TELEMETRY_FRAME_MAX\
+	(TELEMETRY_RECORD_SIZE + TELEMETRY_CRC_SIZE + 1U + 2U)
+
+/**
+ * \typedef telemetry_type_t
+ *  Record types and the meaning of their values
+ */
+typedef enum {
+	telemetry_touch = 1,	/* value0 = raw TSI count, value1 = count after touch_offset */
+	telemetry_led = 2,		/* value0 = new color_t, value1 = previous color_t */
+	telemetry_stack = 3		/* value0 = new stack high-water mark, bytes, value1 = stack size, bytes */
+} telemetry_type_t;
+
+/**
+ * \fn void telemetry_enable
+ * \brief Start or stop sending records, opening TELEMETRY_PORT first if needed. Telemetry is off at boot
+ * \param enable true to start sending
+ * \return kStatus_Success, or the serial_open() error if TELEMETRY_PORT could not be opened
+ */
+status_t telemetry_enable(bool enable);
+
+/**
+ * \fn bool telemetry_is_enabled
+ * \brief Get whether records are being sent
+ * \param N/A
+ * \return true if telemetry is on
+ */
+bool telemetry_is_enabled(void);
+
+/**
+ * \fn void telemetry_tick
+ * \brief Advance the record timestamp and refill the rate limiter. Call once per 100 msec tick
+ * \param N/A
+ * \return N/A
+ */
+void telemetry_tick(void);
+
+/**
+ * \fn void telemetry_record
+ * \brief Send one record if telemetry is on and the rate limit allows it
+ * \param type The record type
+ * \param value0 First value, see telemetry_type_t
+ * \param value1 Second value, see telemetry_type_t
+ * \return N/A
+ */
+void telemetry_record(telemetry_type_t type, uint16_t value0, uint16_t value1);
+
+/**
+ * \fn size_t telemetry_encode
+ * \brief Build the complete frame for one record, delimiters included
+ * \param type The record type
+ * \param sequence The record sequence number
+ * \param value0 First value
+ * \param value1 Second value
+ * \param frame Where to store the frame, at least TELEMETRY_FRAME_MAX bytes
+ * \return Length of the frame
+ */
+size_t telemetry_encode(telemetry_type_t type, uint16_t sequence, uint16_t value0, uint16_t value1, uint8_t *frame);
+
+/**
+ * \fn uint32_t telemetry_get_sent
+ * \brief Get how many records have been sent
+ * \param N/A
+ * \return The amount of records sent
+ */
+uint32_t telemetry_get_sent(void);
+
+/**
+ * \fn uint32_t telemetry_get_dropped
+ * \brief Get how many records the rate limiter dropped. Dropped records still use up a sequence number
+ * \param N/A
+ * \return The amount of records dropped
+ */
+uint32_t telemetry_get_dropped(void);
+
+#endif /* TELEMETRY_H_ */
@@ -31,7 +31,30 @@ void init_onboard_touch_sensor(void){
 			TSI_GENCS_DVOLT(GENCS_DVOLT) |\
 			TSI_GENCS_EXTCHRG(GENCS_EXTCHRG) |\
 			TSI_GENCS_PS(GENCS_PS) |\
-			TSI_GENCS_NSCN(GENCS_NSCN) |\
+			TSI_GENCS_NSCN(params.gencs_nscn) |\
 			TSI_GENCS_TSIEN_MASK |
 			TSI_GENCS_EOSF_MASK;
  }
+
+unsigned int scan_onboard_touch_sensor(void){
+	unsigned int scanned_value;
+
+	GET_TOUCH();
+
+	return scanned_value;
+}
+
+void set_touch_scan_count(uint32_t nscn){
+	uint32_t gencs;
+
+	/**
+	 * Keep every field except NSCN, and never write back the write-1-to-clear flags
+	 */
+	gencs = TSI0->GENCS & ~(TSI_GENCS_NSCN_MASK | TSI_GENCS_EOSF_MASK | TSI_GENCS_OUTRGF_MASK);
+
+	/**
+	 * Disable the module while the scan count changes, then re-enable it
+	 */
+	TSI0->GENCS = gencs & ~TSI_GENCS_TSIEN_MASK;
+	TSI0->GENCS = gencs | TSI_GENCS_NSCN(nscn) | TSI_GENCS_TSIEN_MASK;
+}
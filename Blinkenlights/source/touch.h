@@ -8,6 +8,8 @@
 #ifndef TOUCH_H_
 #define TOUCH_H_
 
+#include "params.h"
+
 /**
  *
   * 		TSIEN:		GENCS configuration for enabling/disabling TSI module. 0 to disable, 1 to enable
@@ -83,7 +85,8 @@
 
 /**
  * \def GENCS_NSCN
- *  Configuration for electrode oscillator count used in making scan. Value can be any value between 1 and 32, inclusive
+ *  Configuration for electrode oscillator count used in making scan. Value can be any value between 1 and 32, inclusive.
+ *  Default for params.gencs_nscn
  */
 #define GENCS_NSCN\
 	(31UL)
@@ -97,7 +100,8 @@
 
 /**
  * \def TOUCH_OFFSET
- * The amount to offset each scanned value by. Calculated by having 0 offset and then printing the scanned value when touch sensor is not being touched
+ * The amount to offset each scanned value by. Calculated by having 0 offset and then printing the scanned value when touch sensor is not being touched.
+ * Default for params.touch_offset
  */
 #define TOUCH_OFFSET\
 	(700)
@@ -111,21 +115,23 @@
 
 /**
  * \def TOUCH_UNTOUCHED_MAX
- * Any scanned_value - TOUCH_OFFSET less than 100 will consider the touch sensor to be untouched
+ * Any scanned_value - TOUCH_OFFSET less than 100 will consider the touch sensor to be untouched. Default for params.touch_untouched_max
  */
 #define TOUCH_UNTOUCHED_MAX\
 	(100)
 
 /**
  * \def TOUCH_LEFT_MAX
- * Any scanned_value - TOUCH_OFFSET greater than TOUCH_UNTOUCHED_MAX but less than 500  will consider the touch sensor to be touched on the left side
+ * Any scanned_value - TOUCH_OFFSET greater than TOUCH_UNTOUCHED_MAX but less than 500  will consider the touch sensor to be touched on the left side.
+ * Default for params.touch_left_max
  */
 #define TOUCH_LEFT_MAX\
 	(500)
 
 /**
  * \def TOUCH_RIGHT_MIN
- * Any scanned_value - TOUCH_OFFSET greater than TOUCH_LEFT_MAX but less than 2000  will consider the touch sensor to be touched on the right side
+ * Any scanned_value - TOUCH_OFFSET greater than TOUCH_LEFT_MAX but less than 2000  will consider the touch sensor to be touched on the right side.
+ * Default for params.touch_right_min
  */
 #define TOUCH_RIGHT_MIN\
 	(2000)
@@ -150,9 +156,9 @@
 		 */\
 		while(!(TSI0->GENCS & TSI_GENCS_EOSF_MASK));\
 		/**
-		 * Now that scan has completed 32 times, store the data and subtract TOUCH_OFFSET
+		 * Now that scan has completed 32 times, store the data and subtract the offset
 		 */\
-		scanned_value = TOUCH_DATA - TOUCH_OFFSET;\
+		scanned_value = TOUCH_DATA - params.touch_offset;\
 		/**
 		 * Clear the end-of-scan flag
 		 */\
@@ -162,10 +168,10 @@
  /**
   * \def PRINTF_TOUCH(x)
   * \param The scanned_value after subtracting TOUCH_OFFSET to print to console
-  * Print the slider value after subtracting offset
+  * Log (at LOG_LEVEL_DEBUG) the slider value after subtracting offset
   */
 #define PRINTF_TOUCH(x)\
-	(PRINTF("SLIDER VALUE %d\r\n", x))
+	LOG_DEBUG(TOUCH, "SLIDER VALUE %d\r\n", x)
 
  /**
   * \fn void init_onboard_touch_sensor
@@ -184,4 +190,20 @@
   */
 void init_onboard_touch_sensor(void);
 
+/**
+ * \fn unsigned int scan_onboard_touch_sensor
+ * \brief Scan the capacitive touch sensor once
+ * \param N/A
+ * \return The scanned value after subtracting params.touch_offset
+ */
+unsigned int scan_onboard_touch_sensor(void);
+
+/**
+ * \fn void set_touch_scan_count
+ * \brief Change the GENCS NSCN field (electrode oscillator count per scan) without reinitializing the TSI module
+ * \param nscn The new NSCN field value, 0 to 31
+ * \return N/A
+ */
+void set_touch_scan_count(uint32_t nscn);
+
 #endif /* TOUCH_H_ */
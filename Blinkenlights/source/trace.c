@@ -0,0 +1,131 @@
+/**
+ * \file    trace.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for the Micro Trace Buffer (MTB) branch trace
+ */
+
+#include "MKL25Z4.h"
+#include "trace.h"
+
+#if (TRACE_BUFFER_SIZE > 0)
+/**
+ *  The trace buffer mtb.c reserves, aligned to its size
+ */
+extern uint8_t __mtb_buffer__[];
+#endif
+
+static uint32_t trace_size;
+static uint32_t trace_watermark;
+
+/**
+ * \fn static uint32_t trace_first
+ * \brief Find the oldest packet and count the packets in the buffer
+ * \param count Where to store the count
+ * \return Byte offset of the oldest packet in the buffer
+ *
+ *  POSITION holds the offset from MTB->BASE of the next write, and sets WRAP once the pointer has gone round
+ */
+static uint32_t trace_first(uint32_t *count){
+	uint32_t position;
+	uint32_t next;
+
+	if(trace_size == 0){
+		*count = 0;
+		return 0;
+	}
+
+	position = MTB->POSITION;
+	next = ((position & MTB_POSITION_POINTER_MASK) + MTB->BASE) & (trace_size - 1);
+	if(position & MTB_POSITION_WRAP_MASK){
+		*count = trace_size / TRACE_PACKET_BYTES;
+		return next;
+	}
+	*count = next / TRACE_PACKET_BYTES;
+
+	return 0;
+}
+
+status_t trace_configure(uint32_t size, uint32_t watermark){
+#if (TRACE_BUFFER_SIZE > 0)
+	uint32_t offset;
+	uint32_t mask;
+
+	if((size < TRACE_MIN_SIZE) || (size > TRACE_BUFFER_SIZE) || ((size & (size - 1)) != 0) ||
+			(watermark >= (size / TRACE_PACKET_BYTES))){
+		return kStatus_InvalidArgument;
+	}
+
+	/**
+	 *  MASTER[MASK] keeps the pointer within 2^(MASK + 4) bytes; the buffer is aligned to its size, so that is the
+	 *  start of the buffer on. POSITION and FLOW may only change with tracing stopped
+	 */
+	for(mask = 0; (TRACE_MIN_SIZE << mask) < size; mask++){
+	}
+	MTB->MASTER = 0;
+	offset = (uint32_t)__mtb_buffer__ - MTB->BASE;
+	MTB->POSITION = offset & MTB_POSITION_POINTER_MASK;
+	MTB->FLOW = (watermark != 0) ?
+			(((offset + (watermark * TRACE_PACKET_BYTES)) & MTB_FLOW_WATERMARK_MASK) | MTB_FLOW_AUTOSTOP_MASK) : 0;
+	MTB->MASTER = MTB_MASTER_MASK(mask);
+	trace_size = size;
+	trace_watermark = watermark;
+
+	return kStatus_Success;
+#else
+	return kStatus_Fail;
+#endif
+}
+
+void trace_start(void){
+	if(trace_size != 0){
+		MTB->MASTER |= MTB_MASTER_EN_MASK;
+	}
+}
+
+void trace_stop(void){
+	MTB->MASTER &= ~MTB_MASTER_EN_MASK;
+}
+
+bool trace_is_running(void){
+	return (MTB->MASTER & MTB_MASTER_EN_MASK) != 0;
+}
+
+bool trace_at(uint32_t index, trace_packet_t *packet){
+#if (TRACE_BUFFER_SIZE > 0)
+	const trace_packet_t *packets;
+	uint32_t count;
+	uint32_t first;
+
+	first = trace_first(&count);
+	if(index >= count){
+		return false;
+	}
+	packets = (const trace_packet_t *)__mtb_buffer__;
+	*packet = packets[((first / TRACE_PACKET_BYTES) + index) % (trace_size / TRACE_PACKET_BYTES)];
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+uint32_t trace_read(trace_packet_t *packets, uint32_t max){
+	uint32_t count;
+	uint32_t skip;
+	uint32_t i;
+
+	(void)trace_first(&count);
+	skip = (count > max) ? (count - max) : 0;
+	for(i = 0; (skip + i < count) && trace_at(skip + i, &packets[i]); i++){
+	}
+
+	return i;
+}
+
+void trace_get_stats(trace_stats_t *stats){
+	stats->size = trace_size;
+	stats->watermark = trace_watermark;
+	(void)trace_first(&stats->packets);
+	stats->running = trace_is_running();
+}
@@ -0,0 +1,155 @@
+/**
+ * \file    trace.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for the Micro Trace Buffer (MTB) branch trace
+ *
+ *  The MTB writes one 8-byte packet to SRAM for every branch the core takes that is not sequential: the source
+ *  address (bit 0 set for an exception entry or return) and the destination (bit 0 set on the first packet after
+ *  tracing starts). It costs no instructions, only SRAM write cycles the core rarely competes for. The buffer is
+ *  __mtb_buffer__, reserved by mtb.c in .mtb_buffer_default and aligned to its size; the MTB wraps within the
+ *  configured size, so the buffer always holds the newest size / 8 branches.
+ *
+ *  main() starts it wrapping over the whole buffer at boot. Narrow it down with trace_configure() and
+ *  trace_start()/trace_stop() around a suspicious region; a watermark stops it by itself after that many packets.
+ *  fault_capture() stops it first thing and saves the newest TRACE_SAVE_PACKETS packets with the fault record, so the
+ *  last branches before a HardFault survive the reset. The shell commands "trace dump" and "fault" print packets as
+ *  "MTB source destination" lines, oldest first; tools/mtb_decode.py turns them and the .axf into function names
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include "fsl_common.h"
+
+/**
+ * \def TRACE_BUFFER_SIZE
+ *  Bytes in __mtb_buffer__: __MTB_BUFFER_SIZE, with the default mtb.c uses, or 0 with __MTB_DISABLE
+ */
+#if defined(__MTB_DISABLE)
+#define TRACE_BUFFER_SIZE\
+	(0U)
+#elif defined(__MTB_BUFFER_SIZE)
+#define TRACE_BUFFER_SIZE\
+	(__MTB_BUFFER_SIZE)
+#else
+#define TRACE_BUFFER_SIZE\
+	(128U)
+#endif
+
+/**
+ * \def TRACE_PACKET_BYTES
+ *  Bytes per packet: source and destination word
+ */
+#define TRACE_PACKET_BYTES\
+	(8U)
+
+/**
+ * \def TRACE_MIN_SIZE
+ *  Smallest trace size MASTER[MASK] can set
+ */
+#define TRACE_MIN_SIZE\
+	(16U)
+
+/**
+ * \def TRACE_SAVE_PACKETS
+ *  Packets saved with a fault record, at most 32 so the record fits in .noinit with a large buffer
+ */
+#define TRACE_SAVE_PACKETS\
+	(MIN(TRACE_BUFFER_SIZE / TRACE_PACKET_BYTES, 32U))
+
+/**
+ * \def TRACE_SOURCE_EXCEPTION
+ *  Source bit 0: the branch was an exception entry or return
+ */
+#define TRACE_SOURCE_EXCEPTION\
+	(1UL)
+
+/**
+ * \def TRACE_DESTINATION_START
+ *  Destination bit 0: first packet after tracing started
+ */
+#define TRACE_DESTINATION_START\
+	(1UL)
+
+/**
+ * \typedef trace_packet_t
+ *  One branch, as the MTB writes it
+ */
+typedef struct {
+	uint32_t source;
+	uint32_t destination;
+} trace_packet_t;
+
+/**
+ * \typedef trace_stats_t
+ *  Where the trace stands
+ */
+typedef struct {
+	uint32_t size;			/* Bytes the trace wraps within, 0 until trace_configure() succeeds */
+	uint32_t watermark;		/* Packets after which it stops by itself, 0 for none */
+	uint32_t packets;		/* Packets in the buffer */
+	bool running;
+} trace_stats_t;
+
+/**
+ * \fn status_t trace_configure
+ * \brief Stop tracing and set where the next trace_start() writes from
+ * \param size Bytes to wrap within: a power of 2 from TRACE_MIN_SIZE to TRACE_BUFFER_SIZE
+ * \param watermark Packets after which tracing stops by itself, or 0 to wrap until trace_stop()
+ * \return kStatus_Success, kStatus_InvalidArgument for a size or watermark out of range, or kStatus_Fail without a
+ * buffer
+ */
+status_t trace_configure(uint32_t size, uint32_t watermark);
+
+/**
+ * \fn void trace_start
+ * \brief Start or resume tracing where it stopped
+ * \param N/A
+ * \return N/A
+ */
+void trace_start(void);
+
+/**
+ * \fn void trace_stop
+ * \brief Stop tracing, freezing the buffer. Safe to call from a fault handler
+ * \param N/A
+ * \return N/A
+ */
+void trace_stop(void);
+
+/**
+ * \fn bool trace_is_running
+ * \brief Tell whether the MTB is tracing; a watermark stops it without trace_stop()
+ * \param N/A
+ * \return true if it is
+ */
+bool trace_is_running(void);
+
+/**
+ * \fn bool trace_at
+ * \brief Get a packet of the buffer by age. Stop tracing before, or reading traces itself
+ * \param index 0 for the oldest packet
+ * \param packet Where to store it
+ * \return false past the newest packet
+ */
+bool trace_at(uint32_t index, trace_packet_t *packet);
+
+/**
+ * \fn uint32_t trace_read
+ * \brief Copy the newest packets out of the buffer, oldest first. Stop tracing before, or the copy traces itself
+ * \param packets Where to store them
+ * \param max Most packets to copy
+ * \return Packets copied
+ */
+uint32_t trace_read(trace_packet_t *packets, uint32_t max);
+
+/**
+ * \fn void trace_get_stats
+ * \brief Describe the trace
+ * \param stats Where to store the description
+ * \return N/A
+ */
+void trace_get_stats(trace_stats_t *stats);
+
+#endif /* TRACE_H_ */
@@ -0,0 +1,54 @@
+/**
+ * \file    update.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for handing over to the resident bootloader
+ */
+
+#include <string.h>
+#include "MKL25Z4.h"
+#include "fsl_flash.h"
+#include "update.h"
+#include "flash_async.h"
+#include "blackbox.h"
+#include "clocks.h"
+
+status_t update_request(void){
+	const uint32_t *descriptor;
+	flash_config_t flash;
+	uint32_t word;
+	uint32_t primask;
+	status_t status;
+
+	descriptor = (const uint32_t *)UPDATE_DESCRIPTOR_ADDRESS;
+	if(descriptor[0] != UPDATE_DESCRIPTOR_MAGIC){
+		return kStatus_Update_NoBootloader;
+	}
+	if(flash_async_busy()){
+		return kStatus_FlashAsync_Busy;
+	}
+	(void)blackbox_flush();
+
+	/**
+	 *  Clearing bits of an erased word needs no erase, so the rest of the descriptor stays as it is
+	 */
+	if(descriptor[3] != 0){
+		memset(&flash, 0, sizeof(flash));
+		if(FLASH_Init(&flash) != kStatus_FLASH_Success){
+			return kStatus_Update_FlashError;
+		}
+		word = 0;
+		(void)clocks_burst_begin();
+		primask = DisableGlobalIRQ();
+		status = FLASH_Program(&flash, UPDATE_REQUEST_ADDRESS, &word, sizeof(word));
+		EnableGlobalIRQ(primask);
+		clocks_burst_end();
+		if(status != kStatus_FLASH_Success){
+			return kStatus_Update_FlashError;
+		}
+	}
+
+	NVIC_SystemReset();
+
+	return kStatus_Success;
+}
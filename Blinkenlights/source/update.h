@@ -0,0 +1,54 @@
+/**
+ * \file    update.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for handing over to the resident bootloader
+ *
+ *  The bootloader (Bootloader/source/boot.h) keeps an image descriptor in the flash sector below PROGRAM_FLASH and
+ *  starts the application only while the descriptor's request word is erased. Clearing that word and resetting makes
+ *  it stay and wait for tools/boot_upload.py instead
+ */
+
+#ifndef UPDATE_H_
+#define UPDATE_H_
+
+#include "fsl_common.h"
+
+/**
+ * \def UPDATE_DESCRIPTOR_ADDRESS
+ *  Bootloader image descriptor, BOOT_DESCRIPTOR_ADDRESS in Bootloader/source/boot.h
+ */
+#define UPDATE_DESCRIPTOR_ADDRESS\
+	(0x1C00U)
+
+/**
+ * \def UPDATE_DESCRIPTOR_MAGIC
+ *  First word of a programmed descriptor, BOOT_DESCRIPTOR_MAGIC
+ */
+#define UPDATE_DESCRIPTOR_MAGIC\
+	(0x424F4F54UL)
+
+/**
+ * \def UPDATE_REQUEST_ADDRESS
+ *  The descriptor's request word
+ */
+#define UPDATE_REQUEST_ADDRESS\
+	(UPDATE_DESCRIPTOR_ADDRESS + 12U)
+
+/**
+ *  Error codes for the bootloader hand-over
+ */
+enum {
+	kStatus_Update_NoBootloader = MAKE_STATUS(kStatusGroup_ApplicationRangeStart + 2, 0),	/* No valid descriptor */
+	kStatus_Update_FlashError = MAKE_STATUS(kStatusGroup_ApplicationRangeStart + 2, 1)		/* Programming failed */
+};
+
+/**
+ * \fn status_t update_request
+ * \brief Flush the black-box log, clear the descriptor's request word and reset into the bootloader
+ * \param N/A
+ * \return Only returns on failure: kStatus_Update_NoBootloader, kStatus_FlashAsync_Busy or kStatus_Update_FlashError
+ */
+status_t update_request(void);
+
+#endif /* UPDATE_H_ */
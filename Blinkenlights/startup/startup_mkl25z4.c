@@ -83,6 +83,13 @@ __attribute__ ((used,section(".FlashConfig"))) const struct {
 extern void SystemInit(void);
 #endif // (__USE_CMSIS)
 
+//*****************************************************************************
+// Declaration of the boot trace and stack painting functions, which ResetISR
+// calls whether or not __USE_CMSIS is defined
+//*****************************************************************************
+extern void boottime_start(void);
+extern void stack_paint(void);
+
 //*****************************************************************************
 // Forward declaration of the core exception handlers.
 // When the application defines a handler (with the same name), this will
@@ -260,22 +267,59 @@ void (* const g_pfnVectors[])(void) = {
 // are written as separate functions rather than being inlined within the
 // ResetISR() function in order to cope with MCUs with multiple banks of
 // memory.
-//*****************************************************************************
-__attribute__ ((section(".after_vectors.init_data")))
+//
+// Both move 16 bytes per iteration with a four register LDM/STM, then the
+// last 0 to 3 words one at a time. The linker script aligns every section to
+// 4 bytes, so len is always a whole number of words. They are naked so the
+// -O0 build does not keep the pointers on the stack: the word loops they
+// replaced took 27 (data) and 20 (bss) cycles per word, these take 4.3 and
+// 2 with one flash wait state (tools/m0sim.py startup). AAPCS puts the
+// arguments in r0-r2.
+//*****************************************************************************
+__attribute__ ((section(".after_vectors.init_data"), naked))
 void data_init(unsigned int romstart, unsigned int start, unsigned int len) {
-	unsigned int *pulDest = (unsigned int*) start;
-	unsigned int *pulSrc = (unsigned int*) romstart;
-	unsigned int loop;
-	for (loop = 0; loop < len; loop = loop + 4)
-		*pulDest++ = *pulSrc++;
-}
-
-__attribute__ ((section(".after_vectors.init_bss")))
+    __asm volatile (
+        "    push    {r4, r5, r6, r7, lr}\n"
+        "    lsrs    r7, r2, #4\n"
+        "    lsls    r7, r7, #4\n"
+        "    adds    r7, r1, r7\n"          // End of the 16-byte blocks
+        "    adds    r2, r1, r2\n"          // End of the section
+        "    b       2f\n"
+        "1:  ldmia   r0!, {r3, r4, r5, r6}\n"
+        "    stmia   r1!, {r3, r4, r5, r6}\n"
+        "2:  cmp     r1, r7\n"
+        "    bne     1b\n"
+        "    b       4f\n"
+        "3:  ldmia   r0!, {r3}\n"
+        "    stmia   r1!, {r3}\n"
+        "4:  cmp     r1, r2\n"
+        "    bne     3b\n"
+        "    pop     {r4, r5, r6, r7, pc}\n"
+    );
+}
+
+__attribute__ ((section(".after_vectors.init_bss"), naked))
 void bss_init(unsigned int start, unsigned int len) {
-	unsigned int *pulDest = (unsigned int*) start;
-	unsigned int loop;
-	for (loop = 0; loop < len; loop = loop + 4)
-		*pulDest++ = 0;
+    __asm volatile (
+        "    push    {r4, r5, r6, r7, lr}\n"
+        "    lsrs    r7, r1, #4\n"
+        "    lsls    r7, r7, #4\n"
+        "    adds    r7, r0, r7\n"          // End of the 16-byte blocks
+        "    adds    r1, r0, r1\n"          // End of the section
+        "    movs    r3, #0\n"
+        "    movs    r4, #0\n"
+        "    movs    r5, #0\n"
+        "    movs    r6, #0\n"
+        "    b       2f\n"
+        "1:  stmia   r0!, {r3, r4, r5, r6}\n"
+        "2:  cmp     r0, r7\n"
+        "    bne     1b\n"
+        "    b       4f\n"
+        "3:  stmia   r0!, {r3}\n"
+        "4:  cmp     r0, r1\n"
+        "    bne     3b\n"
+        "    pop     {r4, r5, r6, r7, pc}\n"
+    );
 }
 
 //*****************************************************************************
@@ -310,6 +354,9 @@ void ResetISR(void) {
     *((volatile unsigned int *)0x40048100) = 0x00u;
 #endif // (__USE_CMSIS)
 
+    // Start the boot phase timer (source/boottime.c)
+    boottime_start();
+
     //
     // Copy the data sections from flash to SRAM.
     //
@@ -335,6 +382,9 @@ void ResetISR(void) {
 		bss_init(ExeAddr, SectionLen);
 	}
 
+    // Paint the free stack for the high-water mark (source/stack.c)
+    stack_paint();
+
 #if !defined (__USE_CMSIS)
 // Assume that if __USE_CMSIS defined, then CMSIS SystemInit code
 // will setup the VTOR register
@@ -473,7 +473,7 @@ int DbgConsole_Scanf(char *fmt_ptr, ...)
 /* See fsl_debug_console.h for documentation of this function. */
 int DbgConsole_Getchar(void)
 {
-    char ch;
+    char ch = 0;
     /* Do nothing if the debug UART is not initialized. */
     if (s_debugConsole.type == DEBUG_CONSOLE_DEVICE_TYPE_NONE)
     {
@@ -530,9 +530,67 @@ static void DbgConsole_PrintfPaddingCharacter(
     }
 }
 
+#if PRINTF_FAST_RADIX_ENABLE
+/*!
+ * @brief Divides a 32-bit unsigned number by 10 without using a hardware or library divide.
+ *
+ * Multiplies by an approximation of 0.8 built from shifts and adds, scales by 1/8, then corrects
+ * the quotient using the remainder. Exact for every 32-bit input.
+ *
+ * @param[in]  n    The dividend.
+ * @param[out] rem  The remainder n % 10.
+
+ * @return n / 10.
+ */
+static uint32_t DbgConsole_DivideBy10(uint32_t n, uint32_t *rem)
+{
+    uint32_t q;
+    uint32_t r;
+
+    q = (n >> 1) + (n >> 2);
+    q = q + (q >> 4);
+    q = q + (q >> 8);
+    q = q + (q >> 16);
+    q = q >> 3;
+    r = n - (((q << 2) + q) << 1);
+    if (r > 9U)
+    {
+        q++;
+        r -= 10U;
+    }
+    *rem = r;
+    return q;
+}
+
+/*!
+ * @brief Returns log2 of the radix if it is a power of two, otherwise 0.
+ *
+ * @param[in] radix  The radix to be converted to.
+
+ * @return Number of bits per digit, or 0 if the radix is not a power of two.
+ */
+static uint32_t DbgConsole_RadixShift(int32_t radix)
+{
+    switch (radix)
+    {
+        case 2:
+            return 1U;
+        case 8:
+            return 3U;
+        case 16:
+            return 4U;
+        default:
+            return 0U;
+    }
+}
+#endif /* PRINTF_FAST_RADIX_ENABLE */
+
 /*!
  * @brief Converts a radix number to a string and return its length.
  *
+ * The digits are stored least significant first, starting at numstr[1]; numstr[0] is a terminator
+ * so the caller can print the string backwards from numstr[length].
+ *
  * @param[in] numstr    Converted string of the number.
  * @param[in] nump      Pointer to the number.
  * @param[in] neg       Polarity of the number.
@@ -545,21 +603,21 @@ static int32_t DbgConsole_ConvertRadixNumToString(char *numstr, void *nump, int3
 {
 #if PRINTF_ADVANCED_ENABLE
     int64_t a;
-    int64_t b;
-    int64_t c;
-
     uint64_t ua;
     uint64_t ub;
     uint64_t uc;
 #else
     int32_t a;
-    int32_t b;
-    int32_t c;
-
     uint32_t ua;
     uint32_t ub;
     uint32_t uc;
 #endif /* PRINTF_ADVANCED_ENABLE */
+#if PRINTF_FAST_RADIX_ENABLE
+    uint32_t shift;
+    uint32_t mask;
+    uint32_t ua32;
+    uint32_t uc32;
+#endif /* PRINTF_FAST_RADIX_ENABLE */
 
     int32_t nlen;
     char *nstrp;
@@ -568,46 +626,16 @@ static int32_t DbgConsole_ConvertRadixNumToString(char *numstr, void *nump, int3
     nstrp = numstr;
     *nstrp++ = '\0';
 
+    /* Signed values are converted through their magnitude; the caller prints the sign. */
     if (neg)
     {
 #if PRINTF_ADVANCED_ENABLE
         a = *(int64_t *)nump;
+        ua = (a < 0) ? ((uint64_t)0 - (uint64_t)a) : (uint64_t)a;
 #else
         a = *(int32_t *)nump;
+        ua = (a < 0) ? (0U - (uint32_t)a) : (uint32_t)a;
 #endif /* PRINTF_ADVANCED_ENABLE */
-        if (a == 0)
-        {
-            *nstrp = '0';
-            ++nlen;
-            return nlen;
-        }
-        while (a != 0)
-        {
-#if PRINTF_ADVANCED_ENABLE
-            b = (int64_t)a / (int64_t)radix;
-            c = (int64_t)a - ((int64_t)b * (int64_t)radix);
-            if (c < 0)
-            {
-                uc = (uint64_t)c;
-                c = (int64_t)(~uc) + 1 + '0';
-            }
-#else
-            b = a / radix;
-            c = a - (b * radix);
-            if (c < 0)
-            {
-                uc = (uint32_t)c;
-                c = (uint32_t)(~uc) + 1 + '0';
-            }
-#endif /* PRINTF_ADVANCED_ENABLE */
-            else
-            {
-                c = c + '0';
-            }
-            a = b;
-            *nstrp++ = (char)c;
-            ++nlen;
-        }
     }
     else
     {
@@ -616,34 +644,65 @@ static int32_t DbgConsole_ConvertRadixNumToString(char *numstr, void *nump, int3
 #else
         ua = *(uint32_t *)nump;
 #endif /* PRINTF_ADVANCED_ENABLE */
-        if (ua == 0)
+    }
+
+    if (ua == 0)
+    {
+        *nstrp = '0';
+        ++nlen;
+        return nlen;
+    }
+
+#if PRINTF_FAST_RADIX_ENABLE
+    shift = DbgConsole_RadixShift(radix);
+    if (shift != 0U)
+    {
+        mask = ((uint32_t)1U << shift) - 1U;
+        while (ua != 0)
         {
-            *nstrp = '0';
+            uc32 = (uint32_t)ua & mask;
+            ua >>= shift;
+            *nstrp++ = (char)((uc32 < 10U) ? (uc32 + '0') : (uc32 - 10U + (use_caps ? 'A' : 'a')));
             ++nlen;
-            return nlen;
         }
-        while (ua != 0)
+        return nlen;
+    }
+
+    /* Radix 10 values that fit in 32 bits never touch the divide helper. */
+    if ((radix == 10) && (ua <= 0xFFFFFFFFU))
+    {
+        ua32 = (uint32_t)ua;
+        while (ua32 != 0U)
         {
+            ua32 = DbgConsole_DivideBy10(ua32, &uc32);
+            *nstrp++ = (char)(uc32 + '0');
+            ++nlen;
+        }
+        return nlen;
+    }
+#endif /* PRINTF_FAST_RADIX_ENABLE */
+
+    while (ua != 0)
+    {
 #if PRINTF_ADVANCED_ENABLE
-            ub = (uint64_t)ua / (uint64_t)radix;
-            uc = (uint64_t)ua - ((uint64_t)ub * (uint64_t)radix);
+        ub = (uint64_t)ua / (uint64_t)radix;
+        uc = (uint64_t)ua - ((uint64_t)ub * (uint64_t)radix);
 #else
-            ub = ua / (uint32_t)radix;
-            uc = ua - (ub * (uint32_t)radix);
+        ub = ua / (uint32_t)radix;
+        uc = ua - (ub * (uint32_t)radix);
 #endif /* PRINTF_ADVANCED_ENABLE */
 
-            if (uc < 10)
-            {
-                uc = uc + '0';
-            }
-            else
-            {
-                uc = uc - 10 + (use_caps ? 'A' : 'a');
-            }
-            ua = ub;
-            *nstrp++ = (char)uc;
-            ++nlen;
+        if (uc < 10)
+        {
+            uc = uc + '0';
         }
+        else
+        {
+            uc = uc - 10 + (use_caps ? 'A' : 'a');
+        }
+        ua = ub;
+        *nstrp++ = (char)uc;
+        ++nlen;
     }
     return nlen;
 }
@@ -84,6 +84,18 @@
 #define SCANF_ADVANCED_ENABLE 0U
 #endif /* SCANF_ADVANCED_ENABLE */
 
+/*! @brief Definition to convert numbers without hardware division.
+ *
+ * Cortex-M0+ has no divide instruction, so every digit produced by a plain '/' costs a call to the
+ * library division helper. When enabled, radix 10 uses a shift-and-add reciprocal and power-of-two
+ * radices use shift/mask. Output is identical either way. "python3 tools/m0sim.py printf" counts
+ * the digit loop at 48 MHz with one flash wait state: 2368 -> 364 cycles for %u of 4294967295,
+ * 1880 -> 136 for %x of 0xDEADBEEF.
+ */
+#ifndef PRINTF_FAST_RADIX_ENABLE
+#define PRINTF_FAST_RADIX_ENABLE 1U
+#endif /* PRINTF_FAST_RADIX_ENABLE */
+
 #if SDK_DEBUGCONSOLE /* Select printf, scanf, putchar, getchar of SDK version. */
 #define PRINTF DbgConsole_Printf
 #define SCANF DbgConsole_Scanf
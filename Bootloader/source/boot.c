@@ -0,0 +1,745 @@
+/**
+ * \file    boot.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Resident bootloader: checks and starts the application, or receives a new one over UART0
+ *
+ *  Runs on the reset clocks (FEI, about 21 MHz core) with interrupts masked throughout; UART0 runs from the 8 MHz
+ *  crystal so the baud rate is exact. Received bytes are moved into a ring by DMA, which keeps going while the CPU
+ *  executes the RAM-resident flash routine, so the next request is received while the previous chunk programs
+ */
+
+#include "MKL25Z4.h"
+#include "boot.h"
+
+/**
+ * \def BOOT_OSC_FREQ
+ *  FRDM-KL25Z crystal frequency
+ */
+#define BOOT_OSC_FREQ\
+	(8000000U)
+
+/**
+ * \def BOOT_CORE_FREQ
+ *  Core clock out of reset: the 32.768 kHz IRC times the FLL factor 640
+ */
+#define BOOT_CORE_FREQ\
+	(20971520U)
+
+/**
+ * \def BOOT_RING_SIZE
+ *  UART0 receive DMA ring, a power of 2 that holds several requests
+ */
+#define BOOT_RING_SIZE\
+	(1024U)
+
+/**
+ * \def BOOT_DMA_DMOD
+ *  DMOD value that wraps the DMA destination at BOOT_RING_SIZE
+ */
+#define BOOT_DMA_DMOD\
+	(7U)
+
+/**
+ * \def BOOT_DMA_BCR_MAX
+ *  Largest DMA byte count
+ */
+#define BOOT_DMA_BCR_MAX\
+	(0xFFFFFU)
+
+/**
+ * \def BOOT_BYTE_TIMEOUT_MS
+ *  Longest gap inside a request
+ */
+#define BOOT_BYTE_TIMEOUT_MS\
+	(50U)
+
+/**
+ * \def BOOT_ERASE_SECTOR
+ *  FTFA command: erase flash sector
+ */
+#define BOOT_ERASE_SECTOR\
+	(0x09U)
+
+/**
+ * \def BOOT_PROGRAM_LONGWORD
+ *  FTFA command: program longword
+ */
+#define BOOT_PROGRAM_LONGWORD\
+	(0x06U)
+
+/**
+ * \def BOOT_FLASH_ERRORS
+ *  FSTAT bits that mean a command failed
+ */
+#define BOOT_FLASH_ERRORS\
+	(FTFA_FSTAT_ACCERR_MASK | FTFA_FSTAT_FPVIOL_MASK | FTFA_FSTAT_MGSTAT0_MASK)
+
+/**
+ * \def BOOT_NO_FAILURE
+ *  boot_failed_offset when nothing failed
+ */
+#define BOOT_NO_FAILURE\
+	(0xFFFFFFFFUL)
+
+/**
+ * \def BOOT_RAMFUNC
+ *  Copied to SRAM by ResetISR(); long_call because SRAM is out of BL range of flash
+ */
+#define BOOT_RAMFUNC\
+	__attribute__((section(".ramfunc.boot"), noinline, long_call))
+
+/**
+ *  CRC-32 (reflected 0x04C11DB7), one entry per nibble
+ */
+static const uint32_t boot_crc_table[16] = {
+	0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+	0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+static uint8_t boot_ring[BOOT_RING_SIZE] __attribute__((aligned(BOOT_RING_SIZE)));
+
+/**
+ *  Bytes received before the DMA byte count was last reloaded, and bytes taken out of the ring
+ */
+static uint32_t boot_rx_base;
+static uint32_t boot_rx_read;
+
+/**
+ *  The request being handled. The payload is word aligned so DATA can be programmed straight from it
+ */
+static uint8_t boot_command;
+static uint32_t boot_length;
+static uint32_t boot_payload[(BOOT_PAYLOAD_MAX + 3) / 4];
+
+/**
+ *  From BEGIN
+ */
+static uint32_t boot_image_size;
+static uint32_t boot_image_crc;
+
+/**
+ *  Offset of a chunk that failed to program, reported in the next answer
+ */
+static uint32_t boot_failed_offset = BOOT_NO_FAILURE;
+
+static uint32_t boot_ms;
+
+/**
+ * \fn static uint32_t boot_crc32
+ * \brief Continue a CRC-32
+ * \param crc 0xFFFFFFFF to start
+ * \param data The bytes
+ * \param length Amount of bytes
+ * \return The CRC so far; XOR with 0xFFFFFFFF at the end
+ */
+static uint32_t boot_crc32(uint32_t crc, const uint8_t *data, uint32_t length){
+	while(length-- != 0){
+		crc ^= *data++;
+		crc = (crc >> 4) ^ boot_crc_table[crc & 0xF];
+		crc = (crc >> 4) ^ boot_crc_table[crc & 0xF];
+	}
+
+	return crc;
+}
+
+/**
+ * \fn static uint32_t boot_millis
+ * \brief Milliseconds, counted by polling the SysTick wrap flag. Runs slow while flash commands execute
+ * \param N/A
+ * \return The count
+ */
+static uint32_t boot_millis(void){
+	if(SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk){
+		boot_ms++;
+	}
+
+	return boot_ms;
+}
+
+/**
+ * \fn static uint8_t boot_flash_run
+ * \brief Run FTFA commands back to back from SRAM
+ * \param command BOOT_ERASE_SECTOR or BOOT_PROGRAM_LONGWORD
+ * \param address Address of the first command
+ * \param words Data to program, 0 for an erase
+ * \param count Amount of commands
+ * \return FSTAT after the last command that ran
+ */
+BOOT_RAMFUNC static uint8_t boot_flash_run(uint8_t command, uint32_t address, const uint32_t *words, uint32_t count){
+	uint32_t word;
+	uint8_t fstat;
+
+	FTFA->FSTAT = FTFA_FSTAT_ACCERR_MASK | FTFA_FSTAT_FPVIOL_MASK;
+	do{
+		FTFA->FCCOB0 = command;
+		FTFA->FCCOB1 = (uint8_t)(address >> 16);
+		FTFA->FCCOB2 = (uint8_t)(address >> 8);
+		FTFA->FCCOB3 = (uint8_t)address;
+		if(words != 0){
+			word = *words++;
+			FTFA->FCCOB4 = (uint8_t)(word >> 24);
+			FTFA->FCCOB5 = (uint8_t)(word >> 16);
+			FTFA->FCCOB6 = (uint8_t)(word >> 8);
+			FTFA->FCCOB7 = (uint8_t)word;
+		}
+		address += 4;
+
+		FTFA->FSTAT = FTFA_FSTAT_CCIF_MASK;
+		while(!(FTFA->FSTAT & FTFA_FSTAT_CCIF_MASK)){
+		}
+		fstat = FTFA->FSTAT;
+	} while((--count != 0) && !(fstat & BOOT_FLASH_ERRORS));
+
+	/**
+	 *  Drop flash cache lines holding the old contents
+	 */
+	MCM->PLACR |= MCM_PLACR_CFCC_MASK;
+
+	return fstat;
+}
+
+/**
+ * \fn static bool boot_erase
+ * \brief Erase one sector
+ * \param address Sector address
+ * \return true on success
+ */
+static bool boot_erase(uint32_t address){
+	return !(boot_flash_run(BOOT_ERASE_SECTOR, address, 0, 1) & BOOT_FLASH_ERRORS);
+}
+
+/**
+ * \fn static bool boot_program
+ * \brief Program erased flash
+ * \param address First longword
+ * \param words The data
+ * \param count Amount of longwords
+ * \return true on success
+ */
+static bool boot_program(uint32_t address, const uint32_t *words, uint32_t count){
+	return !(boot_flash_run(BOOT_PROGRAM_LONGWORD, address, words, count) & BOOT_FLASH_ERRORS);
+}
+
+/**
+ * \fn static bool boot_image_valid
+ * \brief Check the application image: CRC-32, initial stack pointer in SRAM and reset vector inside the image
+ * \param size Image bytes
+ * \param crc Expected CRC-32
+ * \return true if it may be started
+ */
+static bool boot_image_valid(uint32_t size, uint32_t crc){
+	const uint32_t *vectors;
+
+	vectors = (const uint32_t *)BOOT_APP_BASE;
+	if((size < 8) || (size > BOOT_APP_LIMIT - BOOT_APP_BASE)){
+		return false;
+	}
+	if((vectors[0] <= 0x1FFFF000U) || (vectors[0] > 0x20003000U) || !(vectors[1] & 1U) ||
+			(vectors[1] < BOOT_APP_BASE) || (vectors[1] >= BOOT_APP_BASE + size)){
+		return false;
+	}
+
+	return (boot_crc32(0xFFFFFFFFUL, (const uint8_t *)BOOT_APP_BASE, size) ^ 0xFFFFFFFFUL) == crc;
+}
+
+/**
+ * \fn static bool boot_descriptor_valid
+ * \brief Check the descriptor and the image it describes
+ * \param any_request true to accept a descriptor whose request word asks to stay in the bootloader
+ * \return true if the application may be started
+ */
+static bool boot_descriptor_valid(bool any_request){
+	const boot_descriptor_t *descriptor;
+
+	descriptor = (const boot_descriptor_t *)BOOT_DESCRIPTOR_ADDRESS;
+	if((descriptor->magic != BOOT_DESCRIPTOR_MAGIC) || (!any_request && (descriptor->request == 0))){
+		return false;
+	}
+
+	return boot_image_valid(descriptor->size, descriptor->crc);
+}
+
+/**
+ * \fn static bool boot_write_descriptor
+ * \brief Replace the descriptor with one for the given image and no update request
+ * \param size Image bytes
+ * \param crc Image CRC-32
+ * \return true on success
+ */
+static bool boot_write_descriptor(uint32_t size, uint32_t crc){
+	uint32_t words[4];
+
+	words[0] = BOOT_DESCRIPTOR_MAGIC;
+	words[1] = size;
+	words[2] = crc;
+	words[3] = 0xFFFFFFFFUL;
+
+	return boot_erase(BOOT_DESCRIPTOR_ADDRESS) && boot_program(BOOT_DESCRIPTOR_ADDRESS, words, 4);
+}
+
+/**
+ * \fn static void boot_uart_init
+ * \brief Start the crystal oscillator, set up UART0 on PTA1/PTA2 at BOOT_BAUDRATE, and start receiving into the ring
+ *  by DMA
+ * \param N/A
+ * \return N/A
+ */
+static void boot_uart_init(void){
+	uint32_t osr;
+	uint32_t sbr;
+	uint32_t baud;
+	uint32_t error;
+	uint32_t best_osr;
+	uint32_t best_sbr;
+	uint32_t best_error;
+
+	SIM->SCGC4 |= SIM_SCGC4_UART0_MASK;
+	SIM->SCGC5 |= SIM_SCGC5_PORTA_MASK;
+	SIM->SCGC6 |= SIM_SCGC6_DMAMUX_MASK;
+	SIM->SCGC7 |= SIM_SCGC7_DMA_MASK;
+
+	MCG->C2 = (MCG->C2 & ~(MCG_C2_RANGE0_MASK | MCG_C2_HGO0_MASK)) | MCG_C2_RANGE0(1) | MCG_C2_EREFS0_MASK;
+	OSC0->CR = OSC_CR_ERCLKEN_MASK;
+	while(!(MCG->S & MCG_S_OSCINIT0_MASK)){
+	}
+	SIM->SOPT2 = (SIM->SOPT2 & ~SIM_SOPT2_UART0SRC_MASK) | SIM_SOPT2_UART0SRC(2);
+
+	PORTA->PCR[1] = PORT_PCR_MUX(2);
+	PORTA->PCR[2] = PORT_PCR_MUX(2);
+
+	/**
+	 *  Pick the oversampling ratio with the smallest baud rate error
+	 */
+	best_osr = 16;
+	best_sbr = 1;
+	best_error = 0xFFFFFFFFUL;
+	for(osr = 4; osr <= 32; osr++){
+		sbr = (BOOT_OSC_FREQ + (osr * BOOT_BAUDRATE / 2)) / (osr * BOOT_BAUDRATE);
+		if((sbr == 0) || (sbr > 0x1FFF)){
+			continue;
+		}
+		baud = BOOT_OSC_FREQ / (osr * sbr);
+		error = (baud > BOOT_BAUDRATE) ? (baud - BOOT_BAUDRATE) : (BOOT_BAUDRATE - baud);
+		if(error < best_error){
+			best_osr = osr;
+			best_sbr = sbr;
+			best_error = error;
+		}
+	}
+
+	UART0->C2 = 0;
+	UART0->BDH = UART0_BDH_SBR(best_sbr >> 8);
+	UART0->BDL = UART0_BDL_SBR(best_sbr);
+	UART0->C4 = UART0_C4_OSR(best_osr - 1);
+	UART0->C5 = ((best_osr < 8) ? UART0_C5_BOTHEDGE_MASK : 0) | UART0_C5_RDMAE_MASK;
+	UART0->C1 = 0;
+
+	DMAMUX0->CHCFG[0] = 0;
+	DMA0->DMA[0].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+	DMA0->DMA[0].SAR = (uint32_t)&UART0->D;
+	DMA0->DMA[0].DAR = (uint32_t)boot_ring;
+	DMA0->DMA[0].DSR_BCR = DMA_DSR_BCR_BCR(BOOT_DMA_BCR_MAX);
+	DMA0->DMA[0].DCR = DMA_DCR_ERQ_MASK | DMA_DCR_CS_MASK | DMA_DCR_SSIZE(1) | DMA_DCR_DINC_MASK | DMA_DCR_DSIZE(1) |
+			DMA_DCR_DMOD(BOOT_DMA_DMOD);
+	DMAMUX0->CHCFG[0] = DMAMUX_CHCFG_ENBL_MASK | DMAMUX_CHCFG_SOURCE(kDmaRequestMux0LPSCI0Rx & 0xFF);
+
+	/**
+	 *  RIE routes RDRF to the DMA request; the NVIC never sees it
+	 */
+	UART0->C2 = UART0_C2_TE_MASK | UART0_C2_RE_MASK | UART0_C2_RIE_MASK;
+}
+
+/**
+ * \fn static void boot_uart_deinit
+ * \brief Put UART0, the DMA channel, the oscillator and SysTick back the way reset left them
+ * \param N/A
+ * \return N/A
+ */
+static void boot_uart_deinit(void){
+	while(!(UART0->S1 & UART0_S1_TC_MASK)){
+	}
+
+	UART0->C2 = 0;
+	UART0->C5 = 0;
+	DMAMUX0->CHCFG[0] = 0;
+	DMA0->DMA[0].DCR = 0;
+	DMA0->DMA[0].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+	PORTA->PCR[1] = 0;
+	PORTA->PCR[2] = 0;
+	SIM->SOPT2 &= ~SIM_SOPT2_UART0SRC_MASK;
+	SIM->SCGC4 &= ~SIM_SCGC4_UART0_MASK;
+	SIM->SCGC6 &= ~SIM_SCGC6_DMAMUX_MASK;
+	OSC0->CR = 0;
+	MCG->C2 = MCG_C2_LOCRE0_MASK;
+	SysTick->CTRL = 0;
+}
+
+/**
+ * \fn static void boot_start_application
+ * \brief Point VTOR at the application's vectors, load its stack pointer and jump to its reset handler
+ * \param N/A
+ * \return Does not return
+ */
+static void boot_start_application(void){
+	const uint32_t *vectors;
+
+	vectors = (const uint32_t *)BOOT_APP_BASE;
+	SCB->VTOR = BOOT_APP_BASE;
+	__DSB();
+	__asm volatile("msr msp, %0\n\tbx %1" : : "r"(vectors[0]), "r"(vectors[1]));
+}
+
+/**
+ * \fn static uint32_t boot_rx_received
+ * \brief Count every byte the DMA has put in the ring
+ * \param N/A
+ * \return The count
+ */
+static uint32_t boot_rx_received(void){
+	return boot_rx_base + (BOOT_DMA_BCR_MAX - (DMA0->DMA[0].DSR_BCR & DMA_DSR_BCR_BCR_MASK));
+}
+
+/**
+ * \fn static int boot_getc
+ * \brief Take one byte out of the ring
+ * \param timeout_ms How long to wait, or 0 to wait forever
+ * \return The byte, or -1 on timeout or if the ring overflowed
+ */
+static int boot_getc(uint32_t timeout_ms){
+	uint32_t start;
+	uint32_t received;
+
+	start = boot_millis();
+	while((received = boot_rx_received()) == boot_rx_read){
+		if((timeout_ms != 0) && ((boot_millis() - start) >= timeout_ms)){
+			return -1;
+		}
+	}
+
+	if(received - boot_rx_read > BOOT_RING_SIZE){
+		boot_rx_read = received;
+		return -1;
+	}
+
+	return boot_ring[boot_rx_read++ & (BOOT_RING_SIZE - 1)];
+}
+
+/**
+ * \fn static void boot_putc
+ * \brief Send one byte
+ * \param c The byte
+ * \return N/A
+ */
+static void boot_putc(uint8_t c){
+	while(!(UART0->S1 & UART0_S1_TDRE_MASK)){
+	}
+	UART0->D = c;
+}
+
+/**
+ * \fn static boot_status_t boot_receive
+ * \brief Wait for a request and take it into boot_command, boot_length and boot_payload
+ * \param N/A
+ * \return boot_ok, or boot_bad_frame if it was cut short, too long or its CRC was wrong
+ */
+static boot_status_t boot_receive(void){
+	uint8_t header[3];
+	uint8_t *payload;
+	uint32_t crc;
+	uint32_t i;
+	int c;
+
+	do{
+		c = boot_getc(0);
+	} while(c != BOOT_REQUEST_START);
+
+	for(i = 0; i < sizeof(header); i++){
+		if((c = boot_getc(BOOT_BYTE_TIMEOUT_MS)) < 0){
+			return boot_bad_frame;
+		}
+		header[i] = (uint8_t)c;
+	}
+	boot_command = header[0];
+	boot_length = header[1] | ((uint32_t)header[2] << 8);
+	if(boot_length > BOOT_PAYLOAD_MAX){
+		return boot_bad_frame;
+	}
+
+	payload = (uint8_t *)boot_payload;
+	for(i = 0; i < boot_length; i++){
+		if((c = boot_getc(BOOT_BYTE_TIMEOUT_MS)) < 0){
+			return boot_bad_frame;
+		}
+		payload[i] = (uint8_t)c;
+	}
+
+	crc = 0;
+	for(i = 0; i < 4; i++){
+		if((c = boot_getc(BOOT_BYTE_TIMEOUT_MS)) < 0){
+			return boot_bad_frame;
+		}
+		crc |= (uint32_t)c << (8 * i);
+	}
+
+	if((boot_crc32(boot_crc32(0xFFFFFFFFUL, header, sizeof(header)), payload, boot_length) ^ 0xFFFFFFFFUL) != crc){
+		return boot_bad_frame;
+	}
+
+	return boot_ok;
+}
+
+/**
+ * \fn static void boot_reply
+ * \brief Send an answer. Also the point where the host is waiting and the line is quiet, so reload the DMA count here
+ * \param status The status
+ * \param payload Payload bytes, may be NULL if length is 0
+ * \param length Amount of payload bytes
+ * \return N/A
+ */
+static void boot_reply(boot_status_t status, const uint8_t *payload, uint32_t length){
+	uint8_t header[3];
+	uint32_t received;
+	uint32_t crc;
+	uint32_t i;
+
+	if((DMA0->DMA[0].DSR_BCR & DMA_DSR_BCR_BCR_MASK) < (BOOT_DMA_BCR_MAX / 2)){
+		received = boot_rx_received();
+		DMA0->DMA[0].DSR_BCR = DMA_DSR_BCR_BCR(BOOT_DMA_BCR_MAX);
+		boot_rx_base = received;
+	}
+
+	header[0] = (uint8_t)status;
+	header[1] = (uint8_t)length;
+	header[2] = (uint8_t)(length >> 8);
+	crc = boot_crc32(boot_crc32(0xFFFFFFFFUL, header, sizeof(header)), payload, length) ^ 0xFFFFFFFFUL;
+
+	boot_putc(BOOT_RESPONSE_START);
+	for(i = 0; i < sizeof(header); i++){
+		boot_putc(header[i]);
+	}
+	for(i = 0; i < length; i++){
+		boot_putc(payload[i]);
+	}
+	for(i = 0; i < 4; i++){
+		boot_putc((uint8_t)(crc >> (8 * i)));
+	}
+}
+
+/**
+ * \fn static uint32_t boot_get32
+ * \brief Read a little endian u32 from the payload
+ * \param offset Byte offset in the payload
+ * \return The value
+ */
+static uint32_t boot_get32(uint32_t offset){
+	const uint8_t *p;
+
+	p = (const uint8_t *)boot_payload + offset;
+
+	return p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * \fn static void boot_put32
+ * \brief Write a little endian u32
+ * \param p Where
+ * \param value The value
+ * \return N/A
+ */
+static void boot_put32(uint8_t *p, uint32_t value){
+	p[0] = (uint8_t)value;
+	p[1] = (uint8_t)(value >> 8);
+	p[2] = (uint8_t)(value >> 16);
+	p[3] = (uint8_t)(value >> 24);
+}
+
+/**
+ * \fn static bool boot_in_range
+ * \brief Check that a byte range lies inside the application region
+ * \param offset Offset from BOOT_APP_BASE
+ * \param length Amount of bytes
+ * \return true if it does
+ */
+static bool boot_in_range(uint32_t offset, uint32_t length){
+	return (offset <= BOOT_APP_LIMIT - BOOT_APP_BASE) && (length <= BOOT_APP_LIMIT - BOOT_APP_BASE - offset);
+}
+
+/**
+ * \fn static void boot_store_chunk
+ * \brief Program a DATA chunk that has already been answered. The first chunk of a sector erases the sector
+ * \param offset Offset from BOOT_APP_BASE
+ * \param words The data
+ * \param count Amount of longwords
+ * \return N/A
+ */
+static void boot_store_chunk(uint32_t offset, const uint32_t *words, uint32_t count){
+	const uint32_t *flash;
+	uint32_t i;
+	bool ok;
+
+	ok = true;
+	if((offset % BOOT_SECTOR_SIZE) == 0){
+		ok = boot_erase(BOOT_APP_BASE + offset);
+	}
+
+	/**
+	 *  A chunk sent out of order into a sector that was not erased first cannot be programmed
+	 */
+	flash = (const uint32_t *)(BOOT_APP_BASE + offset);
+	for(i = 0; ok && (i < count); i++){
+		ok = (flash[i] == 0xFFFFFFFFUL);
+	}
+	ok = ok && boot_program(BOOT_APP_BASE + offset, words, count);
+
+	if(!ok){
+		boot_failed_offset = offset;
+	}
+}
+
+/**
+ * \fn static void boot_handle
+ * \brief Carry out one request and answer it
+ * \param N/A
+ * \return N/A
+ */
+static void boot_handle(void){
+	uint8_t answer[12];
+	uint32_t offset;
+	uint32_t length;
+
+	if(boot_failed_offset != BOOT_NO_FAILURE){
+		boot_put32(answer, boot_failed_offset);
+		boot_failed_offset = BOOT_NO_FAILURE;
+		boot_reply(boot_flash_error, answer, 4);
+		return;
+	}
+
+	switch(boot_command){
+		case boot_hello:
+			answer[0] = (uint8_t)BOOT_VERSION;
+			answer[1] = (uint8_t)(BOOT_VERSION >> 8);
+			answer[2] = (uint8_t)BOOT_CHUNK_SIZE;
+			answer[3] = (uint8_t)(BOOT_CHUNK_SIZE >> 8);
+			boot_put32(&answer[4], BOOT_APP_BASE);
+			boot_put32(&answer[8], BOOT_APP_LIMIT);
+			boot_reply(boot_ok, answer, 12);
+			break;
+
+		case boot_begin:
+			length = boot_get32(0);
+			if((boot_length != 8) || (length == 0) || ((length % 4) != 0) || !boot_in_range(0, length)){
+				boot_reply(boot_bad_argument, 0, 0);
+				break;
+			}
+			boot_image_size = length;
+			boot_image_crc = boot_get32(4);
+
+			/**
+			 *  From here on the old image must not be started, even if the transfer never finishes
+			 */
+			if(*(const uint32_t *)BOOT_DESCRIPTOR_ADDRESS != 0xFFFFFFFFUL){
+				if(!boot_erase(BOOT_DESCRIPTOR_ADDRESS)){
+					boot_put32(answer, BOOT_DESCRIPTOR_ADDRESS - BOOT_APP_BASE);
+					boot_reply(boot_flash_error, answer, 4);
+					break;
+				}
+			}
+			boot_reply(boot_ok, 0, 0);
+			break;
+
+		case boot_query:
+			offset = boot_get32(0);
+			length = ((const uint8_t *)boot_payload)[4] | ((uint32_t)((const uint8_t *)boot_payload)[5] << 8);
+			if((boot_length != 10) || !boot_in_range(offset, length)){
+				boot_reply(boot_bad_argument, 0, 0);
+				break;
+			}
+			boot_reply(((boot_crc32(0xFFFFFFFFUL, (const uint8_t *)(BOOT_APP_BASE + offset), length) ^ 0xFFFFFFFFUL) ==
+					boot_get32(6)) ? boot_ok : boot_mismatch, 0, 0);
+			break;
+
+		case boot_data:
+			offset = boot_get32(0);
+			length = boot_length - 4;
+			if((boot_length < 8) || ((length % 4) != 0) || ((offset % BOOT_CHUNK_SIZE) != 0) ||
+					!boot_in_range(offset, length)){
+				boot_reply(boot_bad_argument, 0, 0);
+				break;
+			}
+
+			/**
+			 *  Answer first: the host sends the next chunk while this one programs
+			 */
+			boot_reply(boot_ok, 0, 0);
+			boot_store_chunk(offset, &boot_payload[1], length / 4);
+			break;
+
+		case boot_finish:
+			if((boot_image_size == 0) || !boot_image_valid(boot_image_size, boot_image_crc)){
+				boot_reply(boot_bad_image, 0, 0);
+				break;
+			}
+			if(!boot_write_descriptor(boot_image_size, boot_image_crc)){
+				boot_put32(answer, BOOT_DESCRIPTOR_ADDRESS - BOOT_APP_BASE);
+				boot_reply(boot_flash_error, answer, 4);
+				break;
+			}
+			boot_reply(boot_ok, 0, 0);
+			break;
+
+		case boot_run:
+			if(!boot_descriptor_valid(true)){
+				boot_reply(boot_no_image, 0, 0);
+				break;
+			}
+
+			/**
+			 *  Clear an update request the application left, or it would come straight back here
+			 */
+			if(((const boot_descriptor_t *)BOOT_DESCRIPTOR_ADDRESS)->request == 0){
+				(void)boot_write_descriptor(((const boot_descriptor_t *)BOOT_DESCRIPTOR_ADDRESS)->size,
+						((const boot_descriptor_t *)BOOT_DESCRIPTOR_ADDRESS)->crc);
+			}
+			boot_reply(boot_ok, 0, 0);
+			boot_uart_deinit();
+			boot_start_application();
+			break;
+
+		default:
+			boot_reply(boot_bad_argument, 0, 0);
+			break;
+	}
+}
+
+int main(void){
+
+	/**
+	 *  COPC is write-once: disabling the watchdog here also decides it for the application
+	 */
+	SIM->COPC = 0;
+
+	SysTick->LOAD = (BOOT_CORE_FREQ / 1000U) - 1U;
+	SysTick->VAL = 0;
+	SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+	if(boot_descriptor_valid(false)){
+		SysTick->CTRL = 0;
+		boot_start_application();
+	}
+
+	boot_uart_init();
+	while(1){
+		if(boot_receive() == boot_ok){
+			boot_handle();
+		}
+		else{
+			/**
+			 *  Let the rest of a broken request go by before asking for it again
+			 */
+			while(boot_getc(BOOT_BYTE_TIMEOUT_MS) >= 0){
+			}
+			boot_reply(boot_bad_frame, 0, 0);
+		}
+	}
+}
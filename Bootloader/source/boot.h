@@ -0,0 +1,158 @@
+/**
+ * \file    boot.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Flash layout and serial protocol of the resident bootloader
+ *
+ *  Flash layout:
+ *  	0x00000 - 0x01BFF	bootloader (vectors, flash configuration field at 0x400, code)
+ *  	0x01C00 - 0x01FFF	image descriptor sector, see boot_descriptor_t
+ *  	0x02000 - 0x1DFFF	application (Blinkenlights links PROGRAM_FLASH here)
+ *  	0x1E000 - 0x1FFFF	black-box log and settings store, never touched by the bootloader
+ *
+ *  SRAM starts at 0x1FFFF200 for the bootloader (boot.ld): the first 512 bytes are the application's .noinit section,
+ *  which has to survive the pass through the bootloader at every warm reset.
+ *
+ *  At reset the bootloader jumps to the application if the descriptor is valid, no update was requested, and the
+ *  image's CRC-32 and vectors check out. Otherwise it stays and serves the protocol below on UART0 (the OpenSDA
+ *  virtual COM port) at BOOT_BAUDRATE. The application asks for an update by clearing the descriptor's request word
+ *  and resetting (shell command "update").
+ *
+ *  Every request is
+ *  	0xA5 | command u8 | length u16 | payload[length] | CRC-32 u32
+ *  and is answered with
+ *  	0x5A | status u8 | length u16 | payload[length] | CRC-32 u32
+ *  little endian, the CRC over everything between the start byte and the CRC. The host sends a request only after
+ *  the previous answer, and repeats it if the answer is boot_bad_frame or does not come.
+ *
+ *  A DATA request is answered as soon as its CRC checks out and is programmed afterwards, while UART0 DMA already
+ *  receives the next request: transfer and programming overlap. A programming error is reported in the answer to the
+ *  next request, as boot_flash_error with the failed offset.
+ *
+ *  Transfers resume: the bootloader erases a sector when it receives the sector's first chunk, so everything before
+ *  the first sector that does not match the image is kept. The host finds that sector with QUERY and continues from its
+ *  first chunk
+ */
+
+#ifndef BOOT_H_
+#define BOOT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * \def BOOT_VERSION
+ *  Protocol version reported by HELLO
+ */
+#define BOOT_VERSION\
+	(1U)
+
+/**
+ * \def BOOT_BAUDRATE
+ *  UART0 bits per second, from the 8 MHz crystal
+ */
+#define BOOT_BAUDRATE\
+	(115200U)
+
+/**
+ * \def BOOT_SECTOR_SIZE
+ *  Flash erase unit
+ */
+#define BOOT_SECTOR_SIZE\
+	(1024U)
+
+/**
+ * \def BOOT_DESCRIPTOR_ADDRESS
+ *  Sector holding the image descriptor
+ */
+#define BOOT_DESCRIPTOR_ADDRESS\
+	(0x1C00U)
+
+/**
+ * \def BOOT_APP_BASE
+ *  Where the application's vector table is
+ */
+#define BOOT_APP_BASE\
+	(0x2000U)
+
+/**
+ * \def BOOT_APP_LIMIT
+ *  One past the last byte the application may occupy
+ */
+#define BOOT_APP_LIMIT\
+	(0x1E000U)
+
+/**
+ * \def BOOT_CHUNK_SIZE
+ *  Most data bytes in one DATA request, a divisor of BOOT_SECTOR_SIZE
+ */
+#define BOOT_CHUNK_SIZE\
+	(256U)
+
+/**
+ * \def BOOT_PAYLOAD_MAX
+ *  Longest request payload: a DATA offset and chunk
+ */
+#define BOOT_PAYLOAD_MAX\
+	(4U + BOOT_CHUNK_SIZE)
+
+/**
+ * \def BOOT_REQUEST_START
+ *  First byte of every request
+ */
+#define BOOT_REQUEST_START\
+	(0xA5U)
+
+/**
+ * \def BOOT_RESPONSE_START
+ *  First byte of every answer
+ */
+#define BOOT_RESPONSE_START\
+	(0x5AU)
+
+/**
+ * \def BOOT_DESCRIPTOR_MAGIC
+ *  Marks a programmed descriptor
+ */
+#define BOOT_DESCRIPTOR_MAGIC\
+	(0x424F4F54UL)
+
+/**
+ * \typedef boot_descriptor_t
+ *  What the bootloader knows about the application, at BOOT_DESCRIPTOR_ADDRESS. Programmed by FINISH
+ */
+typedef struct {
+	uint32_t magic;		/* BOOT_DESCRIPTOR_MAGIC */
+	uint32_t size;		/* Image bytes from BOOT_APP_BASE */
+	uint32_t crc;		/* CRC-32 of the image */
+	uint32_t request;	/* 0xFFFFFFFF, or 0 once the application asked for an update */
+} boot_descriptor_t;
+
+/**
+ * \typedef boot_command_t
+ *  Requests. Payloads are listed as fields in order
+ */
+typedef enum {
+	boot_hello = 1,		/* -> version u16, chunk size u16, application base u32, application limit u32 */
+	boot_begin = 2,		/* size u32, crc u32: start a transfer and invalidate the current image -> */
+	boot_query = 3,		/* offset u32, length u16, crc u32 -> boot_ok if flash matches, else boot_mismatch */
+	boot_data = 4,		/* offset u32, data: length a multiple of 4, offset a multiple of BOOT_CHUNK_SIZE -> */
+	boot_finish = 5,	/* Check the whole image against BEGIN and program the descriptor -> */
+	boot_run = 6		/* Start the application if it is valid -> */
+} boot_command_t;
+
+/**
+ * \typedef boot_status_t
+ *  Answer status
+ */
+typedef enum {
+	boot_ok = 0,
+	boot_bad_frame = 1,		/* Request CRC or length was wrong: send it again */
+	boot_bad_argument = 2,	/* Unknown command, or offset/length out of range or misaligned */
+	boot_flash_error = 3,	/* Erase or program failed: payload offset u32 */
+	boot_mismatch = 4,		/* QUERY: flash differs */
+	boot_bad_image = 5,		/* FINISH: CRC or vectors wrong */
+	boot_no_image = 6		/* RUN: nothing valid to start */
+} boot_status_t;
+
+#endif /* BOOT_H_ */
@@ -0,0 +1,74 @@
+/**
+ * \file    boot_startup.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Vector table, flash configuration field and reset handler of the resident bootloader
+ *
+ *  The bootloader runs without interrupts, so only the reset and fault vectors are populated
+ */
+
+#include <stdint.h>
+
+extern int main(void);
+
+/**
+ *  From boot.ld
+ */
+extern uint32_t _vStackTop;
+extern uint32_t _data;
+extern uint32_t _edata;
+extern uint32_t _data_load;
+extern uint32_t _bss;
+extern uint32_t _ebss;
+
+void ResetISR(void);
+
+/**
+ * \fn static void boot_fault
+ * \brief Any exception: nothing can be done without a debugger, so wait for a reset
+ * \param N/A
+ * \return N/A
+ */
+static void boot_fault(void){
+	while(1){
+	}
+}
+
+/**
+ *  Initial stack pointer, reset, NMI and HardFault
+ */
+__attribute__ ((used, section(".isr_vector")))
+void (* const boot_vectors[])(void) = {
+	(void (*)(void))&_vStackTop,
+	ResetISR,
+	boot_fault,
+	boot_fault
+};
+
+/**
+ *  Flash configuration field at 0x400: no backdoor key, no protection, unsecured, same as Blinkenlights
+ */
+__attribute__ ((used, section(".FlashConfig")))
+const uint32_t boot_flash_config[4] = {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFE};
+
+/**
+ * \fn void ResetISR
+ * \brief Copy .data (with the RAM-resident flash routines) to SRAM, clear .bss and enter main()
+ * \param N/A
+ * \return N/A
+ */
+void ResetISR(void){
+	uint32_t *src;
+	uint32_t *dst;
+
+	src = &_data_load;
+	for(dst = &_data; dst < &_edata; dst++){
+		*dst = *src++;
+	}
+	for(dst = &_bss; dst < &_ebss; dst++){
+		*dst = 0;
+	}
+
+	main();
+	boot_fault();
+}
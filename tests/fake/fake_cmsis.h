@@ -0,0 +1,106 @@
+/**
+ * \file    fake_cmsis.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Host stand-ins for the CMSIS core intrinsics, force-included ahead of every test
+ *
+ *  CMSIS/cmsis_gcc.h is Cortex-M inline assembly. Defining its include guard here keeps it out, and the intrinsics
+ *  the firmware uses are replaced by C: PRIMASK is a variable the tests can check, and __WFI() calls
+ *  fake_cmsis_wfi(), which a test may define to deliver the interrupt that would end the sleep
+ */
+
+#ifndef FAKE_CMSIS_H_
+#define FAKE_CMSIS_H_
+
+#define __CMSIS_GCC_H
+
+#include <stdint.h>
+
+#ifndef __ASM
+#define __ASM\
+	__asm
+#endif
+
+#ifndef __INLINE
+#define __INLINE\
+	inline
+#endif
+
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE\
+	static inline
+#endif
+
+/**
+ *  Interrupt mask, 1 while __disable_irq() is in force
+ */
+extern volatile uint32_t fake_primask;
+
+/**
+ * \fn void fake_cmsis_wfi
+ * \brief Called by __WFI(). Does nothing unless a test defines it
+ * \param N/A
+ * \return N/A
+ */
+void fake_cmsis_wfi(void);
+
+__attribute__((always_inline)) __STATIC_INLINE void __enable_irq(void){
+	fake_primask = 0;
+}
+
+__attribute__((always_inline)) __STATIC_INLINE void __disable_irq(void){
+	fake_primask = 1;
+}
+
+__attribute__((always_inline)) __STATIC_INLINE uint32_t __get_PRIMASK(void){
+	return fake_primask;
+}
+
+__attribute__((always_inline)) __STATIC_INLINE void __set_PRIMASK(uint32_t primask){
+	fake_primask = primask;
+}
+
+__attribute__((always_inline)) __STATIC_INLINE uint32_t __get_IPSR(void){
+	return 0;
+}
+
+__attribute__((always_inline)) __STATIC_INLINE void __NOP(void){
+}
+
+__attribute__((always_inline)) __STATIC_INLINE void __WFI(void){
+	fake_cmsis_wfi();
+}
+
+__attribute__((always_inline)) __STATIC_INLINE void __WFE(void){
+}
+
+__attribute__((always_inline)) __STATIC_INLINE void __SEV(void){
+}
+
+__attribute__((always_inline)) __STATIC_INLINE void __ISB(void){
+	__sync_synchronize();
+}
+
+__attribute__((always_inline)) __STATIC_INLINE void __DSB(void){
+	__sync_synchronize();
+}
+
+__attribute__((always_inline)) __STATIC_INLINE void __DMB(void){
+	__sync_synchronize();
+}
+
+__attribute__((always_inline)) __STATIC_INLINE uint32_t __REV(uint32_t value){
+	return __builtin_bswap32(value);
+}
+
+__attribute__((always_inline)) __STATIC_INLINE uint32_t __REV16(uint32_t value){
+	return ((value & 0xFF00FF00UL) >> 8) | ((value & 0x00FF00FFUL) << 8);
+}
+
+#define __CLZ\
+	__builtin_clz
+
+#define __BKPT(value)\
+	__builtin_trap()
+
+#endif /* FAKE_CMSIS_H_ */
@@ -0,0 +1,156 @@
+/**
+ * \file    fake_flash.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for the fsl_flash.h simulator with fault injection
+ */
+
+#include <string.h>
+#include "fsl_flash.h"
+#include "fake_flash.h"
+
+/**
+ * \def FAKE_FLASH_SECTOR
+ *  Erase unit
+ */
+#define FAKE_FLASH_SECTOR\
+	(FSL_FEATURE_FLASH_PFLASH_BLOCK_SECTOR_SIZE)
+
+/**
+ * \def FAKE_FLASH_START
+ *  First flash byte fake_mcu.h maps
+ */
+#define FAKE_FLASH_START\
+	(0x1000UL)
+
+/**
+ * \def FAKE_FLASH_END
+ *  One past the last flash byte
+ */
+#define FAKE_FLASH_END\
+	(FSL_FEATURE_FLASH_PFLASH_BLOCK_COUNT * FSL_FEATURE_FLASH_PFLASH_BLOCK_SIZE)
+
+jmp_buf fake_flash_power_loss;
+
+static fake_flash_stats_t fake_flash_stats;
+static uint32_t fake_flash_step;
+static fake_flash_fault_t fake_flash_fault;
+static uint32_t fake_flash_tear_mask;
+
+/**
+ * \fn static fake_flash_fault_t fake_flash_next
+ * \brief Count a step and tell whether it is the one that goes wrong
+ * \param N/A
+ * \return The fault to apply to it, fake_flash_none mostly
+ */
+static fake_flash_fault_t fake_flash_next(void){
+	fake_flash_stats.steps++;
+	if((fake_flash_fault != fake_flash_none) && (fake_flash_stats.steps == fake_flash_step)){
+		fake_flash_stats.fired = true;
+		return fake_flash_fault;
+	}
+
+	return fake_flash_none;
+}
+
+/**
+ * \fn static status_t fake_flash_check
+ * \brief Check a range the way the driver does
+ * \param start First byte
+ * \param length Amount of bytes
+ * \param unit Sector size or 4
+ * \return kStatus_FLASH_Success, kStatus_FLASH_AlignmentError or kStatus_FLASH_AddressError
+ */
+static status_t fake_flash_check(uint32_t start, uint32_t length, uint32_t unit){
+	if(((start % unit) != 0) || ((length % unit) != 0)){
+		return kStatus_FLASH_AlignmentError;
+	}
+	if((start < FAKE_FLASH_START) || (start > FAKE_FLASH_END) || (length > FAKE_FLASH_END - start)){
+		return kStatus_FLASH_AddressError;
+	}
+	if(fake_primask == 0){
+		fake_flash_stats.unmasked++;
+	}
+
+	return kStatus_FLASH_Success;
+}
+
+status_t FLASH_Init(flash_config_t *config){
+	memset(config, 0, sizeof(*config));
+	config->PFlashBlockBase = 0;
+	config->PFlashTotalSize = FAKE_FLASH_END;
+	config->PFlashBlockCount = FSL_FEATURE_FLASH_PFLASH_BLOCK_COUNT;
+	config->PFlashSectorSize = FAKE_FLASH_SECTOR;
+
+	return kStatus_FLASH_Success;
+}
+
+status_t FLASH_Erase(flash_config_t *config, uint32_t start, uint32_t lengthInBytes, uint32_t key){
+	status_t status;
+	uint32_t address;
+
+	(void)config;
+	if(key != kFLASH_ApiEraseKey){
+		return kStatus_FLASH_EraseKeyError;
+	}
+	status = fake_flash_check(start, lengthInBytes, FAKE_FLASH_SECTOR);
+	for(address = start; (status == kStatus_FLASH_Success) && (address < start + lengthInBytes);
+			address += FAKE_FLASH_SECTOR){
+		switch(fake_flash_next()){
+		case fake_flash_fail:
+			return kStatus_FLASH_AccessError;
+		case fake_flash_tear:
+			memset((void *)(uintptr_t)address, 0xFF, FAKE_FLASH_SECTOR / 2);
+			longjmp(fake_flash_power_loss, 1);
+		default:
+			memset((void *)(uintptr_t)address, 0xFF, FAKE_FLASH_SECTOR);
+			fake_flash_stats.erases++;
+			break;
+		}
+	}
+
+	return status;
+}
+
+status_t FLASH_Program(flash_config_t *config, uint32_t start, uint32_t *src, uint32_t lengthInBytes){
+	status_t status;
+	uint32_t *target;
+	uint32_t i;
+
+	(void)config;
+	status = fake_flash_check(start, lengthInBytes, 4);
+	for(i = 0; (status == kStatus_FLASH_Success) && (i < lengthInBytes / 4); i++){
+		target = (uint32_t *)(uintptr_t)(start + (4 * i));
+		if(*target != 0xFFFFFFFFUL){
+			fake_flash_stats.overwrites++;
+		}
+		switch(fake_flash_next()){
+		case fake_flash_fail:
+			return kStatus_FLASH_AccessError;
+		case fake_flash_tear:
+			*target &= src[i] | ~fake_flash_tear_mask;
+			longjmp(fake_flash_power_loss, 1);
+		default:
+			*target &= src[i];
+			fake_flash_stats.programs++;
+			break;
+		}
+	}
+
+	return status;
+}
+
+void fake_flash_reset(void){
+	memset(&fake_flash_stats, 0, sizeof(fake_flash_stats));
+	fake_flash_fault = fake_flash_none;
+}
+
+void fake_flash_inject(uint32_t step, fake_flash_fault_t fault, uint32_t tear_mask){
+	fake_flash_step = step;
+	fake_flash_fault = fault;
+	fake_flash_tear_mask = tear_mask;
+}
+
+void fake_flash_get_stats(fake_flash_stats_t *stats){
+	*stats = fake_flash_stats;
+}
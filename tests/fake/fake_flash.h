@@ -0,0 +1,77 @@
+/**
+ * \file    fake_flash.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for the fsl_flash.h simulator with fault injection
+ *
+ *  FLASH_Init(), FLASH_Erase() and FLASH_Program() work on the flash fake_mcu.h maps, and behave like the part: an
+ *  erase sets whole sectors to 0xFF, and programming can only clear bits. Every sector erased and every longword
+ *  programmed is one step, counted from fake_flash_reset(). One step can be made to go wrong:
+ *  	- fake_flash_fail: the call returns kStatus_FLASH_AccessError there, with the earlier steps of the call done
+ *  	- fake_flash_tear: the step is left half done and the power goes: a programmed longword gets only the bits of
+ *  	  the tear mask cleared, an erased sector only its first half erased, and the call never returns. It longjmp()s
+ *  	  to fake_flash_power_loss, where the test boots the firmware again
+ */
+
+#ifndef FAKE_FLASH_H_
+#define FAKE_FLASH_H_
+
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * \typedef fake_flash_fault_t
+ *  What goes wrong at the chosen step
+ */
+typedef enum {
+	fake_flash_none,
+	fake_flash_fail,	/* The driver reports an error */
+	fake_flash_tear		/* The power fails in the middle of it */
+} fake_flash_fault_t;
+
+/**
+ * \typedef fake_flash_stats_t
+ *  Counters since fake_flash_reset()
+ */
+typedef struct {
+	uint32_t steps;			/* Sectors erased and longwords programmed */
+	uint32_t erases;		/* Sectors erased */
+	uint32_t programs;		/* Longwords programmed */
+	uint32_t overwrites;	/* Longwords programmed that were not erased */
+	uint32_t unmasked;		/* Calls made with interrupts enabled */
+	bool fired;				/* The fault happened */
+} fake_flash_stats_t;
+
+/**
+ *  Where a torn step jumps to. Set it with setjmp() before the step can run
+ */
+extern jmp_buf fake_flash_power_loss;
+
+/**
+ * \fn void fake_flash_reset
+ * \brief Clear the counters and the fault
+ * \param N/A
+ * \return N/A
+ */
+void fake_flash_reset(void);
+
+/**
+ * \fn void fake_flash_inject
+ * \brief Make one step go wrong
+ * \param step The step, counting from 1 after fake_flash_reset()
+ * \param fault What happens there
+ * \param tear_mask For fake_flash_tear on a program, the bits that do get programmed
+ * \return N/A
+ */
+void fake_flash_inject(uint32_t step, fake_flash_fault_t fault, uint32_t tear_mask);
+
+/**
+ * \fn void fake_flash_get_stats
+ * \brief Get the counters
+ * \param stats Where to store them
+ * \return N/A
+ */
+void fake_flash_get_stats(fake_flash_stats_t *stats);
+
+#endif /* FAKE_FLASH_H_ */
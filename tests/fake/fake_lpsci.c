@@ -0,0 +1,206 @@
+/**
+ * \file    fake_lpsci.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for the UART0 (LPSCI) register model
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "MKL25Z4.h"
+#include "MKL25Z4_features.h"
+#include "fake_mcu.h"
+#include "fake_lpsci.h"
+
+/**
+ * \def FAKE_LPSCI_W1C
+ *  S1 flags that are cleared by writing 1
+ */
+#define FAKE_LPSCI_W1C\
+	(UART0_S1_OR_MASK | UART0_S1_NF_MASK | UART0_S1_FE_MASK | UART0_S1_PF_MASK | UART0_S1_IDLE_MASK)
+
+/**
+ * \def FAKE_LPSCI_IRQ_LIMIT
+ *  Interrupts one fake_lpsci_service() call takes before it decides the handler does not clear its source
+ */
+#define FAKE_LPSCI_IRQ_LIMIT\
+	(100000U)
+
+fake_lpsci_t fake_lpsci;
+
+/**
+ * \def FAKE_LPSCI_DMA_SETUP
+ *  DCR fields of the only DMA setup modelled: 8-bit source and destination, destination incrementing
+ */
+#define FAKE_LPSCI_DMA_SETUP\
+	(DMA_DCR_SSIZE_MASK | DMA_DCR_DSIZE_MASK | DMA_DCR_SINC_MASK | DMA_DCR_DINC_MASK)
+
+/**
+ *  S1 as the hardware holds it, the byte in the receive data register, and whether RDRF was set since IDLE was
+ *  cleared
+ */
+static uint8_t fake_lpsci_s1;
+static uint8_t fake_lpsci_rx;
+static bool fake_lpsci_rx_since_idle;
+
+void UART0_DriverIRQHandler(void);
+
+/**
+ * \fn static void fake_lpsci_hook
+ * \brief UART0 register model
+ * \param address Register accessed
+ * \param write true after a write, false before a read
+ * \return N/A
+ */
+static void fake_lpsci_hook(uintptr_t address, bool write){
+	if(address == (uintptr_t)&UART0->S1){
+		if(write){
+			fake_lpsci_s1 &= ~(UART0->S1 & FAKE_LPSCI_W1C);
+			if(UART0->S1 & UART0_S1_IDLE_MASK){
+				fake_lpsci_rx_since_idle = false;
+			}
+		}
+		UART0->S1 = fake_lpsci_s1;
+	}
+	else if(address == (uintptr_t)&UART0->D){
+		if(write){
+			if(fake_lpsci.tx_length < FAKE_LPSCI_TX_SIZE){
+				fake_lpsci.tx[fake_lpsci.tx_length] = UART0->D;
+			}
+			fake_lpsci.tx_length++;
+			if(fake_lpsci.paced){
+				fake_lpsci_s1 &= ~(UART0_S1_TDRE_MASK | UART0_S1_TC_MASK);
+			}
+		}
+		else{
+			fake_lpsci.d_reads++;
+			fake_lpsci_s1 &= ~UART0_S1_RDRF_MASK;
+			UART0->D = fake_lpsci_rx;
+		}
+	}
+}
+
+/**
+ * \fn static void fake_lpsci_dma
+ * \brief Serve the DMA request of the received byte, if a channel takes it
+ * \param N/A
+ * \return N/A
+ */
+static void fake_lpsci_dma(void){
+	uint32_t channel;
+	uint32_t dcr;
+	uint32_t bcr;
+	uint32_t dar;
+	uint32_t window;
+
+	for(channel = 0; channel < FSL_FEATURE_DMA_MODULE_CHANNEL; channel++){
+		if((DMAMUX0->CHCFG[channel] & DMAMUX_CHCFG_ENBL_MASK) &&
+				((DMAMUX0->CHCFG[channel] & DMAMUX_CHCFG_SOURCE_MASK) == (kDmaRequestMux0LPSCI0Rx & 0xFFU))){
+			break;
+		}
+	}
+	if(channel == FSL_FEATURE_DMA_MODULE_CHANNEL){
+		return;
+	}
+
+	dcr = DMA0->DMA[channel].DCR;
+	bcr = DMA0->DMA[channel].DSR_BCR & DMA_DSR_BCR_BCR_MASK;
+	if(!(dcr & DMA_DCR_ERQ_MASK) || (bcr == 0)){
+		return;
+	}
+	if(((dcr & FAKE_LPSCI_DMA_SETUP) != (DMA_DCR_SSIZE(1U) | DMA_DCR_DSIZE(1U) | DMA_DCR_DINC_MASK)) ||
+			(DMA0->DMA[channel].SAR != (uint32_t)(uintptr_t)&UART0->D)){
+		fprintf(stderr, "fake_lpsci: DMA channel %u is not set up as modelled\n", channel);
+		abort();
+	}
+
+	dar = DMA0->DMA[channel].DAR;
+	*(uint8_t *)(uintptr_t)dar = fake_lpsci_rx;
+	fake_lpsci_s1 &= ~UART0_S1_RDRF_MASK;
+
+	window = (dcr & DMA_DCR_DMOD_MASK) ? (16UL << (((dcr & DMA_DCR_DMOD_MASK) >> DMA_DCR_DMOD_SHIFT) - 1)) : 0;
+	if(window != 0){
+		dar = (dar & ~(window - 1)) | ((dar + 1) & (window - 1));
+	}
+	else{
+		dar++;
+	}
+	DMA0->DMA[channel].DAR = dar;
+	bcr--;
+	DMA0->DMA[channel].DSR_BCR = bcr | ((bcr == 0) ? DMA_DSR_BCR_DONE_MASK : 0);
+}
+
+/**
+ * \fn static bool fake_lpsci_pending
+ * \brief Tell whether an enabled interrupt source is pending
+ * \param N/A
+ * \return true if the interrupt would be taken
+ */
+static bool fake_lpsci_pending(void){
+	uint8_t c2;
+	uint8_t c3;
+
+	c2 = UART0->C2;
+	c3 = UART0->C3;
+
+	return ((c2 & UART0_C2_TIE_MASK) && (fake_lpsci_s1 & UART0_S1_TDRE_MASK)) ||
+			((c2 & UART0_C2_TCIE_MASK) && (fake_lpsci_s1 & UART0_S1_TC_MASK)) ||
+			((c2 & UART0_C2_RIE_MASK) && (fake_lpsci_s1 & UART0_S1_RDRF_MASK) && !(UART0->C5 & UART0_C5_RDMAE_MASK)) ||
+			((c2 & UART0_C2_ILIE_MASK) && (fake_lpsci_s1 & UART0_S1_IDLE_MASK)) ||
+			((c3 & UART0_C3_ORIE_MASK) && (fake_lpsci_s1 & UART0_S1_OR_MASK)) ||
+			((c3 & UART0_C3_FEIE_MASK) && (fake_lpsci_s1 & UART0_S1_FE_MASK));
+}
+
+void fake_lpsci_init(void){
+	memset(&fake_lpsci, 0, sizeof(fake_lpsci));
+	fake_lpsci_s1 = UART0_S1_TDRE_MASK | UART0_S1_TC_MASK;
+	fake_lpsci_rx = 0;
+	fake_lpsci_rx_since_idle = false;
+	fake_mcu_trap((uintptr_t)UART0, fake_lpsci_hook);
+}
+
+void fake_lpsci_receive(const uint8_t *data, size_t length){
+	size_t i;
+
+	for(i = 0; i < length; i++){
+		if(fake_lpsci_s1 & UART0_S1_RDRF_MASK){
+			fake_lpsci_s1 |= UART0_S1_OR_MASK;
+			fake_lpsci.rx_lost++;
+		}
+		else{
+			fake_lpsci_rx = data[i];
+			fake_lpsci_s1 |= UART0_S1_RDRF_MASK;
+			fake_lpsci_rx_since_idle = true;
+			if((UART0->C5 & UART0_C5_RDMAE_MASK) && (UART0->C2 & UART0_C2_RIE_MASK)){
+				fake_lpsci_dma();
+			}
+		}
+		fake_lpsci_service();
+	}
+}
+
+void fake_lpsci_idle(void){
+	if(fake_lpsci_rx_since_idle){
+		fake_lpsci_s1 |= UART0_S1_IDLE_MASK;
+	}
+	fake_lpsci_service();
+}
+
+void fake_lpsci_shift(void){
+	fake_lpsci_s1 |= UART0_S1_TDRE_MASK | UART0_S1_TC_MASK;
+	fake_lpsci_service();
+}
+
+void fake_lpsci_service(void){
+	uint32_t taken;
+
+	for(taken = 0; (fake_primask == 0) && fake_lpsci_pending(); taken++){
+		if(taken == FAKE_LPSCI_IRQ_LIMIT){
+			fprintf(stderr, "fake_lpsci: the UART0 interrupt does not clear its source\n");
+			abort();
+		}
+		fake_lpsci.irqs++;
+		UART0_DriverIRQHandler();
+	}
+}
@@ -0,0 +1,94 @@
+/**
+ * \file    fake_lpsci.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for the UART0 (LPSCI) register model
+ *
+ *  fake_lpsci_init() traps the UART0 page (fake_mcu.h). The line runs infinitely fast: a byte written to D is on
+ *  the wire at once, so TDRE and TC stay set, unless the test sets fake_lpsci.paced; then each byte written clears
+ *  them until fake_lpsci_shift() sends it. Received bytes arrive only when the test hands them in. Like the
+ *  part, reading D clears RDRF, a byte that arrives while RDRF is still set is lost and sets OR, and OR, NF, FE, PF
+ *  and IDLE are write-1-to-clear. The UART0 interrupt is taken by fake_lpsci_service(), by calling the driver's
+ *  UART0_DriverIRQHandler() for as long as an enabled source is pending and interrupts are not masked.
+ *
+ *  With C5[RDMAE] and C2[RIE] both set, a received byte is a DMA request instead: the channel DMAMUX0 routes UART0
+ *  receive to moves it from D to DAR, byte wide, with DAR counting up inside its DCR[DMOD] window and BCR counting
+ *  down. A channel with BCR 0 sets DONE and moves nothing more, so the next byte overruns. Only the setup the LPSCI
+ *  driver uses is modelled; any other aborts the test
+ */
+
+#ifndef FAKE_LPSCI_H_
+#define FAKE_LPSCI_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * \def FAKE_LPSCI_TX_SIZE
+ *  Bytes of transmitted data the model keeps
+ */
+#define FAKE_LPSCI_TX_SIZE\
+	(8192U)
+
+/**
+ * \typedef fake_lpsci_t
+ *  How the model runs, and what it saw
+ */
+typedef struct {
+	bool paced;						/* Set by the test to send each byte only at fake_lpsci_shift() */
+	uint8_t tx[FAKE_LPSCI_TX_SIZE];	/* Bytes written to D, in order */
+	size_t tx_length;				/* Bytes written to D, including any beyond FAKE_LPSCI_TX_SIZE */
+	uint32_t rx_lost;				/* Received bytes lost to a hardware overrun */
+	uint32_t d_reads;				/* Reads of D */
+	uint32_t irqs;					/* Times fake_lpsci_service() took the interrupt */
+} fake_lpsci_t;
+
+extern fake_lpsci_t fake_lpsci;
+
+/**
+ * \fn void fake_lpsci_init
+ * \brief Trap the UART0 registers and reset the model: idle line, nothing received, nothing sent
+ * \param N/A
+ * \return N/A
+ *
+ *  Call after fake_mcu_init(), which drops every trap
+ */
+void fake_lpsci_init(void);
+
+/**
+ * \fn void fake_lpsci_receive
+ * \brief Put bytes on the receive line, one frame time apart: after each the interrupt is serviced
+ * \param data The bytes
+ * \param length Amount of bytes
+ * \return N/A
+ */
+void fake_lpsci_receive(const uint8_t *data, size_t length);
+
+/**
+ * \fn void fake_lpsci_idle
+ * \brief Leave the receive line idle for a character time: IDLE is set if a byte was received since it was last
+ *  cleared, then the interrupt is serviced
+ * \param N/A
+ * \return N/A
+ */
+void fake_lpsci_idle(void);
+
+/**
+ * \fn void fake_lpsci_shift
+ * \brief With fake_lpsci.paced set, finish sending the byte on the line: TDRE and TC set, then the interrupt is
+ *  serviced
+ * \param N/A
+ * \return N/A
+ */
+void fake_lpsci_shift(void);
+
+/**
+ * \fn void fake_lpsci_service
+ * \brief Take the UART0 interrupt until no enabled source is pending, unless interrupts are masked
+ * \param N/A
+ * \return N/A
+ */
+void fake_lpsci_service(void);
+
+#endif /* FAKE_LPSCI_H_ */
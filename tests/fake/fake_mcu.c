@@ -0,0 +1,228 @@
+/**
+ * \file    fake_mcu.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Function definitions for the host stand-in of the KL25Z memory map
+ *
+ *  A trapped page is mapped without access. The fault of each access is taken in fake_mcu_segv(), which tells a read
+ *  from a write by the page fault error code, opens the page and single-steps the one instruction; fake_mcu_step()
+ *  closes the page again after it. Reads call the model before the instruction, writes after it. x86-64 Linux only
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+#include <sys/mman.h>
+#include "fake_mcu.h"
+
+/**
+ * \def FAKE_MCU_TRAPS
+ *  Most pages trapped at once
+ */
+#define FAKE_MCU_TRAPS\
+	(8)
+
+/**
+ * \def FAKE_MCU_EFLAGS_TF
+ *  x86 trap flag: single-step
+ */
+#define FAKE_MCU_EFLAGS_TF\
+	(0x100UL)
+
+/**
+ * \def FAKE_MCU_PF_WRITE
+ *  Page fault error code bit: the access was a write
+ */
+#define FAKE_MCU_PF_WRITE\
+	(0x2UL)
+
+/**
+ * \typedef fake_mcu_region_t
+ *  A part of the KL25Z memory map backed by host memory
+ */
+typedef struct {
+	uintptr_t base;
+	size_t size;
+} fake_mcu_region_t;
+
+/**
+ *  Flash above the first page (the host can not map page 0), the peripheral bridge, GPIO, the PPB, MCM and MTB, FGPIO
+ */
+static const fake_mcu_region_t fake_mcu_regions[] = {
+	{0x00001000UL, 0x0001F000UL},
+	{0x40000000UL, 0x00080000UL},
+	{0x400FF000UL, 0x00001000UL},
+	{0xE0000000UL, 0x00100000UL},
+	{0xF0000000UL, 0x00004000UL},
+	{0xF8000000UL, 0x00001000UL}
+};
+
+/**
+ * \typedef fake_mcu_trap_t
+ *  A trapped page and its model
+ */
+typedef struct {
+	uintptr_t page;
+	fake_mcu_hook_t hook;
+} fake_mcu_trap_t;
+
+static fake_mcu_trap_t fake_mcu_traps[FAKE_MCU_TRAPS];
+static bool fake_mcu_mapped;
+
+/**
+ *  The page opened for the instruction being stepped, and the write to report after it
+ */
+static uintptr_t fake_mcu_open;
+static uintptr_t fake_mcu_written;
+static fake_mcu_hook_t fake_mcu_write_hook;
+
+volatile uint32_t fake_primask;
+
+__attribute__((weak)) void fake_cmsis_wfi(void){
+}
+
+/**
+ * \fn static fake_mcu_trap_t *fake_mcu_find
+ * \brief Find the trap of a page
+ * \param page Page address
+ * \return The trap, or NULL
+ */
+static fake_mcu_trap_t *fake_mcu_find(uintptr_t page){
+	size_t i;
+
+	for(i = 0; i < FAKE_MCU_TRAPS; i++){
+		if((fake_mcu_traps[i].hook != NULL) && (fake_mcu_traps[i].page == page)){
+			return &fake_mcu_traps[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * \fn static void fake_mcu_segv
+ * \brief Take an access to a trapped page: open it and step the instruction
+ * \param signal SIGSEGV
+ * \param info Faulting address
+ * \param context Registers of the faulting code
+ * \return N/A
+ */
+static void fake_mcu_segv(int signal, siginfo_t *info, void *context){
+	ucontext_t *uc;
+	fake_mcu_trap_t *trap;
+	uintptr_t address;
+
+	(void)signal;
+	uc = context;
+	address = (uintptr_t)info->si_addr;
+	trap = fake_mcu_find(address & ~(FAKE_MCU_PAGE - 1));
+	if(trap == NULL){
+		fprintf(stderr, "fake_mcu: access to unmapped address 0x%08lx\n", (unsigned long)address);
+		abort();
+	}
+
+	(void)mprotect((void *)trap->page, FAKE_MCU_PAGE, PROT_READ | PROT_WRITE);
+	fake_mcu_open = trap->page;
+	if(uc->uc_mcontext.gregs[REG_ERR] & FAKE_MCU_PF_WRITE){
+		fake_mcu_written = address;
+		fake_mcu_write_hook = trap->hook;
+	}
+	else{
+		fake_mcu_write_hook = NULL;
+		trap->hook(address, false);
+	}
+	uc->uc_mcontext.gregs[REG_EFL] |= FAKE_MCU_EFLAGS_TF;
+}
+
+/**
+ * \fn static void fake_mcu_step
+ * \brief After the instruction: report a write and close the page
+ * \param signal SIGTRAP
+ * \param info N/A
+ * \param context Registers of the stepped code
+ * \return N/A
+ */
+static void fake_mcu_step(int signal, siginfo_t *info, void *context){
+	ucontext_t *uc;
+
+	(void)signal;
+	(void)info;
+	uc = context;
+	uc->uc_mcontext.gregs[REG_EFL] &= ~FAKE_MCU_EFLAGS_TF;
+	if(fake_mcu_write_hook != NULL){
+		fake_mcu_write_hook(fake_mcu_written, true);
+		fake_mcu_write_hook = NULL;
+	}
+	if(fake_mcu_find(fake_mcu_open) != NULL){
+		(void)mprotect((void *)fake_mcu_open, FAKE_MCU_PAGE, PROT_NONE);
+	}
+}
+
+void fake_mcu_init(void){
+	struct sigaction action;
+	size_t i;
+	void *mapped;
+
+	for(i = 0; i < FAKE_MCU_TRAPS; i++){
+		fake_mcu_trap(fake_mcu_traps[i].page, NULL);
+	}
+
+	if(!fake_mcu_mapped){
+		for(i = 0; i < sizeof(fake_mcu_regions) / sizeof(fake_mcu_regions[0]); i++){
+			mapped = mmap((void *)fake_mcu_regions[i].base, fake_mcu_regions[i].size, PROT_READ | PROT_WRITE,
+					MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+			if(mapped != (void *)fake_mcu_regions[i].base){
+				fprintf(stderr, "fake_mcu: can not map 0x%08lx\n", (unsigned long)fake_mcu_regions[i].base);
+				exit(2);
+			}
+		}
+
+		memset(&action, 0, sizeof(action));
+		action.sa_flags = SA_SIGINFO | SA_NODEFER;
+		action.sa_sigaction = fake_mcu_segv;
+		(void)sigaction(SIGSEGV, &action, NULL);
+		action.sa_sigaction = fake_mcu_step;
+		(void)sigaction(SIGTRAP, &action, NULL);
+		fake_mcu_mapped = true;
+	}
+
+	for(i = 0; i < sizeof(fake_mcu_regions) / sizeof(fake_mcu_regions[0]); i++){
+		memset((void *)fake_mcu_regions[i].base, 0, fake_mcu_regions[i].size);
+	}
+	fake_primask = 0;
+}
+
+void fake_mcu_trap(uintptr_t base, fake_mcu_hook_t hook){
+	fake_mcu_trap_t *trap;
+	uintptr_t page;
+	size_t i;
+
+	page = base & ~(FAKE_MCU_PAGE - 1);
+	trap = fake_mcu_find(page);
+	if(hook == NULL){
+		if(trap != NULL){
+			trap->hook = NULL;
+			(void)mprotect((void *)page, FAKE_MCU_PAGE, PROT_READ | PROT_WRITE);
+		}
+		return;
+	}
+
+	for(i = 0; (trap == NULL) && (i < FAKE_MCU_TRAPS); i++){
+		if(fake_mcu_traps[i].hook == NULL){
+			trap = &fake_mcu_traps[i];
+		}
+	}
+	if(trap == NULL){
+		fprintf(stderr, "fake_mcu: more than %d trapped pages\n", FAKE_MCU_TRAPS);
+		exit(2);
+	}
+	trap->page = page;
+	trap->hook = hook;
+	(void)mprotect((void *)page, FAKE_MCU_PAGE, PROT_NONE);
+}
+
+void fake_mcu_erase_flash(void){
+	memset((void *)fake_mcu_regions[0].base, 0xFF, fake_mcu_regions[0].size);
+}
@@ -0,0 +1,62 @@
+/**
+ * \file    fake_mcu.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Macros and function headers for the host stand-in of the KL25Z memory map
+ *
+ *  The tests build the firmware sources unchanged, so registers and flash are accessed at their KL25Z addresses.
+ *  fake_mcu_init() maps zeroed host memory there: the flash above its first 4 KB page, the peripheral bridge, the
+ *  GPIO and FGPIO ports, the Private Peripheral Bus (SCB, NVIC, SysTick) and the MCM and MTB. Tests link with
+ *  -no-pie, so nothing of the test program itself lives at those addresses.
+ *
+ *  Most registers behave as plain memory, which is enough to check what the firmware wrote. A register with side
+ *  effects (a data register that pops a FIFO, a write-1-to-clear status, a command launch) is modelled by trapping
+ *  its 4 KB page with fake_mcu_trap(): every access to the page then calls the model, before a read so it can put
+ *  the value in place, and after a write so it can act on it and store the register's real state back
+ */
+
+#ifndef FAKE_MCU_H_
+#define FAKE_MCU_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * \def FAKE_MCU_PAGE
+ *  Granule of fake_mcu_trap()
+ */
+#define FAKE_MCU_PAGE\
+	(0x1000UL)
+
+/**
+ * \typedef fake_mcu_hook_t
+ *  Register model, called with the byte address the firmware accessed. The page is accessible while it runs
+ */
+typedef void (*fake_mcu_hook_t)(uintptr_t address, bool write);
+
+/**
+ * \fn void fake_mcu_init
+ * \brief Map the memory, or zero it again on later calls, and drop every trap. Call before anything else
+ * \param N/A
+ * \return N/A
+ */
+void fake_mcu_init(void);
+
+/**
+ * \fn void fake_mcu_trap
+ * \brief Route every access to a page of registers through a model
+ * \param base Address in the page
+ * \param hook The model, or NULL to make the page plain memory again
+ * \return N/A
+ */
+void fake_mcu_trap(uintptr_t base, fake_mcu_hook_t hook);
+
+/**
+ * \fn void fake_mcu_erase_flash
+ * \brief Fill the mapped flash with the erased value 0xFF
+ * \param N/A
+ * \return N/A
+ */
+void fake_mcu_erase_flash(void);
+
+#endif /* FAKE_MCU_H_ */
@@ -0,0 +1,113 @@
+/**
+ * \file    test.h
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Check macros for the host unit tests
+ *
+ *  Each test program runs its cases with TEST_RUN() and returns test_summary() from main(). A failed check prints
+ *  where it was and the case goes on, so one run shows every failure
+ */
+
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <stdbool.h>
+#include <stdio.h>
+
+/**
+ * \def CHECK
+ *  Check a condition
+ */
+#define CHECK(condition)\
+	test_check((condition), #condition, __FILE__, __LINE__)
+
+/**
+ * \def CHECK_EQUAL
+ *  Check two integers are equal, printing both if not
+ */
+#define CHECK_EQUAL(expected, actual)\
+	test_check_equal((long long)(expected), (long long)(actual), #actual, __FILE__, __LINE__)
+
+/**
+ * \def TEST_RUN
+ *  Run a test case
+ */
+#define TEST_RUN(test)\
+	test_run(test, #test)
+
+static unsigned test_cases;
+static unsigned test_checks;
+static unsigned test_failures;
+
+/**
+ * \fn static bool test_check
+ * \brief Count a check, and print it if it failed
+ * \param passed Result of the check
+ * \param text The condition as written
+ * \param file Source file of the check
+ * \param line Line of the check
+ * \return passed
+ */
+static inline bool test_check(bool passed, const char *text, const char *file, int line){
+	test_checks++;
+	if(!passed){
+		test_failures++;
+		printf("%s:%d: check failed: %s\n", file, line, text);
+	}
+
+	return passed;
+}
+
+/**
+ * \fn static bool test_check_equal
+ * \brief Count a check of two integers, and print both if they differ
+ * \param expected The right value
+ * \param actual The value found
+ * \param text The expression that gave actual
+ * \param file Source file of the check
+ * \param line Line of the check
+ * \return true if they are equal
+ */
+static inline bool test_check_equal(long long expected, long long actual, const char *text, const char *file, int line){
+	test_checks++;
+	if(expected != actual){
+		test_failures++;
+		printf("%s:%d: %s is %lld (0x%llx), expected %lld (0x%llx)\n", file, line, text, actual,
+				(unsigned long long)actual, expected, (unsigned long long)expected);
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * \fn static void test_run
+ * \brief Run a test case and print its name if it failed
+ * \param test The case
+ * \param name Its name
+ * \return N/A
+ */
+static inline void test_run(void (*test)(void), const char *name){
+	unsigned failures;
+
+	failures = test_failures;
+	test_cases++;
+	test();
+	if(test_failures != failures){
+		printf("FAIL %s\n", name);
+	}
+}
+
+/**
+ * \fn static int test_summary
+ * \brief Print the totals of the program
+ * \param N/A
+ * \return Exit status for main(): 0 if every check passed
+ */
+static inline int test_summary(void){
+	printf("%u cases, %u checks, %u failed\n", test_cases, test_checks, test_failures);
+
+	return (test_failures == 0) ? 0 : 1;
+}
+
+#endif /* TEST_H_ */
@@ -0,0 +1,267 @@
+/**
+ * \file    test_baud.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Host tests of the exact LPSCI divisor search (LPSCI_CalculateBaudRate() in drivers/fsl_lpsci.c)
+ *
+ *  The search is checked against a table of target rates at both UART0 clocks of clocks.h, and against every OSR and
+ *  SBR pair the part has for random rates and clocks: no pair may be closer to the rate than the one chosen, and of
+ *  the pairs as close the chosen one has the highest OSR. LPSCI_SetBaudRate() must then program that pair
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "fake_mcu.h"
+#include "test.h"
+#include "fsl_lpsci.h"
+
+/**
+ * \def TEST_SBR_MAX
+ *  Largest SBR: 13 bits
+ */
+#define TEST_SBR_MAX\
+	(0x1FFFU)
+
+/**
+ * \def TEST_RANDOM_RATES
+ *  Random rates checked against every pair
+ */
+#define TEST_RANDOM_RATES\
+	(1000U)
+
+/**
+ * \typedef test_baud_t
+ *  A target rate and what the search must give for it
+ */
+typedef struct {
+	uint32_t clock_hz;
+	uint32_t rate_bps;
+	status_t status;
+	uint32_t osr;
+	uint32_t sbr;
+	uint32_t actual_bps;
+	uint32_t error_ppm;
+} test_baud_t;
+
+/**
+ *  UART0 at 48 MHz in clocks_run and 4 MHz in clocks_vlpr. Rates from 300 baud to the 12 Mbaud of OSR 4 and SBR 1;
+ *  above 1 Mbaud the 4 MHz clock cannot keep to 3 %
+ */
+static const test_baud_t test_table[] = {
+	{48000000U, 300U, kStatus_Success, 32U, 5000U, 300U, 0U},
+	{48000000U, 1200U, kStatus_Success, 32U, 1250U, 1200U, 0U},
+	{48000000U, 9600U, kStatus_Success, 25U, 200U, 9600U, 0U},
+	{48000000U, 19200U, kStatus_Success, 25U, 100U, 19200U, 0U},
+	{48000000U, 38400U, kStatus_Success, 25U, 50U, 38400U, 0U},
+	{48000000U, 57600U, kStatus_Success, 17U, 49U, 57623U, 400U},
+	{48000000U, 115200U, kStatus_Success, 32U, 13U, 115384U, 1602U},
+	{48000000U, 230400U, kStatus_Success, 26U, 8U, 230769U, 1602U},
+	{48000000U, 250000U, kStatus_Success, 32U, 6U, 250000U, 0U},
+	{48000000U, 460800U, kStatus_Success, 26U, 4U, 461538U, 1602U},
+	{48000000U, 500000U, kStatus_Success, 32U, 3U, 500000U, 0U},
+	{48000000U, 921600U, kStatus_Success, 26U, 2U, 923076U, 1602U},
+	{48000000U, 1000000U, kStatus_Success, 24U, 2U, 1000000U, 0U},
+	{48000000U, 1500000U, kStatus_Success, 32U, 1U, 1500000U, 0U},
+	{48000000U, 2000000U, kStatus_Success, 24U, 1U, 2000000U, 0U},
+	{48000000U, 3000000U, kStatus_Success, 16U, 1U, 3000000U, 0U},
+	{48000000U, 4000000U, kStatus_Success, 12U, 1U, 4000000U, 0U},
+	{48000000U, 6000000U, kStatus_Success, 8U, 1U, 6000000U, 0U},
+	{48000000U, 12000000U, kStatus_Success, 4U, 1U, 12000000U, 0U},
+	{4000000U, 300U, kStatus_Success, 22U, 606U, 300U, 100U},
+	{4000000U, 1200U, kStatus_Success, 11U, 303U, 1200U, 100U},
+	{4000000U, 9600U, kStatus_Success, 32U, 13U, 9615U, 1602U},
+	{4000000U, 19200U, kStatus_Success, 26U, 8U, 19230U, 1602U},
+	{4000000U, 38400U, kStatus_Success, 26U, 4U, 38461U, 1602U},
+	{4000000U, 57600U, kStatus_Success, 23U, 3U, 57971U, 6441U},
+	{4000000U, 115200U, kStatus_Success, 7U, 5U, 114285U, 7936U},
+	{4000000U, 230400U, kStatus_Success, 17U, 1U, 235294U, 21241U},
+	{4000000U, 250000U, kStatus_Success, 16U, 1U, 250000U, 0U},
+	{4000000U, 460800U, kStatus_LPSCI_BaudrateNotSupport, 9U, 1U, 444444U, 35493U},
+	{4000000U, 500000U, kStatus_Success, 8U, 1U, 500000U, 0U},
+	{4000000U, 921600U, kStatus_LPSCI_BaudrateNotSupport, 4U, 1U, 1000000U, 85069U},
+	{4000000U, 1000000U, kStatus_Success, 4U, 1U, 1000000U, 0U},
+	{4000000U, 1500000U, kStatus_LPSCI_BaudrateNotSupport, 4U, 1U, 1000000U, 333333U},
+	{4000000U, 2000000U, kStatus_LPSCI_BaudrateNotSupport, 4U, 1U, 1000000U, 500000U},
+	{4000000U, 3000000U, kStatus_LPSCI_BaudrateNotSupport, 4U, 1U, 1000000U, 666666U},
+	{4000000U, 4000000U, kStatus_LPSCI_BaudrateNotSupport, 4U, 1U, 1000000U, 750000U},
+	{4000000U, 6000000U, kStatus_LPSCI_BaudrateNotSupport, 4U, 1U, 1000000U, 833333U},
+	{4000000U, 12000000U, kStatus_LPSCI_BaudrateNotSupport, 4U, 1U, 1000000U, 916666U},
+};
+
+/**
+ * \fn static uint64_t test_error_ppm
+ * \brief Error of a divisor pair, as the driver states it
+ * \param rate_bps The rate asked for
+ * \param clock_hz The UART0 clock
+ * \param osr Over-sampling ratio
+ * \param sbr Baud rate divisor
+ * \return |clock - rate * osr * sbr| / (rate * osr * sbr) in parts per million, rounded down
+ */
+static uint64_t test_error_ppm(uint32_t rate_bps, uint32_t clock_hz, uint32_t osr, uint32_t sbr){
+	uint64_t divided;
+	uint64_t difference;
+
+	divided = (uint64_t)rate_bps * osr * sbr;
+	difference = (divided > clock_hz) ? (divided - clock_hz) : (clock_hz - divided);
+
+	return (difference * 1000000U) / divided;
+}
+
+/**
+ * \fn static bool test_exhaustive
+ * \brief Check the search against every OSR and SBR pair
+ * \param rate_bps The rate
+ * \param clock_hz The UART0 clock
+ * \return true if the search chose a closest pair, with the highest OSR of those
+ */
+static bool test_exhaustive(uint32_t rate_bps, uint32_t clock_hz){
+	lpsci_baud_config_t config;
+	status_t status;
+	uint64_t best_ppm;
+	uint64_t error_ppm;
+	uint32_t best_osr;
+	uint32_t osr;
+	uint32_t sbr;
+	bool passed;
+
+	best_ppm = UINT64_MAX;
+	best_osr = 0;
+	for(osr = 4; osr <= 32; osr++){
+		for(sbr = 1; sbr <= TEST_SBR_MAX; sbr++){
+			error_ppm = test_error_ppm(rate_bps, clock_hz, osr, sbr);
+			if(error_ppm <= best_ppm){
+				best_ppm = error_ppm;
+				best_osr = osr;
+			}
+		}
+	}
+
+	memset(&config, 0, sizeof(config));
+	status = LPSCI_CalculateBaudRate(rate_bps, clock_hz, &config);
+	passed = CHECK_EQUAL(best_ppm, config.errorPpm);
+	passed &= CHECK_EQUAL(best_osr, config.osr);
+	if(CHECK((config.sbr >= 1) && (config.sbr <= TEST_SBR_MAX))){
+		passed &= CHECK_EQUAL(best_ppm, test_error_ppm(rate_bps, clock_hz, config.osr, config.sbr));
+		passed &= CHECK_EQUAL(clock_hz / (config.osr * config.sbr), config.baudRate_Bps);
+	}
+	else{
+		passed = false;
+	}
+	passed &= CHECK_EQUAL((best_ppm > 30000U) ? kStatus_LPSCI_BaudrateNotSupport : kStatus_Success, status);
+	if(!passed){
+		printf("%u baud from %u Hz\n", rate_bps, clock_hz);
+	}
+
+	return passed;
+}
+
+/**
+ * \fn static void test_table_rates
+ * \brief The search gives the divisors of the table
+ * \param N/A
+ * \return N/A
+ */
+static void test_table_rates(void){
+	lpsci_baud_config_t config;
+	status_t status;
+	size_t i;
+
+	for(i = 0; i < (sizeof(test_table) / sizeof(test_table[0])); i++){
+		memset(&config, 0, sizeof(config));
+		status = LPSCI_CalculateBaudRate(test_table[i].rate_bps, test_table[i].clock_hz, &config);
+		if(!CHECK_EQUAL(test_table[i].status, status) || !CHECK_EQUAL(test_table[i].osr, config.osr) ||
+				!CHECK_EQUAL(test_table[i].sbr, config.sbr) ||
+				!CHECK_EQUAL(test_table[i].actual_bps, config.baudRate_Bps) ||
+				!CHECK_EQUAL(test_table[i].error_ppm, config.errorPpm)){
+			printf("%u baud from %u Hz\n", test_table[i].rate_bps, test_table[i].clock_hz);
+		}
+	}
+}
+
+/**
+ * \fn static void test_table_exhaustive
+ * \brief No pair is better than the one chosen for a rate of the table
+ * \param N/A
+ * \return N/A
+ */
+static void test_table_exhaustive(void){
+	size_t i;
+
+	for(i = 0; i < (sizeof(test_table) / sizeof(test_table[0])); i++){
+		test_exhaustive(test_table[i].rate_bps, test_table[i].clock_hz);
+	}
+}
+
+/**
+ * \fn static void test_random_rates
+ * \brief No pair is better than the one chosen for random rates, at the two UART0 clocks and at random clocks
+ * \param N/A
+ * \return N/A
+ */
+static void test_random_rates(void){
+	uint32_t clock_hz;
+	uint32_t rate_bps;
+	uint32_t failed;
+	uint32_t i;
+
+	srand(28);
+	failed = 0;
+	for(i = 0; (i < TEST_RANDOM_RATES) && (failed < 5); i++){
+		switch(i % 3){
+			case 0:
+				clock_hz = 48000000U;
+				break;
+			case 1:
+				clock_hz = 4000000U;
+				break;
+			default:
+				clock_hz = 1000000U + ((uint32_t)rand() % 47000000U);
+				break;
+		}
+		rate_bps = 300U + ((uint32_t)rand() % (clock_hz / 4U));
+		if(!test_exhaustive(rate_bps, clock_hz)){
+			failed++;
+		}
+	}
+}
+
+/**
+ * \fn static void test_registers
+ * \brief LPSCI_SetBaudRate() programs the divisors chosen, samples on both edges below OSR 8, and keeps the other
+ *  bits of the registers it shares
+ * \param N/A
+ * \return N/A
+ */
+static void test_registers(void){
+	fake_mcu_init();
+	UART0->BDH = UART0_BDH_SBNS_MASK | UART0_BDH_RXEDGIE_MASK;
+	UART0->C2 = UART0_C2_TE_MASK | UART0_C2_RE_MASK | UART0_C2_RIE_MASK;
+	UART0->C4 = UART0_C4_M10_MASK;
+	UART0->C5 = UART0_C5_RDMAE_MASK;
+
+	CHECK_EQUAL(kStatus_Success, LPSCI_SetBaudRate(UART0, 115200U, 4000000U));
+	CHECK_EQUAL(UART0_C4_M10_MASK | UART0_C4_OSR(7U - 1U), UART0->C4);
+	CHECK_EQUAL(UART0_C5_RDMAE_MASK | UART0_C5_BOTHEDGE_MASK, UART0->C5);
+	CHECK_EQUAL(UART0_BDH_SBNS_MASK | UART0_BDH_RXEDGIE_MASK, UART0->BDH);
+	CHECK_EQUAL(5, UART0->BDL);
+	CHECK_EQUAL(UART0_C2_TE_MASK | UART0_C2_RE_MASK | UART0_C2_RIE_MASK, UART0->C2);
+
+	CHECK_EQUAL(kStatus_Success, LPSCI_SetBaudRate(UART0, 300U, 48000000U));
+	CHECK_EQUAL(UART0_C4_M10_MASK | UART0_C4_OSR(32U - 1U), UART0->C4);
+	CHECK_EQUAL(UART0_C5_RDMAE_MASK, UART0->C5);
+	CHECK_EQUAL(UART0_BDH_SBNS_MASK | UART0_BDH_RXEDGIE_MASK | (5000U >> 8), UART0->BDH);
+	CHECK_EQUAL(5000U & 0xFFU, UART0->BDL);
+
+	CHECK_EQUAL(kStatus_LPSCI_BaudrateNotSupport, LPSCI_SetBaudRate(UART0, 921600U, 4000000U));
+	CHECK_EQUAL(UART0_C4_M10_MASK | UART0_C4_OSR(32U - 1U), UART0->C4);
+	CHECK_EQUAL(5000U & 0xFFU, UART0->BDL);
+}
+
+int main(void){
+	TEST_RUN(test_table_rates);
+	TEST_RUN(test_table_exhaustive);
+	TEST_RUN(test_random_rates);
+	TEST_RUN(test_registers);
+
+	return test_summary();
+}
@@ -0,0 +1,413 @@
+/**
+ * \file    test_blackbox.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Host tests of the black-box flash ring log (blackbox.c) on simulated flash
+ *
+ *  The cost table of blackbox.h is reproduced by recording at a steady rate for ten simulated days and counting
+ *  FLASH_Program() calls and sector erases. The ring is then wrapped several times across reboots, and one batch that
+ *  crosses into a sector needing an erase is cut at every step by the flash simulator (fake/fake_flash.h), torn by a
+ *  power loss or failed by the driver. After each cut the log must read back in sequence order with every record
+ *  written before the batch, take new records after them, and never program a longword that was not erased
+ */
+
+#include <string.h>
+#include "fake_mcu.h"
+#include "fake_flash.h"
+#include "test.h"
+#include "../Blinkenlights/source/blackbox.c"
+
+/**
+ * \def TEST_TICKS_PER_DAY
+ *  100 msec ticks per day
+ */
+#define TEST_TICKS_PER_DAY\
+	(864000UL)
+
+/**
+ * \def TEST_DAYS
+ *  Days each rate of the cost table is simulated for
+ */
+#define TEST_DAYS\
+	(10U)
+
+/**
+ * \def TEST_ERASE_CYCLES
+ *  Sector endurance the table assumes, from the KL25 datasheet
+ */
+#define TEST_ERASE_CYCLES\
+	(50000.0)
+
+/**
+ * \def TEST_LONGWORD_USEC
+ *  Longword program time the table assumes, from the KL25 datasheet
+ */
+#define TEST_LONGWORD_USEC\
+	(65U)
+
+/**
+ * \def TEST_CUT_HEAD
+ *  Slot the batch cut short starts at: two records before the end of a sector, so it erases the next one midway
+ */
+#define TEST_CUT_HEAD\
+	(BLACKBOX_SECTOR_RECORDS - 2)
+
+/**
+ * \typedef test_rate_t
+ *  One row of the cost table in blackbox.h
+ */
+typedef struct {
+	const char *name;
+	uint32_t ticks_per_record;
+	double programs_per_day;	/* FLASH_Program calls/day */
+	double erases_per_day;		/* sector erases/day, per sector */
+	double lifetime;			/* sector lifetime */
+	double lifetime_days;		/* days per unit of lifetime */
+} test_rate_t;
+
+static const test_rate_t test_rates[] = {
+	{"1 per minute", 600, 383, 5.6, 24, 365.25},
+	{"1 per second", 10, 22950, 338, 5, 365.25 / 12},
+};
+
+status_t clocks_burst_begin(void){
+	return kStatus_Success;
+}
+
+void clocks_burst_end(void){
+}
+
+/**
+ * \fn static void test_boot
+ * \brief Reset: RAM cleared, interrupts on, the log found again from flash
+ * \param N/A
+ * \return N/A
+ */
+static void test_boot(void){
+	fake_primask = 0;
+	blackbox_buffered = 0;
+	blackbox_dropped = 0;
+	blackbox_programs = 0;
+	blackbox_erases = 0;
+	blackbox_ticks = 0;
+	CHECK_EQUAL(kStatus_Success, blackbox_init());
+}
+
+/**
+ * \fn static void test_start
+ * \brief Erased flash, then a boot, whose reset record is flushed
+ * \param N/A
+ * \return N/A
+ */
+static void test_start(void){
+	fake_mcu_erase_flash();
+	fake_flash_reset();
+	test_boot();
+	CHECK_EQUAL(kStatus_Success, blackbox_flush());
+}
+
+/**
+ * \fn static void test_append
+ * \brief Record events and flush them
+ * \param count Amount of events, at most BLACKBOX_BUFFER
+ * \return N/A
+ */
+static void test_append(uint32_t count){
+	while(count--){
+		blackbox_record(blackbox_led, (uint8_t)count, blackbox_sequence);
+	}
+	CHECK_EQUAL(kStatus_Success, blackbox_flush());
+}
+
+/**
+ * \fn static uint32_t test_read
+ * \brief Read the log oldest first, checking the whole records are in rising sequence order
+ * \param sequences Where to store the sequence numbers of the whole records, BLACKBOX_SLOTS of them, or NULL
+ * \return Amount of whole records
+ */
+static uint32_t test_read(uint32_t *sequences){
+	const blackbox_record_t *record;
+	uint32_t count;
+	uint32_t index;
+	bool valid;
+
+	count = 0;
+	for(index = 0; (record = blackbox_at(index, &valid)) != NULL; index++){
+		if(!valid){
+			continue;
+		}
+		if(count != 0){
+			CHECK(record->sequence > sequences[count - 1]);
+		}
+		sequences[count++] = record->sequence;
+	}
+	CHECK(index <= BLACKBOX_SLOTS);
+
+	return count;
+}
+
+/**
+ * \fn static bool test_holds
+ * \brief Check the log read back has a run of sequence numbers
+ * \param sequences What test_read() found
+ * \param count Amount found
+ * \param first First sequence number of the run
+ * \param length Length of the run
+ * \return true if every one is there
+ */
+static bool test_holds(const uint32_t *sequences, uint32_t count, uint32_t first, uint32_t length){
+	uint32_t i;
+
+	for(i = 0; (i < count) && (sequences[i] != first); i++){
+	}
+
+	return ((i + length) <= count) && (sequences[i + length - 1] == first + length - 1);
+}
+
+/**
+ * \fn static void test_table
+ * \brief Ten days at each rate of the cost table give its FLASH_Program() calls and erases per day, sector lifetime
+ *  and batch length
+ * \param N/A
+ * \return N/A
+ *
+ *  The log starts two records into a sector, as after a boot, so batches straddle sector boundaries as they do on
+ *  the device
+ */
+static void test_table(void){
+	static uint32_t sequences[BLACKBOX_SLOTS];
+	const test_rate_t *rate;
+	blackbox_stats_t stats;
+	fake_flash_stats_t flash;
+	double programs;
+	double erases;
+	double lifetime;
+	uint32_t records;
+	uint32_t tick;
+	uint32_t i;
+
+	for(i = 0; i < (sizeof(test_rates) / sizeof(test_rates[0])); i++){
+		rate = &test_rates[i];
+		test_start();
+		test_boot();
+		fake_flash_reset();
+		records = blackbox_buffered;
+		for(tick = 1; tick <= (TEST_DAYS * TEST_TICKS_PER_DAY); tick++){
+			if((tick % rate->ticks_per_record) == 0){
+				blackbox_record(blackbox_param, 0, tick);
+				records++;
+			}
+			blackbox_tick();
+		}
+		blackbox_get_stats(&stats);
+		fake_flash_get_stats(&flash);
+		programs = (double)stats.programs / TEST_DAYS;
+		erases = (double)stats.erases / TEST_DAYS / BLACKBOX_SECTOR_COUNT;
+		lifetime = TEST_ERASE_CYCLES / erases / rate->lifetime_days;
+		printf("%s: %.0f programs/day, %.2f erases/day per sector, lifetime %.1f\n", rate->name, programs, erases,
+				lifetime);
+
+		CHECK_EQUAL(0, stats.dropped);
+		CHECK((programs > (rate->programs_per_day - 1.0)) && (programs < (rate->programs_per_day + 1.0)));
+		CHECK((erases >= (rate->erases_per_day * 0.98)) && (erases <= (rate->erases_per_day * 1.02)));
+		CHECK_EQUAL(rate->lifetime, (uint32_t)(lifetime + 0.5));
+		CHECK_EQUAL(stats.erases, flash.erases);
+		CHECK_EQUAL((records - stats.buffered) * (sizeof(blackbox_record_t) / 4U), flash.programs);
+		CHECK_EQUAL(16, BLACKBOX_BATCH * (sizeof(blackbox_record_t) / 4U));
+		CHECK_EQUAL(1, (16U * TEST_LONGWORD_USEC + 500U) / 1000U);
+		CHECK_EQUAL(0, flash.overwrites);
+		CHECK_EQUAL(0, flash.unmasked);
+		CHECK_EQUAL(BLACKBOX_SLOTS - BLACKBOX_SECTOR_RECORDS + (blackbox_head % BLACKBOX_SECTOR_RECORDS),
+				test_read(sequences));
+	}
+}
+
+/**
+ * \fn static void test_burst
+ * \brief Up to BLACKBOX_BUFFER records between two ticks are kept, any more are dropped and counted
+ * \param N/A
+ * \return N/A
+ */
+static void test_burst(void){
+	static uint32_t sequences[BLACKBOX_SLOTS];
+	blackbox_stats_t stats;
+	uint32_t first;
+	uint32_t i;
+
+	test_start();
+	first = blackbox_sequence;
+	for(i = 0; i < BLACKBOX_BUFFER; i++){
+		blackbox_record(blackbox_param, 1, i);
+	}
+	blackbox_get_stats(&stats);
+	CHECK_EQUAL(BLACKBOX_BUFFER, stats.buffered);
+	CHECK_EQUAL(0, stats.dropped);
+	blackbox_record(blackbox_param, 1, i);
+	blackbox_get_stats(&stats);
+	CHECK_EQUAL(1, stats.dropped);
+
+	blackbox_tick();
+	blackbox_get_stats(&stats);
+	CHECK_EQUAL(0, stats.buffered);
+	CHECK(test_holds(sequences, test_read(sequences), first, BLACKBOX_BUFFER));
+}
+
+/**
+ * \fn static void test_ring_wrap
+ * \brief The ring wraps over every sector several times across reboots, and keeps the newest records in order with
+ *  the sequence carried on from flash
+ * \param N/A
+ * \return N/A
+ */
+static void test_ring_wrap(void){
+	static uint32_t sequences[BLACKBOX_SLOTS];
+	fake_flash_stats_t flash;
+	uint32_t count;
+	uint32_t round;
+	uint32_t sequence;
+
+	test_start();
+	for(round = 0; blackbox_sequence < (3U * BLACKBOX_SLOTS); round++){
+		test_append(1 + (round % 7));
+		if((round % 29) == 0){
+			sequence = blackbox_sequence;
+			test_boot();
+			CHECK_EQUAL(sequence + 1, blackbox_sequence);
+			CHECK_EQUAL(kStatus_Success, blackbox_flush());
+		}
+		count = test_read(sequences);
+		CHECK(count >= MIN(BLACKBOX_SLOTS - BLACKBOX_SECTOR_RECORDS, blackbox_sequence));
+		CHECK(test_holds(sequences, count, blackbox_sequence - count, count));
+	}
+	fake_flash_get_stats(&flash);
+	CHECK(flash.erases > (2U * BLACKBOX_SECTOR_COUNT));
+	CHECK_EQUAL(0, flash.overwrites);
+	CHECK_EQUAL(0, flash.unmasked);
+}
+
+/**
+ * \fn static void test_prepare_cut
+ * \brief Fill the ring past one wrap and stop with the head at TEST_CUT_HEAD, so the next batch of BLACKBOX_BATCH
+ *  programs two records, erases a sector of old records and programs two more
+ * \param N/A
+ * \return N/A
+ */
+static void test_prepare_cut(void){
+	test_start();
+	while(blackbox_sequence < BLACKBOX_SLOTS){
+		test_append(BLACKBOX_BATCH);
+	}
+	while(blackbox_head != TEST_CUT_HEAD){
+		test_append(1);
+	}
+}
+
+/**
+ * \fn static bool test_cut
+ * \brief Run the batch of test_prepare_cut() with one fault injected, then check the log and that it carries on
+ * \param step Step to fault
+ * \param fault What happens there
+ * \param tear_mask Bits a torn program does get programmed
+ * \return true if the fault happened, false if the batch finished before reaching the step
+ */
+static bool test_cut(uint32_t step, fake_flash_fault_t fault, uint32_t tear_mask){
+	static uint32_t sequences[BLACKBOX_SLOTS];
+	fake_flash_stats_t flash;
+	blackbox_stats_t stats;
+	uint32_t first;
+	uint32_t written;
+	uint32_t count;
+	uint32_t i;
+	status_t status;
+
+	test_prepare_cut();
+	first = blackbox_sequence;
+	for(i = 0; i < BLACKBOX_BATCH; i++){
+		blackbox_record(blackbox_param, 2, i);
+	}
+	fake_flash_reset();
+	fake_flash_inject(step, fault, tear_mask);
+
+	/**
+	 *  Records whose last longword was programmed before the step: two in the first sector, the erase, two more
+	 */
+	written = 0;
+	for(i = 0; i < BLACKBOX_BATCH; i++){
+		if((((i + 1) * (sizeof(blackbox_record_t) / 4U)) + ((i >= 2) ? 1U : 0U)) < step){
+			written++;
+		}
+	}
+
+	if(setjmp(fake_flash_power_loss) == 0){
+		status = blackbox_flush();
+		fake_flash_get_stats(&flash);
+		if(!flash.fired){
+			CHECK_EQUAL(kStatus_Success, status);
+			CHECK(test_holds(sequences, test_read(sequences), first - TEST_CUT_HEAD, TEST_CUT_HEAD + BLACKBOX_BATCH));
+			return false;
+		}
+		CHECK_EQUAL(kStatus_Fail, status);
+		CHECK_EQUAL(0, fake_primask);
+		blackbox_get_stats(&stats);
+		CHECK(stats.dropped >= (BLACKBOX_BATCH - written));
+	}
+	else{
+		test_boot();
+		CHECK_EQUAL(first + written, blackbox_sequence - 1);
+		CHECK_EQUAL(kStatus_Success, blackbox_flush());
+	}
+
+	/**
+	 *  Every record before the batch in the sector being filled, and the batch's whole records, survive
+	 */
+	count = test_read(sequences);
+	if(!CHECK(test_holds(sequences, count, first - TEST_CUT_HEAD, TEST_CUT_HEAD)) ||
+			!CHECK((written == 0) || test_holds(sequences, count, first, written))){
+		printf("%s at step %u (mask 0x%08x)\n", (fault == fake_flash_tear) ? "tear" : "failure", step, tear_mask);
+	}
+
+	/**
+	 *  New records go after them, and stay there over a reboot
+	 */
+	first = blackbox_sequence;
+	test_append(BLACKBOX_BUFFER);
+	test_append(BLACKBOX_BUFFER);
+	CHECK(test_holds(sequences, test_read(sequences), first, 2U * BLACKBOX_BUFFER));
+	test_boot();
+	CHECK(test_holds(sequences, test_read(sequences), first, 2U * BLACKBOX_BUFFER));
+	fake_flash_get_stats(&flash);
+	CHECK_EQUAL(0, flash.overwrites);
+	CHECK_EQUAL(0, flash.unmasked);
+
+	return true;
+}
+
+/**
+ * \fn static void test_torn_batch
+ * \brief Cut the batch at every step: the power lost in the middle of a longword or of the erase, or the driver
+ *  failing there, a failed erase included
+ * \param N/A
+ * \return N/A
+ */
+static void test_torn_batch(void){
+	static const uint32_t masks[] = {0x00000000UL, 0x0F0F0F0FUL, 0xFFFF0000UL};
+	uint32_t step;
+	uint32_t m;
+
+	for(step = 1; test_cut(step, fake_flash_fail, 0); step++){
+		for(m = 0; m < (sizeof(masks) / sizeof(masks[0])); m++){
+			test_cut(step, fake_flash_tear, masks[m]);
+		}
+	}
+	CHECK_EQUAL((BLACKBOX_BATCH * (sizeof(blackbox_record_t) / 4U)) + 1U, step - 1);
+}
+
+int main(void){
+	fake_mcu_init();
+	TEST_RUN(test_table);
+	TEST_RUN(test_burst);
+	TEST_RUN(test_ring_wrap);
+	TEST_RUN(test_torn_batch);
+
+	return test_summary();
+}
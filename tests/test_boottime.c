@@ -0,0 +1,284 @@
+/**
+ * \file    test_boottime.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Host tests of the boot phase trace (boottime.c): the warm reset counter kept in .noinit, the 32-bit time
+ *  from TPM0 and its overflows, the marks, the end of the trace at a clock profile switch, and the boot flags
+ *
+ *  A reset is simulated by setting the reset cause in RCM_SRS0 and calling boottime_init() again without touching
+ *  the counter, as the .noinit section is left alone by crt0
+ */
+
+#include <string.h>
+#include "fake_mcu.h"
+#include "test.h"
+#include "../Blinkenlights/source/boottime.c"
+
+/**
+ * \typedef test_boottime_t
+ *  What the stubs of power.c, settings.c and clocks.c saw
+ */
+typedef struct {
+	int32_t wait_held;			/* WAIT constraints taken less those given back */
+	uint32_t saved_flags;
+	bool saved;
+	uint32_t stored_flags;		/* What settings_read() returns */
+	bool stored;
+	clocks_notifier_t notifier;	/* What clocks_register() was given */
+	uint32_t registered;
+} test_boottime_t;
+
+static test_boottime_t test_boottime;
+
+void power_constrain(power_mode_t mode){
+	if(mode == power_wait){
+		test_boottime.wait_held++;
+	}
+}
+
+void power_release(power_mode_t mode){
+	if(mode == power_wait){
+		test_boottime.wait_held--;
+	}
+}
+
+status_t settings_read(settings_key_t key, void *value, size_t size, size_t *length){
+	if((key != settings_key_boot) || !test_boottime.stored || (size != sizeof(uint32_t))){
+		return kStatus_Fail;
+	}
+	memcpy(value, &test_boottime.stored_flags, sizeof(uint32_t));
+
+	return kStatus_Success;
+}
+
+status_t settings_write(settings_key_t key, const void *value, size_t length){
+	if((key != settings_key_boot) || (length != sizeof(uint32_t))){
+		return kStatus_Fail;
+	}
+	memcpy(&test_boottime.saved_flags, value, sizeof(uint32_t));
+	test_boottime.saved = true;
+
+	return kStatus_Success;
+}
+
+status_t clocks_register(clocks_notifier_t notifier){
+	test_boottime.notifier = notifier;
+	test_boottime.registered++;
+
+	return kStatus_Success;
+}
+
+/**
+ * \fn static uint32_t test_reset
+ * \brief Reset the MCU with a cause and run the start of the boot, leaving .noinit as it was
+ * \param cause RCM_SRS0 bits of the reset
+ * \return The warm reset count the trace recorded
+ */
+static uint32_t test_reset(uint32_t cause){
+	boottime_trace_t trace;
+
+	fake_mcu_init();
+	memset(&test_boottime, 0, sizeof(test_boottime));
+	memset(&boottime_trace, 0, sizeof(boottime_trace));
+	boottime_overflows = 0;
+	*(volatile uint8_t *)&RCM->SRS0 = (uint8_t)cause;
+	boottime_start();
+	boottime_init();
+	boottime_get_trace(&trace);
+
+	return trace.warm_resets;
+}
+
+/**
+ * \fn static void test_warm_resets
+ * \brief The counter clears at a power-on or low-voltage reset and when its magic or check is wrong, and counts
+ *  every other reset
+ * \param N/A
+ * \return N/A
+ */
+static void test_warm_resets(void){
+	uint32_t i;
+
+	memset(&boottime_warm, 0xA5, sizeof(boottime_warm));
+	CHECK_EQUAL(0, test_reset(RCM_SRS0_POR_MASK | RCM_SRS0_LVD_MASK));
+	for(i = 1; i <= 5; i++){
+		CHECK_EQUAL(i, test_reset(RCM_SRS0_PIN_MASK));
+	}
+	CHECK_EQUAL(6, test_reset(RCM_SRS0_WDOG_MASK));
+	CHECK_EQUAL(0, test_reset(RCM_SRS0_POR_MASK));
+	CHECK_EQUAL(1, test_reset(RCM_SRS0_PIN_MASK));
+	CHECK_EQUAL(0, test_reset(RCM_SRS0_LVD_MASK));
+	CHECK_EQUAL(1, test_reset(RCM_SRS0_PIN_MASK));
+
+	/**
+	 *  SRAM that lost its contents without a POR or LVD flag
+	 */
+	boottime_warm.check ^= 1;
+	CHECK_EQUAL(0, test_reset(RCM_SRS0_PIN_MASK));
+	CHECK_EQUAL(1, test_reset(RCM_SRS0_PIN_MASK));
+	boottime_warm.magic = 0;
+	CHECK_EQUAL(0, test_reset(RCM_SRS0_PIN_MASK));
+	boottime_warm.resets = 7;
+	boottime_warm.check = ~7U;
+	boottime_warm.magic = (uint32_t)~BOOTTIME_WARM_MAGIC;
+	CHECK_EQUAL(0, test_reset(RCM_SRS0_PIN_MASK));
+	CHECK_EQUAL(0xFFFFFFFFUL, boottime_warm.check);
+}
+
+/**
+ * \fn static void test_timer
+ * \brief boottime_start() runs TPM0 from MCGIRCLK, and the time joins the overflow count to the counter, taking an
+ *  overflow not serviced yet into account
+ * \param N/A
+ * \return N/A
+ */
+static void test_timer(void){
+	test_reset(RCM_SRS0_POR_MASK);
+	CHECK(SIM->SCGC6 & SIM_SCGC6_TPM0_MASK);
+	CHECK_EQUAL(BOOTTIME_TPMSRC_MCGIRCLK, (SIM->SOPT2 & SIM_SOPT2_TPMSRC_MASK) >> SIM_SOPT2_TPMSRC_SHIFT);
+	CHECK(MCG->C1 & MCG_C1_IRCLKEN_MASK);
+	CHECK_EQUAL(BOOTTIME_TIMER_MOD, TPM0->MOD);
+	CHECK_EQUAL(TPM_SC_CMOD(1) | TPM_SC_TOIE_MASK, TPM0->SC);
+	CHECK_EQUAL(1, test_boottime.wait_held);
+
+	TPM0->CNT = 0x1234;
+	CHECK_EQUAL(0x1234, boottime_now());
+	TPM0_DriverIRQHandler();
+	TPM0_DriverIRQHandler();
+	TPM0->SC &= ~TPM_SC_TOF_MASK;
+	CHECK_EQUAL(0x21234, boottime_now());
+
+	/**
+	 *  Wrapped to 3 with the overflow still pending
+	 */
+	TPM0->CNT = 3;
+	TPM0->SC |= TPM_SC_TOF_MASK;
+	CHECK_EQUAL(0x30003, boottime_now());
+	TPM0_DriverIRQHandler();
+	TPM0->SC &= ~TPM_SC_TOF_MASK;
+	CHECK_EQUAL(0x30003, boottime_now());
+}
+
+/**
+ * \fn static void test_marks
+ * \brief Marks keep their order and time, the first LED edge is the end of the LED phase, and boottime_end() stops
+ *  the timer, gives back WAIT once and freezes the trace
+ * \param N/A
+ * \return N/A
+ */
+static void test_marks(void){
+	static const boottime_phase_t phases[] = {
+		boottime_settings, boottime_pins, boottime_clocks, boottime_peripherals, boottime_power, boottime_leds,
+		boottime_storage, boottime_touch, boottime_pll, boottime_console
+	};
+	boottime_trace_t trace;
+	uint32_t i;
+
+	test_reset(RCM_SRS0_PIN_MASK);
+	for(i = 0; i < (sizeof(phases) / sizeof(phases[0])); i++){
+		TPM0->CNT = (i + 1) * 100;
+		boottime_mark(phases[i]);
+	}
+	boottime_get_trace(&trace);
+	CHECK_EQUAL(i + 1, trace.count);
+	CHECK_EQUAL(boottime_crt0, trace.marks[0].phase);
+	CHECK_EQUAL(0, trace.marks[0].ticks);
+	for(i = 0; i < (sizeof(phases) / sizeof(phases[0])); i++){
+		CHECK_EQUAL(phases[i], trace.marks[i + 1].phase);
+		CHECK_EQUAL((i + 1) * 100, trace.marks[i + 1].ticks);
+	}
+	CHECK_EQUAL(600, trace.first_led);
+	CHECK(!trace.done);
+
+	boottime_end();
+	boottime_mark(boottime_selftest);
+	boottime_get_trace(&trace);
+	CHECK(trace.done);
+	CHECK_EQUAL(11, trace.count);
+	CHECK_EQUAL(0, TPM0->SC);
+	CHECK(!(SIM->SCGC6 & SIM_SCGC6_TPM0_MASK));
+	CHECK_EQUAL(0, test_boottime.wait_held);
+
+	/**
+	 *  More marks than phases are dropped
+	 */
+	test_reset(RCM_SRS0_PIN_MASK);
+	for(i = 0; i < (2 * boottime_phase_count); i++){
+		boottime_mark(boottime_selftest);
+	}
+	boottime_get_trace(&trace);
+	CHECK_EQUAL(boottime_phase_count, trace.count);
+}
+
+/**
+ * \fn static void test_clock_switch
+ * \brief The first profile switch ends the trace before MCGIRCLK changes, and the boottime_end() of main() that
+ *  follows gives nothing back twice
+ * \param N/A
+ * \return N/A
+ */
+static void test_clock_switch(void){
+	boottime_trace_t trace;
+
+	test_reset(RCM_SRS0_PIN_MASK);
+	CHECK_EQUAL(1, test_boottime.registered);
+	if(!CHECK(test_boottime.notifier != NULL)){
+		return;
+	}
+
+	/**
+	 *  A refused switch and the after calls leave the trace running
+	 */
+	CHECK_EQUAL(kStatus_Success, test_boottime.notifier(clocks_after, clocks_run, clocks_run));
+	CHECK_EQUAL(kStatus_Success, test_boottime.notifier(clocks_after, clocks_vlpr, clocks_run));
+	boottime_mark(boottime_settings);
+	boottime_get_trace(&trace);
+	CHECK(!trace.done);
+	CHECK_EQUAL(2, trace.count);
+
+	CHECK_EQUAL(kStatus_Success, test_boottime.notifier(clocks_before, clocks_run, clocks_vlpr));
+	boottime_get_trace(&trace);
+	CHECK(trace.done);
+	CHECK_EQUAL(0, TPM0->SC);
+	CHECK(!(SIM->SCGC6 & SIM_SCGC6_TPM0_MASK));
+	CHECK_EQUAL(0, test_boottime.wait_held);
+
+	boottime_mark(boottime_pins);
+	CHECK_EQUAL(kStatus_Success, test_boottime.notifier(clocks_before, clocks_vlpr, clocks_run));
+	boottime_end();
+	boottime_get_trace(&trace);
+	CHECK_EQUAL(2, trace.count);
+	CHECK_EQUAL(0, test_boottime.wait_held);
+}
+
+/**
+ * \fn static void test_flags
+ * \brief Only the known flags are kept, loaded or saved, and a missing setting means the full boot
+ * \param N/A
+ * \return N/A
+ */
+static void test_flags(void){
+	boottime_trace_t trace;
+
+	test_reset(RCM_SRS0_POR_MASK);
+	CHECK_EQUAL(0, boottime_load_flags());
+	test_boottime.stored = true;
+	test_boottime.stored_flags = 0xFFFFFFF0UL | BOOTTIME_FLAG_SKIP_SELFTEST;
+	CHECK_EQUAL(BOOTTIME_FLAG_SKIP_SELFTEST, boottime_load_flags());
+	boottime_get_trace(&trace);
+	CHECK_EQUAL(BOOTTIME_FLAG_SKIP_SELFTEST, trace.flags);
+
+	CHECK_EQUAL(kStatus_Success, boottime_save_flags(~0U));
+	CHECK(test_boottime.saved);
+	CHECK_EQUAL(BOOTTIME_FLAGS_FAST, test_boottime.saved_flags);
+}
+
+int main(void){
+	TEST_RUN(test_warm_resets);
+	TEST_RUN(test_timer);
+	TEST_RUN(test_marks);
+	TEST_RUN(test_clock_switch);
+	TEST_RUN(test_flags);
+
+	return test_summary();
+}
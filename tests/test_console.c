@@ -0,0 +1,445 @@
+/**
+ * \file    test_console.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Host tests of the console line editor (source/console.c) fed through the LPSCI model
+ *
+ *  Bytes go in on the UART0 receive line of fake/fake_lpsci.h and take the whole path of the firmware: the LPSCI
+ *  driver's RX interrupt, its ring buffer, serial_read() and the line editor. The lines handed to the callback and
+ *  the echo written to UART0 are compared with a reference editor written from the rules in console.c
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "fake_mcu.h"
+#include "fake_lpsci.h"
+#include "test.h"
+#include "../Blinkenlights/source/console.c"
+#include "power.h"
+
+/**
+ * \def TEST_TRANSCRIPT_SIZE
+ *  Bytes of completed lines a test keeps, each followed by '\0'
+ */
+#define TEST_TRANSCRIPT_SIZE\
+	(65536U)
+
+/**
+ * \def TEST_RING_CAPACITY
+ *  Bytes the receive ring holds: the driver keeps one slot free
+ */
+#define TEST_RING_CAPACITY\
+	(CONSOLE_RX_RING_SIZE - 1U)
+
+/**
+ * \typedef test_transcript_t
+ *  Completed lines and the echo, from the console or from the reference editor
+ */
+typedef struct {
+	char lines[TEST_TRANSCRIPT_SIZE];
+	size_t length;
+	uint32_t count;
+	uint8_t echo[FAKE_LPSCI_TX_SIZE];
+	size_t echo_length;
+} test_transcript_t;
+
+/**
+ * \typedef test_reference_t
+ *  The reference editor
+ */
+typedef struct {
+	char line[CONSOLE_LINE_MAX];
+	uint32_t length;
+	bool after_cr;
+} test_reference_t;
+
+static test_transcript_t console_out;
+static test_transcript_t reference_out;
+static test_reference_t reference;
+static uint32_t test_bad_lengths;
+
+uint32_t SystemCoreClock = 48000000UL;
+
+void power_constrain(power_mode_t deepest){
+}
+
+void power_release(power_mode_t deepest){
+}
+
+status_t clocks_register(clocks_notifier_t notifier){
+	return kStatus_Success;
+}
+
+clocks_profile_t clocks_get_profile(void){
+	return clocks_run;
+}
+
+uint32_t clocks_get_uart0_freq(clocks_profile_t profile){
+	return 48000000UL;
+}
+
+int DbgConsole_Printf(const char *fmt_s, ...){
+	return 0;
+}
+
+/**
+ * \fn static void test_append
+ * \brief Add a completed line to a transcript
+ * \param out The transcript
+ * \param line The line
+ * \param length Its length
+ * \return N/A
+ */
+static void test_append(test_transcript_t *out, const char *line, uint32_t length){
+	if(out->length + length + 1 <= TEST_TRANSCRIPT_SIZE){
+		memcpy(&out->lines[out->length], line, length);
+		out->lines[out->length + length] = '\0';
+	}
+	out->length += length + 1;
+	out->count++;
+}
+
+/**
+ * \fn static void test_line
+ * \brief Line callback: record the line, then scribble over it as a callback may
+ * \param line The line
+ * \param length Its length
+ * \return N/A
+ */
+static void test_line(char *line, uint32_t length){
+	if(strlen(line) != length){
+		test_bad_lengths++;
+	}
+	test_append(&console_out, line, length);
+	memset(line, '#', length);
+}
+
+/**
+ * \fn static void reference_echo
+ * \brief Add to the echo the reference editor expects
+ * \param s The echoed string
+ * \param length Its length
+ * \return N/A
+ */
+static void reference_echo(const char *s, size_t length){
+	if(reference_out.echo_length + length <= sizeof(reference_out.echo)){
+		memcpy(&reference_out.echo[reference_out.echo_length], s, length);
+	}
+	reference_out.echo_length += length;
+}
+
+/**
+ * \fn static void reference_edit
+ * \brief The line editor as its comment describes it
+ * \param c A received byte
+ * \return N/A
+ */
+static void reference_edit(uint8_t c){
+	bool after_cr;
+
+	after_cr = reference.after_cr;
+	reference.after_cr = (c == '\r');
+	if((c == '\n') && after_cr){
+		return;
+	}
+	if((c == '\r') || (c == '\n')){
+		reference_echo("\r\n", 2);
+		test_append(&reference_out, reference.line, reference.length);
+		reference.length = 0;
+	}
+	else if((c == '\b') || (c == 0x7F)){
+		if(reference.length != 0){
+			reference.length--;
+			reference_echo("\b \b", 3);
+		}
+	}
+	else if((c >= ' ') && (reference.length < CONSOLE_LINE_MAX)){
+		reference.line[reference.length++] = (char)c;
+		reference_echo((const char *)&c, 1);
+	}
+}
+
+/**
+ * \fn static void test_start
+ * \brief Reset the hardware, the console and both transcripts
+ * \param N/A
+ * \return N/A
+ */
+static void test_start(void){
+	fake_mcu_init();
+	fake_lpsci_init();
+	memset(&console_out, 0, sizeof(console_out));
+	memset(&reference_out, 0, sizeof(reference_out));
+	memset(&reference, 0, sizeof(reference));
+	test_bad_lengths = 0;
+	console_init(test_line);
+}
+
+/**
+ * \fn static void test_feed
+ * \brief Receive bytes on the console and in the reference, without polling the console
+ * \param data The bytes
+ * \param length Amount of bytes
+ * \return N/A
+ */
+static void test_feed(const void *data, size_t length){
+	size_t i;
+
+	fake_lpsci_receive(data, length);
+	for(i = 0; i < length; i++){
+		reference_edit(((const uint8_t *)data)[i]);
+	}
+}
+
+/**
+ * \fn static void test_compare
+ * \brief Check the console produced what the reference did
+ * \param N/A
+ * \return N/A
+ */
+static void test_compare(void){
+	CHECK_EQUAL(reference_out.count, console_out.count);
+	CHECK_EQUAL(reference_out.length, console_out.length);
+	CHECK(memcmp(reference_out.lines, console_out.lines, MIN(reference_out.length, TEST_TRANSCRIPT_SIZE)) == 0);
+	CHECK_EQUAL(reference_out.echo_length, fake_lpsci.tx_length);
+	CHECK(memcmp(reference_out.echo, fake_lpsci.tx, MIN(fake_lpsci.tx_length, FAKE_LPSCI_TX_SIZE)) == 0);
+	CHECK_EQUAL(0, test_bad_lengths);
+}
+
+/**
+ * \fn static void test_endings
+ * \brief CR, LF and CR LF each end one line; LF CR and CR CR end two
+ * \param N/A
+ * \return N/A
+ */
+static void test_endings(void){
+	static const char stream[] = "a\rb\nc\r\nd\n\re\r\rf\r\n\ng";
+
+	test_start();
+	test_feed(stream, sizeof(stream) - 1);
+	console_poll();
+	CHECK_EQUAL(9, console_out.count);
+	CHECK(memcmp(console_out.lines, "a\0b\0c\0d\0\0e\0\0f\0", 15) == 0);
+	test_compare();
+}
+
+/**
+ * \fn static void test_backspace
+ * \brief Backspace and DEL erase one character each and echo the erase; on an empty line they do nothing
+ * \param N/A
+ * \return N/A
+ */
+static void test_backspace(void){
+	static const char stream[] = "\b\x7F" "abc\b\x7F" "d\b\b\b" "e\r";
+
+	test_start();
+	test_feed(stream, sizeof(stream) - 1);
+	console_poll();
+	CHECK_EQUAL(1, console_out.count);
+	CHECK(strcmp(console_out.lines, "e") == 0);
+	CHECK_EQUAL(strlen("abc\b \b\b \bd\b \b\b \be\r\n"), fake_lpsci.tx_length);
+	CHECK(memcmp(fake_lpsci.tx, "abc\b \b\b \bd\b \b\b \be\r\n", fake_lpsci.tx_length) == 0);
+	test_compare();
+}
+
+/**
+ * \fn static void test_controls
+ * \brief Other control characters are dropped without echo, bytes above 0x7F are kept
+ * \param N/A
+ * \return N/A
+ */
+static void test_controls(void){
+	static const char stream[] = "a\x01\x1B[A\t\x00" "b\xC3\xA9\r";
+
+	test_start();
+	test_feed(stream, sizeof(stream) - 1);
+	console_poll();
+	CHECK_EQUAL(1, console_out.count);
+	CHECK(strcmp(console_out.lines, "a[Ab\xC3\xA9") == 0);
+	test_compare();
+}
+
+/**
+ * \fn static void test_long_line
+ * \brief A line stops growing at CONSOLE_LINE_MAX, and the next line starts empty
+ * \param N/A
+ * \return N/A
+ */
+static void test_long_line(void){
+	char stream[CONSOLE_LINE_MAX + 20];
+	uint32_t i;
+
+	test_start();
+	for(i = 0; i < sizeof(stream); i++){
+		stream[i] = (char)('0' + (i % 10));
+	}
+	test_feed(stream, sizeof(stream));
+	console_poll();
+	test_feed("\b\rok\r", 5);
+	console_poll();
+	CHECK_EQUAL(2, console_out.count);
+	CHECK_EQUAL(CONSOLE_LINE_MAX - 1, strlen(console_out.lines));
+	CHECK(strcmp(&console_out.lines[CONSOLE_LINE_MAX], "ok") == 0);
+	test_compare();
+}
+
+/**
+ * \fn static void test_split
+ * \brief A line may arrive over many polls, and many lines in one
+ * \param N/A
+ * \return N/A
+ */
+static void test_split(void){
+	test_start();
+	test_feed("hel", 3);
+	console_poll();
+	CHECK_EQUAL(0, console_out.count);
+	test_feed("lo\r", 2);
+	console_poll();
+	CHECK_EQUAL(0, console_out.count);
+	test_feed("\r\nx\ry\rz", 6);
+	console_poll();
+	CHECK_EQUAL(3, console_out.count);
+	CHECK(memcmp(console_out.lines, "hello\0x\0y\0", 10) == 0);
+	test_compare();
+}
+
+/**
+ * \fn static void test_idle_poll
+ * \brief With nothing received, console_poll() returns at once without touching the receiver
+ * \param N/A
+ * \return N/A
+ */
+static void test_idle_poll(void){
+	uint32_t i;
+
+	test_start();
+	for(i = 0; i < 1000; i++){
+		console_poll();
+	}
+	CHECK_EQUAL(0, fake_lpsci.d_reads);
+	CHECK_EQUAL(0, console_out.count);
+	CHECK_EQUAL(0, fake_lpsci.tx_length);
+}
+
+/**
+ * \fn static void test_ring_overrun
+ * \brief More than the ring holds between two polls: the oldest bytes are lost and counted, and the console carries on
+ * \param N/A
+ * \return N/A
+ */
+static void test_ring_overrun(void){
+	char stream[TEST_RING_CAPACITY + 73];
+	uint32_t i;
+
+	test_start();
+	for(i = 0; i < sizeof(stream); i++){
+		stream[i] = (char)('a' + (i % 26));
+	}
+	fake_lpsci_receive((const uint8_t *)stream, sizeof(stream));
+	CHECK_EQUAL(73, console_get_rx_overruns());
+	fake_lpsci_receive((const uint8_t *)"\r", 1);
+	CHECK_EQUAL(74, console_get_rx_overruns());
+	console_poll();
+
+	/**
+	 *  The ring kept the CR and the TEST_RING_CAPACITY - 1 bytes before it, and the line their first CONSOLE_LINE_MAX
+	 */
+	CHECK_EQUAL(1, console_out.count);
+	CHECK_EQUAL(CONSOLE_LINE_MAX, strlen(console_out.lines));
+	CHECK(memcmp(console_out.lines, &stream[sizeof(stream) - TEST_RING_CAPACITY + 1], CONSOLE_LINE_MAX) == 0);
+
+	console_out.length = 0;
+	console_out.count = 0;
+	fake_lpsci_receive((const uint8_t *)"next\r", 5);
+	console_poll();
+	CHECK_EQUAL(1, console_out.count);
+	CHECK(strcmp(console_out.lines, "next") == 0);
+	CHECK_EQUAL(74, console_get_rx_overruns());
+}
+
+/**
+ * \fn static void test_hardware_overrun
+ * \brief A byte that arrives while the RX interrupt is held off sets OR: the driver drops the data register, the
+ *  overrun is counted, and reception carries on
+ * \param N/A
+ * \return N/A
+ */
+static void test_hardware_overrun(void){
+	test_start();
+	fake_primask = 1;
+	fake_lpsci_receive((const uint8_t *)"ab", 2);
+	fake_primask = 0;
+	fake_lpsci_service();
+	CHECK_EQUAL(1, fake_lpsci.rx_lost);
+	CHECK_EQUAL(1, console_get_rx_overruns());
+	CHECK_EQUAL(0, serial_rx_available(serial_port0));
+
+	fake_lpsci_receive((const uint8_t *)"cd\r", 3);
+	console_poll();
+	CHECK_EQUAL(1, console_out.count);
+	CHECK(strcmp(console_out.lines, "cd") == 0);
+}
+
+/**
+ * \fn static void test_random_streams
+ * \brief Random byte streams in random chunks, each chunk small enough for the ring, against the reference
+ * \param N/A
+ * \return N/A
+ */
+static void test_random_streams(void){
+	uint8_t chunk[TEST_RING_CAPACITY];
+	uint32_t round;
+	uint32_t total;
+	size_t length;
+	size_t i;
+	uint32_t r;
+
+	srand(29);
+	for(round = 0; round < 20; round++){
+		test_start();
+		for(total = 0; total < 3000; total += length){
+			length = 1 + (rand() % TEST_RING_CAPACITY);
+			for(i = 0; i < length; i++){
+				r = rand() % 100;
+				if(r < 2){
+					chunk[i] = '\r';
+				}
+				else if(r < 4){
+					chunk[i] = '\n';
+				}
+				else if(r < 8){
+					chunk[i] = (r & 1) ? '\b' : 0x7F;
+				}
+				else if(r < 10){
+					chunk[i] = (uint8_t)(rand() % ' ');
+				}
+				else if(r < 12){
+					chunk[i] = (uint8_t)(0x80 + (rand() % 0x80));
+				}
+				else{
+					chunk[i] = (uint8_t)(' ' + (rand() % 95));
+				}
+			}
+			test_feed(chunk, length);
+			console_poll();
+		}
+		test_compare();
+		CHECK_EQUAL(0, console_get_rx_overruns());
+		CHECK_EQUAL(0, fake_lpsci.rx_lost);
+	}
+}
+
+int main(void){
+	TEST_RUN(test_endings);
+	TEST_RUN(test_backspace);
+	TEST_RUN(test_controls);
+	TEST_RUN(test_long_line);
+	TEST_RUN(test_split);
+	TEST_RUN(test_idle_poll);
+	TEST_RUN(test_ring_overrun);
+	TEST_RUN(test_hardware_overrun);
+	TEST_RUN(test_random_streams);
+
+	return test_summary();
+}
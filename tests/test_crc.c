@@ -0,0 +1,204 @@
+/**
+ * \file    test_crc.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Host known-answer tests of the CRC-16 and CRC-32 library (crc.c)
+ *
+ *  The check value of "123456789", then random buffers at every start alignment and length up to a few slices,
+ *  whole and split into random pieces, against a bitwise reference kept here. This file builds the CRC_BYTEWISE
+ *  tables; test_crc_nibble.c and test_crc_slice4.c build the same test with the other values of CRC_IMPLEMENTATION
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "fake_mcu.h"
+#include "test.h"
+#include "../Blinkenlights/source/crc.c"
+
+/**
+ * \def TEST_BUFFER_SIZE
+ *  Largest random buffer, before the start offset
+ */
+#define TEST_BUFFER_SIZE\
+	(64U)
+
+/**
+ * \def TEST_ALIGNMENTS
+ *  Start offsets tried: every byte of a word
+ */
+#define TEST_ALIGNMENTS\
+	(4U)
+
+/**
+ * \def TEST_SPLITS
+ *  Random ways each buffer is split into streaming calls
+ */
+#define TEST_SPLITS\
+	(20U)
+
+/**
+ * \fn static uint32_t test_reference32
+ * \brief CRC-32 a bit at a time, from the polynomial
+ * \param data The bytes
+ * \param length Amount of bytes
+ * \return The CRC-32
+ */
+static uint32_t test_reference32(const uint8_t *data, size_t length){
+	uint32_t crc;
+	uint32_t bit;
+
+	crc = 0xFFFFFFFFUL;
+	while(length--){
+		crc ^= *data++;
+		for(bit = 0; bit < 8; bit++){
+			crc = (crc & 1) ? ((crc >> 1) ^ 0xEDB88320UL) : (crc >> 1);
+		}
+	}
+
+	return crc ^ 0xFFFFFFFFUL;
+}
+
+/**
+ * \fn static uint16_t test_reference16
+ * \brief CRC-16/CCITT-FALSE a bit at a time, from the polynomial
+ * \param data The bytes
+ * \param length Amount of bytes
+ * \return The CRC-16
+ */
+static uint16_t test_reference16(const uint8_t *data, size_t length){
+	uint16_t crc;
+	uint32_t bit;
+
+	crc = 0xFFFF;
+	while(length--){
+		crc ^= (uint16_t)(*data++ << 8);
+		for(bit = 0; bit < 8; bit++){
+			crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+		}
+	}
+
+	return crc;
+}
+
+/**
+ * \fn static bool test_split
+ * \brief CRC a buffer in random pieces, some empty, and check both CRCs against the reference
+ * \param data The bytes
+ * \param length Amount of bytes
+ * \return true if both matched
+ */
+static bool test_split(const uint8_t *data, size_t length){
+	uint32_t crc32;
+	uint16_t crc16;
+	size_t offset;
+	size_t piece;
+
+	crc32 = crc32_init();
+	crc16 = crc16_init();
+	for(offset = 0; offset < length; offset += piece){
+		piece = (size_t)rand() % (length - offset + 1);
+		crc32 = crc32_update(crc32, &data[offset], piece);
+		crc16 = crc16_update(crc16, &data[offset], piece);
+	}
+
+	return CHECK_EQUAL(test_reference32(data, length), crc32_final(crc32)) &&
+			CHECK_EQUAL(test_reference16(data, length), crc16_final(crc16));
+}
+
+/**
+ * \fn static void test_check_values
+ * \brief "123456789" gives the check values of crc.h, in one call and a byte at a time
+ * \param N/A
+ * \return N/A
+ */
+static void test_check_values(void){
+	static const char check[] = "123456789";
+	uint32_t crc32;
+	uint16_t crc16;
+	size_t i;
+
+	CHECK_EQUAL(CRC32_CHECK, test_reference32((const uint8_t *)check, 9));
+	CHECK_EQUAL(CRC16_CHECK, test_reference16((const uint8_t *)check, 9));
+	CHECK_EQUAL(CRC32_CHECK, crc32_buffer(check, 9));
+	CHECK_EQUAL(CRC16_CHECK, crc16_buffer(check, 9));
+
+	crc32 = crc32_init();
+	crc16 = crc16_init();
+	for(i = 0; i < 9; i++){
+		crc32 = crc32_update(crc32, &check[i], 1);
+		crc16 = crc16_update(crc16, &check[i], 1);
+	}
+	CHECK_EQUAL(CRC32_CHECK, crc32_final(crc32));
+	CHECK_EQUAL(CRC16_CHECK, crc16_final(crc16));
+
+	CHECK_EQUAL(0, crc32_buffer(check, 0));
+	CHECK_EQUAL(0xFFFF, crc16_buffer(check, 0));
+}
+
+/**
+ * \fn static void test_bytes
+ * \brief Every byte value alone and after a run of 0xFF, which covers each entry of the byte tables
+ * \param N/A
+ * \return N/A
+ */
+static void test_bytes(void){
+	uint8_t data[5];
+	uint32_t value;
+	uint32_t failed;
+
+	failed = 0;
+	memset(data, 0xFF, sizeof(data));
+	for(value = 0; (value < 256) && (failed < 5); value++){
+		data[4] = (uint8_t)value;
+		if(!CHECK_EQUAL(test_reference32(&data[4], 1), crc32_buffer(&data[4], 1)) ||
+				!CHECK_EQUAL(test_reference16(&data[4], 1), crc16_buffer(&data[4], 1)) ||
+				!CHECK_EQUAL(test_reference32(data, 5), crc32_buffer(data, 5)) ||
+				!CHECK_EQUAL(test_reference16(data, 5), crc16_buffer(data, 5))){
+			failed++;
+		}
+	}
+}
+
+/**
+ * \fn static void test_random_buffers
+ * \brief Random buffers of every length up to TEST_BUFFER_SIZE, at every start alignment, whole and split
+ * \param N/A
+ * \return N/A
+ */
+static void test_random_buffers(void){
+	uint8_t buffer[TEST_BUFFER_SIZE + TEST_ALIGNMENTS] __attribute__((aligned(4)));
+	uint8_t *data;
+	size_t alignment;
+	size_t length;
+	size_t i;
+	uint32_t split;
+	uint32_t failed;
+
+	srand(35);
+	failed = 0;
+	for(alignment = 0; alignment < TEST_ALIGNMENTS; alignment++){
+		data = &buffer[alignment];
+		for(length = 0; (length <= TEST_BUFFER_SIZE) && (failed < 5); length++){
+			for(i = 0; i < length; i++){
+				data[i] = (uint8_t)rand();
+			}
+			if(!CHECK_EQUAL(test_reference32(data, length), crc32_buffer(data, length)) ||
+					!CHECK_EQUAL(test_reference16(data, length), crc16_buffer(data, length))){
+				failed++;
+			}
+			for(split = 0; split < TEST_SPLITS; split++){
+				if(!test_split(data, length)){
+					failed++;
+				}
+			}
+		}
+	}
+}
+
+int main(void){
+	TEST_RUN(test_check_values);
+	TEST_RUN(test_bytes);
+	TEST_RUN(test_random_buffers);
+
+	return test_summary();
+}
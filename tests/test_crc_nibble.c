@@ -0,0 +1,11 @@
+/**
+ * \file    test_crc_nibble.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   test_crc.c with the CRC_NIBBLE tables
+ */
+
+#define CRC_IMPLEMENTATION\
+	(CRC_NIBBLE)
+
+#include "test_crc.c"
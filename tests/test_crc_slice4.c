@@ -0,0 +1,11 @@
+/**
+ * \file    test_crc_slice4.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   test_crc.c with the CRC_SLICE4 tables
+ */
+
+#define CRC_IMPLEMENTATION\
+	(CRC_SLICE4)
+
+#include "test_crc.c"
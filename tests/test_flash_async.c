@@ -0,0 +1,535 @@
+/**
+ * \file    test_flash_async.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Host tests of the non-blocking flash driver (source/flash_async.c) against a model of the FTFA
+ *
+ *  The model runs each command as soon as FSTAT[CCIF] is written, on the flash fake_mcu maps at 0, and can fail any
+ *  one command with ACCERR, FPVIOL or MGSTAT0. The clocks.h and power.h calls are counted by stubs, and the FTFA
+ *  interrupt is taken by hand whenever it is enabled, pending and not masked
+ */
+
+#include <string.h>
+#include "fake_mcu.h"
+#include "test.h"
+#include "../Blinkenlights/source/flash_async.c"
+
+/**
+ * \def TEST_BASE
+ *  First sector the driver may erase: __top_PROGRAM_FLASH in the Makefile
+ */
+#define TEST_BASE\
+	(0x1E000UL)
+
+/**
+ * \def TEST_WORDS
+ *  Longwords of the program tests: two full steps and a partial one
+ */
+#define TEST_WORDS\
+	((2U * FLASH_ASYNC_PROGRAM_WORDS) + 22U)
+
+/**
+ * \def TEST_LOG
+ *  Commands the model remembers
+ */
+#define TEST_LOG\
+	(512U)
+
+/**
+ * \typedef ftfa_model_t
+ *  State of the FTFA model
+ */
+typedef struct {
+	uint8_t fstat;				/* FSTAT as the hardware holds it */
+	uint32_t commands;			/* Commands launched */
+	uint32_t fail_at;			/* Command that fails, counting from 1, or 0 */
+	uint8_t fail_bits;			/* What it fails with */
+	uint32_t unmasked;			/* Commands launched with interrupts enabled */
+	uint32_t slow;				/* Commands launched outside clocks_run */
+	uint32_t unheld;			/* Commands launched without a burst held */
+	uint8_t command[TEST_LOG];	/* FCCOB0 of each command */
+	uint32_t address[TEST_LOG];	/* Its address */
+} ftfa_model_t;
+
+/**
+ * \typedef test_stubs_t
+ *  State of the clocks.h and power.h stubs
+ */
+typedef struct {
+	int32_t constraints;		/* power_constrain(power_wait) less power_release(power_wait) */
+	uint32_t burst_begins;
+	uint32_t burst_ends;
+	bool burst;
+	uint32_t ramp;				/* clocks_get_profile() calls after clocks_burst_begin() still in VLPR */
+	uint32_t callbacks;
+	status_t status;			/* Status of the last callback */
+	void *user_data;			/* user_data of the last callback */
+} test_stubs_t;
+
+static ftfa_model_t ftfa_model;
+static test_stubs_t stubs;
+static uint32_t test_data[TEST_WORDS];
+
+void power_constrain(power_mode_t deepest){
+	if(deepest == power_wait){
+		stubs.constraints++;
+	}
+}
+
+void power_release(power_mode_t deepest){
+	if(deepest == power_wait){
+		stubs.constraints--;
+	}
+}
+
+status_t clocks_burst_begin(void){
+	stubs.burst_begins++;
+	stubs.burst = true;
+
+	return kStatus_Success;
+}
+
+void clocks_burst_end(void){
+	stubs.burst_ends++;
+	stubs.burst = false;
+}
+
+clocks_profile_t clocks_get_profile(void){
+	if(!stubs.burst){
+		return clocks_vlpr;
+	}
+	if(stubs.ramp != 0){
+		stubs.ramp--;
+		return clocks_vlpr;
+	}
+
+	return clocks_run;
+}
+
+/**
+ * \fn static void ftfa_execute
+ * \brief Run the command in FCCOB, with the fault injected if it is its turn
+ * \param N/A
+ * \return N/A
+ */
+static void ftfa_execute(void){
+	uint32_t address;
+	uint32_t word;
+	uint32_t *target;
+	uint32_t n;
+
+	n = ftfa_model.commands++;
+	address = ((uint32_t)FTFA->FCCOB1 << 16) | ((uint32_t)FTFA->FCCOB2 << 8) | FTFA->FCCOB3;
+	if(n < TEST_LOG){
+		ftfa_model.command[n] = FTFA->FCCOB0;
+		ftfa_model.address[n] = address;
+	}
+	ftfa_model.unmasked += (fake_primask == 0) ? 1 : 0;
+	ftfa_model.slow += (stubs.burst && (stubs.ramp == 0)) ? 0 : 1;
+	ftfa_model.unheld += stubs.burst ? 0 : 1;
+
+	if(ftfa_model.commands == ftfa_model.fail_at){
+		ftfa_model.fstat |= ftfa_model.fail_bits;
+	}
+	else if((address < TEST_BASE) || (address >= FLASH_ASYNC_END)){
+		ftfa_model.fstat |= FTFA_FSTAT_FPVIOL_MASK;
+	}
+	else if(FTFA->FCCOB0 == FLASH_ASYNC_ERASE_SECTOR){
+		if((address % FLASH_ASYNC_SECTOR_SIZE) != 0){
+			ftfa_model.fstat |= FTFA_FSTAT_ACCERR_MASK;
+		}
+		else{
+			memset((void *)(uintptr_t)address, 0xFF, FLASH_ASYNC_SECTOR_SIZE);
+		}
+	}
+	else if(FTFA->FCCOB0 == FLASH_ASYNC_PROGRAM_LONGWORD){
+		word = ((uint32_t)FTFA->FCCOB4 << 24) | ((uint32_t)FTFA->FCCOB5 << 16) | ((uint32_t)FTFA->FCCOB6 << 8) |
+				FTFA->FCCOB7;
+		target = (uint32_t *)(uintptr_t)address;
+		if((address % 4) != 0){
+			ftfa_model.fstat |= FTFA_FSTAT_ACCERR_MASK;
+		}
+		else if(*target != 0xFFFFFFFFUL){
+			ftfa_model.fstat |= FTFA_FSTAT_MGSTAT0_MASK;
+		}
+		else{
+			*target = word;
+		}
+	}
+	else{
+		ftfa_model.fstat |= FTFA_FSTAT_ACCERR_MASK;
+	}
+}
+
+/**
+ * \fn static void ftfa_hook
+ * \brief FTFA register model. FSTAT: ACCERR and FPVIOL are write-1-to-clear, writing CCIF launches the command
+ *  unless one of them is set, and MGSTAT0 tells about the last command
+ * \param address Register accessed
+ * \param write true after a write, false before a read
+ * \return N/A
+ */
+static void ftfa_hook(uintptr_t address, bool write){
+	uint8_t written;
+
+	if(address != (uintptr_t)&FTFA->FSTAT){
+		return;
+	}
+	if(write){
+		written = FTFA->FSTAT;
+		ftfa_model.fstat &= ~(written & (FTFA_FSTAT_ACCERR_MASK | FTFA_FSTAT_FPVIOL_MASK));
+		if((written & FTFA_FSTAT_CCIF_MASK) &&
+				!(ftfa_model.fstat & (FTFA_FSTAT_ACCERR_MASK | FTFA_FSTAT_FPVIOL_MASK))){
+			ftfa_model.fstat &= ~FTFA_FSTAT_MGSTAT0_MASK;
+			ftfa_execute();
+		}
+	}
+	FTFA->FSTAT = ftfa_model.fstat;
+}
+
+/**
+ * \fn static void test_callback
+ * \brief Operation callback: record how it ended
+ * \param status How the operation ended
+ * \param user_data Checked against what was queued
+ * \return N/A
+ */
+static void test_callback(status_t status, void *user_data){
+	stubs.callbacks++;
+	stubs.status = status;
+	stubs.user_data = user_data;
+}
+
+/**
+ * \fn static void test_interrupt
+ * \brief Take the FTFA interrupt if it is enabled, pending and not masked
+ * \param N/A
+ * \return true if it was taken
+ */
+static bool test_interrupt(void){
+	if((FTFA->FCNFG & FTFA_FCNFG_CCIE_MASK) && (FTFA->FSTAT & FTFA_FSTAT_CCIF_MASK) && (fake_primask == 0)){
+		FTFA_DriverIRQHandler();
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * \fn static uint32_t test_finish
+ * \brief Run the main loop and the interrupt until the queued operations are done
+ * \param N/A
+ * \return Polls it took
+ */
+static uint32_t test_finish(void){
+	uint32_t polls;
+
+	for(polls = 0; flash_async_busy() && (polls < 10000); polls++){
+		flash_async_poll();
+		(void)test_interrupt();
+	}
+
+	return polls;
+}
+
+/**
+ * \fn static void test_setup
+ * \brief Fresh memory, erased flash, an idle FTFA and a driver with nothing queued
+ * \param N/A
+ * \return N/A
+ */
+static void test_setup(void){
+	uint32_t i;
+
+	fake_mcu_init();
+	fake_mcu_erase_flash();
+	memset(&ftfa_model, 0, sizeof(ftfa_model));
+	memset(&stubs, 0, sizeof(stubs));
+	memset(&flash_async, 0, sizeof(flash_async));
+	ftfa_model.fstat = FTFA_FSTAT_CCIF_MASK;
+	FTFA->FSTAT = ftfa_model.fstat;
+	fake_mcu_trap(FTFA_BASE, ftfa_hook);
+	for(i = 0; i < TEST_WORDS; i++){
+		test_data[i] = 0xA5000000UL ^ (i * 0x01010101UL);
+	}
+}
+
+/**
+ * \fn static void test_init
+ * \brief The launcher is found in .ramfunc, and the interrupt is enabled with CCIE off
+ * \param N/A
+ * \return N/A
+ */
+static void test_init(void){
+	test_setup();
+	FTFA->FCNFG = FTFA_FCNFG_CCIE_MASK;
+	CHECK_EQUAL(kStatus_Success, flash_async_init());
+	CHECK_EQUAL(0, FTFA->FCNFG & FTFA_FCNFG_CCIE_MASK);
+	CHECK(NVIC->ISER[0] & (1UL << FTFA_IRQn));
+}
+
+/**
+ * \fn static void test_reject
+ * \brief Bad requests are refused without touching the FTFA, the power constraint or the clocks
+ * \param N/A
+ * \return N/A
+ */
+static void test_reject(void){
+	test_setup();
+	CHECK_EQUAL(kStatus_FLASH_AlignmentError, flash_async_erase(TEST_BASE + 4, FLASH_ASYNC_SECTOR_SIZE, NULL, NULL));
+	CHECK_EQUAL(kStatus_FLASH_AlignmentError, flash_async_erase(TEST_BASE, 100, NULL, NULL));
+	CHECK_EQUAL(kStatus_FLASH_AlignmentError, flash_async_erase(TEST_BASE, 0, NULL, NULL));
+	CHECK_EQUAL(kStatus_FLASH_AddressError, flash_async_erase(TEST_BASE - FLASH_ASYNC_SECTOR_SIZE,
+			FLASH_ASYNC_SECTOR_SIZE, NULL, NULL));
+	CHECK_EQUAL(kStatus_FLASH_AddressError, flash_async_erase(FLASH_ASYNC_END - FLASH_ASYNC_SECTOR_SIZE,
+			2 * FLASH_ASYNC_SECTOR_SIZE, NULL, NULL));
+	CHECK_EQUAL(kStatus_FLASH_AlignmentError, flash_async_program(TEST_BASE + 2, test_data, 4, NULL, NULL));
+	CHECK_EQUAL(kStatus_FLASH_AlignmentError, flash_async_program(TEST_BASE, test_data, 6, NULL, NULL));
+	CHECK_EQUAL(kStatus_InvalidArgument, flash_async_program(TEST_BASE, NULL, 4, NULL, NULL));
+
+	CHECK_EQUAL(kStatus_Success, flash_async_erase(TEST_BASE, FLASH_ASYNC_SECTOR_SIZE, NULL, NULL));
+	CHECK_EQUAL(kStatus_FlashAsync_Busy, flash_async_program(TEST_BASE, test_data, 4, NULL, NULL));
+	CHECK_EQUAL(1, stubs.constraints);
+	CHECK_EQUAL(0, ftfa_model.commands);
+	CHECK_EQUAL(0, stubs.burst_begins);
+	(void)test_finish();
+	CHECK_EQUAL(0, stubs.constraints);
+}
+
+/**
+ * \fn static void test_erase_steps
+ * \brief An erase runs one sector per poll, masked, in RUN, and reports once
+ * \param N/A
+ * \return N/A
+ */
+static void test_erase_steps(void){
+	uint32_t i;
+
+	test_setup();
+	memset((void *)TEST_BASE, 0, 4 * FLASH_ASYNC_SECTOR_SIZE);
+	CHECK_EQUAL(kStatus_Success, flash_async_erase(TEST_BASE + FLASH_ASYNC_SECTOR_SIZE, 3 * FLASH_ASYNC_SECTOR_SIZE,
+			test_callback, &stubs));
+	CHECK(flash_async_busy());
+
+	for(i = 0; i < 3; i++){
+		flash_async_poll();
+		CHECK_EQUAL(i + 1, ftfa_model.commands);
+		CHECK_EQUAL(FLASH_ASYNC_ERASE_SECTOR, ftfa_model.command[i]);
+		CHECK_EQUAL(TEST_BASE + ((i + 1) * FLASH_ASYNC_SECTOR_SIZE), ftfa_model.address[i]);
+
+		/**
+		 *  The next step waits for the interrupt
+		 */
+		flash_async_poll();
+		CHECK_EQUAL(i + 1, ftfa_model.commands);
+		CHECK_EQUAL(0, stubs.callbacks);
+		CHECK(test_interrupt());
+	}
+
+	CHECK(!flash_async_busy());
+	CHECK_EQUAL(1, stubs.callbacks);
+	CHECK_EQUAL(kStatus_FLASH_Success, stubs.status);
+	CHECK(stubs.user_data == &stubs);
+	CHECK_EQUAL(0, ftfa_model.unmasked);
+	CHECK_EQUAL(0, ftfa_model.slow);
+	CHECK_EQUAL(0, stubs.constraints);
+	CHECK_EQUAL(1, stubs.burst_begins);
+	CHECK_EQUAL(1, stubs.burst_ends);
+	CHECK(MCM->PLACR & MCM_PLACR_CFCC_MASK);
+	CHECK_EQUAL(0, *(uint8_t *)TEST_BASE);
+	for(i = FLASH_ASYNC_SECTOR_SIZE; i < 4 * FLASH_ASYNC_SECTOR_SIZE; i++){
+		if(!CHECK_EQUAL(0xFF, *(uint8_t *)(TEST_BASE + i))){
+			break;
+		}
+	}
+}
+
+/**
+ * \fn static void test_program_batches
+ * \brief A program runs in steps of FLASH_ASYNC_PROGRAM_WORDS and a partial last one, with the words in order
+ * \param N/A
+ * \return N/A
+ */
+static void test_program_batches(void){
+	static const uint32_t steps[] = {FLASH_ASYNC_PROGRAM_WORDS, 2 * FLASH_ASYNC_PROGRAM_WORDS, TEST_WORDS};
+	uint32_t i;
+
+	test_setup();
+	CHECK_EQUAL(kStatus_Success, flash_async_program(TEST_BASE, test_data, sizeof(test_data), test_callback, NULL));
+	for(i = 0; i < 3; i++){
+		flash_async_poll();
+		CHECK_EQUAL(steps[i], ftfa_model.commands);
+		CHECK(test_interrupt());
+	}
+
+	CHECK(!flash_async_busy());
+	CHECK_EQUAL(1, stubs.callbacks);
+	CHECK_EQUAL(kStatus_FLASH_Success, stubs.status);
+	CHECK_EQUAL(0, memcmp((const void *)TEST_BASE, test_data, sizeof(test_data)));
+	CHECK_EQUAL(0xFFFFFFFFUL, *(const uint32_t *)(TEST_BASE + sizeof(test_data)));
+	for(i = 0; i < TEST_WORDS; i++){
+		if(!CHECK_EQUAL(TEST_BASE + (4 * i), ftfa_model.address[i]) ||
+				!CHECK_EQUAL(FLASH_ASYNC_PROGRAM_LONGWORD, ftfa_model.command[i])){
+			break;
+		}
+	}
+	CHECK_EQUAL(0, ftfa_model.unmasked);
+	CHECK_EQUAL(0, stubs.constraints);
+	CHECK_EQUAL(1, stubs.burst_ends);
+}
+
+/**
+ * \fn static void test_errors
+ * \brief Each error bit, injected in the middle of a step, stops the step there and ends the operation with its
+ *  status, releasing the constraint and the burst
+ * \param N/A
+ * \return N/A
+ */
+static void test_errors(void){
+	static const uint8_t bits[] = {FTFA_FSTAT_ACCERR_MASK, FTFA_FSTAT_FPVIOL_MASK, FTFA_FSTAT_MGSTAT0_MASK};
+	static const status_t statuses[] = {kStatus_FLASH_AccessError, kStatus_FLASH_ProtectionViolation,
+			kStatus_FLASH_CommandFailure};
+	uint32_t fail;
+	uint32_t i;
+
+	for(i = 0; i < 3; i++){
+		test_setup();
+		fail = FLASH_ASYNC_PROGRAM_WORDS + 6;
+		ftfa_model.fail_at = fail;
+		ftfa_model.fail_bits = bits[i];
+		CHECK_EQUAL(kStatus_Success, flash_async_program(TEST_BASE, test_data, sizeof(test_data), test_callback,
+				NULL));
+		(void)test_finish();
+
+		CHECK(!flash_async_busy());
+		CHECK_EQUAL(1, stubs.callbacks);
+		CHECK_EQUAL(statuses[i], stubs.status);
+		CHECK_EQUAL(fail, ftfa_model.commands);
+		CHECK_EQUAL(0, memcmp((const void *)TEST_BASE, test_data, (fail - 1) * 4));
+		CHECK_EQUAL(0xFFFFFFFFUL, *(const uint32_t *)(TEST_BASE + ((fail - 1) * 4)));
+		CHECK_EQUAL(0, stubs.constraints);
+		CHECK_EQUAL(1, stubs.burst_ends);
+		CHECK(!stubs.burst);
+
+		/**
+		 *  The error bits are cleared before the next operation launches
+		 */
+		CHECK_EQUAL(kStatus_Success, flash_async_erase(TEST_BASE, FLASH_ASYNC_SECTOR_SIZE, test_callback, NULL));
+		(void)test_finish();
+		CHECK_EQUAL(kStatus_FLASH_Success, stubs.status);
+		CHECK_EQUAL(fail + 1, ftfa_model.commands);
+	}
+
+	/**
+	 *  The first sector of an erase
+	 */
+	test_setup();
+	ftfa_model.fail_at = 1;
+	ftfa_model.fail_bits = FTFA_FSTAT_ACCERR_MASK;
+	CHECK_EQUAL(kStatus_Success, flash_async_erase(TEST_BASE, 2 * FLASH_ASYNC_SECTOR_SIZE, test_callback, NULL));
+	(void)test_finish();
+	CHECK_EQUAL(kStatus_FLASH_AccessError, stubs.status);
+	CHECK_EQUAL(1, ftfa_model.commands);
+	CHECK_EQUAL(0, stubs.constraints);
+}
+
+/**
+ * \fn static void test_chain_callback
+ * \brief Callback of the test_requeue chain: queue the next link until there are none left
+ * \param status How the link ended
+ * \param user_data Links left
+ * \return N/A
+ */
+static void test_chain_callback(status_t status, void *user_data){
+	uint32_t *left;
+
+	test_callback(status, user_data);
+	left = user_data;
+	if((status == kStatus_FLASH_Success) && (*left != 0)){
+		(*left)--;
+		CHECK_EQUAL(kStatus_Success, flash_async_program(TEST_BASE + (stubs.callbacks * 4 * FLASH_ASYNC_PROGRAM_WORDS),
+				&test_data[stubs.callbacks * FLASH_ASYNC_PROGRAM_WORDS], 4 * FLASH_ASYNC_PROGRAM_WORDS,
+				test_chain_callback, left));
+	}
+}
+
+/**
+ * \fn static void test_requeue
+ * \brief Operations queued from the callback run under the burst of the first, which ends once with the last
+ * \param N/A
+ * \return N/A
+ */
+static void test_requeue(void){
+	uint32_t left;
+
+	test_setup();
+	left = 1;
+	CHECK_EQUAL(kStatus_Success, flash_async_program(TEST_BASE, test_data, 4 * FLASH_ASYNC_PROGRAM_WORDS,
+			test_chain_callback, &left));
+	(void)test_finish();
+
+	CHECK_EQUAL(2, stubs.callbacks);
+	CHECK_EQUAL(kStatus_FLASH_Success, stubs.status);
+	CHECK_EQUAL(0, left);
+	CHECK_EQUAL(2 * FLASH_ASYNC_PROGRAM_WORDS, ftfa_model.commands);
+	CHECK_EQUAL(0, memcmp((const void *)TEST_BASE, test_data, 2 * 4 * FLASH_ASYNC_PROGRAM_WORDS));
+	CHECK_EQUAL(1, stubs.burst_begins);
+	CHECK_EQUAL(1, stubs.burst_ends);
+	CHECK_EQUAL(0, ftfa_model.unheld);
+	CHECK_EQUAL(0, stubs.constraints);
+}
+
+/**
+ * \fn static void test_burst_handoff
+ * \brief Nothing launches until the burst has brought the clocks to RUN, and the burst is asked for only once
+ * \param N/A
+ * \return N/A
+ */
+static void test_burst_handoff(void){
+	uint32_t i;
+
+	test_setup();
+	stubs.ramp = 3;
+	CHECK_EQUAL(kStatus_Success, flash_async_erase(TEST_BASE, FLASH_ASYNC_SECTOR_SIZE, test_callback, NULL));
+	for(i = 0; i < 3; i++){
+		flash_async_poll();
+		CHECK_EQUAL(0, ftfa_model.commands);
+		CHECK(!test_interrupt());
+	}
+	flash_async_poll();
+	CHECK_EQUAL(1, ftfa_model.commands);
+	CHECK(test_interrupt());
+
+	CHECK_EQUAL(1, stubs.callbacks);
+	CHECK_EQUAL(0, ftfa_model.slow);
+	CHECK_EQUAL(1, stubs.burst_begins);
+	CHECK_EQUAL(1, stubs.burst_ends);
+}
+
+/**
+ * \fn static void test_stale_interrupt
+ * \brief The interrupt with no step running only turns CCIE off
+ * \param N/A
+ * \return N/A
+ */
+static void test_stale_interrupt(void){
+	test_setup();
+	FTFA->FCNFG = FTFA_FCNFG_CCIE_MASK;
+	CHECK(test_interrupt());
+	CHECK_EQUAL(0, FTFA->FCNFG & FTFA_FCNFG_CCIE_MASK);
+	CHECK_EQUAL(0, stubs.callbacks);
+	CHECK_EQUAL(0, stubs.constraints);
+}
+
+int main(void){
+	TEST_RUN(test_init);
+	TEST_RUN(test_reject);
+	TEST_RUN(test_erase_steps);
+	TEST_RUN(test_program_batches);
+	TEST_RUN(test_errors);
+	TEST_RUN(test_requeue);
+	TEST_RUN(test_burst_handoff);
+	TEST_RUN(test_stale_interrupt);
+
+	return test_summary();
+}
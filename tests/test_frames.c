@@ -0,0 +1,381 @@
+/**
+ * \file    test_frames.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Host tests of DMA receive with idle-line framing on UART0 (serial_rx_dma) with a simulated byte stream
+ *
+ *  Frames go in on the receive line of fake/fake_lpsci.h, which hands every byte to the DMA channel the driver set
+ *  up, and each is followed by an idle character. serial.c must then call the frame callback once per frame, with
+ *  views into the DMA buffer that hold exactly the frame: split in two where it wraps around the end of the buffer,
+ *  and reported as an overrun, not a frame, where it did not fit
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "fake_mcu.h"
+#include "fake_lpsci.h"
+#include "test.h"
+#include "power.h"
+#include "clocks.h"
+#include "../Blinkenlights/source/serial.c"
+
+/**
+ * \def TEST_BUFFER_SIZE
+ *  DMA buffer size, a power of 2
+ */
+#define TEST_BUFFER_SIZE\
+	(64U)
+
+/**
+ * \def TEST_CHANNEL
+ *  DMA channel of the receiver
+ */
+#define TEST_CHANNEL\
+	(2U)
+
+/**
+ * \def TEST_BCR_MAX
+ *  Byte count the driver loads into the DMA channel
+ */
+#define TEST_BCR_MAX\
+	(0xFFFFFUL)
+
+/**
+ * \def TEST_RANDOM_BYTES
+ *  Bytes received by test_random_frames
+ */
+#define TEST_RANDOM_BYTES\
+	(0x10000UL)
+
+/**
+ * \typedef test_frames_t
+ *  What the frame callback was given
+ */
+typedef struct {
+	uint32_t frames;
+	uint32_t bad_views;				/* Segments outside the buffer, empty, or a second one not at its start */
+	size_t segments;				/* Segments of the last frame */
+	uint8_t last[TEST_BUFFER_SIZE];	/* Bytes of the last frame */
+	size_t length;					/* Their amount */
+} test_frames_t;
+
+static uint8_t test_buffer[TEST_BUFFER_SIZE] __attribute__((aligned(TEST_BUFFER_SIZE)));
+static test_frames_t test_frames;
+
+void power_constrain(power_mode_t deepest){
+}
+
+void power_release(power_mode_t deepest){
+}
+
+status_t clocks_register(clocks_notifier_t notifier){
+	return kStatus_Success;
+}
+
+clocks_profile_t clocks_get_profile(void){
+	return clocks_run;
+}
+
+uint32_t clocks_get_uart0_freq(clocks_profile_t profile){
+	return 48000000UL;
+}
+
+/**
+ * \fn static void test_frame
+ * \brief Frame callback: check the views and keep the bytes
+ * \param port The port
+ * \param frame The segments
+ * \param count Amount of segments
+ * \return N/A
+ */
+static void test_frame(serial_port_t port, const serial_segment_t *frame, size_t count){
+	size_t i;
+
+	test_frames.frames++;
+	test_frames.segments = count;
+	test_frames.length = 0;
+	for(i = 0; i < count; i++){
+		if((port != serial_port0) || (frame[i].length == 0) || (frame[i].data < test_buffer) ||
+				(frame[i].data + frame[i].length > test_buffer + TEST_BUFFER_SIZE) ||
+				((i == 1) && (frame[i].data != test_buffer)) ||
+				((i == 0) && (count == 2) && (frame[i].data + frame[i].length != test_buffer + TEST_BUFFER_SIZE)) ||
+				(test_frames.length + frame[i].length > TEST_BUFFER_SIZE)){
+			test_frames.bad_views++;
+			continue;
+		}
+		memcpy(&test_frames.last[test_frames.length], frame[i].data, frame[i].length);
+		test_frames.length += frame[i].length;
+	}
+}
+
+/**
+ * \fn static void test_start
+ * \brief Reset the hardware and open UART0 in serial_rx_dma mode
+ * \param N/A
+ * \return N/A
+ */
+static void test_start(void){
+	serial_config_t config;
+
+	fake_mcu_init();
+	fake_lpsci_init();
+	memset(&test_frames, 0, sizeof(test_frames));
+	config.baud_rate = 0;
+	config.rx_mode = serial_rx_dma;
+	config.rx_buffer = test_buffer;
+	config.rx_buffer_size = sizeof(test_buffer);
+	config.dma_channel = TEST_CHANNEL;
+	config.frame_callback = test_frame;
+	CHECK_EQUAL(kStatus_Success, serial_open(serial_port0, &config));
+}
+
+/**
+ * \fn static void test_fill
+ * \brief Make frame bytes that differ from frame to frame
+ * \param data Where to store them
+ * \param length Amount of bytes
+ * \param seed Frame number
+ * \return N/A
+ */
+static void test_fill(uint8_t *data, size_t length, uint32_t seed){
+	size_t i;
+
+	for(i = 0; i < length; i++){
+		data[i] = (uint8_t)((seed * 29U) + (i * 7U) + 1U);
+	}
+}
+
+/**
+ * \fn static bool test_send_frame
+ * \brief Receive one frame and the idle character after it, and check the callback got exactly it
+ * \param length Frame length, at most TEST_BUFFER_SIZE
+ * \param seed Frame number
+ * \return true if it did
+ */
+static bool test_send_frame(size_t length, uint32_t seed){
+	uint8_t data[TEST_BUFFER_SIZE];
+	uint32_t frames;
+	bool passed;
+
+	test_fill(data, length, seed);
+	frames = test_frames.frames;
+	fake_lpsci_receive(data, length);
+	passed = CHECK_EQUAL(frames, test_frames.frames);
+	fake_lpsci_idle();
+	passed &= CHECK_EQUAL(frames + 1, test_frames.frames);
+	passed &= CHECK_EQUAL(length, test_frames.length);
+	passed &= CHECK(memcmp(data, test_frames.last, length) == 0);
+	passed &= CHECK_EQUAL(0, test_frames.bad_views);
+
+	return passed;
+}
+
+/**
+ * \fn static void test_single
+ * \brief One frame, one callback, a view straight into the DMA buffer; the setup the driver made is checked too
+ * \param N/A
+ * \return N/A
+ */
+static void test_single(void){
+	serial_stats_t stats;
+
+	test_start();
+	CHECK(UART0->C5 & UART0_C5_RDMAE_MASK);
+	CHECK(UART0->C1 & UART0_C1_ILT_MASK);
+	CHECK(UART0->C2 & UART0_C2_ILIE_MASK);
+	CHECK(UART0->C2 & UART0_C2_RIE_MASK);
+	CHECK(test_send_frame(5, 1));
+	CHECK_EQUAL(1, test_frames.segments);
+	CHECK(memcmp(test_buffer, test_frames.last, 5) == 0);
+	serial_get_stats(serial_port0, &stats);
+	CHECK_EQUAL(5, stats.rx_bytes);
+	CHECK_EQUAL(0, stats.rx_overruns);
+	CHECK_EQUAL(0, fake_lpsci.d_reads);
+}
+
+/**
+ * \fn static void test_gaps
+ * \brief A frame only ends at an idle character: bytes with no idle between them make one frame, and an idle with
+ *  nothing new received ends none
+ * \param N/A
+ * \return N/A
+ */
+static void test_gaps(void){
+	test_start();
+	fake_lpsci_receive((const uint8_t *)"abc", 3);
+	fake_lpsci_receive((const uint8_t *)"de", 2);
+	fake_lpsci_idle();
+	fake_lpsci_idle();
+	CHECK_EQUAL(1, test_frames.frames);
+	CHECK_EQUAL(5, test_frames.length);
+	CHECK(memcmp(test_frames.last, "abcde", 5) == 0);
+
+	fake_lpsci_receive((const uint8_t *)"f", 1);
+	fake_lpsci_idle();
+	CHECK_EQUAL(2, test_frames.frames);
+	CHECK_EQUAL(1, test_frames.length);
+	CHECK_EQUAL('f', test_frames.last[0]);
+}
+
+/**
+ * \fn static void test_wrap
+ * \brief Frames that end at, cross and start at the end of the buffer
+ * \param N/A
+ * \return N/A
+ */
+static void test_wrap(void){
+	test_start();
+	CHECK(test_send_frame(TEST_BUFFER_SIZE - 10, 1));
+	CHECK(test_send_frame(10, 2));
+	CHECK_EQUAL(1, test_frames.segments);
+	CHECK(test_send_frame(TEST_BUFFER_SIZE - 1, 3));
+	CHECK_EQUAL(1, test_frames.segments);
+	CHECK(test_send_frame(3, 4));
+	CHECK_EQUAL(2, test_frames.segments);
+	CHECK(test_send_frame(TEST_BUFFER_SIZE, 5));
+	CHECK_EQUAL(2, test_frames.segments);
+	CHECK(test_send_frame(TEST_BUFFER_SIZE - 2, 6));
+	CHECK_EQUAL(1, test_frames.segments);
+	CHECK(test_send_frame(TEST_BUFFER_SIZE, 7));
+	CHECK_EQUAL(1, test_frames.segments);
+}
+
+/**
+ * \fn static void test_too_long
+ * \brief A frame longer than the buffer, by any amount, is an overrun, not a frame, and the next frame is whole again
+ * \param N/A
+ * \return N/A
+ */
+static void test_too_long(void){
+	uint8_t data[TEST_BUFFER_SIZE + 9];
+	serial_stats_t stats;
+
+	test_start();
+	CHECK(test_send_frame(7, 1));
+	test_fill(data, sizeof(data), 2);
+	fake_lpsci_receive(data, sizeof(data));
+	fake_lpsci_idle();
+	CHECK_EQUAL(1, test_frames.frames);
+	serial_get_stats(serial_port0, &stats);
+	CHECK_EQUAL(1, stats.rx_overruns);
+	CHECK_EQUAL(7, stats.rx_bytes);
+
+	CHECK(test_send_frame(20, 3));
+	CHECK(test_send_frame(TEST_BUFFER_SIZE, 4));
+	serial_get_stats(serial_port0, &stats);
+	CHECK_EQUAL(1, stats.rx_overruns);
+	CHECK_EQUAL(7 + 20 + TEST_BUFFER_SIZE, stats.rx_bytes);
+
+	test_fill(data, TEST_BUFFER_SIZE + 1, 5);
+	fake_lpsci_receive(data, TEST_BUFFER_SIZE + 1);
+	fake_lpsci_idle();
+	CHECK_EQUAL(3, test_frames.frames);
+	serial_get_stats(serial_port0, &stats);
+	CHECK_EQUAL(2, stats.rx_overruns);
+	CHECK(test_send_frame(11, 6));
+}
+
+/**
+ * \fn static void test_masked
+ * \brief A frame whose idle interrupt is held off by masked interrupts is delivered once they are unmasked, merged
+ *  with what arrived meanwhile
+ * \param N/A
+ * \return N/A
+ */
+static void test_masked(void){
+	test_start();
+	fake_primask = 1;
+	fake_lpsci_receive((const uint8_t *)"12", 2);
+	fake_lpsci_idle();
+	fake_lpsci_receive((const uint8_t *)"345", 3);
+	CHECK_EQUAL(0, test_frames.frames);
+	fake_primask = 0;
+	fake_lpsci_service();
+	CHECK_EQUAL(1, test_frames.frames);
+	CHECK_EQUAL(5, test_frames.length);
+	CHECK(memcmp(test_frames.last, "12345", 5) == 0);
+	CHECK_EQUAL(0, fake_lpsci.rx_lost);
+}
+
+/**
+ * \fn static void test_reload
+ * \brief Run the DMA byte count down past the point where the driver reloads it, several times over: each time as
+ *  if a frame far too long for the buffer came in, which is an overrun, and the frames after it are whole again
+ * \param N/A
+ * \return N/A
+ *
+ *  Receiving half a megabyte byte by byte through the register traps takes minutes, so the bytes of the long frame
+ *  are skipped: BCR is counted down and DAR moved on in its window as the channel would have done
+ */
+static void test_reload(void){
+	serial_stats_t stats;
+	uint32_t round;
+	uint32_t frames;
+	uint32_t bcr;
+	uint32_t skipped;
+	uint32_t dar;
+
+	test_start();
+	for(round = 0; round < 3; round++){
+		CHECK(test_send_frame(TEST_BUFFER_SIZE - 5, (round * 3) + 1));
+		frames = test_frames.frames;
+		bcr = DMA0->DMA[TEST_CHANNEL].DSR_BCR & DMA_DSR_BCR_BCR_MASK;
+		skipped = bcr - ((TEST_BCR_MAX / 2) - 10);
+		dar = DMA0->DMA[TEST_CHANNEL].DAR;
+		DMA0->DMA[TEST_CHANNEL].DAR = (dar & ~(TEST_BUFFER_SIZE - 1)) | ((dar + skipped) & (TEST_BUFFER_SIZE - 1));
+		DMA0->DMA[TEST_CHANNEL].DSR_BCR = bcr - skipped;
+		fake_lpsci_receive((const uint8_t *)"x", 1);
+		fake_lpsci_idle();
+		CHECK_EQUAL(TEST_BCR_MAX, DMA0->DMA[TEST_CHANNEL].DSR_BCR & DMA_DSR_BCR_BCR_MASK);
+		CHECK_EQUAL(frames, test_frames.frames);
+		serial_get_stats(serial_port0, &stats);
+		CHECK_EQUAL(round + 1, stats.rx_overruns);
+
+		CHECK(test_send_frame(TEST_BUFFER_SIZE, (round * 3) + 2));
+		CHECK(test_send_frame(9, (round * 3) + 3));
+	}
+	CHECK_EQUAL(0, fake_lpsci.rx_lost);
+}
+
+/**
+ * \fn static void test_random_frames
+ * \brief Random frame lengths
+ * \param N/A
+ * \return N/A
+ */
+static void test_random_frames(void){
+	serial_stats_t stats;
+	uint32_t frame;
+	uint32_t failed;
+	size_t length;
+	uint64_t total;
+
+	srand(32);
+	test_start();
+	total = 0;
+	failed = 0;
+	for(frame = 0; total < TEST_RANDOM_BYTES; frame++){
+		length = 1 + (rand() % TEST_BUFFER_SIZE);
+		if(!test_send_frame(length, frame) && (++failed == 5)){
+			break;
+		}
+		total += length;
+	}
+	serial_get_stats(serial_port0, &stats);
+	CHECK_EQUAL(frame, test_frames.frames);
+	CHECK_EQUAL((uint32_t)total, stats.rx_bytes);
+	CHECK_EQUAL(0, stats.rx_overruns);
+	CHECK_EQUAL(0, fake_lpsci.rx_lost);
+}
+
+int main(void){
+	TEST_RUN(test_single);
+	TEST_RUN(test_gaps);
+	TEST_RUN(test_wrap);
+	TEST_RUN(test_too_long);
+	TEST_RUN(test_masked);
+	TEST_RUN(test_reload);
+	TEST_RUN(test_random_frames);
+
+	return test_summary();
+}
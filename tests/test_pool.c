@@ -0,0 +1,408 @@
+/**
+ * \file    test_pool.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Host tests of the fixed-size block pools (pool.c), and the host run of the "bench pool" comparison
+ *
+ *  Every pool is allocated to exhaustion and freed in scrambled orders, with the counters checked along the way. The
+ *  POOL_DEBUG checks are tried with double frees, pointers into the middle of a block or outside every pool, and
+ *  overwritten tags and canaries; blackbox_record() is stubbed to keep what pool_free() logs. This file builds with
+ *  POOL_DEBUG, test_pool_release.c without it.
+ *
+ *  test_bench() repeats shell_bench_pool() (shell.c) with the host clock and glibc malloc() and prints the result.
+ *  On the target the same pattern runs as the shell command "bench pool", in core clock cycles
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "fake_mcu.h"
+#include "test.h"
+#include "shell.h"
+#include "../Blinkenlights/source/pool.c"
+
+/**
+ * \def TEST_BLOCKS_MAX
+ *  Most blocks in one pool
+ */
+#define TEST_BLOCKS_MAX\
+	(POOL_EVENT_COUNT)
+
+/**
+ * \def TEST_BENCH_ROUNDS
+ *  Rounds of the host benchmark; many more than on the target, so the host clock resolves them
+ */
+#define TEST_BENCH_ROUNDS\
+	(200000UL)
+
+/**
+ * \typedef test_blackbox_t
+ *  Records pool_free() logged
+ */
+typedef struct {
+	uint32_t records;
+	blackbox_type_t type;
+	uint8_t code;
+	uint32_t value;
+} test_blackbox_t;
+
+static test_blackbox_t test_blackbox;
+
+void blackbox_record(blackbox_type_t type, uint8_t code, uint32_t value){
+	test_blackbox.records++;
+	test_blackbox.type = type;
+	test_blackbox.code = code;
+	test_blackbox.value = value;
+}
+
+/**
+ * \fn static void test_start
+ * \brief Refill every pool and clear the counters
+ * \param N/A
+ * \return N/A
+ */
+static void test_start(void){
+	fake_primask = 0;
+	memset(pool_states, 0, sizeof(pool_states));
+	memset(&test_blackbox, 0, sizeof(test_blackbox));
+	pool_init();
+}
+
+/**
+ * \fn static bool test_stats
+ * \brief Check a pool's counters
+ * \param pool The pool
+ * \param used Blocks expected allocated
+ * \param high_water Expected high-water mark
+ * \param failures Expected failed allocations
+ * \param errors Expected POOL_DEBUG errors
+ * \return true if they all match
+ */
+static bool test_stats(pool_id_t pool, uint32_t used, uint32_t high_water, uint32_t failures, uint32_t errors){
+	pool_stats_t stats;
+
+	pool_get_stats(pool, &stats);
+
+	return CHECK_EQUAL(pool_layouts[pool].size, stats.size) && CHECK_EQUAL(pool_layouts[pool].count, stats.count) &&
+			CHECK_EQUAL(used, stats.used) && CHECK_EQUAL(high_water, stats.high_water) &&
+			CHECK_EQUAL(failures, stats.failures) && CHECK_EQUAL(errors, stats.errors);
+}
+
+/**
+ * \fn static uint32_t test_fill
+ * \brief Allocate every block of a pool, checking each is aligned, inside the pool, distinct from the others and
+ *  writable over its full size. Stops early, without a failed allocation, if the pool runs dry
+ * \param pool The pool
+ * \param blocks Where to store the blocks, TEST_BLOCKS_MAX of them
+ * \return Amount of blocks allocated
+ */
+static uint32_t test_fill(pool_id_t pool, uint8_t *blocks[TEST_BLOCKS_MAX]){
+	const pool_layout_t *layout;
+	uint32_t count;
+	uint32_t i;
+
+	layout = &pool_layouts[pool];
+	for(count = 0; count < layout->count; count++){
+		if(pool_states[pool].free == NULL){
+			break;
+		}
+		blocks[count] = pool_alloc(pool);
+		if(blocks[count] == NULL){
+			break;
+		}
+		CHECK_EQUAL(0, (uintptr_t)blocks[count] % 4);
+		CHECK_EQUAL(pool, pool_owner((uint32_t *)blocks[count]));
+		CHECK((uint32_t *)(blocks[count] + layout->size) <= &layout->blocks[layout->stride * layout->count]);
+		for(i = 0; i < count; i++){
+			CHECK(blocks[i] != blocks[count]);
+		}
+		memset(blocks[count], (int)(count + 1), layout->size);
+	}
+	for(i = 0; i < count; i++){
+		CHECK_EQUAL(i + 1, blocks[i][0]);
+		CHECK_EQUAL(i + 1, blocks[i][layout->size - 1]);
+	}
+
+	return count;
+}
+
+/**
+ * \fn static void test_classes
+ * \brief Each pool hands out exactly its count of blocks in address order, fails once empty, and takes them all back
+ *  in any order, independently of the other pools
+ * \param N/A
+ * \return N/A
+ */
+static void test_classes(void){
+	uint8_t *blocks[TEST_BLOCKS_MAX];
+	uint32_t pool;
+	uint32_t other;
+	uint32_t count;
+	uint32_t i;
+
+	test_start();
+	for(pool = 0; pool < pool_count; pool++){
+		blocks[0] = pool_alloc((pool_id_t)pool);
+		test_stats((pool_id_t)pool, 1, 1, 0, 0);
+		pool_free(blocks[0]);
+		test_stats((pool_id_t)pool, 0, 1, 0, 0);
+
+		count = test_fill((pool_id_t)pool, blocks);
+		CHECK_EQUAL(pool_layouts[pool].count, count);
+		for(i = 1; i < count; i++){
+			CHECK(blocks[i] > blocks[i - 1]);
+		}
+		CHECK(pool_alloc((pool_id_t)pool) == NULL);
+		CHECK(pool_alloc((pool_id_t)pool) == NULL);
+		test_stats((pool_id_t)pool, count, count, 2, 0);
+		for(other = 0; other < pool_count; other++){
+			if(other != pool){
+				test_stats((pool_id_t)other, 0, (other < pool) ? pool_layouts[other].count : 0,
+						(other < pool) ? 2 : 0, 0);
+			}
+		}
+
+		for(i = 0; i < count; i++){
+			pool_free(blocks[(i * 3U) % count]);
+			test_stats((pool_id_t)pool, count - i - 1, count, 2, 0);
+		}
+		pool_free(NULL);
+		CHECK_EQUAL(count, test_fill((pool_id_t)pool, blocks));
+		for(i = count; i > 0; i--){
+			pool_free(blocks[i - 1]);
+		}
+		test_stats((pool_id_t)pool, 0, count, 2, 0);
+	}
+	CHECK_EQUAL(0, test_blackbox.records);
+	CHECK_EQUAL(0, fake_primask);
+}
+
+/**
+ * \fn static void test_random
+ * \brief Random allocations and frees across the pools against a count kept by the test
+ * \param N/A
+ * \return N/A
+ */
+static void test_random(void){
+	uint8_t *held[pool_count][TEST_BLOCKS_MAX];
+	uint32_t counts[pool_count];
+	uint32_t high_water[pool_count];
+	uint32_t failures[pool_count];
+	uint32_t step;
+	uint32_t pool;
+	uint32_t i;
+	uint8_t *block;
+
+	srand(48);
+	test_start();
+	memset(counts, 0, sizeof(counts));
+	memset(high_water, 0, sizeof(high_water));
+	memset(failures, 0, sizeof(failures));
+	for(step = 0; step < 100000; step++){
+		pool = (uint32_t)rand() % pool_count;
+		if(rand() % 2){
+			block = pool_alloc((pool_id_t)pool);
+			if(counts[pool] == pool_layouts[pool].count){
+				CHECK(block == NULL);
+				failures[pool]++;
+			}
+			else if(CHECK(block != NULL)){
+				held[pool][counts[pool]++] = block;
+				high_water[pool] = MAX(high_water[pool], counts[pool]);
+				*(uint32_t *)block = step;
+			}
+		}
+		else if(counts[pool] != 0){
+			i = (uint32_t)rand() % counts[pool];
+			CHECK_EQUAL(pool, pool_owner((uint32_t *)held[pool][i]));
+			pool_free(held[pool][i]);
+			held[pool][i] = held[pool][--counts[pool]];
+		}
+	}
+	for(pool = 0; pool < pool_count; pool++){
+		test_stats((pool_id_t)pool, counts[pool], high_water[pool], failures[pool], 0);
+	}
+	CHECK_EQUAL(0, test_blackbox.records);
+}
+
+/**
+ * \fn static void test_bad_pointers
+ * \brief Freeing a pointer outside every pool is logged and changes nothing
+ * \param N/A
+ * \return N/A
+ */
+static void test_bad_pointers(void){
+	uint32_t outside[4];
+	uint32_t pool;
+
+	test_start();
+	pool_free(&outside[1]);
+	CHECK_EQUAL(1, test_blackbox.records);
+	CHECK_EQUAL(blackbox_fault, test_blackbox.type);
+	CHECK_EQUAL(blackbox_fault_pool_pointer, test_blackbox.code);
+	CHECK_EQUAL((uint32_t)(uintptr_t)&outside[1], test_blackbox.value);
+	for(pool = 0; pool < pool_count; pool++){
+		test_stats((pool_id_t)pool, 0, 0, 0, 0);
+	}
+	CHECK_EQUAL(0, fake_primask);
+}
+
+#if POOL_DEBUG
+/**
+ * \fn static void test_misuse
+ * \brief Double frees, pointers into a block, and overwritten tags are logged and counted, and leave the free list
+ *  as it was, so the pool still hands out each block once
+ * \param N/A
+ * \return N/A
+ */
+static void test_misuse(void){
+	uint8_t *blocks[TEST_BLOCKS_MAX];
+	uint8_t *first;
+	uint32_t count;
+
+	test_start();
+	first = pool_alloc(pool_log);
+	pool_free(first);
+	pool_free(first);
+	CHECK_EQUAL(1, test_blackbox.records);
+	CHECK_EQUAL(blackbox_fault_pool_double_free, test_blackbox.code);
+	CHECK_EQUAL((uint32_t)(uintptr_t)first, test_blackbox.value);
+	test_stats(pool_log, 0, 1, 0, 1);
+	CHECK_EQUAL(POOL_LOG_COUNT, test_fill(pool_log, blocks));
+	CHECK(pool_alloc(pool_log) == NULL);
+
+	pool_free(blocks[1] + 4);
+	CHECK_EQUAL(2, test_blackbox.records);
+	CHECK_EQUAL(blackbox_fault_pool_pointer, test_blackbox.code);
+	test_stats(pool_log, POOL_LOG_COUNT, POOL_LOG_COUNT, 1, 2);
+
+	/**
+	 *  An underrun of the block before it, which overwrites this block's tag
+	 */
+	((uint32_t *)blocks[2])[-1] = 0;
+	pool_free(blocks[2]);
+	CHECK_EQUAL(3, test_blackbox.records);
+	CHECK_EQUAL(blackbox_fault_pool_overrun, test_blackbox.code);
+	test_stats(pool_log, POOL_LOG_COUNT, POOL_LOG_COUNT, 1, 3);
+	CHECK(pool_alloc(pool_log) == NULL);
+	CHECK_EQUAL(0, fake_primask);
+
+	for(count = 0; count < POOL_LOG_COUNT; count++){
+		if(count != 2){
+			pool_free(blocks[count]);
+		}
+	}
+	CHECK_EQUAL(3, test_blackbox.records);
+	test_stats(pool_log, 1, POOL_LOG_COUNT, 2, 3);
+}
+
+/**
+ * \fn static void test_canary
+ * \brief A write one byte past the end of a block is caught by the canary on free; the block is still freed and its
+ *  canary put right, so the next user of the block is not blamed for it
+ * \param N/A
+ * \return N/A
+ */
+static void test_canary(void){
+	uint8_t *blocks[TEST_BLOCKS_MAX];
+	uint8_t *block;
+	uint32_t pool;
+	uint32_t count;
+
+	for(pool = 0; pool < pool_count; pool++){
+		test_start();
+		block = pool_alloc((pool_id_t)pool);
+		block[pool_layouts[pool].size] ^= 0x01;
+		pool_free(block);
+		CHECK_EQUAL(1, test_blackbox.records);
+		CHECK_EQUAL(blackbox_fault_pool_overrun, test_blackbox.code);
+		CHECK_EQUAL((uint32_t)(uintptr_t)block, test_blackbox.value);
+		test_stats((pool_id_t)pool, 0, 1, 0, 1);
+
+		count = test_fill((pool_id_t)pool, blocks);
+		CHECK_EQUAL(pool_layouts[pool].count, count);
+		CHECK(blocks[0] == block);
+		pool_free(block);
+		CHECK_EQUAL(1, test_blackbox.records);
+
+		block = blocks[count - 1];
+		memset(block, 0, pool_layouts[pool].size + 4);
+		pool_free(block);
+		CHECK_EQUAL(2, test_blackbox.records);
+		CHECK_EQUAL(blackbox_fault_pool_overrun, test_blackbox.code);
+		test_stats((pool_id_t)pool, count - 2, count, 0, 2);
+	}
+	CHECK_EQUAL(0, fake_primask);
+}
+#endif /* POOL_DEBUG */
+
+/**
+ * \fn static uint64_t test_now
+ * \brief Read the host's monotonic clock
+ * \param N/A
+ * \return Nanoseconds
+ */
+static uint64_t test_now(void){
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * \fn static void test_bench
+ * \brief shell_bench_pool() on the host: SHELL_BENCH_POOL_BLOCKS blocks of POOL_EVENT_SIZE taken and given back in
+ *  the same scrambled order, from pool_event and from malloc()
+ * \param N/A
+ * \return N/A
+ *
+ *  Only the average is printed: the host clock is too coarse to time single calls, and the worst round is set by
+ *  the host scheduler rather than by either allocator
+ */
+static void test_bench(void){
+	void *blocks[SHELL_BENCH_POOL_BLOCKS];
+	uint64_t total[2];
+	uint64_t start;
+	uint32_t round;
+	uint32_t i;
+	uint32_t j;
+
+	test_start();
+	for(j = 0; j < 2; j++){
+		total[j] = 0;
+		for(round = 0; round < TEST_BENCH_ROUNDS; round++){
+			start = test_now();
+			for(i = 0; i < SHELL_BENCH_POOL_BLOCKS; i++){
+				blocks[i] = (j == 0) ? pool_alloc(pool_event) : malloc(POOL_EVENT_SIZE);
+				__asm volatile ("" : : "r" (blocks[i]) : "memory");
+			}
+			for(i = 0; i < SHELL_BENCH_POOL_BLOCKS; i++){
+				if(j == 0){
+					pool_free(blocks[(i * 5U) % SHELL_BENCH_POOL_BLOCKS]);
+				}
+				else{
+					free(blocks[(i * 5U) % SHELL_BENCH_POOL_BLOCKS]);
+				}
+			}
+			total[j] += test_now() - start;
+		}
+	}
+	test_stats(pool_event, 0, SHELL_BENCH_POOL_BLOCKS, 0, 0);
+
+	printf("POOL %.1f NS PER ALLOC+FREE\n", (double)total[0] / (SHELL_BENCH_POOL_BLOCKS * TEST_BENCH_ROUNDS));
+	printf("MALLOC %.1f NS PER ALLOC+FREE\n", (double)total[1] / (SHELL_BENCH_POOL_BLOCKS * TEST_BENCH_ROUNDS));
+}
+
+int main(void){
+	TEST_RUN(test_classes);
+	TEST_RUN(test_random);
+	TEST_RUN(test_bad_pointers);
+#if POOL_DEBUG
+	TEST_RUN(test_misuse);
+	TEST_RUN(test_canary);
+#endif /* POOL_DEBUG */
+	TEST_RUN(test_bench);
+
+	return test_summary();
+}
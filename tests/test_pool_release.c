@@ -0,0 +1,11 @@
+/**
+ * \file    test_pool_release.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   test_pool.c without POOL_DEBUG, as the Release and Production configurations build the pools
+ */
+
+#define POOL_DEBUG\
+	(0)
+
+#include "test_pool.c"
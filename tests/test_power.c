@@ -0,0 +1,376 @@
+/**
+ * \file    test_power.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Host tests of the power-mode constraints (power.c): power_allowed(), the constraint counters, and the mode
+ *  power_idle() enters
+ *
+ *  The SMC entry calls are stubs that record the mode and then run what the test set as the wake-up: the LPTMR
+ *  interrupt that ends the idle time, or an early interrupt that changes the constraints
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "fake_mcu.h"
+#include "test.h"
+#include "clocks.h"
+#include "../Blinkenlights/source/power.c"
+
+/**
+ * \def TEST_ENTRIES
+ *  Mode entries a test can record
+ */
+#define TEST_ENTRIES\
+	(16U)
+
+/**
+ * \typedef test_wake_t
+ *  What ends a low power mode: called with the number of the entry, from 0
+ */
+typedef void (*test_wake_t)(uint32_t entry);
+
+/**
+ * \typedef test_power_t
+ *  Mode entries seen by the SMC stubs, and how each ends
+ */
+typedef struct {
+	power_mode_t entered[TEST_ENTRIES];
+	uint32_t entries;
+	uint32_t unmasked_entries;		/* Entries made with interrupts not masked */
+	test_wake_t wake;
+	bool expire_before_stop;			/* Take the LPTMR interrupt just before SMC_PreEnterStopModes() masks */
+	clocks_profile_t profile;
+} test_power_t;
+
+static test_power_t test_power;
+
+clocks_profile_t clocks_get_profile(void){
+	return test_power.profile;
+}
+
+/**
+ * \fn static void test_expire
+ * \brief Wake-up by the LPTMR: the idle time is up
+ * \param entry N/A
+ * \return N/A
+ */
+static void test_expire(uint32_t entry){
+	LPTMR0_IRQHandler();
+}
+
+/**
+ * \fn static status_t test_enter
+ * \brief Record a mode entry and wake up from it
+ * \param mode The mode entered
+ * \return kStatus_Success
+ */
+static status_t test_enter(power_mode_t mode){
+	uint32_t entry;
+
+	entry = test_power.entries++;
+	if(entry < TEST_ENTRIES){
+		test_power.entered[entry] = mode;
+	}
+	if(fake_primask == 0){
+		test_power.unmasked_entries++;
+	}
+	if(entry == 100){
+		printf("power_idle() does not stop entering low power modes\n");
+		exit(1);
+	}
+	test_power.wake(entry);
+
+	return kStatus_Success;
+}
+
+void SMC_PreEnterStopModes(void){
+	if(test_power.expire_before_stop){
+		LPTMR0_IRQHandler();
+	}
+	__disable_irq();
+}
+
+void SMC_PostExitStopModes(void){
+	__enable_irq();
+}
+
+status_t SMC_SetPowerModeWait(SMC_Type *base){
+	return test_enter(power_wait);
+}
+
+status_t SMC_SetPowerModeStop(SMC_Type *base, smc_partial_stop_option_t option){
+	return test_enter(power_stop);
+}
+
+status_t SMC_SetPowerModeVlps(SMC_Type *base){
+	return test_enter(power_vlps);
+}
+
+status_t SMC_SetPowerModeLls(SMC_Type *base){
+	return test_enter(power_lls);
+}
+
+/**
+ * \fn static void test_start
+ * \brief Reset the hardware, the constraints and the counters
+ * \param N/A
+ * \return N/A
+ */
+static void test_start(void){
+	fake_mcu_init();
+	fake_primask = 0;
+	memset(&test_power, 0, sizeof(test_power));
+	test_power.wake = test_expire;
+	test_power.profile = clocks_run;
+	memset((void *)power_constraints, 0, sizeof(power_constraints));
+	memset(&power_stats, 0, sizeof(power_stats));
+	power_charge_uams = 0;
+	power_expired = false;
+	power_init();
+}
+
+/**
+ * \fn static void test_arbitration
+ * \brief The shallowest constraint wins, whatever order constraints are taken and given back in
+ * \param N/A
+ * \return N/A
+ */
+static void test_arbitration(void){
+	uint32_t mode;
+	uint32_t other;
+
+	test_start();
+	CHECK_EQUAL(POWER_DEEPEST_MODE, power_allowed());
+
+	for(mode = power_run; mode < power_mode_count; mode++){
+		power_constrain((power_mode_t)mode);
+		CHECK_EQUAL(mode, power_allowed());
+		for(other = power_run; other < power_mode_count; other++){
+			power_constrain((power_mode_t)other);
+			CHECK_EQUAL((other < mode) ? other : mode, power_allowed());
+			power_release((power_mode_t)mode);
+			CHECK_EQUAL(other, power_allowed());
+			power_constrain((power_mode_t)mode);
+			power_release((power_mode_t)other);
+			CHECK_EQUAL(mode, power_allowed());
+		}
+		power_release((power_mode_t)mode);
+		CHECK_EQUAL(POWER_DEEPEST_MODE, power_allowed());
+	}
+}
+
+/**
+ * \fn static void test_counting
+ * \brief A mode stays constrained until every holder gave it back, and giving back one not held changes nothing
+ * \param N/A
+ * \return N/A
+ */
+static void test_counting(void){
+	uint32_t i;
+
+	test_start();
+	for(i = 0; i < 3; i++){
+		power_constrain(power_wait);
+	}
+	for(i = 0; i < 3; i++){
+		CHECK_EQUAL(power_wait, power_allowed());
+		power_release(power_wait);
+	}
+	CHECK_EQUAL(POWER_DEEPEST_MODE, power_allowed());
+
+	power_release(power_wait);
+	power_release(power_stop);
+	CHECK_EQUAL(POWER_DEEPEST_MODE, power_allowed());
+	power_constrain(power_wait);
+	CHECK_EQUAL(power_wait, power_allowed());
+	power_release(power_wait);
+	CHECK_EQUAL(POWER_DEEPEST_MODE, power_allowed());
+}
+
+/**
+ * \fn static void test_masking
+ * \brief Taking and giving back constraints leaves the interrupt mask as it found it
+ * \param N/A
+ * \return N/A
+ */
+static void test_masking(void){
+	test_start();
+	power_constrain(power_stop);
+	CHECK_EQUAL(0, fake_primask);
+	power_release(power_stop);
+	CHECK_EQUAL(0, fake_primask);
+
+	fake_primask = 1;
+	power_constrain(power_stop);
+	CHECK_EQUAL(1, fake_primask);
+	power_release(power_stop);
+	CHECK_EQUAL(1, fake_primask);
+	fake_primask = 0;
+}
+
+/**
+ * \fn static void test_random
+ * \brief Random constraints and releases against a count kept by the test
+ * \param N/A
+ * \return N/A
+ */
+static void test_random(void){
+	uint32_t held[power_mode_count];
+	power_stats_t stats;
+	power_mode_t expected;
+	power_mode_t mode;
+	uint32_t step;
+	uint32_t failed;
+
+	srand(40);
+	test_start();
+	memset(held, 0, sizeof(held));
+	failed = 0;
+	for(step = 0; (step < 20000) && (failed < 5); step++){
+		mode = (power_mode_t)(rand() % power_mode_count);
+		if((rand() % 2) && (held[mode] < 200)){
+			power_constrain(mode);
+			held[mode]++;
+		}
+		else{
+			power_release(mode);
+			if(held[mode] != 0){
+				held[mode]--;
+			}
+		}
+
+		for(expected = power_run; (expected < POWER_DEEPEST_MODE) && (held[expected] == 0); expected++){
+		}
+		power_get_stats(&stats);
+		if(!CHECK_EQUAL(expected, power_allowed()) || !CHECK_EQUAL(expected, stats.allowed)){
+			failed++;
+		}
+	}
+}
+
+/**
+ * \fn static void test_idle_mode
+ * \brief power_idle() enters the deepest allowed mode once when nothing wakes it early
+ * \param N/A
+ * \return N/A
+ *
+ *  Under a RUN constraint it polls the LPTMR counter, which is plain memory here, so that case is left out
+ */
+static void test_idle_mode(void){
+	power_stats_t stats;
+	uint32_t mode;
+
+	for(mode = power_wait; mode < power_mode_count; mode++){
+		test_start();
+		power_constrain((power_mode_t)mode);
+		power_idle(10);
+		power_get_stats(&stats);
+		CHECK_EQUAL(1, test_power.entries);
+		CHECK_EQUAL(mode, test_power.entered[0]);
+		CHECK_EQUAL(0, test_power.unmasked_entries);
+		CHECK_EQUAL(1, stats.entries[mode]);
+		CHECK_EQUAL(10, stats.residency_ms[mode]);
+		CHECK_EQUAL(0, fake_primask);
+	}
+
+	test_start();
+	power_idle(10);
+	CHECK_EQUAL(1, test_power.entries);
+	CHECK_EQUAL(POWER_DEEPEST_MODE, test_power.entered[0]);
+
+	test_start();
+	test_power.profile = clocks_vlpr;
+	power_constrain(power_stop);
+	power_idle(10);
+	CHECK_EQUAL(1, test_power.entries);
+	CHECK_EQUAL(power_wait, test_power.entered[0]);
+}
+
+/**
+ * \fn static void test_release_wake
+ * \brief Early wake-up: a transfer ends and gives back its WAIT constraint
+ * \param entry Number of the entry
+ * \return N/A
+ */
+static void test_release_wake(uint32_t entry){
+	if(entry == 0){
+		power_release(power_wait);
+	}
+	else{
+		LPTMR0_IRQHandler();
+	}
+}
+
+/**
+ * \fn static void test_constrain_wake
+ * \brief Early wake-up: a flash operation is queued and takes a WAIT constraint
+ * \param entry Number of the entry
+ * \return N/A
+ */
+static void test_constrain_wake(uint32_t entry){
+	if(entry == 0){
+		power_constrain(power_wait);
+	}
+	else{
+		LPTMR0_IRQHandler();
+	}
+}
+
+/**
+ * \fn static void test_idle_rearbitrate
+ * \brief After each early wake-up power_idle() picks the mode again from the constraints as they are then
+ * \param N/A
+ * \return N/A
+ */
+static void test_idle_rearbitrate(void){
+	power_stats_t stats;
+
+	test_start();
+	power_constrain(power_wait);
+	test_power.wake = test_release_wake;
+	power_idle(20);
+	CHECK_EQUAL(2, test_power.entries);
+	CHECK_EQUAL(power_wait, test_power.entered[0]);
+	CHECK_EQUAL(POWER_DEEPEST_MODE, test_power.entered[1]);
+	power_get_stats(&stats);
+	CHECK_EQUAL(2, stats.entries[power_run]);
+
+	test_start();
+	test_power.wake = test_constrain_wake;
+	power_idle(20);
+	CHECK_EQUAL(2, test_power.entries);
+	CHECK_EQUAL(POWER_DEEPEST_MODE, test_power.entered[0]);
+	CHECK_EQUAL(power_wait, test_power.entered[1]);
+	CHECK_EQUAL(power_wait, power_allowed());
+}
+
+/**
+ * \fn static void test_idle_expired
+ * \brief The idle time running out between the last test of it and the interrupts being masked for the entry must
+ *  not leave the core in a stop mode waiting for another timer period
+ * \param N/A
+ * \return N/A
+ */
+static void test_idle_expired(void){
+	power_stats_t stats;
+
+	test_start();
+	test_power.expire_before_stop = true;
+	power_idle(10);
+	CHECK_EQUAL(0, test_power.entries);
+	power_get_stats(&stats);
+	CHECK_EQUAL(0, stats.entries[POWER_DEEPEST_MODE]);
+	CHECK_EQUAL(0, fake_primask);
+}
+
+int main(void){
+	TEST_RUN(test_arbitration);
+	TEST_RUN(test_counting);
+	TEST_RUN(test_masking);
+	TEST_RUN(test_random);
+	TEST_RUN(test_idle_mode);
+	TEST_RUN(test_idle_rearbitrate);
+	TEST_RUN(test_idle_expired);
+
+	return test_summary();
+}
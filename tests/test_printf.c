@@ -0,0 +1,267 @@
+/**
+ * \file    test_printf.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Host fuzz test of the number conversion of the debug console printf without division
+ *  (PRINTF_FAST_RADIX_ENABLE in utilities/fsl_debug_console.c)
+ *
+ *  DbgConsole_DivideBy10() is checked against the C operators for every 32-bit input, and
+ *  DbgConsole_ConvertRadixNumToString() against the conversion it replaced, kept here as the reference, for edge and
+ *  random values in each radix and sign the printf formats use. test_printf_advanced.c builds the same test with
+ *  PRINTF_ADVANCED_ENABLE, where the conversion takes 64-bit values; DbgConsole_DivideBy10() is the same there, so
+ *  that build leaves it out
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "fake_mcu.h"
+#include "test.h"
+#include "../Blinkenlights/utilities/fsl_debug_console.c"
+
+/**
+ * \def TEST_RANDOM_VALUES
+ *  Random values per radix and sign
+ */
+#define TEST_RANDOM_VALUES\
+	(500000UL)
+
+/**
+ * \def TEST_STRING_SIZE
+ *  Room for a converted number: the terminator and 64 binary digits
+ */
+#define TEST_STRING_SIZE\
+	(72U)
+
+#if PRINTF_ADVANCED_ENABLE
+typedef int64_t test_signed_t;
+typedef uint64_t test_unsigned_t;
+#else
+typedef int32_t test_signed_t;
+typedef uint32_t test_unsigned_t;
+#endif /* PRINTF_ADVANCED_ENABLE */
+
+/**
+ * \typedef test_format_t
+ *  A radix and sign a printf format converts with
+ */
+typedef struct {
+	int32_t radix;
+	bool neg;
+	bool use_caps;
+} test_format_t;
+
+/**
+ *  %d and %i, %u, %x, %X and %p, %o, %b, and one radix no format uses, which takes the division loop
+ */
+static const test_format_t test_formats[] = {
+	{10, true, false}, {10, false, false}, {16, false, false}, {16, false, true}, {8, false, false},
+	{2, false, false}, {7, false, false},
+};
+
+/**
+ * \fn static int32_t test_reference
+ * \brief The conversion as it was before PRINTF_FAST_RADIX_ENABLE: a division per digit
+ * \param numstr Where to store the terminator and then the digits, least significant first
+ * \param nump The number
+ * \param neg Whether it is signed
+ * \param radix The radix
+ * \param use_caps Whether digits above 9 are capitals
+ * \return Amount of digits
+ */
+static int32_t test_reference(char *numstr, void *nump, int32_t neg, int32_t radix, bool use_caps){
+	test_signed_t a;
+	test_signed_t b;
+	test_signed_t c;
+	test_unsigned_t ua;
+	test_unsigned_t ub;
+	test_unsigned_t uc;
+	int32_t nlen;
+	char *nstrp;
+
+	nlen = 0;
+	nstrp = numstr;
+	*nstrp++ = '\0';
+
+	if(neg){
+		a = *(test_signed_t *)nump;
+		if(a == 0){
+			*nstrp = '0';
+			return 1;
+		}
+		while(a != 0){
+			b = a / radix;
+			c = a - (b * radix);
+			if(c < 0){
+				uc = (test_unsigned_t)c;
+				c = (test_signed_t)(~uc) + 1 + '0';
+			}
+			else{
+				c = c + '0';
+			}
+			a = b;
+			*nstrp++ = (char)c;
+			++nlen;
+		}
+	}
+	else{
+		ua = *(test_unsigned_t *)nump;
+		if(ua == 0){
+			*nstrp = '0';
+			return 1;
+		}
+		while(ua != 0){
+			ub = ua / (test_unsigned_t)radix;
+			uc = ua - (ub * (test_unsigned_t)radix);
+			if(uc < 10){
+				uc = uc + '0';
+			}
+			else{
+				uc = uc - 10 + (use_caps ? 'A' : 'a');
+			}
+			ua = ub;
+			*nstrp++ = (char)uc;
+			++nlen;
+		}
+	}
+
+	return nlen;
+}
+
+/**
+ * \fn static bool test_convert
+ * \brief Convert a value with the firmware and with the reference, and check both gave the same string
+ * \param value The value, as its bits
+ * \param format Radix and sign
+ * \return true if they did
+ */
+static bool test_convert(test_unsigned_t value, const test_format_t *format){
+	char expected[TEST_STRING_SIZE];
+	char actual[TEST_STRING_SIZE];
+	int32_t expected_length;
+	int32_t actual_length;
+	bool passed;
+
+	memset(expected, 0x55, sizeof(expected));
+	memset(actual, 0x55, sizeof(actual));
+	expected_length = test_reference(expected, &value, format->neg, format->radix, format->use_caps);
+	actual_length = DbgConsole_ConvertRadixNumToString(actual, &value, format->neg, format->radix,
+			format->use_caps);
+	passed = (expected_length == actual_length) && (memcmp(expected, actual, expected_length + 1) == 0);
+	if(!passed){
+		printf("%llx in radix %d%s: %d digits, expected %d\n", (unsigned long long)value, format->radix,
+				format->neg ? " signed" : "", actual_length, expected_length);
+	}
+
+	return CHECK(passed);
+}
+
+/**
+ * \fn static test_unsigned_t test_random
+ * \brief A random value, of random bit length so that short numbers come up as often as long ones
+ * \param N/A
+ * \return The value
+ */
+static test_unsigned_t test_random(void){
+	test_unsigned_t value;
+	uint32_t i;
+
+	value = 0;
+	for(i = 0; i < sizeof(value); i++){
+		value = (value << 8) | (test_unsigned_t)(rand() & 0xFF);
+	}
+
+	return value >> (rand() % (sizeof(value) * 8));
+}
+
+#if !PRINTF_ADVANCED_ENABLE
+/**
+ * \fn static void test_divide_by_10
+ * \brief DbgConsole_DivideBy10() gives the quotient and remainder of every 32-bit input
+ * \param N/A
+ * \return N/A
+ */
+static void test_divide_by_10(void){
+	uint32_t n;
+	uint32_t q;
+	uint32_t r;
+	uint32_t failed;
+
+	failed = 0;
+	n = 0;
+	do{
+		q = DbgConsole_DivideBy10(n, &r);
+		if((q != n / 10U) || (r != n % 10U)){
+			if(failed++ < 5){
+				printf("DbgConsole_DivideBy10(%u) gave %u remainder %u\n", n, q, r);
+			}
+		}
+	} while(++n != 0);
+	CHECK_EQUAL(0, failed);
+}
+#endif /* !PRINTF_ADVANCED_ENABLE */
+
+/**
+ * \fn static void test_edges
+ * \brief Zero, the extremes of each width, and every power of the radix with its neighbours
+ * \param N/A
+ * \return N/A
+ */
+static void test_edges(void){
+	static const test_unsigned_t values[] = {
+		0, 1, 9, 10, 11, 99, 100, 0x7FFFFFFFUL, 0x80000000UL, 0x80000001UL, 0xFFFFFFFEUL, 0xFFFFFFFFUL,
+		(test_unsigned_t)(test_signed_t)-1, (test_unsigned_t)(test_signed_t)-9, (test_unsigned_t)(test_signed_t)-10,
+		(test_unsigned_t)(test_signed_t)INT32_MIN,
+#if PRINTF_ADVANCED_ENABLE
+		0x100000000ULL, 0x7FFFFFFFFFFFFFFFULL, 0x8000000000000000ULL, 0xFFFFFFFFFFFFFFFFULL,
+#endif /* PRINTF_ADVANCED_ENABLE */
+	};
+	test_unsigned_t radix;
+	test_unsigned_t power;
+	size_t format;
+	size_t i;
+
+	for(format = 0; format < (sizeof(test_formats) / sizeof(test_formats[0])); format++){
+		for(i = 0; i < (sizeof(values) / sizeof(values[0])); i++){
+			test_convert(values[i], &test_formats[format]);
+		}
+		radix = (test_unsigned_t)test_formats[format].radix;
+		for(power = 1; power != 0; power = (power > ((test_unsigned_t)-1 / radix)) ? 0 : power * radix){
+			test_convert(power - 1, &test_formats[format]);
+			test_convert(power, &test_formats[format]);
+			test_convert(power + 1, &test_formats[format]);
+			test_convert((test_unsigned_t)0 - power, &test_formats[format]);
+		}
+	}
+}
+
+/**
+ * \fn static void test_random_values
+ * \brief Random values in each radix and sign
+ * \param N/A
+ * \return N/A
+ */
+static void test_random_values(void){
+	size_t format;
+	uint32_t i;
+	uint32_t failed;
+
+	srand(27);
+	for(format = 0; format < (sizeof(test_formats) / sizeof(test_formats[0])); format++){
+		failed = 0;
+		for(i = 0; (i < TEST_RANDOM_VALUES) && (failed < 5); i++){
+			if(!test_convert(test_random(), &test_formats[format])){
+				failed++;
+			}
+		}
+	}
+}
+
+int main(void){
+#if !PRINTF_ADVANCED_ENABLE
+	TEST_RUN(test_divide_by_10);
+#endif /* !PRINTF_ADVANCED_ENABLE */
+	TEST_RUN(test_edges);
+	TEST_RUN(test_random_values);
+
+	return test_summary();
+}
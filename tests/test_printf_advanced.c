@@ -0,0 +1,11 @@
+/**
+ * \file    test_printf_advanced.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   test_printf.c with PRINTF_ADVANCED_ENABLE, where the number conversion takes 64-bit values
+ */
+
+#define PRINTF_ADVANCED_ENABLE\
+	(1U)
+
+#include "test_printf.c"
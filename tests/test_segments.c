@@ -0,0 +1,642 @@
+/**
+ * \file    test_segments.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Host tests of the scatter-gather sends of the LPSCI and UART drivers against register models
+ *
+ *  LPSCI_TransferSendSegmentsNonBlocking() runs on UART0 as fake/fake_lpsci.h models it, and
+ *  UART_TransferSendSegmentsNonBlocking() on UART1 as modelled here. Both lines are paced: each byte written to D
+ *  stays on the line, with TDRE clear, until the test shifts it out, so the send can be checked byte by byte. Every
+ *  byte of a segment encodes the segment and its offset in it, so a byte sent from the wrong segment, out of order,
+ *  twice or not at all shows in the stream
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "MKL25Z4.h"
+#include "fsl_lpsci.h"
+#include "fsl_uart.h"
+#include "fake_mcu.h"
+#include "fake_lpsci.h"
+#include "test.h"
+
+/**
+ * \def TEST_SEGMENTS_MAX
+ *  Most segments in one send
+ */
+#define TEST_SEGMENTS_MAX\
+	(8U)
+
+/**
+ * \def TEST_SEGMENT_MAX
+ *  Longest segment: offsets fit the low 5 bits of a byte
+ */
+#define TEST_SEGMENT_MAX\
+	(32U)
+
+/**
+ * \def TEST_GUARD
+ *  Fill around and between the segments, which must never be sent
+ */
+#define TEST_GUARD\
+	(0xEEU)
+
+/**
+ * \def TEST_IRQ_LIMIT
+ *  Interrupts one uart1_service() call takes before it decides the handler does not clear its source
+ */
+#define TEST_IRQ_LIMIT\
+	(100000U)
+
+/**
+ * \typedef uart1_model_t
+ *  State of the UART1 model: same line as fake_lpsci.h, but S1 is read-only on this UART
+ */
+typedef struct {
+	uint8_t s1;						/* S1 as the hardware holds it */
+	uint8_t tx[FAKE_LPSCI_TX_SIZE];	/* Bytes written to D, in order */
+	size_t tx_length;
+} uart1_model_t;
+
+/**
+ * \typedef test_port_t
+ *  One driver and its model, behind the same calls
+ */
+typedef struct {
+	const char *name;
+	void (*open)(void);
+	status_t (*send)(const uint8_t *const *data, const size_t *sizes, size_t count);
+	status_t (*send_plain)(const uint8_t *data, size_t size);
+	status_t (*get_count)(uint32_t *count);
+	void (*abort)(void);
+	void (*shift)(void);
+	bool (*tx_irq_enabled)(void);
+	const uint8_t *tx;
+	const size_t *tx_length;
+	status_t idle;					/* Status of the callback at the end of a send */
+} test_port_t;
+
+/**
+ * \typedef test_stream_t
+ *  Callback record of a port
+ */
+typedef struct {
+	uint32_t callbacks;
+	status_t status;				/* Of the last callback */
+	size_t sent;					/* Bytes on the line at the last callback */
+} test_stream_t;
+
+void UART1_DriverIRQHandler(void);
+
+static uart1_model_t uart1_model;
+static lpsci_handle_t lpsci_handle;
+static uart_handle_t uart_handle;
+static lpsci_segment_t lpsci_segments[TEST_SEGMENTS_MAX];
+static uart_segment_t uart_segments[TEST_SEGMENTS_MAX];
+static test_stream_t test_stream;
+static const test_port_t *test_port;
+
+/**
+ *  Segment buffers, with guard bytes between them
+ */
+static uint8_t test_memory[TEST_SEGMENTS_MAX][TEST_SEGMENT_MAX + 8];
+
+/**
+ * \fn static void uart1_hook
+ * \brief UART1 register model
+ * \param address Register accessed
+ * \param write true after a write, false before a read
+ * \return N/A
+ */
+static void uart1_hook(uintptr_t address, bool write){
+	if(address == (uintptr_t)&UART1->S1){
+		*(volatile uint8_t *)&UART1->S1 = uart1_model.s1;
+	}
+	else if((address == (uintptr_t)&UART1->D) && write){
+		if(uart1_model.tx_length < FAKE_LPSCI_TX_SIZE){
+			uart1_model.tx[uart1_model.tx_length] = UART1->D;
+		}
+		uart1_model.tx_length++;
+		uart1_model.s1 &= ~(UART_S1_TDRE_MASK | UART_S1_TC_MASK);
+	}
+}
+
+/**
+ * \fn static void uart1_service
+ * \brief Take the UART1 interrupt while its transmit sources are enabled and pending
+ * \param N/A
+ * \return N/A
+ */
+static void uart1_service(void){
+	uint32_t taken;
+
+	for(taken = 0; ((UART1->C2 & UART_C2_TIE_MASK) && (uart1_model.s1 & UART_S1_TDRE_MASK)) ||
+			((UART1->C2 & UART_C2_TCIE_MASK) && (uart1_model.s1 & UART_S1_TC_MASK)); taken++){
+		if(taken == TEST_IRQ_LIMIT){
+			fprintf(stderr, "test_segments: the UART1 interrupt does not clear its source\n");
+			abort();
+		}
+		UART1_DriverIRQHandler();
+	}
+}
+
+/**
+ * \fn static void test_lpsci_callback
+ * \brief LPSCI transfer callback
+ * \param base N/A
+ * \param handle N/A
+ * \param status Reason
+ * \param user_data N/A
+ * \return N/A
+ */
+static void test_lpsci_callback(UART0_Type *base, lpsci_handle_t *handle, status_t status, void *user_data){
+	test_stream.callbacks++;
+	test_stream.status = status;
+	test_stream.sent = fake_lpsci.tx_length;
+}
+
+/**
+ * \fn static void test_uart_callback
+ * \brief UART transfer callback
+ * \param base N/A
+ * \param handle N/A
+ * \param status Reason
+ * \param user_data N/A
+ * \return N/A
+ */
+static void test_uart_callback(UART_Type *base, uart_handle_t *handle, status_t status, void *user_data){
+	test_stream.callbacks++;
+	test_stream.status = status;
+	test_stream.sent = uart1_model.tx_length;
+}
+
+/**
+ * \fn static void lpsci_open
+ * \brief Model UART0 paced and create the LPSCI handle
+ * \param N/A
+ * \return N/A
+ */
+static void lpsci_open(void){
+	fake_lpsci_init();
+	fake_lpsci.paced = true;
+	LPSCI_TransferCreateHandle(UART0, &lpsci_handle, test_lpsci_callback, NULL);
+}
+
+/**
+ * \fn static status_t lpsci_send
+ * \brief Start a scatter-gather send on UART0, and take the interrupt it raises
+ * \param data Segment starts
+ * \param sizes Segment sizes
+ * \param count Amount of segments
+ * \return The driver's status
+ */
+static status_t lpsci_send(const uint8_t *const *data, const size_t *sizes, size_t count){
+	status_t status;
+	size_t i;
+
+	for(i = 0; i < count; i++){
+		lpsci_segments[i].data = data[i];
+		lpsci_segments[i].dataSize = sizes[i];
+	}
+	status = LPSCI_TransferSendSegmentsNonBlocking(UART0, &lpsci_handle, lpsci_segments, count);
+	fake_lpsci_service();
+
+	return status;
+}
+
+/**
+ * \fn static status_t lpsci_send_plain
+ * \brief Start a send of one buffer on UART0, and take the interrupt it raises
+ * \param data The buffer
+ * \param size Its size
+ * \return The driver's status
+ */
+static status_t lpsci_send_plain(const uint8_t *data, size_t size){
+	lpsci_transfer_t xfer;
+	status_t status;
+
+	xfer.data = (uint8_t *)data;
+	xfer.dataSize = size;
+	status = LPSCI_TransferSendNonBlocking(UART0, &lpsci_handle, &xfer);
+	fake_lpsci_service();
+
+	return status;
+}
+
+/**
+ * \fn static status_t lpsci_get_count
+ * \brief Get the bytes of the UART0 send written to D so far
+ * \param count Where to store them
+ * \return The driver's status
+ */
+static status_t lpsci_get_count(uint32_t *count){
+	return LPSCI_TransferGetSendCount(UART0, &lpsci_handle, count);
+}
+
+/**
+ * \fn static void lpsci_abort
+ * \brief Abort the UART0 send
+ * \param N/A
+ * \return N/A
+ */
+static void lpsci_abort(void){
+	LPSCI_TransferAbortSend(UART0, &lpsci_handle);
+}
+
+/**
+ * \fn static bool lpsci_tx_irq_enabled
+ * \brief Tell whether a UART0 transmit interrupt is enabled
+ * \param N/A
+ * \return true if TIE or TCIE is set
+ */
+static bool lpsci_tx_irq_enabled(void){
+	return (UART0->C2 & (UART0_C2_TIE_MASK | UART0_C2_TCIE_MASK)) != 0;
+}
+
+/**
+ * \fn static void uart_open
+ * \brief Model UART1 paced and create the UART handle
+ * \param N/A
+ * \return N/A
+ */
+static void uart_open(void){
+	memset(&uart1_model, 0, sizeof(uart1_model));
+	uart1_model.s1 = UART_S1_TDRE_MASK | UART_S1_TC_MASK;
+	fake_mcu_trap((uintptr_t)UART1, uart1_hook);
+	UART_TransferCreateHandle(UART1, &uart_handle, test_uart_callback, NULL);
+}
+
+/**
+ * \fn static status_t uart_send
+ * \brief Start a scatter-gather send on UART1, and take the interrupt it raises
+ * \param data Segment starts
+ * \param sizes Segment sizes
+ * \param count Amount of segments
+ * \return The driver's status
+ */
+static status_t uart_send(const uint8_t *const *data, const size_t *sizes, size_t count){
+	status_t status;
+	size_t i;
+
+	for(i = 0; i < count; i++){
+		uart_segments[i].data = data[i];
+		uart_segments[i].dataSize = sizes[i];
+	}
+	status = UART_TransferSendSegmentsNonBlocking(UART1, &uart_handle, uart_segments, count);
+	uart1_service();
+
+	return status;
+}
+
+/**
+ * \fn static status_t uart_send_plain
+ * \brief Start a send of one buffer on UART1, and take the interrupt it raises
+ * \param data The buffer
+ * \param size Its size
+ * \return The driver's status
+ */
+static status_t uart_send_plain(const uint8_t *data, size_t size){
+	uart_transfer_t xfer;
+	status_t status;
+
+	xfer.data = (uint8_t *)data;
+	xfer.dataSize = size;
+	status = UART_TransferSendNonBlocking(UART1, &uart_handle, &xfer);
+	uart1_service();
+
+	return status;
+}
+
+/**
+ * \fn static status_t uart_get_count
+ * \brief Get the bytes of the UART1 send written to D so far
+ * \param count Where to store them
+ * \return The driver's status
+ */
+static status_t uart_get_count(uint32_t *count){
+	return UART_TransferGetSendCount(UART1, &uart_handle, count);
+}
+
+/**
+ * \fn static void uart_abort
+ * \brief Abort the UART1 send
+ * \param N/A
+ * \return N/A
+ */
+static void uart_abort(void){
+	UART_TransferAbortSend(UART1, &uart_handle);
+}
+
+/**
+ * \fn static void uart_shift
+ * \brief Finish sending the byte on the UART1 line, and take the interrupt that raises
+ * \param N/A
+ * \return N/A
+ */
+static void uart_shift(void){
+	uart1_model.s1 |= UART_S1_TDRE_MASK | UART_S1_TC_MASK;
+	uart1_service();
+}
+
+/**
+ * \fn static bool uart_tx_irq_enabled
+ * \brief Tell whether a UART1 transmit interrupt is enabled
+ * \param N/A
+ * \return true if TIE or TCIE is set
+ */
+static bool uart_tx_irq_enabled(void){
+	return (UART1->C2 & (UART_C2_TIE_MASK | UART_C2_TCIE_MASK)) != 0;
+}
+
+static const test_port_t test_ports[] = {
+	{"LPSCI", lpsci_open, lpsci_send, lpsci_send_plain, lpsci_get_count, lpsci_abort, fake_lpsci_shift,
+			lpsci_tx_irq_enabled, fake_lpsci.tx, &fake_lpsci.tx_length, kStatus_LPSCI_TxIdle},
+	{"UART", uart_open, uart_send, uart_send_plain, uart_get_count, uart_abort, uart_shift, uart_tx_irq_enabled,
+			uart1_model.tx, &uart1_model.tx_length, kStatus_UART_TxIdle}
+};
+
+/**
+ * \fn static void test_start
+ * \brief Reset the hardware and open the port under test
+ * \param N/A
+ * \return N/A
+ */
+static void test_start(void){
+	fake_mcu_init();
+	memset(&test_stream, 0, sizeof(test_stream));
+	memset(test_memory, TEST_GUARD, sizeof(test_memory));
+	test_port->open();
+}
+
+/**
+ * \fn static uint8_t test_byte
+ * \brief The byte at an offset of a segment
+ * \param segment Segment index
+ * \param offset Offset in it
+ * \return The byte
+ */
+static uint8_t test_byte(size_t segment, size_t offset){
+	return (uint8_t)((segment << 5) | offset);
+}
+
+/**
+ * \fn static void test_layout
+ * \brief Fill the segment buffers for a send
+ * \param sizes Segment sizes
+ * \param count Amount of segments
+ * \param data Where to store the segment pointers
+ * \return Total bytes
+ */
+static size_t test_layout(const size_t *sizes, size_t count, const uint8_t **data){
+	size_t total;
+	size_t i;
+	size_t j;
+
+	total = 0;
+	for(i = 0; i < count; i++){
+		data[i] = &test_memory[i][4];
+		for(j = 0; j < sizes[i]; j++){
+			test_memory[i][4 + j] = test_byte(i, j);
+		}
+		total += sizes[i];
+	}
+
+	return total;
+}
+
+/**
+ * \fn static void test_send_paced
+ * \brief Send segments one byte at a time, checking every byte, the send count and the callback as it goes
+ * \param sizes Segment sizes
+ * \param count Amount of segments
+ * \return N/A
+ */
+static void test_send_paced(const size_t *sizes, size_t count){
+	const uint8_t *data[TEST_SEGMENTS_MAX];
+	uint8_t expected[TEST_SEGMENTS_MAX * TEST_SEGMENT_MAX];
+	size_t total;
+	size_t start;
+	size_t sent;
+	size_t i;
+	size_t j;
+	uint32_t progress;
+
+	total = test_layout(sizes, count, data);
+	sent = 0;
+	for(i = 0; i < count; i++){
+		for(j = 0; j < sizes[i]; j++){
+			expected[sent++] = test_byte(i, j);
+		}
+	}
+
+	start = *test_port->tx_length;
+	test_stream.callbacks = 0;
+	CHECK_EQUAL(kStatus_Success, test_port->send(data, sizes, count));
+	for(sent = 1; sent < total; sent++){
+		CHECK_EQUAL(start + sent, *test_port->tx_length);
+		CHECK_EQUAL(kStatus_Success, test_port->get_count(&progress));
+		CHECK_EQUAL(sent, progress);
+		CHECK_EQUAL(0, test_stream.callbacks);
+		test_port->shift();
+	}
+
+	CHECK_EQUAL(start + total, *test_port->tx_length);
+	CHECK(memcmp(&test_port->tx[start], expected, total) == 0);
+	CHECK_EQUAL(1, test_stream.callbacks);
+	CHECK_EQUAL(test_port->idle, test_stream.status);
+	CHECK_EQUAL(start + total, test_stream.sent);
+	CHECK(!test_port->tx_irq_enabled());
+	CHECK_EQUAL(kStatus_NoTransferInProgress, test_port->get_count(&progress));
+
+	/**
+	 *  The last byte leaving the line must not start anything else
+	 */
+	test_port->shift();
+	CHECK_EQUAL(start + total, *test_port->tx_length);
+	CHECK_EQUAL(1, test_stream.callbacks);
+}
+
+/**
+ * \fn static void test_boundaries
+ * \brief Sends with empty segments first, in the middle and last, and single bytes
+ * \param N/A
+ * \return N/A
+ */
+static void test_boundaries(void){
+	static const size_t shapes[][TEST_SEGMENTS_MAX] = {
+		{5},
+		{1},
+		{1, 1, 1, 1},
+		{3, 0, 1, 5, 0},
+		{0, 0, 7},
+		{0, 4, 0, 0, 0, 0, 0, 0},
+		{31, 1, 31, 1},
+		{2, 0, 0, 2, 0, 0, 2, 0}
+	};
+	static const size_t counts[] = {1, 1, 4, 5, 3, 8, 4, 8};
+	size_t i;
+
+	test_start();
+	for(i = 0; i < sizeof(counts) / sizeof(counts[0]); i++){
+		test_send_paced(shapes[i], counts[i]);
+	}
+}
+
+/**
+ * \fn static void test_random_shapes
+ * \brief Random segment counts and sizes, back to back on one handle
+ * \param N/A
+ * \return N/A
+ */
+static void test_random_shapes(void){
+	size_t sizes[TEST_SEGMENTS_MAX];
+	size_t count;
+	size_t total;
+	size_t i;
+	uint32_t round;
+
+	srand(31);
+	test_start();
+	for(round = 0; round < 300; round++){
+		do{
+			count = 1 + (rand() % TEST_SEGMENTS_MAX);
+			total = 0;
+			for(i = 0; i < count; i++){
+				sizes[i] = ((rand() % 4) == 0) ? 0 : (rand() % TEST_SEGMENT_MAX);
+				total += sizes[i];
+			}
+		} while(total == 0);
+		test_send_paced(sizes, count);
+		if(*test_port->tx_length > FAKE_LPSCI_TX_SIZE - (TEST_SEGMENTS_MAX * TEST_SEGMENT_MAX)){
+			test_start();
+		}
+	}
+}
+
+/**
+ * \fn static void test_empty
+ * \brief A send of nothing but empty segments is refused and starts nothing
+ * \param N/A
+ * \return N/A
+ */
+static void test_empty(void){
+	static const size_t sizes[] = {0, 0, 0};
+	const uint8_t *data[3];
+	uint32_t progress;
+
+	test_start();
+	(void)test_layout(sizes, 3, data);
+	CHECK_EQUAL(kStatus_InvalidArgument, test_port->send(data, sizes, 3));
+	CHECK(!test_port->tx_irq_enabled());
+	CHECK_EQUAL(kStatus_NoTransferInProgress, test_port->get_count(&progress));
+	CHECK_EQUAL(0, *test_port->tx_length);
+	CHECK_EQUAL(0, test_stream.callbacks);
+}
+
+/**
+ * \fn static void test_zero_copy
+ * \brief Bytes are taken from the caller's buffers as they are sent, not copied at the start
+ * \param N/A
+ * \return N/A
+ */
+static void test_zero_copy(void){
+	static const size_t sizes[] = {2, 3};
+	const uint8_t *data[2];
+
+	test_start();
+	(void)test_layout(sizes, 2, data);
+	CHECK_EQUAL(kStatus_Success, test_port->send(data, sizes, 2));
+	test_memory[1][4] = 'z';
+	while(test_stream.callbacks == 0){
+		test_port->shift();
+	}
+	CHECK_EQUAL(5, *test_port->tx_length);
+	CHECK_EQUAL('z', test_port->tx[2]);
+}
+
+/**
+ * \fn static void test_busy
+ * \brief A send while one is running is refused and does not disturb it
+ * \param N/A
+ * \return N/A
+ */
+static void test_busy(void){
+	static const size_t sizes[] = {4, 4};
+	const uint8_t *data[2];
+	size_t i;
+
+	test_start();
+	(void)test_layout(sizes, 2, data);
+	CHECK_EQUAL(kStatus_Success, test_port->send(data, sizes, 2));
+	test_port->shift();
+	CHECK(test_port->send(data, sizes, 1) != kStatus_Success);
+	CHECK(test_port->send_plain(data[1], 4) != kStatus_Success);
+	while(test_stream.callbacks == 0){
+		test_port->shift();
+	}
+	CHECK_EQUAL(8, *test_port->tx_length);
+	for(i = 0; i < 8; i++){
+		CHECK_EQUAL(test_byte(i / 4, i % 4), test_port->tx[i]);
+	}
+}
+
+/**
+ * \fn static void test_abort
+ * \brief Aborting in the middle of a segment stops at once, and later sends start from their own first byte
+ * \param N/A
+ * \return N/A
+ */
+static void test_abort(void){
+	static const size_t sizes[] = {3, 4, 5};
+	static const size_t tail[] = {1, 2};
+	const uint8_t *data[3];
+	uint32_t progress;
+
+	test_start();
+	(void)test_layout(sizes, 3, data);
+	CHECK_EQUAL(kStatus_Success, test_port->send(data, sizes, 3));
+	test_port->shift();
+	test_port->shift();
+	test_port->shift();
+	test_port->shift();
+	CHECK_EQUAL(kStatus_Success, test_port->get_count(&progress));
+	CHECK_EQUAL(5, progress);
+	test_port->abort();
+	CHECK(!test_port->tx_irq_enabled());
+	CHECK_EQUAL(kStatus_NoTransferInProgress, test_port->get_count(&progress));
+	test_port->shift();
+	CHECK_EQUAL(5, *test_port->tx_length);
+
+	/**
+	 *  A plain send after the aborted segments must not pick up where they left off
+	 */
+	CHECK_EQUAL(kStatus_Success, test_port->send_plain((const uint8_t *)"ab", 2));
+	test_port->shift();
+	test_port->shift();
+	CHECK_EQUAL(7, *test_port->tx_length);
+	CHECK(memcmp(&test_port->tx[5], "ab", 2) == 0);
+	CHECK_EQUAL(1, test_stream.callbacks);
+
+	test_send_paced(tail, 2);
+}
+
+int main(void){
+	unsigned failures;
+	size_t i;
+
+	for(i = 0; i < sizeof(test_ports) / sizeof(test_ports[0]); i++){
+		test_port = &test_ports[i];
+		failures = test_failures;
+		TEST_RUN(test_boundaries);
+		TEST_RUN(test_random_shapes);
+		TEST_RUN(test_empty);
+		TEST_RUN(test_zero_copy);
+		TEST_RUN(test_busy);
+		TEST_RUN(test_abort);
+		if(test_failures != failures){
+			printf("FAIL on %s\n", test_port->name);
+		}
+	}
+
+	return test_summary();
+}
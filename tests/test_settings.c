@@ -0,0 +1,374 @@
+/**
+ * \file    test_settings.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Host tests of the settings store (source/settings.c) on simulated flash, torn at every step
+ *
+ *  Each scenario brings the store to a known state, then writes one key while the flash simulator (fake/fake_flash.h)
+ *  cuts the power or fails the driver at step 1, 2, ... until the write gets through untouched. After each cut the
+ *  store is booted again, and after each failure it is used as is. Either way every key must read back as before the
+ *  write or, for the key written, as after it; the store must then take a new value, keep it across a reboot, and
+ *  never have programmed a longword that was not erased
+ */
+
+#include <string.h>
+#include "fake_mcu.h"
+#include "fake_flash.h"
+#include "test.h"
+#include "../Blinkenlights/source/settings.c"
+
+/**
+ * \def TEST_AREA
+ *  Bytes of the store
+ */
+#define TEST_AREA\
+	(SETTINGS_SECTOR_COUNT * SETTINGS_SECTOR_SIZE)
+
+/**
+ * \def TEST_PARAMS_LENGTH
+ *  Length of the settings_key_params values
+ */
+#define TEST_PARAMS_LENGTH\
+	(41U)
+
+/**
+ * \typedef test_value_t
+ *  What a key holds
+ */
+typedef struct {
+	bool present;
+	size_t length;
+	uint8_t bytes[SETTINGS_VALUE_MAX];
+} test_value_t;
+
+/**
+ * \typedef test_scenario_t
+ *  A store to start from and the write to cut short
+ */
+typedef struct {
+	const char *name;
+	void (*prepare)(void);	/* Writes the starting state from an erased store */
+	settings_key_t key;		/* Key of the write */
+	size_t length;			/* Its length, 0 for a delete */
+} test_scenario_t;
+
+static uint8_t test_snapshot[TEST_AREA];
+static test_value_t test_before[settings_key_count];
+static uint32_t test_version;
+
+status_t clocks_burst_begin(void){
+	return kStatus_Success;
+}
+
+void clocks_burst_end(void){
+}
+
+/**
+ * \fn static void test_fill
+ * \brief Make a value that differs from every other one made
+ * \param value Where to store it
+ * \param length Its length
+ * \return N/A
+ */
+static void test_fill(test_value_t *value, size_t length){
+	size_t i;
+
+	test_version++;
+	value->present = (length != 0);
+	value->length = length;
+	for(i = 0; i < length; i++){
+		value->bytes[i] = (uint8_t)((test_version * 37U) + (i * 11U));
+	}
+}
+
+/**
+ * \fn static bool test_holds
+ * \brief Compare what the store gives for a key with a value
+ * \param key The key
+ * \param value The value expected
+ * \return true if they match
+ */
+static bool test_holds(settings_key_t key, const test_value_t *value){
+	uint8_t bytes[SETTINGS_VALUE_MAX];
+	size_t length;
+	status_t status;
+
+	status = settings_read(key, bytes, sizeof(bytes), &length);
+	if(!value->present){
+		return status == kStatus_Settings_NotFound;
+	}
+
+	return (status == kStatus_Success) && (length == value->length) && (memcmp(bytes, value->bytes, length) == 0);
+}
+
+/**
+ * \fn static void test_write
+ * \brief Write a fresh value for a key and remember it as the state before
+ * \param key The key
+ * \param length Value length, 0 to delete
+ * \return N/A
+ */
+static void test_write(settings_key_t key, size_t length){
+	test_fill(&test_before[key], length);
+	CHECK_EQUAL(kStatus_Success, settings_write(key, test_before[key].bytes, length));
+}
+
+/**
+ * \fn static void test_boot
+ * \brief Reset: interrupts on, the store found again from flash
+ * \param N/A
+ * \return N/A
+ */
+static void test_boot(void){
+	fake_primask = 0;
+	CHECK_EQUAL(kStatus_Success, settings_init());
+}
+
+/**
+ * \fn static void prepare_empty
+ * \brief Nothing in the store yet
+ * \param N/A
+ * \return N/A
+ */
+static void prepare_empty(void){
+}
+
+/**
+ * \fn static void prepare_room
+ * \brief Both keys written, with room left in the active sector
+ * \param N/A
+ * \return N/A
+ */
+static void prepare_room(void){
+	test_write(settings_key_params, TEST_PARAMS_LENGTH);
+	test_write(settings_key_boot, 4);
+}
+
+/**
+ * \fn static void prepare_full
+ * \brief Both keys written, with the active sector too full for another params record, after one rotation
+ * \param N/A
+ * \return N/A
+ */
+static void prepare_full(void){
+	settings_stats_t stats;
+
+	test_write(settings_key_boot, 4);
+	do{
+		test_write(settings_key_params, TEST_PARAMS_LENGTH);
+		settings_get_stats(&stats);
+	} while(stats.sequence < 2);
+	while(stats.used + (2 * SETTINGS_RECORD_SIZE(TEST_PARAMS_LENGTH)) <= SETTINGS_SECTOR_SIZE){
+		test_write(settings_key_params, TEST_PARAMS_LENGTH);
+		settings_get_stats(&stats);
+	}
+	test_write(settings_key_params, TEST_PARAMS_LENGTH);
+}
+
+static const test_scenario_t test_scenarios[] = {
+	{"first write", prepare_empty, settings_key_params, TEST_PARAMS_LENGTH},
+	{"append", prepare_room, settings_key_params, TEST_PARAMS_LENGTH},
+	{"append delete", prepare_room, settings_key_boot, 0},
+	{"rotate", prepare_full, settings_key_params, TEST_PARAMS_LENGTH},
+	{"rotate other key", prepare_full, settings_key_boot, 4},
+	{"rotate delete", prepare_full, settings_key_params, 0}
+};
+
+/**
+ * \fn static bool test_consistent
+ * \brief Check every key holds its value from before the write, or the key written its new value
+ * \param key Key of the write
+ * \param after Its new value
+ * \return true if so
+ */
+static bool test_consistent(settings_key_t key, const test_value_t *after){
+	uint32_t k;
+	bool passed;
+
+	passed = true;
+	for(k = 0; k < settings_key_count; k++){
+		if(k == key){
+			passed &= CHECK(test_holds(k, &test_before[k]) || test_holds(k, after));
+		}
+		else{
+			passed &= CHECK(test_holds(k, &test_before[k]));
+		}
+	}
+
+	return passed;
+}
+
+/**
+ * \fn static void test_recover
+ * \brief Check the store still takes a value as it is, and keeps it over a reboot
+ * \param key Key to write
+ * \return N/A
+ */
+static void test_recover(settings_key_t key){
+	test_value_t value;
+	uint32_t k;
+
+	test_fill(&value, (key == settings_key_boot) ? 4 : TEST_PARAMS_LENGTH);
+	CHECK_EQUAL(kStatus_Success, settings_write(key, value.bytes, value.length));
+	CHECK(test_holds(key, &value));
+	test_boot();
+	CHECK(test_holds(key, &value));
+	for(k = 0; k < settings_key_count; k++){
+		if(k != key){
+			CHECK(test_holds(k, &test_before[k]));
+		}
+	}
+}
+
+/**
+ * \fn static uint32_t test_cut
+ * \brief Run the write of a scenario with one fault injected
+ * \param scenario The scenario
+ * \param step Step to fault
+ * \param fault What happens there
+ * \param tear_mask Bits a torn program does get programmed
+ * \return 1 if the fault happened, 0 if the write finished before reaching the step
+ */
+static uint32_t test_cut(const test_scenario_t *scenario, uint32_t step, fake_flash_fault_t fault,
+		uint32_t tear_mask){
+	static test_value_t after;
+	fake_flash_stats_t stats;
+	status_t status;
+
+	memcpy((void *)SETTINGS_FLASH_START, test_snapshot, TEST_AREA);
+	test_boot();
+	test_fill(&after, scenario->length);
+	fake_flash_reset();
+	fake_flash_inject(step, fault, tear_mask);
+
+	if(setjmp(fake_flash_power_loss) == 0){
+		status = settings_write(scenario->key, after.bytes, after.length);
+		fake_flash_get_stats(&stats);
+		if(!stats.fired){
+			CHECK_EQUAL(kStatus_Success, status);
+			CHECK(test_holds(scenario->key, &after));
+			CHECK_EQUAL(0, stats.overwrites);
+			CHECK_EQUAL(0, stats.unmasked);
+			return 0;
+		}
+
+		/**
+		 *  The driver failed: the store reports it and carries on without a reboot
+		 */
+		CHECK_EQUAL(kStatus_Settings_FlashError, status);
+		CHECK_EQUAL(0, fake_primask);
+		if(!test_consistent(scenario->key, &after)){
+			printf("%s: failure at step %u\n", scenario->name, step);
+		}
+	}
+	else{
+		test_boot();
+		if(!test_consistent(scenario->key, &after)){
+			printf("%s: tear at step %u (mask 0x%08x)\n", scenario->name, step, tear_mask);
+		}
+	}
+
+	/**
+	 *  Whatever survived of the write counts as the state before the recovery write
+	 */
+	if(test_holds(scenario->key, &after)){
+		test_before[scenario->key] = after;
+	}
+	test_recover(scenario->key);
+	fake_flash_get_stats(&stats);
+	CHECK_EQUAL(0, stats.overwrites);
+	CHECK_EQUAL(0, stats.unmasked);
+
+	return 1;
+}
+
+/**
+ * \fn static void test_scenario
+ * \brief Cut the write of a scenario at every step, each way
+ * \param scenario The scenario
+ * \return N/A
+ */
+static void test_scenario(const test_scenario_t *scenario){
+	static const uint32_t masks[] = {0x00000000UL, 0x0F0F0F0FUL, 0xFFFF0000UL};
+	test_value_t before[settings_key_count];
+	uint32_t steps;
+	uint32_t step;
+	uint32_t m;
+
+	fake_mcu_erase_flash();
+	memset(test_before, 0, sizeof(test_before));
+	test_boot();
+	fake_flash_reset();
+	scenario->prepare();
+	memcpy(test_snapshot, (const void *)SETTINGS_FLASH_START, TEST_AREA);
+	memcpy(before, test_before, sizeof(before));
+
+	steps = 0;
+	for(step = 1; ; step++){
+		memcpy(test_before, before, sizeof(before));
+		if(test_cut(scenario, step, fake_flash_fail, 0) == 0){
+			break;
+		}
+		for(m = 0; m < sizeof(masks) / sizeof(masks[0]); m++){
+			memcpy(test_before, before, sizeof(before));
+			(void)test_cut(scenario, step, fake_flash_tear, masks[m]);
+		}
+		steps++;
+	}
+	CHECK(steps > 0);
+}
+
+/**
+ * \fn static void test_all_scenarios
+ * \brief Every scenario, every step
+ * \param N/A
+ * \return N/A
+ */
+static void test_all_scenarios(void){
+	uint32_t i;
+
+	for(i = 0; i < sizeof(test_scenarios) / sizeof(test_scenarios[0]); i++){
+		test_scenario(&test_scenarios[i]);
+	}
+}
+
+/**
+ * \fn static void test_wear
+ * \brief Many writes rotate over every sector in turn and keep the newest values over reboots
+ * \param N/A
+ * \return N/A
+ */
+static void test_wear(void){
+	fake_flash_stats_t stats;
+	settings_stats_t settings;
+	uint32_t seen;
+	uint32_t i;
+
+	fake_mcu_erase_flash();
+	memset(test_before, 0, sizeof(test_before));
+	test_boot();
+	fake_flash_reset();
+	seen = 0;
+	for(i = 0; i < 400; i++){
+		test_write((i % 3) ? settings_key_params : settings_key_boot, (i % 3) ? TEST_PARAMS_LENGTH : 4);
+		settings_get_stats(&settings);
+		seen |= 1UL << settings.sector;
+		if((i % 50) == 0){
+			test_boot();
+		}
+	}
+	test_boot();
+	CHECK(test_holds(settings_key_params, &test_before[settings_key_params]));
+	CHECK(test_holds(settings_key_boot, &test_before[settings_key_boot]));
+	CHECK_EQUAL((1UL << SETTINGS_SECTOR_COUNT) - 1, seen);
+	fake_flash_get_stats(&stats);
+	CHECK_EQUAL(0, stats.overwrites);
+}
+
+int main(void){
+	fake_mcu_init();
+	TEST_RUN(test_all_scenarios);
+	TEST_RUN(test_wear);
+
+	return test_summary();
+}
@@ -0,0 +1,366 @@
+/**
+ * \file    test_telemetry.c
+ * \author	Dayton Flores (dafl2542@colorado.edu)
+ * \date	10/19/2026
+ * \brief   Host round-trip tests of the telemetry framing (telemetry.c): COBS and the trailing CRC-16
+ *
+ *  Frames are decoded with a COBS decoder written here from the algorithm, the way the host tool reads the stream.
+ *  telemetry_cobs_encode() is checked alone over every length up to its 254-byte block, and telemetry_encode() and
+ *  telemetry_record() by decoding their frames. serial.c is stubbed: writes are kept for the test to decode
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "fake_mcu.h"
+#include "test.h"
+#include "../Blinkenlights/source/telemetry.c"
+
+/**
+ * \def TEST_COBS_BLOCK
+ *  Most bytes telemetry_cobs_encode() takes: one code byte covers them all
+ */
+#define TEST_COBS_BLOCK\
+	(254U)
+
+/**
+ * \def TEST_PAYLOAD_SIZE
+ *  Size of a decoded frame: the record and its CRC
+ */
+#define TEST_PAYLOAD_SIZE\
+	(TELEMETRY_RECORD_SIZE + TELEMETRY_CRC_SIZE)
+
+/**
+ * \def TEST_WRITES
+ *  Frames serial_write_blocking() can keep
+ */
+#define TEST_WRITES\
+	(32U)
+
+/**
+ * \typedef test_serial_t
+ *  What the serial stubs saw
+ */
+typedef struct {
+	uint8_t frames[TEST_WRITES][TELEMETRY_FRAME_MAX];
+	size_t lengths[TEST_WRITES];
+	uint32_t writes;
+	uint32_t opens;
+} test_serial_t;
+
+static test_serial_t test_serial;
+
+status_t serial_open(serial_port_t port, const serial_config_t *config){
+	test_serial.opens++;
+
+	return kStatus_Success;
+}
+
+bool serial_is_open(serial_port_t port){
+	return test_serial.opens != 0;
+}
+
+void serial_write_blocking(serial_port_t port, const uint8_t *data, size_t length){
+	if(CHECK(length <= TELEMETRY_FRAME_MAX) && (test_serial.writes < TEST_WRITES)){
+		memcpy(test_serial.frames[test_serial.writes], data, length);
+		test_serial.lengths[test_serial.writes] = length;
+	}
+	test_serial.writes++;
+}
+
+/**
+ * \fn static bool test_cobs_decode
+ * \brief Undo COBS
+ * \param in The encoded bytes, without delimiters
+ * \param length Amount of encoded bytes
+ * \param out Where to store the decoded bytes, at least length bytes
+ * \param decoded Where to store the amount of decoded bytes
+ * \return true if in was well formed: no 0x00, and no code byte pointing past the end
+ *
+ *  A code of 0xFF is a full block, 254 bytes with no 0x00 after them
+ */
+static bool test_cobs_decode(const uint8_t *in, size_t length, uint8_t *out, size_t *decoded){
+	size_t i;
+	size_t n;
+	uint8_t code;
+	uint8_t j;
+
+	i = 0;
+	n = 0;
+	while(i < length){
+		code = in[i++];
+		if(code == 0){
+			return false;
+		}
+		for(j = 1; j < code; j++){
+			if((i >= length) || (in[i] == 0)){
+				return false;
+			}
+			out[n++] = in[i++];
+		}
+		if((code != 0xFF) && (i < length)){
+			out[n++] = 0;
+		}
+	}
+	*decoded = n;
+
+	return true;
+}
+
+/**
+ * \fn static bool test_frame_decode
+ * \brief Check a frame's delimiters, undo its COBS and check the CRC-16 after the record
+ * \param frame The frame, delimiters included
+ * \param length Length of the frame
+ * \param record Where to store the record and its CRC
+ * \return true if the frame is intact
+ */
+static bool test_frame_decode(const uint8_t *frame, size_t length, uint8_t record[TEST_PAYLOAD_SIZE]){
+	uint8_t decoded[TELEMETRY_FRAME_MAX];
+	size_t decoded_length;
+	uint16_t crc;
+
+	if((length < 2) || (frame[0] != 0) || (frame[length - 1] != 0) ||
+			!test_cobs_decode(&frame[1], length - 2, decoded, &decoded_length) ||
+			(decoded_length != TEST_PAYLOAD_SIZE)){
+		return false;
+	}
+	memcpy(record, decoded, TEST_PAYLOAD_SIZE);
+	crc = (uint16_t)(record[TELEMETRY_RECORD_SIZE] | (record[TELEMETRY_RECORD_SIZE + 1] << 8));
+
+	return crc16_buffer(record, TELEMETRY_RECORD_SIZE) == crc;
+}
+
+/**
+ * \fn static bool test_cobs_round_trip
+ * \brief Encode bytes, check the result has no 0x00 and one byte of overhead, and decode it back
+ * \param data The bytes
+ * \param length Amount of bytes, at most TEST_COBS_BLOCK
+ * \return true if all held
+ */
+static bool test_cobs_round_trip(const uint8_t *data, size_t length){
+	uint8_t encoded[TEST_COBS_BLOCK + 2];
+	uint8_t decoded[TEST_COBS_BLOCK + 2];
+	size_t encoded_length;
+	size_t decoded_length;
+
+	memset(encoded, 0x55, sizeof(encoded));
+	encoded_length = telemetry_cobs_encode(data, length, encoded);
+	if(!CHECK_EQUAL(length + 1, encoded_length) || !CHECK_EQUAL(0x55, encoded[encoded_length]) ||
+			!CHECK(memchr(encoded, 0, encoded_length) == NULL)){
+		printf("length %zu\n", length);
+		return false;
+	}
+
+	return CHECK(test_cobs_decode(encoded, encoded_length, decoded, &decoded_length)) &&
+			CHECK_EQUAL(length, decoded_length) && CHECK(memcmp(data, decoded, length) == 0);
+}
+
+/**
+ * \fn static void test_cobs_vectors
+ * \brief Known encodings: lone and adjacent zeros, zeros at either end, and a full block
+ * \param N/A
+ * \return N/A
+ */
+static void test_cobs_vectors(void){
+	static const struct {
+		uint8_t in[8];
+		size_t in_length;
+		uint8_t out[8];
+		size_t out_length;
+	} vectors[] = {
+		{{0}, 0, {0x01}, 1},
+		{{0x00}, 1, {0x01, 0x01}, 2},
+		{{0x00, 0x00}, 2, {0x01, 0x01, 0x01}, 3},
+		{{0x11, 0x22, 0x00, 0x33}, 4, {0x03, 0x11, 0x22, 0x02, 0x33}, 5},
+		{{0x11, 0x22, 0x33, 0x44}, 4, {0x05, 0x11, 0x22, 0x33, 0x44}, 5},
+		{{0x11, 0x00, 0x00, 0x00}, 4, {0x02, 0x11, 0x01, 0x01, 0x01}, 5},
+		{{0x00, 0x11}, 2, {0x01, 0x02, 0x11}, 3},
+	};
+	uint8_t block[TEST_COBS_BLOCK];
+	uint8_t encoded[TEST_COBS_BLOCK + 1];
+	size_t i;
+
+	for(i = 0; i < (sizeof(vectors) / sizeof(vectors[0])); i++){
+		if(!CHECK_EQUAL(vectors[i].out_length, telemetry_cobs_encode(vectors[i].in, vectors[i].in_length, encoded)) ||
+				!CHECK(memcmp(vectors[i].out, encoded, vectors[i].out_length) == 0)){
+			printf("vector %zu\n", i);
+		}
+	}
+
+	for(i = 0; i < TEST_COBS_BLOCK; i++){
+		block[i] = (uint8_t)(i + 1);
+	}
+	CHECK_EQUAL(TEST_COBS_BLOCK + 1, telemetry_cobs_encode(block, TEST_COBS_BLOCK, encoded));
+	CHECK_EQUAL(0xFF, encoded[0]);
+	CHECK(memcmp(block, &encoded[1], TEST_COBS_BLOCK) == 0);
+}
+
+/**
+ * \fn static void test_cobs_lengths
+ * \brief Every length up to the 254-byte block: all 0x00, no 0x00 (the longest run), 0x00 at either end or in
+ *  every position, and random bytes with many 0x00
+ * \param N/A
+ * \return N/A
+ */
+static void test_cobs_lengths(void){
+	uint8_t data[TEST_COBS_BLOCK];
+	size_t length;
+	size_t i;
+	uint32_t failed;
+
+	srand(33);
+	failed = 0;
+	for(length = 0; (length <= TEST_COBS_BLOCK) && (failed < 5); length++){
+		memset(data, 0, length);
+		failed += !test_cobs_round_trip(data, length);
+		memset(data, 0xFF, length);
+		failed += !test_cobs_round_trip(data, length);
+		for(i = 0; i < length; i++){
+			data[i] = 0;
+			failed += !test_cobs_round_trip(data, length);
+			data[i] = 0xFF;
+		}
+		for(i = 0; i < length; i++){
+			data[i] = (rand() % 4) ? (uint8_t)rand() : 0;
+		}
+		failed += !test_cobs_round_trip(data, length);
+	}
+}
+
+/**
+ * \fn static void test_frame_round_trip
+ * \brief telemetry_encode() frames decode to the record layout of telemetry.h with a matching CRC, for fields of all
+ *  0x00, all 0xFF and random
+ * \param N/A
+ * \return N/A
+ */
+static void test_frame_round_trip(void){
+	uint8_t frame[TELEMETRY_FRAME_MAX + 1];
+	uint8_t record[TEST_PAYLOAD_SIZE];
+	uint16_t sequence;
+	uint16_t value0;
+	uint16_t value1;
+	size_t length;
+	uint32_t i;
+	uint32_t failed;
+
+	srand(330);
+	failed = 0;
+	for(i = 0; (i < 10000) && (failed < 5); i++){
+		switch(i){
+		case 0:
+			sequence = 0;
+			value0 = 0;
+			value1 = 0;
+			telemetry_ticks = 0;
+			break;
+		case 1:
+			sequence = 0xFFFF;
+			value0 = 0xFFFF;
+			value1 = 0xFFFF;
+			telemetry_ticks = 0xFFFFFFFFUL;
+			break;
+		default:
+			sequence = (uint16_t)rand();
+			value0 = (rand() % 4) ? (uint16_t)rand() : 0;
+			value1 = (rand() % 4) ? (uint16_t)(rand() & 0xFF00) : 0;
+			telemetry_ticks = (uint32_t)rand() >> (rand() % 32);
+			break;
+		}
+
+		frame[TELEMETRY_FRAME_MAX] = 0x55;
+		length = telemetry_encode(telemetry_led, sequence, value0, value1, frame);
+		if(!CHECK_EQUAL(TELEMETRY_FRAME_MAX, length) || !CHECK_EQUAL(0x55, frame[TELEMETRY_FRAME_MAX]) ||
+				!CHECK(memchr(&frame[1], 0, length - 2) == NULL) ||
+				!CHECK(test_frame_decode(frame, length, record)) ||
+				!CHECK_EQUAL(telemetry_led, record[0]) || !CHECK_EQUAL(0, record[1]) ||
+				!CHECK_EQUAL(sequence, record[2] | (record[3] << 8)) ||
+				!CHECK_EQUAL(telemetry_ticks, record[4] | (record[5] << 8) | (record[6] << 16) |
+						((uint32_t)record[7] << 24)) ||
+				!CHECK_EQUAL(value0, record[8] | (record[9] << 8)) ||
+				!CHECK_EQUAL(value1, record[10] | (record[11] << 8))){
+			failed++;
+		}
+	}
+	telemetry_ticks = 0;
+}
+
+/**
+ * \fn static void test_frame_corruption
+ * \brief Every single-bit error between the delimiters makes the frame fail to decode or fail its CRC
+ * \param N/A
+ * \return N/A
+ */
+static void test_frame_corruption(void){
+	uint8_t frame[TELEMETRY_FRAME_MAX];
+	uint8_t record[TEST_PAYLOAD_SIZE];
+	size_t length;
+	size_t byte;
+	uint32_t bit;
+	uint32_t i;
+
+	srand(331);
+	for(i = 0; i < 100; i++){
+		telemetry_ticks = (uint32_t)rand();
+		length = telemetry_encode(telemetry_touch, (uint16_t)rand(), (uint16_t)rand(), (uint16_t)(rand() & 0xFF),
+				frame);
+		for(byte = 1; byte < (length - 1); byte++){
+			for(bit = 0; bit < 8; bit++){
+				frame[byte] ^= (uint8_t)(1U << bit);
+				if(!CHECK(!test_frame_decode(frame, length, record))){
+					printf("bit %u of byte %zu of frame %u\n", bit, byte, i);
+				}
+				frame[byte] ^= (uint8_t)(1U << bit);
+			}
+		}
+		CHECK(test_frame_decode(frame, length, record));
+	}
+	telemetry_ticks = 0;
+}
+
+/**
+ * \fn static void test_record_stream
+ * \brief telemetry_record() sends decodable frames with consecutive sequence numbers until the rate limit drops
+ *  some, and the numbers skip the dropped ones
+ * \param N/A
+ * \return N/A
+ */
+static void test_record_stream(void){
+	uint8_t record[TEST_PAYLOAD_SIZE];
+	uint32_t i;
+
+	memset(&test_serial, 0, sizeof(test_serial));
+	telemetry_record(telemetry_stack, 1, 2);
+	CHECK_EQUAL(0, test_serial.writes);
+
+	CHECK_EQUAL(kStatus_Success, telemetry_enable(true));
+	CHECK_EQUAL(1, test_serial.opens);
+	for(i = 0; i < (TELEMETRY_BURST + 2); i++){
+		telemetry_record(telemetry_stack, (uint16_t)i, 0);
+	}
+	telemetry_tick();
+	telemetry_record(telemetry_stack, 0xAA00, 0x00BB);
+
+	CHECK_EQUAL(TELEMETRY_BURST + 1, test_serial.writes);
+	CHECK_EQUAL(TELEMETRY_BURST + 1, telemetry_get_sent());
+	CHECK_EQUAL(2, telemetry_get_dropped());
+	for(i = 0; i < test_serial.writes; i++){
+		if(CHECK(test_frame_decode(test_serial.frames[i], test_serial.lengths[i], record))){
+			CHECK_EQUAL((i < TELEMETRY_BURST) ? i : (TELEMETRY_BURST + 2), record[2] | (record[3] << 8));
+			CHECK_EQUAL((i < TELEMETRY_BURST) ? 0 : 1, record[4]);
+		}
+	}
+	CHECK_EQUAL(0xAA00, record[8] | (record[9] << 8));
+	CHECK_EQUAL(0x00BB, record[10] | (record[11] << 8));
+	telemetry_enable(false);
+}
+
+int main(void){
+	TEST_RUN(test_cobs_vectors);
+	TEST_RUN(test_cobs_lengths);
+	TEST_RUN(test_frame_round_trip);
+	TEST_RUN(test_frame_corruption);
+	TEST_RUN(test_record_stream);
+
+	return test_summary();
+}
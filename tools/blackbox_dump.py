@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+"""
+Blinkenlights black-box log reader.
+
+Decodes the flash ring log (see Blinkenlights/source/blackbox.h) from one of:
+
+    - the board, by sending "blackbox raw" and reading the "BB" lines back
+    - a saved console capture containing those lines
+    - a binary image of the log region read out with a debugger (.bin)
+
+Records are 16 bytes, little endian:
+
+    sequence u32 | tick u32 | type u8 | code u8 | CRC-16/CCITT-FALSE u16 | value u32
+
+with the CRC over the other 14 bytes. Torn and erased slots are skipped, the
+rest are printed oldest first, one per line, or written as CSV. Gaps in the
+sequence numbers (records dropped by the RAM buffer or overwritten) are
+reported on stderr.
+
+Requires pyserial when reading from the board.
+
+    python3 tools/blackbox_dump.py --port /dev/ttyACM0
+    python3 tools/blackbox_dump.py capture.txt --csv log.csv
+    python3 tools/blackbox_dump.py blackbox.bin
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+DEFAULT_BAUD = 115200
+ERASED = 0xFFFFFFFF
+RECORD = struct.Struct("<IIBBHI")
+TYPES = {1: "reset", 2: "led", 3: "param", 4: "save", 5: "fault"}
+COLORS = ("white", "red", "green", "blue")
+POOL_FAULTS = {2: "pool_free() of a non-block", 3: "pool block freed twice", 4: "pool block overrun"}
+COLUMNS = ("sequence", "seconds", "type", "code", "value", "detail")
+
+# RCM_SRS0 and RCM_SRS1 bits, for reset records
+SRS0 = {0x80: "POR", 0x40: "PIN", 0x20: "COP", 0x08: "LVD", 0x04: "LOC", 0x02: "LOL", 0x01: "WAKEUP"}
+SRS1 = {0x20: "SACKERR", 0x08: "MDM_AP", 0x04: "SW", 0x02: "LOCKUP"}
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, same as crc16_buffer()."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def flags(value, names):
+    return "+".join(name for bit, name in names.items() if value & bit) or "-"
+
+
+def detail(kind, code, value):
+    """Human-readable meaning of a record."""
+    if kind == 1:
+        return "reset %s %s" % (flags(code, SRS0), flags(value, SRS1))
+    if kind == 2:
+        name = lambda color: COLORS[color] if color < len(COLORS) else str(color)
+        return "%s -> %s" % (name(value), name(code))
+    if kind == 3:
+        return "params word %d = %d" % (code, value)
+    if kind == 4:
+        return "save %s, settings sequence %d" % ("failed" if code else "ok", value)
+    if kind == 5 and code == 1:
+        return "stack guard written at 0x%08x" % value
+    if kind == 5 and code == 5:
+        return "hard fault at pc 0x%08x before the reset" % value
+    if kind == 5 and code in POOL_FAULTS:
+        return "%s at 0x%08x" % (POOL_FAULTS[code], value)
+    if kind == 5:
+        return "fault %d at pc 0x%08x" % (code, value)
+    return ""
+
+
+def decode(slot):
+    """Return a row in COLUMNS order, or None for an erased or torn slot."""
+    sequence, tick, kind, code, crc, value = RECORD.unpack(slot)
+    if sequence == ERASED or crc16(slot[:10] + slot[12:]) != crc:
+        return None
+    return (sequence, tick / 10.0, TYPES.get(kind, str(kind)), code, value, detail(kind, code, value))
+
+
+def slots_from_lines(lines):
+    """Turn "BB w0 w1 w2 w3" lines into 16-byte slots."""
+    for line in lines:
+        fields = line.split()
+        if len(fields) == 5 and fields[0] == "BB":
+            yield struct.pack("<4I", *(int(word, 16) for word in fields[1:]))
+
+
+def slots_from_image(data):
+    for offset in range(0, len(data) - RECORD.size + 1, RECORD.size):
+        yield data[offset:offset + RECORD.size]
+
+
+def read_board(device, baud):
+    import serial
+
+    port = serial.Serial(device, baud, timeout=2)
+    port.reset_input_buffer()
+    port.write(b"blackbox raw\r")
+    lines = []
+    while True:
+        line = port.readline().decode("ascii", errors="replace")
+        if not line:
+            raise SystemExit("no answer from %s" % device)
+        lines.append(line)
+        if line.startswith("BLACKBOX "):
+            sys.stderr.write(line)
+            return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("input", nargs="?", help="console capture or .bin image of the log region")
+    parser.add_argument("--port", help="read from the board on this serial device instead")
+    parser.add_argument("--baud", type=int, default=DEFAULT_BAUD, help="baud rate (default %(default)s)")
+    parser.add_argument("--csv", help="write CSV here instead of printing")
+    args = parser.parse_args()
+
+    if args.port:
+        slots = slots_from_lines(read_board(args.port, args.baud))
+    elif args.input and args.input.endswith(".bin"):
+        with open(args.input, "rb") as image:
+            slots = slots_from_image(image.read())
+    elif args.input:
+        with open(args.input, encoding="ascii", errors="replace") as capture:
+            slots = list(slots_from_lines(capture))
+    else:
+        parser.error("give a capture file, an image or --port")
+
+    rows = []
+    torn = 0
+    for slot in slots:
+        row = decode(slot)
+        if row is None:
+            torn += 1
+        else:
+            rows.append(row)
+    # A raw image is in slot order, not age order
+    rows.sort()
+
+    gaps = sum(1 for a, b in zip(rows, rows[1:]) if b[0] != a[0] + 1)
+    sys.stderr.write("%d records, %d empty or torn slots, %d sequence gaps\n" % (len(rows), torn, gaps))
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as out:
+            writer = csv.writer(out)
+            writer.writerow(COLUMNS)
+            writer.writerows(rows)
+    else:
+        for row in rows:
+            print("%10d %10.1f  %-6s %s" % (row[0], row[1], row[2], row[5]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,399 @@
+#!/usr/bin/env python3
+"""
+Blinkenlights serial bootloader uploader.
+
+Sends an application image (Blinkenlights.bin, linked at 0x2000, made with
+"make -C Debug bin") to the resident bootloader (see Bootloader/source/boot.h)
+over the OpenSDA virtual COM port:
+
+    HELLO, BEGIN, QUERY sectors already in flash, DATA chunks, FINISH, RUN
+
+An interrupted transfer resumes: QUERY finds the first sector that does not
+match the image and DATA continues from there. Frames with a bad CRC or no
+answer are sent again; a programming error restarts from the failed sector.
+
+To get into the bootloader, type "update" on the application's console, or
+hold the board in the bootloader by having no valid image.
+
+--simulate runs the same host logic against a model of the bootloader with
+flash and UART timing (typical KL25 datasheet figures), and reports the
+end-to-end update time with and without pipelined programming. --cut N resets
+the model while it programs DATA chunk N, then resumes.
+
+Requires pyserial when talking to the board.
+
+    python3 tools/boot_upload.py --port /dev/ttyACM0 Blinkenlights/Debug/Blinkenlights.bin
+    python3 tools/boot_upload.py --simulate Blinkenlights/Debug/Blinkenlights.bin --cut 200
+    python3 tools/boot_upload.py --simulate --size 65536
+"""
+
+import argparse
+import random
+import struct
+import sys
+import time
+import zlib
+
+DEFAULT_BAUD = 115200
+REQUEST_START = 0xA5
+RESPONSE_START = 0x5A
+SECTOR = 1024
+ERASED = 0xFFFFFFFF
+
+HELLO, BEGIN, QUERY, DATA, FINISH, RUN = range(1, 7)
+OK, BAD_FRAME, BAD_ARGUMENT, FLASH_ERROR, MISMATCH, BAD_IMAGE, NO_IMAGE = range(7)
+STATUS = ("ok", "bad frame", "bad argument", "flash error", "mismatch", "bad image", "no image")
+RETRIES = 5
+
+
+def crc32(data):
+    """CRC-32 (zlib), same as boot_crc32()."""
+    return zlib.crc32(data) & 0xFFFFFFFF
+
+
+def frame(start, kind, payload):
+    body = struct.pack("<BH", kind, len(payload)) + payload
+    return bytes([start]) + body + struct.pack("<I", crc32(body))
+
+
+class UploadError(Exception):
+    pass
+
+
+class SerialLink:
+    """Requests to the board."""
+
+    def __init__(self, device, baud):
+        import serial
+
+        self.port = serial.Serial(device, baud, timeout=1)
+        self.port.reset_input_buffer()
+
+    def transact(self, command, payload=b""):
+        self.port.write(frame(REQUEST_START, command, payload))
+        while True:
+            byte = self.port.read(1)
+            if not byte:
+                return None
+            if byte[0] == RESPONSE_START:
+                break
+        header = self.port.read(3)
+        if len(header) != 3:
+            return None
+        status, length = struct.unpack("<BH", header)
+        rest = self.port.read(length + 4)
+        if len(rest) != length + 4 or crc32(header + rest[:length]) != struct.unpack("<I", rest[length:])[0]:
+            return None
+        return status, rest[:length]
+
+    def elapsed(self, start):
+        return time.monotonic() - start
+
+    def now(self):
+        return time.monotonic()
+
+
+class SimulatedBootloader:
+    """
+    The protocol of boot.c on a model of the KL25 flash, with a clock that
+    advances by the UART byte times, host turnaround, CRC and flash command
+    times. With pipelined=False a DATA chunk is programmed before it is
+    answered, to show what the overlap saves.
+    """
+
+    BASE, LIMIT, DESCRIPTOR, CHUNK = 0x2000, 0x1E000, 0x1C00, 256
+
+    def __init__(self, baud, latency_ms, pipelined, corrupt=0.0, seed=1):
+        self.flash = bytearray(b"\xff" * 0x20000)
+        self.byte_s = 10.0 / baud
+        self.latency = latency_ms / 1000.0
+        self.pipelined = pipelined
+        self.corrupt = corrupt
+        self.random = random.Random(seed)
+        # Typical tpgm4 and tersscr, and about 25 cycles per byte for the nibble CRC at 20.97 MHz
+        self.program_s = 65e-6
+        self.erase_s = 14e-3
+        self.crc_s = 1.2e-6
+        self.clock = 0.0
+        self.busy_until = 0.0
+        self.cut_at = None
+        self.torn = False
+        self.data_count = 0
+        self.reset()
+        self.frames = 0
+        self.resends = 0
+
+    def reset(self):
+        self.size = 0
+        self.crc = 0
+        self.failed = None
+        self.busy_until = self.clock
+
+    def now(self):
+        return self.clock
+
+    def elapsed(self, start):
+        return self.clock - start
+
+    def word(self, address):
+        return struct.unpack_from("<I", self.flash, address)[0]
+
+    def erase(self, address):
+        self.flash[address:address + SECTOR] = b"\xff" * SECTOR
+        return self.erase_s
+
+    def program(self, address, data):
+        for offset in range(0, len(data), 4):
+            if self.word(address + offset) != ERASED:
+                return None
+        self.flash[address:address + len(data)] = data
+        return self.program_s * len(data) // 4
+
+    def image_valid(self, size, crc):
+        if size < 8 or size > self.LIMIT - self.BASE:
+            return False
+        sp, reset = struct.unpack_from("<II", self.flash, self.BASE)
+        if not (0x1FFFF000 < sp <= 0x20003000) or not reset & 1 or not self.BASE <= reset < self.BASE + size:
+            return False
+        return crc32(bytes(self.flash[self.BASE:self.BASE + size])) == crc
+
+    def write_descriptor(self, size, crc):
+        self.erase(self.DESCRIPTOR)
+        self.flash[self.DESCRIPTOR:self.DESCRIPTOR + 16] = struct.pack("<4I", 0x424F4F54, size, crc, ERASED)
+        return self.erase_s + 4 * self.program_s
+
+    def in_range(self, offset, length):
+        return offset <= self.LIMIT - self.BASE and length <= self.LIMIT - self.BASE - offset
+
+    def transact(self, command, payload=b""):
+        request = bytearray(frame(REQUEST_START, command, payload))
+        self.frames += 1
+        if self.random.random() < self.corrupt:
+            request[self.random.randrange(1, len(request))] ^= 0x10
+
+        # Host to board; DMA receives while the previous chunk programs, the CPU looks at it once that is done
+        arrived = self.clock + self.latency / 2 + len(request) * self.byte_s
+        start = max(arrived, self.busy_until)
+        work = self.crc_s * (len(request) - 5)
+        deferred = 0.0
+
+        body = bytes(request[1:-4])
+        if crc32(body) != struct.unpack("<I", request[-4:])[0]:
+            status, answer = BAD_FRAME, b""
+            start += 50e-3
+        elif self.failed is not None:
+            status, answer = FLASH_ERROR, struct.pack("<I", self.failed)
+            self.failed = None
+        else:
+            status, answer, work_more, deferred = self.handle(command, payload)
+            work += work_more
+
+        reply = len(answer) + 8
+        replied = start + work + reply * self.byte_s
+        self.busy_until = replied + deferred
+        self.clock = replied + self.latency / 2
+        if self.torn:
+            self.torn = False
+            raise ConnectionResetError("board reset while programming chunk %d" % self.data_count)
+        return status, answer
+
+    def handle(self, command, payload):
+        """Return status, answer payload, time before the answer, time after it."""
+        if command == HELLO:
+            return OK, struct.pack("<HHII", 1, self.CHUNK, self.BASE, self.LIMIT), 0.0, 0.0
+
+        if command == BEGIN:
+            size, crc = struct.unpack("<II", payload)
+            if size == 0 or size % 4 or not self.in_range(0, size):
+                return BAD_ARGUMENT, b"", 0.0, 0.0
+            self.size, self.crc = size, crc
+            if self.word(self.DESCRIPTOR) != ERASED:
+                return OK, b"", self.erase(self.DESCRIPTOR), 0.0
+            return OK, b"", 0.0, 0.0
+
+        if command == QUERY:
+            offset, length, crc = struct.unpack("<IHI", payload)
+            if not self.in_range(offset, length):
+                return BAD_ARGUMENT, b"", 0.0, 0.0
+            data = bytes(self.flash[self.BASE + offset:self.BASE + offset + length])
+            return (OK if crc32(data) == crc else MISMATCH), b"", self.crc_s * length, 0.0
+
+        if command == DATA:
+            offset = struct.unpack_from("<I", payload)[0]
+            data = payload[4:]
+            if len(data) == 0 or len(data) % 4 or offset % self.CHUNK or not self.in_range(offset, len(data)):
+                return BAD_ARGUMENT, b"", 0.0, 0.0
+            self.data_count += 1
+            spent = self.store(offset, data)
+            if self.pipelined:
+                return OK, b"", 0.0, spent
+            return OK, b"", spent, 0.0
+
+        if command == FINISH:
+            check = self.crc_s * self.size
+            if not self.size or not self.image_valid(self.size, self.crc):
+                return BAD_IMAGE, b"", check, 0.0
+            return OK, b"", check + self.write_descriptor(self.size, self.crc), 0.0
+
+        if command == RUN:
+            size, crc = struct.unpack_from("<II", self.flash, self.DESCRIPTOR + 4)
+            if self.word(self.DESCRIPTOR) != 0x424F4F54 or not self.image_valid(size, crc):
+                return NO_IMAGE, b"", 0.0, 0.0
+            return OK, b"", self.crc_s * size, 0.0
+
+        return BAD_ARGUMENT, b"", 0.0, 0.0
+
+    def store(self, offset, data):
+        address = self.BASE + offset
+        spent = 0.0
+        if offset % SECTOR == 0:
+            spent += self.erase(address)
+        if self.cut_at is not None and self.data_count == self.cut_at:
+            # Torn: only the first half of the chunk made it
+            data = data[:len(data) // 2]
+            self.cut_at = None
+            self.torn = True
+        programmed = self.program(address, data)
+        if programmed is None:
+            self.failed = offset
+            return spent
+        return spent + programmed
+
+
+def request(link, command, payload=b"", accept=(OK,)):
+    """Send until there is an answer with a good CRC that is not BAD_FRAME."""
+    for _ in range(RETRIES):
+        answer = link.transact(command, payload)
+        if answer is None or answer[0] == BAD_FRAME:
+            if hasattr(link, "resends"):
+                link.resends += 1
+            continue
+        status, data = answer
+        if status not in accept and status != FLASH_ERROR:
+            raise UploadError("command %d: %s" % (command, STATUS[status] if status < len(STATUS) else status))
+        return status, data
+    raise UploadError("command %d: no answer after %d tries" % (command, RETRIES))
+
+
+def first_mismatch(link, image):
+    """Offset of the first sector of image that is not in flash yet."""
+    for offset in range(0, len(image), SECTOR):
+        part = image[offset:offset + SECTOR]
+        status, _ = request(link, QUERY, struct.pack("<IHI", offset, len(part), crc32(part)), (OK, MISMATCH))
+        if status != OK:
+            return offset
+    return len(image)
+
+
+def upload(link, image, resume=True, run=True, log=lambda text: None):
+    """Carry out a whole update. Returns the offset the transfer started from."""
+    _, hello = request(link, HELLO)
+    version, chunk, base, limit = struct.unpack("<HHII", hello)
+    if len(image) > limit - base:
+        raise UploadError("image is %d bytes, the bootloader takes %d" % (len(image), limit - base))
+    log("bootloader version %d, chunk %d, application 0x%05x-0x%05x" % (version, chunk, base, limit))
+
+    request(link, BEGIN, struct.pack("<II", len(image), crc32(image)))
+    offset = first_mismatch(link, image) if resume else 0
+    started = offset
+    if offset:
+        log("resuming at 0x%05x" % offset)
+
+    restarts = 0
+    while True:
+        while offset < len(image):
+            status, data = request(link, DATA, struct.pack("<I", offset) + image[offset:offset + chunk])
+            if status == FLASH_ERROR:
+                # That chunk was fine, the error is about an earlier one
+                restarts += 1
+                if restarts > RETRIES:
+                    raise UploadError("flash keeps failing at 0x%05x" % struct.unpack("<I", data)[0])
+                offset = struct.unpack("<I", data)[0] // SECTOR * SECTOR
+                log("programming failed, again from 0x%05x" % offset)
+                continue
+            offset += chunk
+
+        status, data = request(link, FINISH, accept=(OK,))
+        if status == OK:
+            break
+        restarts += 1
+        if restarts > RETRIES:
+            raise UploadError("finish keeps failing")
+        offset = struct.unpack("<I", data)[0] // SECTOR * SECTOR
+
+    if run:
+        request(link, RUN)
+    return started
+
+
+def load_image(path, size, seed):
+    if path:
+        with open(path, "rb") as binary:
+            image = binary.read()
+    else:
+        # Random body behind a plausible vector table
+        generator = random.Random(seed)
+        image = struct.pack("<II", 0x20003000, 0x20C1) + bytes(generator.randrange(256) for _ in range(size - 8))
+    return image + b"\xff" * (-len(image) % 4)
+
+
+def simulate(image, args):
+    print("image %d bytes, %d baud, %.1f ms host turnaround" % (len(image), args.baud, args.latency))
+    for pipelined in (False, True):
+        device = SimulatedBootloader(args.baud, args.latency, pipelined, args.corrupt)
+        # Something else in flash already, so every sector has to be erased
+        device.flash[device.BASE:device.BASE + len(image)] = bytes(b ^ 0x5A for b in image)
+        start = device.now()
+        if args.cut is not None:
+            device.cut_at = args.cut
+            try:
+                upload(device, image, run=False)
+            except ConnectionResetError as reset:
+                print("  %s at %.2f s" % (reset, device.elapsed(start)))
+            device.clock += 0.5
+            device.reset()
+        resumed = upload(device, image)
+        total = device.elapsed(start)
+        ok = device.image_valid(len(image), crc32(image)) and device.flash[device.BASE:device.BASE + len(image)] == image
+        print("%-14s %7.2f s  %6.1f KB/s  %d frames, %d resent%s  %s" % (
+            "pipelined" if pipelined else "not pipelined", total, len(image) / 1024.0 / total, device.frames,
+            device.resends, ", resumed at 0x%05x" % resumed if resumed else "", "verified" if ok else "WRONG"))
+        if not ok:
+            sys.exit(1)
+    line = len(image) / (args.baud / 10.0)
+    print("UART alone would take %.2f s" % line)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("image", nargs="?", help="raw application image linked at 0x2000")
+    parser.add_argument("--port", help="serial device of the board")
+    parser.add_argument("--baud", type=int, default=DEFAULT_BAUD, help="baud rate (default %(default)s)")
+    parser.add_argument("--full", action="store_true", help="send everything instead of resuming")
+    parser.add_argument("--no-run", action="store_true", help="stay in the bootloader afterwards")
+    parser.add_argument("--simulate", action="store_true", help="measure against a model of the board")
+    parser.add_argument("--size", type=int, default=48 * 1024, help="random image size when simulating without one")
+    parser.add_argument("--latency", type=float, default=1.0, help="simulated host turnaround in ms (default 1)")
+    parser.add_argument("--corrupt", type=float, default=0.0, help="simulated fraction of requests damaged")
+    parser.add_argument("--cut", type=int, help="simulate a reset while DATA chunk N programs, then resume")
+    args = parser.parse_args()
+
+    if args.simulate:
+        simulate(load_image(args.image, args.size, 1), args)
+        return
+    if not args.port or not args.image:
+        parser.error("give --port and an image, or --simulate")
+
+    image = load_image(args.image, 0, 0)
+    link = SerialLink(args.port, args.baud)
+    start = link.now()
+    try:
+        upload(link, image, not args.full, not args.no_run, lambda text: sys.stderr.write(text + "\n"))
+    except UploadError as error:
+        raise SystemExit("update failed: %s" % error)
+    total = link.elapsed(start)
+    print("%d bytes in %.2f s, %.1f KB/s" % (len(image), total, len(image) / 1024.0 / total))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""
+Blinkenlights console terminal.
+
+Prints everything the board sends and follows the firmware's baud rate
+handshake (see console_set_baud() in Blinkenlights/source/console.h):
+
+    board: "BAUD <rate>\\r\\n" at the old rate
+    host:  switch the port to <rate>, send 'U'
+    board: "BAUD OK\\r\\n" at the new rate
+
+Lines typed on stdin are forwarded to the board.
+
+Requires pyserial.
+
+    python3 tools/console.py /dev/ttyACM0
+"""
+
+import argparse
+import re
+import sys
+import threading
+import time
+
+import serial
+
+DEFAULT_BAUD = 115200
+SYNC_CHAR = b"U"
+BAUD_LINE = re.compile(rb"^BAUD (\d+)\r?$")
+
+
+def follow(port, line):
+    """Switch the host side if line is a baud announcement."""
+    match = BAUD_LINE.match(line)
+    if not match:
+        return
+    rate = int(match.group(1))
+    # The firmware drains its shifter before switching, so the announcement
+    # has fully arrived; give it a moment to reprogram the divisors.
+    time.sleep(0.01)
+    port.baudrate = rate
+    port.reset_input_buffer()
+    port.write(SYNC_CHAR)
+    sys.stderr.write("[switched to %d baud]\n" % rate)
+
+
+def reader(port):
+    line = b""
+    while True:
+        data = port.read(port.in_waiting or 1)
+        if not data:
+            continue
+        sys.stdout.write(data.decode("ascii", errors="replace"))
+        sys.stdout.flush()
+        for byte in data:
+            line += bytes([byte])
+            if byte == ord("\n"):
+                follow(port, line.rstrip(b"\n"))
+                line = b""
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("port", help="serial device, e.g. /dev/ttyACM0")
+    parser.add_argument("--baud", type=int, default=DEFAULT_BAUD,
+                        help="initial baud rate (default %(default)s)")
+    args = parser.parse_args()
+
+    port = serial.Serial(args.port, args.baud, timeout=0.1)
+    threading.Thread(target=reader, args=(port,), daemon=True).start()
+    try:
+        for text in sys.stdin:
+            port.write(text.rstrip("\n").encode("ascii") + b"\r")
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
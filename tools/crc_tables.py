@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""
+Generate the CRC lookup tables in Blinkenlights/source/crc.c.
+
+    CRC-32              reflected, polynomial 0xEDB88320 (IEEE 802.3)
+    CRC-16/CCITT-FALSE  not reflected, polynomial 0x1021
+
+For each CRC this prints the 256-entry byte tables used by CRC_SLICE4
+(table 0 is also the CRC_BYTEWISE table) and the 16-entry CRC_NIBBLE table.
+
+    python3 tools/crc_tables.py > /tmp/tables.c
+"""
+
+CRC32_POLY = 0xEDB88320
+CRC16_POLY = 0x1021
+
+
+def crc32_entry(value, bits):
+    for _ in range(bits):
+        value = (value >> 1) ^ CRC32_POLY if value & 1 else value >> 1
+    return value
+
+
+def crc16_entry(value, bits):
+    value <<= 16 - bits
+    for _ in range(bits):
+        value = ((value << 1) ^ CRC16_POLY) if value & 0x8000 else (value << 1)
+        value &= 0xFFFF
+    return value
+
+
+def crc32_slices():
+    tables = [[crc32_entry(i, 8) for i in range(256)]]
+    for _ in range(3):
+        prev = tables[-1]
+        tables.append([(v >> 8) ^ tables[0][v & 0xFF] for v in prev])
+    return tables
+
+
+def crc16_slices():
+    tables = [[crc16_entry(i, 8) for i in range(256)]]
+    for _ in range(3):
+        prev = tables[-1]
+        tables.append([((v << 8) & 0xFFFF) ^ tables[0][v >> 8] for v in prev])
+    return tables
+
+
+def emit(name, ctype, values, digits, per_line):
+    print("static const %s %s = {" % (ctype, name))
+    for i in range(0, len(values), per_line):
+        row = ", ".join("0x%0*X" % (digits, v) for v in values[i:i + per_line])
+        print("\t%s%s" % (row, "," if i + per_line < len(values) else ""))
+    print("};")
+
+
+def emit_slices(name, ctype, tables, digits, per_line):
+    print("static const %s %s[CRC_TABLE_SLICES][256] = {" % (ctype, name))
+    for t, values in enumerate(tables):
+        if t == 1:
+            print("#if (CRC_IMPLEMENTATION == CRC_SLICE4)")
+        print("\t{")
+        for i in range(0, len(values), per_line):
+            row = ", ".join("0x%0*X" % (digits, v) for v in values[i:i + per_line])
+            print("\t\t%s%s" % (row, "," if i + per_line < len(values) else ""))
+        print("\t},")
+    print("#endif")
+    print("};")
+
+
+def main():
+    emit_slices("crc32_table", "uint32_t", crc32_slices(), 8, 6)
+    print()
+    emit_slices("crc16_table", "uint16_t", crc16_slices(), 4, 8)
+    print()
+    emit("crc32_nibble_table[16]", "uint32_t", [crc32_entry(i, 4) for i in range(16)], 8, 4)
+    print()
+    emit("crc16_nibble_table[16]", "uint16_t", [crc16_entry(i, 4) for i in range(16)], 4, 8)
+
+
+if __name__ == "__main__":
+    main()
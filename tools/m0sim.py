@@ -0,0 +1,645 @@
+#!/usr/bin/env python3
+"""
+Count Cortex-M0+ cycles of small Blinkenlights routines in an instruction-level model.
+
+The model executes the ARMv6-M Thumb instruction set (16-bit instructions and BL)
+with the Cortex-M0+ timings: 1 cycle per instruction, 2 for loads, stores and
+taken branches, 1+N for LDM/STM/PUSH/POP, 3+N for POP into PC, 3 for BL. Every
+access to flash (addresses below 0x20000 - the KL25 has 128K) adds --flash-wait
+cycles: the core fetches 32 bits at a time, and a fetch that misses the small
+flash controller cache pays the wait, as does every data access to flash. SRAM
+is zero wait state. Peripheral accesses add one cycle for the bus clock, at half
+the core clock, and read back what was last written, except for the status bits
+in PERIPHERAL_SET that read as set so wait loops fall through, and the hardware
+fields in PERIPHERAL_READ_ONLY that writes leave alone.
+
+The routines are machine code assembled from the listings below (llvm-mc
+--triple=thumbv6m-none-eabi), as GCC compiles them at -O0, the level both build
+configurations use:
+    startup  data_init()/bss_init() before and after the LDM/STM rewrite. The
+             "old" ones are the word loops of the MCUXpresso startup file
+    hotpath  the RAMFUNC functions (source/sections.h) run from flash and from
+             SRAM. The touch scan and LED update is the GET_TOUCH() and
+             GET_LED_COLOR() code of Debug/source/led.o
+    printf   the digit loop of DbgConsole_ConvertRadixNumToString() before and
+             after PRINTF_FAST_RADIX_ENABLE (utilities/fsl_debug_console.c).
+             These listings are written by hand, not taken from GCC, with the
+             same register use on both sides so only the arithmetic differs;
+             the "old" loop calls a shift-and-subtract divide standing in for
+             the library's __aeabi_uidivmod
+
+    python3 tools/m0sim.py startup
+    python3 tools/m0sim.py --flash-wait 1 --cache 0 startup --sizes 64 1024 8192
+    python3 tools/m0sim.py hotpath
+    python3 tools/m0sim.py printf
+"""
+
+import argparse
+
+FLASH_BASE = 0x00000000
+FLASH_SIZE = 128 * 1024
+SRAM_BASE = 0x1FFFF000
+SRAM_SIZE = 16 * 1024
+PERIPHERAL_BASE = 0x40000000
+PERIPHERAL_SIZE = 0x100000
+PERIPHERAL_WAIT = 1
+RETURN = 0xFFFFFFF0
+
+# ResetISR runs before main() sets up the clocks, on the FEI reset clock
+RESET_CORE_HZ = 20971520
+RUN_CORE_HZ = 48000000
+
+# Where the routines are placed: .after_vectors is right after the vector table
+CODE_FLASH = 0x2100
+COPY_SRC = 0x10000
+COPY_DST = 0x20000000
+
+# .ramfunc follows the 512-byte .noinit window at the bottom of SRAM
+CODE_SRAM = 0x1FFFF200
+
+TSI0_GENCS = 0x40045000
+TSI0_DATA = 0x40045004
+TSI0_GENCS_EOSF = 0x4
+LPTMR0_CSR = 0x40040000
+TOUCH_OFFSET = 700
+
+# Digit buffer of the printf conversion
+DIGITS = 0x20000300
+
+# Addresses the hot path listings load from their literal pools
+SCANNED_VALUE = 0x20000100
+POWER_EXPIRED = 0x20000104
+COBS_IN = 0x20000200
+COBS_OUT = 0x20000240
+
+PERIPHERAL_SET = {TSI0_GENCS: TSI0_GENCS_EOSF}
+PERIPHERAL_READ_ONLY = {TSI0_DATA: 0xFFFF}
+
+ROUTINES = {
+    # data_init() before: word loop at -O0
+    #   push {r7, lr}; sub sp, #32; add r7, sp, #0
+    #   str r0, [r7, #12]; str r1, [r7, #8]; str r2, [r7, #4]
+    #   ldr r3, [r7, #8]; str r3, [r7, #28]; ldr r3, [r7, #12]; str r3, [r7, #24]
+    #   movs r3, #0; str r3, [r7, #20]; b 2f
+    # 1: ldr r2, [r7, #24]; adds r3, r2, #4; str r3, [r7, #24]
+    #   ldr r3, [r7, #28]; adds r1, r3, #4; str r1, [r7, #28]
+    #   ldr r2, [r2]; str r2, [r3]
+    #   ldr r3, [r7, #20]; adds r3, #4; str r3, [r7, #20]
+    # 2: ldr r2, [r7, #20]; ldr r3, [r7, #4]; cmp r2, r3; bcc 1b
+    #   nop; mov sp, r7; add sp, #32; pop {r7, pc}
+    "data_init_old": "80b588b000aff860b9607a60bb68fb61fb68bb6100237b610ae0ba69131dbb61fb69191df96112681a607b69"
+                     "04337b617a697b689a42f0d300bfbd4608b080bd",
+    # data_init() after: startup/startup_mkl25z4.c
+    "data_init_new": "f0b517093f01cf198a1801e078c878c1b942fbd101e008c808c19142fbd1f0bd",
+    # bss_init() before: word loop at -O0
+    #   push {r7, lr}; sub sp, #16; add r7, sp, #0
+    #   str r0, [r7, #4]; str r1, [r7]; ldr r3, [r7, #4]; str r3, [r7, #12]
+    #   movs r3, #0; str r3, [r7, #8]; b 2f
+    # 1: ldr r3, [r7, #12]; adds r2, r3, #4; str r2, [r7, #12]
+    #   movs r2, #0; str r2, [r3]
+    #   ldr r3, [r7, #8]; adds r3, #4; str r3, [r7, #8]
+    # 2: ldr r2, [r7, #8]; ldr r3, [r7]; cmp r2, r3; bcc 1b
+    #   nop; mov sp, r7; add sp, #16; pop {r7, pc}
+    "bss_init_old": "80b584b000af786039607b68fb600023bb6007e0fb681a1dfa6000221a60bb680433bb60ba683b689a42f3d3"
+                    "00bfbd4604b080bd",
+    # bss_init() after: startup/startup_mkl25z4.c
+    "bss_init_new": "f0b50f093f01c7194118002300240025002600e078c0b842fcd100e008c08842fcd1f0bd",
+    # update_led_color(), led.c: GET_TOUCH() and GET_LED_COLOR() with LED_OFF()/LED_ON(), taken from blink_sequence()
+    # in Debug/source/led.o (push {r7, lr}; sub sp, #40; add r7, sp, #0 / mov sp, r7; add sp, #40; pop {r7, pc}
+    # around it, the locals onboard_led at [r7, #39] and onboard_led_prev at [r7, #3], both white), the literal pool:
+    #   .word TSI0, -TOUCH_OFFSET, SCANNED_VALUE, PTB, PTD
+    # The touch thresholds were still constants when that object was built; params.c makes them three more loads
+    "touch_led": "80b58ab000af2723fb1800221a70fb1c00221a70624ba02212065a60604b5a685f4b8021c9030a435a60c0465c4b1b6804221340"
+                 "fad05a4b5b681b041b0c594a9a18594b1a60564b1a68554b04210a431a60fb1c27217a1812781a70524b1b68632b04d87b18"
+                 "fa1c12781a7019e04e4b1a68fa235b009a4204d22723fb1801221a700ee0484b1a68fa23db009a4204d22723fb1802221a70"
+                 "03e02723fb1803221a702723fa18fb1c12781b789a4200d171e0fb1c1b78032b2dd032dc022b22d02fdc002b02d0012b15d0"
+                 "2ae0374b5a68364b8021c9020a435a60344b5a68334b802109030a435a60314b5a68304b02210a435a6015e02d4b5a682c4b"
+                 "8021c9020a435a600de0294b5a68284b802109030a435a6005e0264b5a68254b02210a435a60c0462723fb181b78032b2dd0"
+                 "32dc022b22d02fdc002b02d0012b15d02ae01a4b9a68194b8021c9020a439a60174b9a68164b802109030a439a60144b9a68"
+                 "134b02210a439a6015e0104b9a680f4b8021c9020a439a600de00c4b9a680b4b802109030a439a6005e0094b9a68084b0221"
+                 "0a439a60c046bd460ab080bdc0460050044044fdffff0001002040f00f40c0f00f40",
+    # LPTMR0_IRQHandler(), power.c
+    #   push {r7, lr}; add r7, sp, #0
+    #   ldr r3, =LPTMR0; ldr r2, [r3]; ldr r3, =LPTMR0; movs r1, #128; orrs r2, r1; str r2, [r3]
+    #   ldr r3, =POWER_EXPIRED; movs r2, #1; strb r2, [r3]
+    #   nop; mov sp, r7; pop {r7, pc}
+    "lptmr_isr": "80b500af054b1a68044b80210a431a60034b01221a70c046bd4680bd0000044004010020",
+    # telemetry_cobs_encode(), telemetry.c
+    #   push {r7, lr}; sub sp, #24; add r7, sp, #0
+    #   str r0, [r7, #12]; str r1, [r7, #8]; str r2, [r7, #4]
+    #   ldr r3, [r7, #4]; str r3, [r7, #20]; ldr r3, [r7, #4]; adds r3, r3, #1; str r3, [r7, #16]
+    #   ldr r3, [r7, #20]; movs r2, #1; strb r2, [r3]; b 4f
+    # 1: ldr r3, [r7, #12]; ldrb r3, [r3]; cmp r3, #0; bne 2f
+    #   ldr r3, [r7, #16]; adds r2, r3, #1; str r2, [r7, #16]; str r3, [r7, #20]
+    #   ldr r3, [r7, #20]; movs r2, #1; strb r2, [r3]; b 3f
+    # 2: ldr r3, [r7, #16]; adds r2, r3, #1; str r2, [r7, #16]; ldr r2, [r7, #12]; ldrb r2, [r2]; strb r2, [r3]
+    #   ldr r3, [r7, #20]; ldrb r3, [r3]; adds r3, r3, #1; uxtb r2, r3; ldr r3, [r7, #20]; strb r2, [r3]
+    # 3: ldr r3, [r7, #12]; adds r3, r3, #1; str r3, [r7, #12]
+    # 4: ldr r3, [r7, #8]; subs r2, r3, #1; str r2, [r7, #8]; cmp r3, #0; bne 1b
+    #   ldr r2, [r7, #16]; ldr r3, [r7, #4]; subs r3, r2, r3; movs r0, r3
+    #   mov sp, r7; add sp, #24; pop {r7, pc}
+    "cobs_encode": "80b586b000aff860b9607a607b687b617b685b1c3b617b6901221a701ae0fb681b78002b07d13b695a1c3a617b617b6901221a70"
+                   "0be03b695a1c3a61fa6812781a707b691b785b1cdab27b691a70fb685b1cfb60bb685a1eba60002bdfd13a697b68d31a1800"
+                   "bd4606b080bd",
+    # Digit loop before PRINTF_FAST_RADIX_ENABLE: a division per digit. r0 = digit buffer, r1 = value, r2 = radix;
+    # returns the amount of digits, stored least significant first
+    #   push {r4, r5, r6, r7, lr}; movs r4, r0; movs r5, r1; movs r6, r2; movs r7, #0
+    # 1: movs r0, r5; movs r1, r6; bl udivmod
+    #   cmp r1, #10; bcc 2f; adds r1, #39
+    # 2: adds r1, #48; strb r1, [r4]; adds r4, #1; adds r7, #1; movs r5, r0; bne 1b
+    #   movs r0, r7; pop {r4, r5, r6, r7, pc}
+    # udivmod: r0 / r1, quotient in r0 and remainder in r1, one quotient bit per pass
+    #   movs r2, #0; movs r3, #1; push {r4, lr}; lsrs r4, r0, #1
+    # 3: cmp r1, r4; bhi 4f; lsls r1, r1, #1; lsls r3, r3, #1; b 3b
+    # 4: cmp r0, r1; bcc 5f; subs r0, r0, r1; orrs r2, r3
+    # 5: lsrs r1, r1, #1; lsrs r3, r3, #1; bne 4b
+    #   movs r1, r0; movs r0, r2; pop {r4, pc}
+    "radix_old": "f0b504000d00160000272800310000f00bf80a2900d3273130312170013401370500f2d13800f0bd0022012310b54408"
+                 "a14202d849005b00fae7884201d3401a1a4349085b08f8d10100100010bd",
+    # Radix 10 digit loop after: DbgConsole_DivideBy10(). r0 = digit buffer, r1 = value
+    #   push {r4, r5, r6, lr}; movs r4, r0; movs r5, r1; movs r6, #0
+    # 1: movs r0, r5; bl div10
+    #   adds r1, #48; strb r1, [r4]; adds r4, #1; adds r6, #1; movs r5, r0; bne 1b
+    #   movs r0, r6; pop {r4, r5, r6, pc}
+    # div10:
+    #   lsrs r1, r0, #1; lsrs r2, r0, #2; adds r1, r1, r2
+    #   lsrs r2, r1, #4; adds r1, r1, r2; lsrs r2, r1, #8; adds r1, r1, r2; lsrs r2, r1, #16; adds r1, r1, r2
+    #   lsrs r1, r1, #3; lsls r2, r1, #2; adds r2, r2, r1; lsls r2, r2, #1; subs r2, r0, r2
+    #   cmp r2, #9; bls 2f; adds r1, #1; subs r2, #10
+    # 2: movs r0, r1; movs r1, r2; bx lr
+    "radix10_new": "70b504000d000026280000f008f830312170013401360500f6d1300070bd4108820889180a0989180a0a89180a0c8918"
+                   "c9088a0052185200821a092a01d901310a3a080011007047",
+    # Power of two digit loop after: DbgConsole_RadixShift(). r0 = digit buffer, r1 = value, r2 = bits per digit
+    #   push {r4, r5, lr}; movs r3, #1; lsls r3, r2; subs r3, #1; movs r4, #0
+    # 1: movs r5, r1; ands r5, r3; lsrs r1, r2; cmp r5, #10; bcc 2f; adds r5, #39
+    # 2: adds r5, #48; strb r5, [r0]; adds r0, #1; adds r4, #1; cmp r1, #0; bne 1b
+    #   movs r0, r4; pop {r4, r5, pc}
+    "radix_shift_new": "30b501239340013b00240d001d40d1400a2d00d3273530350570013001340029f3d1200030bd",
+}
+
+
+class Fault(Exception):
+    pass
+
+
+class Cpu:
+    """ARMv6-M core with Cortex-M0+ timing and a flash wait state model"""
+
+    def __init__(self, flash_wait, cache):
+        self.flash = bytearray(b"\xff" * FLASH_SIZE)
+        self.sram = bytearray(SRAM_SIZE)
+        self.peripherals = {}
+        self.flash_wait = flash_wait
+        self.cache_size = cache
+        self.cache = []
+        self.r = [0] * 16
+        self.n = self.z = self.c = self.v = False
+        self.cycles = 0
+        self.fetched = None
+
+    # Memory
+
+    def region(self, address, size):
+        if FLASH_BASE <= address and address + size <= FLASH_BASE + FLASH_SIZE:
+            return self.flash, address - FLASH_BASE, True
+        if SRAM_BASE <= address and address + size <= SRAM_BASE + SRAM_SIZE:
+            return self.sram, address - SRAM_BASE, False
+        raise Fault("bus fault at 0x%08X" % address)
+
+    def load(self, address, size, signed=False):
+        if address % size:
+            raise Fault("unaligned access at 0x%08X" % address)
+        if PERIPHERAL_BASE <= address < PERIPHERAL_BASE + PERIPHERAL_SIZE:
+            self.cycles += PERIPHERAL_WAIT
+            value = self.peripherals.get(address, 0) | PERIPHERAL_SET.get(address, 0)
+            return value & ((1 << (8 * size)) - 1)
+        mem, offset, flash = self.region(address, size)
+        if flash:
+            self.cycles += self.flash_wait
+        return int.from_bytes(mem[offset:offset + size], "little", signed=signed) & 0xFFFFFFFF
+
+    def store(self, address, size, value):
+        if address % size:
+            raise Fault("unaligned access at 0x%08X" % address)
+        if PERIPHERAL_BASE <= address < PERIPHERAL_BASE + PERIPHERAL_SIZE:
+            self.cycles += PERIPHERAL_WAIT
+            read_only = PERIPHERAL_READ_ONLY.get(address, 0)
+            value = (value & ((1 << (8 * size)) - 1) & ~read_only) | (self.peripherals.get(address, 0) & read_only)
+            self.peripherals[address] = value
+            return
+        mem, offset, flash = self.region(address, size)
+        if flash:
+            raise Fault("store to flash at 0x%08X" % address)
+        mem[offset:offset + size] = (value & ((1 << (8 * size)) - 1)).to_bytes(size, "little")
+
+    def write(self, address, data):
+        mem, offset, _ = self.region(address, len(data))
+        mem[offset:offset + len(data)] = data
+
+    def read(self, address, length):
+        mem, offset, _ = self.region(address, length)
+        return bytes(mem[offset:offset + length])
+
+    def fetch(self, address):
+        """Read an instruction halfword, charging a 32-bit fetch when the word changes"""
+        word = address & ~3
+        mem, offset, flash = self.region(address, 2)
+        if word != self.fetched:
+            self.fetched = word
+            if flash:
+                if word in self.cache:
+                    self.cache.remove(word)
+                else:
+                    self.cycles += self.flash_wait
+                if self.cache_size:
+                    self.cache.append(word)
+                    del self.cache[:-self.cache_size]
+        return int.from_bytes(mem[offset:offset + 2], "little")
+
+    # Flags
+
+    def nz(self, value):
+        value &= 0xFFFFFFFF
+        self.n = bool(value >> 31)
+        self.z = value == 0
+        return value
+
+    def add(self, a, b, carry=0):
+        total = a + b + carry
+        result = total & 0xFFFFFFFF
+        self.c = total > 0xFFFFFFFF
+        self.v = bool(~(a ^ b) & (a ^ result) & 0x80000000)
+        return self.nz(result)
+
+    def condition(self, cond):
+        return [self.z, not self.z, self.c, not self.c, self.n, not self.n, self.v, not self.v,
+                self.c and not self.z, not self.c or self.z, self.n == self.v, self.n != self.v,
+                not self.z and self.n == self.v, self.z or self.n != self.v, True][cond]
+
+    # Execution
+
+    def branch(self, target):
+        self.r[15] = target & ~1
+        self.fetched = None
+
+    def step(self):
+        pc = self.r[15]
+        hw = self.fetch(pc)
+        self.r[15] = pc + 2
+        r = self.r
+        cycles = 1
+        top5 = hw >> 11
+
+        if top5 <= 2:
+            op, imm, rm, rd = top5, (hw >> 6) & 31, (hw >> 3) & 7, hw & 7
+            value = r[rm]
+            if op == 0:
+                if imm:
+                    self.c = bool((value >> (32 - imm)) & 1)
+                r[rd] = self.nz(value << imm)
+            else:
+                imm = imm or 32
+                self.c = bool((value >> (imm - 1)) & 1)
+                if op == 2 and value >> 31:
+                    value |= ~0xFFFFFFFF
+                r[rd] = self.nz(value >> imm)
+        elif top5 == 3:
+            operand = (hw >> 6) & 7 if hw & 0x400 else r[(hw >> 6) & 7]
+            rn, rd = (hw >> 3) & 7, hw & 7
+            if hw & 0x200:
+                r[rd] = self.add(r[rn], ~operand & 0xFFFFFFFF, 1)
+            else:
+                r[rd] = self.add(r[rn], operand)
+        elif top5 <= 7:
+            op, rdn, imm = top5 & 3, (hw >> 8) & 7, hw & 0xFF
+            if op == 0:
+                r[rdn] = self.nz(imm)
+            elif op == 1:
+                self.add(r[rdn], ~imm & 0xFFFFFFFF, 1)
+            elif op == 2:
+                r[rdn] = self.add(r[rdn], imm)
+            else:
+                r[rdn] = self.add(r[rdn], ~imm & 0xFFFFFFFF, 1)
+        elif hw >> 10 == 0x10:
+            cycles = self.alu((hw >> 6) & 15, (hw >> 3) & 7, hw & 7)
+        elif hw >> 10 == 0x11:
+            op, rm = (hw >> 8) & 3, (hw >> 3) & 15
+            rdn = ((hw >> 4) & 8) | (hw & 7)
+            value = (pc + 4) if rm == 15 else r[rm]
+            if op == 0:
+                if rdn == 15:
+                    self.branch(r[15] + 2 + value)
+                    cycles = 2
+                else:
+                    r[rdn] = (r[rdn] + value) & 0xFFFFFFFF
+            elif op == 1:
+                self.add(r[rdn], ~value & 0xFFFFFFFF, 1)
+            elif op == 2:
+                if rdn == 15:
+                    self.branch(value)
+                    cycles = 2
+                else:
+                    r[rdn] = value
+            else:
+                if hw & 0x80:
+                    r[14] = (pc + 2) | 1
+                self.branch(value)
+                cycles = 2
+        elif top5 == 9:
+            address = ((pc + 4) & ~3) + (hw & 0xFF) * 4
+            r[(hw >> 8) & 7] = self.load(address, 4)
+            cycles = 2
+        elif hw >> 12 == 5:
+            op, rm, rn, rt = (hw >> 9) & 7, (hw >> 6) & 7, (hw >> 3) & 7, hw & 7
+            address = (r[rn] + r[rm]) & 0xFFFFFFFF
+            size = [4, 2, 1, 1, 4, 2, 1, 2][op]
+            if op < 3:
+                self.store(address, size, r[rt])
+            else:
+                r[rt] = self.load(address, size, signed=op in (3, 7))
+            cycles = 2
+        elif hw >> 13 == 3 or hw >> 12 == 8:
+            load, rn, rt, imm = (hw >> 11) & 1, (hw >> 3) & 7, hw & 7, (hw >> 6) & 31
+            size = 2 if hw >> 12 == 8 else (1 if hw & 0x1000 else 4)
+            address = (r[rn] + imm * size) & 0xFFFFFFFF
+            if load:
+                r[rt] = self.load(address, size)
+            else:
+                self.store(address, size, r[rt])
+            cycles = 2
+        elif hw >> 12 == 9:
+            address = r[13] + (hw & 0xFF) * 4
+            rt = (hw >> 8) & 7
+            if hw & 0x800:
+                r[rt] = self.load(address, 4)
+            else:
+                self.store(address, 4, r[rt])
+            cycles = 2
+        elif hw >> 12 == 0xA:
+            base = r[13] if hw & 0x800 else (pc + 4) & ~3
+            r[(hw >> 8) & 7] = (base + (hw & 0xFF) * 4) & 0xFFFFFFFF
+        elif hw >> 12 == 0xB:
+            cycles = self.misc(hw)
+        elif hw >> 12 == 0xC:
+            rn, regs = (hw >> 8) & 7, [i for i in range(8) if hw & (1 << i)]
+            address = r[rn]
+            for i in regs:
+                if hw & 0x800:
+                    r[i] = self.load(address, 4)
+                else:
+                    self.store(address, 4, r[i])
+                address += 4
+            if not (hw & 0x800 and rn in regs):
+                r[rn] = address
+            cycles = 1 + len(regs)
+        elif hw >> 12 == 0xD:
+            cond = (hw >> 8) & 15
+            if cond >= 14:
+                raise Fault("undefined or SVC 0x%04X at 0x%08X" % (hw, pc))
+            if self.condition(cond):
+                offset = (hw & 0xFF) - (0x100 if hw & 0x80 else 0)
+                self.branch(pc + 4 + offset * 2)
+                cycles = 2
+        elif top5 == 0x1C:
+            offset = (hw & 0x7FF) - (0x800 if hw & 0x400 else 0)
+            self.branch(pc + 4 + offset * 2)
+            cycles = 2
+        elif top5 == 0x1E:
+            low = self.fetch(pc + 2)
+            s = (hw >> 10) & 1
+            j1, j2 = (low >> 13) & 1, (low >> 11) & 1
+            i1, i2 = 1 - (j1 ^ s), 1 - (j2 ^ s)
+            offset = (s << 24) | (i1 << 23) | (i2 << 22) | ((hw & 0x3FF) << 12) | ((low & 0x7FF) << 1)
+            if s:
+                offset -= 1 << 25
+            r[14] = (pc + 4) | 1
+            self.branch(pc + 4 + offset)
+            cycles = 3
+        else:
+            raise Fault("unsupported instruction 0x%04X at 0x%08X" % (hw, pc))
+
+        self.cycles += cycles
+
+    def alu(self, op, rm, rdn):
+        r = self.r
+        a, b = r[rdn], r[rm]
+        if op in (2, 3, 4, 7):
+            shift = b & 0xFF
+            if shift:
+                if op == 2:
+                    self.c = shift <= 32 and bool((a >> (32 - shift)) & 1)
+                    a = a << shift if shift < 32 else 0
+                elif op == 3:
+                    self.c = shift <= 32 and bool((a >> (shift - 1)) & 1)
+                    a = a >> shift if shift < 32 else 0
+                elif op == 4:
+                    signed = a - (1 << 32) if a >> 31 else a
+                    a = (signed >> min(shift, 32)) & 0xFFFFFFFF
+                    self.c = bool(a >> 31) if shift >= 32 else bool((signed >> (shift - 1)) & 1)
+                else:
+                    shift %= 32
+                    a = ((a >> shift) | (a << (32 - shift))) & 0xFFFFFFFF if shift else a
+                    self.c = bool(a >> 31)
+            r[rdn] = self.nz(a)
+        elif op == 0:
+            r[rdn] = self.nz(a & b)
+        elif op == 1:
+            r[rdn] = self.nz(a ^ b)
+        elif op == 5:
+            r[rdn] = self.add(a, b, int(self.c))
+        elif op == 6:
+            r[rdn] = self.add(a, ~b & 0xFFFFFFFF, int(self.c))
+        elif op == 8:
+            self.nz(a & b)
+        elif op == 9:
+            r[rdn] = self.add(0, ~b & 0xFFFFFFFF, 1)
+        elif op == 10:
+            self.add(a, ~b & 0xFFFFFFFF, 1)
+        elif op == 11:
+            self.add(a, b)
+        elif op == 12:
+            r[rdn] = self.nz(a | b)
+        elif op == 13:
+            r[rdn] = self.nz(a * b)
+        elif op == 14:
+            r[rdn] = self.nz(a & ~b)
+        else:
+            r[rdn] = self.nz(~b)
+        return 1
+
+    def misc(self, hw):
+        r = self.r
+        if hw & 0xFF00 == 0xB000:
+            imm = (hw & 0x7F) * 4
+            r[13] = (r[13] - imm if hw & 0x80 else r[13] + imm) & 0xFFFFFFFF
+            return 1
+        if hw & 0xFF00 == 0xB200:
+            op, value = (hw >> 6) & 3, r[(hw >> 3) & 7]
+            value = [value & 0xFFFF, value & 0xFF, value & 0xFFFF, value & 0xFF][op]
+            if op == 0 and value & 0x8000:
+                value |= 0xFFFF0000
+            if op == 1 and value & 0x80:
+                value |= 0xFFFFFF00
+            r[hw & 7] = value
+            return 1
+        if hw & 0xFE00 == 0xB400:
+            regs = [i for i in range(8) if hw & (1 << i)] + ([14] if hw & 0x100 else [])
+            address = r[13] - 4 * len(regs)
+            r[13] = address
+            for i in regs:
+                self.store(address, 4, r[i])
+                address += 4
+            return 1 + len(regs)
+        if hw & 0xFE00 == 0xBC00:
+            regs = [i for i in range(8) if hw & (1 << i)]
+            address = r[13]
+            for i in regs:
+                r[i] = self.load(address, 4)
+                address += 4
+            if hw & 0x100:
+                target = self.load(address, 4)
+                r[13] = address + 4
+                self.branch(target)
+                return 3 + len(regs) + 1
+            r[13] = address
+            return 1 + len(regs)
+        if hw & 0xFF00 == 0xBA00:
+            op, value = (hw >> 6) & 3, r[(hw >> 3) & 7]
+            b = value.to_bytes(4, "little")
+            if op == 0:
+                value = int.from_bytes(b, "big")
+            elif op == 1:
+                value = int.from_bytes(b[1::-1] + b[3:1:-1], "little")
+            else:
+                value = int.from_bytes(b[1::-1], "little")
+                if value & 0x8000:
+                    value |= 0xFFFF0000
+            r[hw & 7] = value
+            return 1
+        if hw & 0xFF00 == 0xBF00 or hw & 0xFFEF == 0xB662:
+            return 1
+        raise Fault("unsupported instruction 0x%04X at 0x%08X" % (hw, r[15] - 2))
+
+    def call(self, address, args, limit=10000000):
+        """Run a routine from address until it returns; return the cycles it took"""
+        self.r = [0] * 16
+        self.r[:len(args)] = args
+        self.r[13] = SRAM_BASE + SRAM_SIZE
+        self.r[14] = RETURN | 1
+        self.branch(address)
+        self.cycles = 0
+        steps = 0
+        while self.r[15] != RETURN:
+            self.step()
+            steps += 1
+            if steps > limit:
+                raise Fault("routine did not return")
+        return self.cycles
+
+
+def bench_startup(args):
+    print("Section init at %.2f MHz, %d flash wait state(s), %d-word fetch cache"
+          % (RESET_CORE_HZ / 1e6, args.flash_wait, args.cache))
+    print("%-14s %8s %10s %12s %10s" % ("routine", "bytes", "cycles", "cycles/word", "usec"))
+    for size in args.sizes:
+        size &= ~3
+        pattern = bytes((i * 7 + 3) & 0xFF for i in range(size))
+        for name in ("data_init_old", "data_init_new", "bss_init_old", "bss_init_new"):
+            cpu = Cpu(args.flash_wait, args.cache)
+            cpu.write(CODE_FLASH, bytes.fromhex(ROUTINES[name]))
+            cpu.write(COPY_SRC, pattern)
+            cpu.write(COPY_DST, b"\xaa" * (size + 4))
+            if name.startswith("data"):
+                cycles = cpu.call(CODE_FLASH, [COPY_SRC, COPY_DST, size])
+                expected = pattern
+            else:
+                cycles = cpu.call(CODE_FLASH, [COPY_DST, size])
+                expected = bytes(size)
+            if cpu.read(COPY_DST, size) != expected or cpu.read(COPY_DST + size, 4) != b"\xaa" * 4:
+                raise SystemExit("%s produced the wrong contents for %d bytes" % (name, size))
+            print("%-14s %8d %10d %12.2f %10.1f" % (name, size, cycles, cycles / max(size // 4, 1),
+                                                      cycles * 1e6 / RESET_CORE_HZ))
+
+
+def bench_hotpath(args):
+    record = bytes([1, 0, 0x34, 0x12, 0x10, 0x27, 0, 0, 0xC8, 0, 0x2C, 1, 0x5A, 0xA5])
+    cases = [
+        ("touch_led", "untouched", {TSI0_DATA: TOUCH_OFFSET + 50}, []),
+        ("touch_led", "new color", {TSI0_DATA: TOUCH_OFFSET + 300}, []),
+        ("lptmr_isr", "tick", {}, []),
+        ("cobs_encode", "%d-byte record" % len(record), {}, [COBS_IN, len(record), COBS_OUT]),
+    ]
+    print("RAMFUNC hot paths at %d MHz, %d flash wait state(s), %d-word fetch cache"
+          % (RUN_CORE_HZ // 1000000, args.flash_wait, args.cache))
+    print("%-12s %-16s %6s %8s %8s %7s" % ("routine", "case", "bytes", "flash", "sram", "saved"))
+    for name, case, peripherals, call_args in cases:
+        cycles = []
+        for address in (CODE_FLASH, CODE_SRAM):
+            cpu = Cpu(args.flash_wait, args.cache)
+            cpu.write(address, bytes.fromhex(ROUTINES[name]))
+            cpu.write(COBS_IN, record)
+            cpu.peripherals.update(peripherals)
+            cycles.append(cpu.call(address, call_args))
+            if name == "cobs_encode" and b"\x00" in cpu.read(COBS_OUT, cpu.r[0]):
+                raise SystemExit("cobs_encode left a 0x00 in its output")
+            if name == "touch_led" and cpu.load(SCANNED_VALUE, 4) != peripherals[TSI0_DATA] - TOUCH_OFFSET:
+                raise SystemExit("touch_led stored the wrong scanned value")
+        print("%-12s %-16s %6d %8d %8d %6.0f%%" % (name, case, len(ROUTINES[name]) // 2, cycles[0], cycles[1],
+                                                   100.0 * (cycles[0] - cycles[1]) / cycles[0]))
+
+
+def bench_printf(args):
+    cases = [
+        ("%u", 10, 7),
+        ("%u", 10, 12345),
+        ("%u", 10, 4294967295),
+        ("%x", 16, 0xBEEF),
+        ("%x", 16, 0xDEADBEEF),
+        ("%o", 8, 0o17777777777),
+    ]
+    print("printf number conversion at %d MHz, %d flash wait state(s), %d-word fetch cache"
+          % (RUN_CORE_HZ // 1000000, args.flash_wait, args.cache))
+    print("%-6s %-12s %6s %8s %8s %8s" % ("format", "value", "digits", "old", "new", "saved"))
+    for spec, radix, value in cases:
+        digits = ""
+        while True:
+            digits = "0123456789abcdef"[value // radix ** len(digits) % radix] + digits
+            if radix ** len(digits) > value:
+                break
+        cycles = []
+        for name, call_args in (("radix_old", [DIGITS, value, radix]),
+                                ("radix10_new", [DIGITS, value]) if radix == 10 else
+                                ("radix_shift_new", [DIGITS, value, radix.bit_length() - 1])):
+            cpu = Cpu(args.flash_wait, args.cache)
+            cpu.write(CODE_FLASH, bytes.fromhex(ROUTINES[name]))
+            cycles.append(cpu.call(CODE_FLASH, call_args))
+            if cpu.r[0] != len(digits) or cpu.read(DIGITS, len(digits))[::-1] != digits.encode():
+                raise SystemExit("%s converted %d to the wrong digits" % (name, value))
+        print("%-6s %-12s %6d %8d %8d %7.0f%%" % (spec, ("%" + spec[1]) % value, len(digits), cycles[0], cycles[1],
+                                                 100.0 * (cycles[0] - cycles[1]) / cycles[0]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--flash-wait", type=int, default=1,
+                        help="wait states per flash access (default 1: flash clock at half the core clock)")
+    parser.add_argument("--cache", type=int, default=16,
+                        help="32-bit flash words the fetch cache keeps, 0 for none (default 16)")
+    commands = parser.add_subparsers(dest="command", required=True)
+    startup = commands.add_parser("startup", help="data_init()/bss_init() before and after the LDM/STM rewrite")
+    startup.add_argument("--sizes", type=int, nargs="+", default=[64, 1024, 4100],
+                         help="section sizes in bytes (default 64 1024 4100)")
+    commands.add_parser("hotpath", help="the RAMFUNC hot paths from flash and from SRAM")
+    commands.add_parser("printf", help="the printf number conversion with a division per digit and without")
+    args = parser.parse_args()
+
+    if args.command == "startup":
+        bench_startup(args)
+    elif args.command == "hotpath":
+        bench_hotpath(args)
+    elif args.command == "printf":
+        bench_printf(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""
+Blinkenlights MTB branch trace decoder.
+
+Turns the "MTB source destination" lines the shell prints (see
+Blinkenlights/source/trace.h) into an execution history, oldest branch first,
+from one of:
+
+    - the board, by sending "trace dump" (or "fault" with --fault) and reading
+      the lines back
+    - a saved console capture containing those lines
+
+Each packet is one taken branch. Bit 0 of the source is set when the branch
+was an exception entry or return, bit 0 of the destination on the first packet
+after tracing started. The code between two packets ran straight through: from
+one packet's destination to the next packet's source. Addresses are named from
+the symbols of the image (--axf), as function+offset, and with --lines as
+file:line too.
+
+Requires pyserial when reading from the board, and binutils for the target.
+
+    python3 tools/mtb_decode.py --port /dev/ttyACM0 --axf Blinkenlights/Debug/Blinkenlights.axf
+    python3 tools/mtb_decode.py capture.txt --axf Blinkenlights/Debug/Blinkenlights.axf --lines
+"""
+
+import argparse
+import bisect
+import re
+import subprocess
+import sys
+
+DEFAULT_BAUD = 115200
+DEFAULT_NM = "arm-none-eabi-nm"
+DEFAULT_ADDR2LINE = "arm-none-eabi-addr2line"
+
+PACKET = re.compile(r"^MTB ([0-9a-fA-F]{8}) ([0-9a-fA-F]{8})\s*$")
+NM_LINE = re.compile(r"^([0-9a-fA-F]+)\s+([0-9a-fA-F]+)\s+[tTwW]\s+(\S+)$")
+END = ("TRACE DUMP ", "FAULT TRACE ", "NO FAULT RECORDED")
+
+
+def packets_from_lines(lines):
+    """Turn "MTB source destination" lines into (source, destination) pairs."""
+    for line in lines:
+        match = PACKET.match(line.strip())
+        if match:
+            yield int(match.group(1), 16), int(match.group(2), 16)
+
+
+def read_board(device, baud, command):
+    import serial
+
+    port = serial.Serial(device, baud, timeout=2)
+    port.reset_input_buffer()
+    port.write(command.encode("ascii") + b"\r")
+    lines = []
+    while True:
+        line = port.readline().decode("ascii", errors="replace")
+        if not line:
+            raise SystemExit("no answer from %s" % device)
+        lines.append(line)
+        if line.startswith(END):
+            sys.stderr.write(line)
+            return lines
+
+
+class Symbols:
+    """Function symbols of the image, for address -> function+offset."""
+
+    def __init__(self, nm, axf):
+        try:
+            text = subprocess.run([nm, "-S", "--defined-only", axf], check=True, stdout=subprocess.PIPE,
+                                  universal_newlines=True).stdout
+        except (OSError, subprocess.CalledProcessError) as error:
+            raise SystemExit("%s: %s" % (nm, error))
+        functions = set()
+        for line in text.splitlines():
+            match = NM_LINE.match(line)
+            if match and int(match.group(2), 16):
+                # Thumb function symbols carry bit 0
+                functions.add((int(match.group(1), 16) & ~1, int(match.group(2), 16), match.group(3)))
+        self.functions = sorted(functions)
+        self.starts = [start for start, _, _ in self.functions]
+
+    def name(self, address):
+        i = bisect.bisect_right(self.starts, address) - 1
+        if i >= 0:
+            start, size, name = self.functions[i]
+            if address < start + size:
+                return "%s+0x%x" % (name, address - start) if address != start else name
+        return "?"
+
+
+def read_lines(addr2line, axf, addresses):
+    """file:line of each address, from one addr2line run."""
+    if not addresses:
+        return {}
+    try:
+        text = subprocess.run([addr2line, "-e", axf] + ["0x%x" % address for address in addresses], check=True,
+                              stdout=subprocess.PIPE, universal_newlines=True).stdout
+    except (OSError, subprocess.CalledProcessError) as error:
+        raise SystemExit("%s: %s" % (addr2line, error))
+    return {address: line.rsplit("/", 1)[-1] for address, line in zip(addresses, text.splitlines())}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("input", nargs="?", help="console capture with MTB lines")
+    parser.add_argument("--port", help="read from the board on this serial device instead")
+    parser.add_argument("--baud", type=int, default=DEFAULT_BAUD, help="baud rate (default %(default)s)")
+    parser.add_argument("--fault", action="store_true", help="with --port, read the trace saved by the last HardFault")
+    parser.add_argument("--axf", help="the image that ran, to name the addresses")
+    parser.add_argument("--nm", default=DEFAULT_NM, help="nm to read the image with (default %(default)s)")
+    parser.add_argument("--lines", action="store_true", help="add file:line from addr2line")
+    parser.add_argument("--addr2line", default=DEFAULT_ADDR2LINE, help="addr2line to use (default %(default)s)")
+    args = parser.parse_args()
+
+    if args.port:
+        packets = list(packets_from_lines(read_board(args.port, args.baud, "fault" if args.fault else "trace dump")))
+    elif args.input:
+        with open(args.input, encoding="ascii", errors="replace") as capture:
+            packets = list(packets_from_lines(capture))
+    else:
+        parser.error("give a capture file or --port")
+    if not packets:
+        raise SystemExit("no MTB lines found")
+
+    symbols = Symbols(args.nm, args.axf) if args.axf else None
+    addresses = sorted({address & ~1 for packet in packets for address in packet})
+    lines = read_lines(args.addr2line, args.axf, addresses) if (args.lines and args.axf) else {}
+
+    def where(address):
+        address &= ~1
+        text = "0x%08x" % address
+        if symbols:
+            text += " %s" % symbols.name(address)
+        if address in lines:
+            text += " (%s)" % lines[address]
+        return text
+
+    for i, (source, destination) in enumerate(packets):
+        notes = []
+        if destination & 1:
+            notes.append("trace start")
+        if source & 1:
+            notes.append("exception")
+        print("%4d  %s -> %s%s" % (i, where(source), where(destination), "  [%s]" % ", ".join(notes) if notes else ""))
+    sys.stderr.write("%d branches, oldest first\n" % len(packets))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,292 @@
+#!/usr/bin/env python3
+"""
+Flash and RAM used per module of a Blinkenlights build, from the linker map, checked against a baseline.
+
+Every input section the map lists is charged to the module it came from
+(source/led, drivers/fsl_uart, libcr_c.a, ...) as text (flash only: code and
+constants), data (initialized: its image in flash plus its copy in SRAM, .ramfunc
+included) or bss (SRAM only, .noinit included). Alignment fill goes to (fill),
+the section table ResetISR walks to (linker), and the heap and stack reservations
+of the linker script to (heap+stack).
+
+With -flto the map only shows the LTO partitions (*.ltrans*.o) as input files.
+Their sections are charged through the debug information instead: --axf runs
+nm -S -l on the image, and each symbol inside such a section is charged to its
+source file. Padding, and symbols without line information, stay under (lto).
+
+With --baseline the totals are compared to a report saved with --write-baseline,
+and the check fails (exit status 1) when flash or RAM grew by more than
+--threshold bytes. Modules that grew by more than that are marked. Until a
+baseline has been saved there is nothing to compare with: the check then warns
+that it did not run, on stderr, and passes, so a fresh tree still builds.
+
+    python3 tools/size_report.py Blinkenlights/Production/Blinkenlights.map --axf Blinkenlights/Production/Blinkenlights.axf
+    python3 tools/size_report.py Blinkenlights.map --axf Blinkenlights.axf --write-baseline ../size_baseline_Production.txt
+    python3 tools/size_report.py Blinkenlights.map --axf Blinkenlights.axf --baseline ../size_baseline_Production.txt
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+
+DEFAULT_THRESHOLD = 256
+DEFAULT_NM = "arm-none-eabi-nm"
+SOURCE_DIRS = ("source", "drivers", "board", "utilities", "startup", "CMSIS")
+KINDS = ("text", "data", "bss")
+
+# Output sections that take no memory on the target
+NOT_LOADED = re.compile(r"^\.(debug|comment|ARM\.attributes|stab|gnu\.attributes)")
+
+# The reservations of the linker script, filled but owned by no object
+RESERVED = (".heap", ".heap2stackfill", ".stack")
+
+MEMORY = re.compile(r"^(\S+)\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s*(\S*)$")
+OUTPUT = re.compile(r"^(\.\S+)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)(?:\s+load address (0x[0-9a-fA-F]+))?)?\s*$")
+INPUT = re.compile(r"^ (\S+)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)(?:\s+(.+))?)?$")
+CONTINUED = re.compile(r"^\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(.+)$")
+NM_LINE = re.compile(r"^([0-9a-fA-F]+)\s+([0-9a-fA-F]+)\s+\S\s+(\S+)\t(.+):\d+$")
+
+
+def module_of_path(path):
+    """source/led from ./source/led.o, C:\\...\\Blinkenlights\\source\\led.c or libcr_c.a from libcr_c.a(memcpy.o)"""
+    path = path.strip().replace("\\", "/")
+    library = re.search(r"([^/]+\.a)\(", path)
+    if library:
+        return library.group(1)
+    parts = path.split("/")
+    for i in range(len(parts) - 1, -1, -1):
+        if parts[i] in SOURCE_DIRS and i + 1 < len(parts):
+            return "/".join(parts[i:]).rsplit(".", 1)[0]
+    return parts[-1]
+
+
+def read_memory(lines):
+    """Memory regions from the Memory Configuration table: name -> (origin, length, attributes)"""
+    regions = {}
+    inside = False
+    for line in lines:
+        if line.startswith("Memory Configuration"):
+            inside = True
+        elif line.startswith("Linker script and memory map"):
+            break
+        elif inside:
+            match = MEMORY.match(line.strip())
+            if match and match.group(1) not in ("Name", "*default*"):
+                regions[match.group(1)] = (int(match.group(2), 16), int(match.group(3), 16), match.group(4))
+    return regions
+
+
+def read_sections(lines):
+    """Input sections of the memory map: (output section, kind, address, size, input file or a (name))"""
+    sections = []
+    output = None
+    kind = None
+    pending = None
+    inside = False
+    for line in lines:
+        if line.startswith("Linker script and memory map"):
+            inside = True
+            continue
+        if not inside or not line.strip():
+            continue
+        if not line.startswith(" "):
+            match = OUTPUT.match(line.rstrip())
+            if match:
+                output = match.group(1)
+                kind = "data" if match.group(4) else None
+                # A long name puts the address on the next line, like an input section's
+                pending = ("output", output) if match.group(2) is None else None
+                if match.group(2) is not None:
+                    sections.append((output, kind, int(match.group(2), 16), 0, None))
+            continue
+        if pending and pending[0] == "output":
+            match = CONTINUED.match(line)
+            pending = None
+            if match:
+                kind = "data" if "load address" in match.group(3) else None
+                sections.append((output, kind, int(match.group(1), 16), 0, None))
+                continue
+        match = INPUT.match(line.rstrip())
+        if match and match.group(1) == "*fill*" and match.group(2):
+            owner = "(heap+stack)" if output in RESERVED else "(fill)"
+            sections.append((output, kind, int(match.group(2), 16), int(match.group(3), 16), owner))
+            continue
+        if match and match.group(2):
+            if not match.group(1).startswith("*") and match.group(4):
+                sections.append((output, kind, int(match.group(2), 16), int(match.group(3), 16), match.group(4)))
+            continue
+        if match and not match.group(1).startswith("*") and match.group(1).startswith("."):
+            pending = ("input", match.group(1))
+            continue
+        match = CONTINUED.match(line)
+        if not match:
+            continue
+        if pending and pending[0] == "input":
+            sections.append((output, kind, int(match.group(1), 16), int(match.group(2), 16), match.group(3)))
+            pending = None
+        elif re.match(r"(LONG|SHORT|BYTE|QUAD) ", match.group(3)):
+            sections.append((output, kind, int(match.group(1), 16), int(match.group(2), 16), "(linker)"))
+    return sections
+
+
+def read_symbols(nm, axf):
+    """Symbols with a size and line information: sorted (address, size, module)"""
+    try:
+        text = subprocess.run([nm, "-S", "-l", "--defined-only", axf], check=True, stdout=subprocess.PIPE,
+                              universal_newlines=True).stdout
+    except (OSError, subprocess.CalledProcessError) as error:
+        raise SystemExit("%s: %s" % (nm, error))
+    symbols = set()
+    for line in text.splitlines():
+        match = NM_LINE.match(line)
+        if match and int(match.group(2), 16):
+            symbols.add((int(match.group(1), 16) & ~1, int(match.group(2), 16), module_of_path(match.group(4))))
+    return sorted(symbols)
+
+
+def split_lto(symbols, address, size):
+    """Bytes of an LTO partition's section per source module"""
+    shares = {}
+    end = address + size
+    for start, length, module in symbols:
+        if start >= end:
+            break
+        if start >= address:
+            length = min(length, end - start)
+            shares[module] = shares.get(module, 0) + length
+            size -= length
+    if size > 0:
+        shares["(lto)"] = shares.get("(lto)", 0) + size
+    return shares
+
+
+def region_of(regions, address):
+    for name, (origin, length, _) in regions.items():
+        if origin <= address < origin + length:
+            return name
+    return None
+
+
+def tally(sections, regions, symbols):
+    """Bytes per module and kind, and the flash and RAM used"""
+    modules = {}
+    flash = 0
+    ram = 0
+    output_region = {}
+    for output, kind, address, size, owner in sections:
+        if NOT_LOADED.match(output):
+            continue
+        if owner is None:
+            output_region[output] = region_of(regions, address)
+            continue
+        region = output_region.get(output) or region_of(regions, address)
+        if region is None or size == 0:
+            continue
+        kind = kind or ("bss" if "w" in regions[region][2] else "text")
+        if owner.startswith("("):
+            shares = {owner: size}
+        elif ".ltrans" in owner:
+            shares = split_lto(symbols, address, size)
+        else:
+            shares = {module_of_path(owner): size}
+        for module, share in shares.items():
+            modules.setdefault(module, dict.fromkeys(KINDS, 0))[kind] += share
+        flash += size if kind != "bss" else 0
+        ram += size if kind != "text" else 0
+    return modules, flash, ram
+
+
+def read_baseline(path):
+    baseline = {}
+    with open(path) as f:
+        for line in f:
+            fields = line.split()
+            if fields and not line.startswith("#"):
+                baseline[fields[0]] = dict(zip(KINDS, map(int, fields[1:4])))
+    return baseline
+
+
+def write_baseline(path, source, modules):
+    with open(path, "w") as f:
+        f.write("# Size baseline from %s: module text data bss (bytes). Written by tools/size_report.py\n" % source)
+        for module in sorted(modules):
+            f.write("%s %d %d %d\n" % ((module,) + tuple(modules[module][kind] for kind in KINDS)))
+
+
+def footprint(sizes):
+    """Flash and RAM of one module or of the totals"""
+    return sizes["text"] + sizes["data"], sizes["data"] + sizes["bss"]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("map", help="linker map, e.g. Blinkenlights/Production/Blinkenlights.map")
+    parser.add_argument("--axf", help="the linked image, to charge LTO partitions to their source files")
+    parser.add_argument("--nm", default=DEFAULT_NM, help="nm to read the image with (default %s)" % DEFAULT_NM)
+    parser.add_argument("--baseline", help="report to compare with; a missing file is warned about and skipped")
+    parser.add_argument("--write-baseline", metavar="FILE", help="save this report as the new baseline")
+    parser.add_argument("--threshold", type=int, default=DEFAULT_THRESHOLD,
+                        help="bytes flash or RAM may grow before the check fails (default %d)" % DEFAULT_THRESHOLD)
+    args = parser.parse_args()
+
+    with open(args.map, errors="replace") as f:
+        lines = f.read().splitlines()
+    regions = read_memory(lines)
+    symbols = read_symbols(args.nm, args.axf) if args.axf else []
+    modules, flash, ram = tally(read_sections(lines), regions, symbols)
+    if not modules:
+        raise SystemExit("%s: no sections found" % args.map)
+
+    baseline = None
+    missing = False
+    if args.baseline:
+        try:
+            baseline = read_baseline(args.baseline)
+        except FileNotFoundError:
+            missing = True
+
+    empty = dict.fromkeys(KINDS, 0)
+    totals = {kind: sum(sizes[kind] for sizes in modules.values()) for kind in KINDS}
+    print("Size report for %s" % args.map)
+    print("%-28s %7s %7s %7s %8s %8s" % ("module", "text", "data", "bss", "d.flash", "d.ram"))
+    status = 0
+    for module in sorted(set(modules) | set(baseline or {})):
+        sizes = modules.get(module, empty)
+        line = "%-28s %7d %7d %7d" % ((module,) + tuple(sizes[kind] for kind in KINDS))
+        if baseline is not None:
+            now, before = footprint(sizes), footprint(baseline.get(module, empty))
+            deltas = (now[0] - before[0], now[1] - before[1])
+            line += " %+8d %+8d" % deltas
+            if max(deltas) > args.threshold:
+                line += "  grew"
+        print(line)
+    print("%-28s %7d %7d %7d" % (("total",) + tuple(totals[kind] for kind in KINDS)))
+
+    for name, used, writable in (("Flash", flash, False), ("RAM", ram, True)):
+        size = sum(length for _, length, attributes in regions.values() if ("w" in attributes) == writable)
+        print("%-5s %6d of %6d bytes (%4.1f%%), %d left" % (name, used, size, 100.0 * used / max(size, 1),
+                                                           size - used))
+
+    if baseline is not None:
+        before = [sum(footprint(sizes)[i] for sizes in baseline.values()) for i in (0, 1)]
+        now = [sum(footprint(sizes)[i] for sizes in modules.values()) for i in (0, 1)]
+        for name, b, n in (("Flash", before[0], now[0]), ("RAM", before[1], now[1])):
+            print("%-5s %+d bytes against the baseline" % (name, n - b))
+            if n - b > args.threshold:
+                print("%s grew by %d bytes, over the %d byte threshold" % (name, n - b, args.threshold),
+                      file=sys.stderr)
+                status = 1
+
+    if missing:
+        print("warning: no baseline %s, size not checked; save one with --write-baseline (make size-baseline)"
+              % args.baseline, file=sys.stderr)
+
+    if args.write_baseline:
+        write_baseline(args.write_baseline, args.map, modules)
+        print("Baseline written to %s" % args.write_baseline)
+    sys.exit(status)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,315 @@
+#!/usr/bin/env python3
+"""
+Worst-case stack depth of a Blinkenlights build from the compiler's stack usage and call graph.
+
+Reads the .su (-fstack-usage) and .ci (-fcallgraph-info=su) files GCC writes
+next to every object of a build configuration. The .su files give the frame of
+each function, the .ci files who calls whom. The deepest call chain is worked
+out for each entry point: ResetISR (and main() through it) and every exception
+handler. Interrupts stack on top of main: a handler can only be preempted by one
+of a higher priority, so the worst case is main, plus the deepest handler of
+each priority level, plus a 32-byte exception frame and 4 bytes of alignment for
+each level. The IRQs run at priority 0, as nothing calls NVIC_SetPriority();
+HardFault and NMI preempt them.
+
+What the compiler cannot see is filled in from the tables below: the targets of
+function pointers, and the frames of naked and hand-written functions. A call
+to a function with no .su entry (a C library routine) is charged --unknown bytes
+and listed.
+
+Fails (exit status 1) when the worst case is over the budget: --budget bytes,
+or the _StackSize the linker script reserves. Also fails on recursion or on a
+frame the compiler reports as unbounded.
+
+    python3 tools/stack_report.py Blinkenlights/Debug
+    python3 tools/stack_report.py Blinkenlights/Debug --ld Blinkenlights/Debug/Blinkenlights_Debug.ld
+    python3 tools/stack_report.py Blinkenlights/Debug --budget 768 --priority UART0_IRQHandler=1
+"""
+
+import argparse
+import os
+import re
+import sys
+
+EXCEPTION_FRAME = 32 + 4
+DEFAULT_UNKNOWN = 64
+MAIN_ENTRY = "ResetISR"
+
+# Exception priorities other than the default 0 of the IRQs and SVC/PendSV/SysTick
+PRIORITIES = {"NMI_Handler": -2, "HardFault_Handler": -1}
+
+# What each function pointer call can reach: caller -> regular expressions matched against the callees' names.
+# An empty list means nothing is ever stored in that pointer in this firmware
+INDIRECT_CALLS = {
+    "shell_execute": [r"^shell_(?!execute$)"],
+    "console_edit": [r"^shell_execute$"],
+    "clocks_switch": [r"_clock_notifier$"],
+    "flash_async_finish": [],
+    "serial_lpsci_frame_callback": [],
+    "LPSCI_TransferHandleIRQ": [r"^serial_lpsci_callback$"],
+    "LPSCI_TransferReceiveNonBlocking": [r"^serial_lpsci_callback$"],
+    "LPSCI_TransferHandleRxDmaIdle": [r"^serial_lpsci_callback$", r"^serial_lpsci_frame_callback$"],
+    "UART_TransferHandleIRQ": [r"^serial_uart_callback$"],
+    "UART_TransferReceiveNonBlocking": [r"^serial_uart_callback$"],
+    "UART0_DriverIRQHandler": [r"^LPSCI_TransferHandleIRQ$"],
+    "UART1_DriverIRQHandler": [r"^UART_TransferHandleIRQ$"],
+    "UART2_DriverIRQHandler": [r"^UART_TransferHandleIRQ$"],
+    "DbgConsole_Putchar": [r"^LPSCI_WriteBlocking$"],
+    "DbgConsole_Getchar": [r"^LPSCI_ReadBlocking$"],
+    "DbgConsole_PrintfFormattedData": [r"^DbgConsole_Putchar$"],
+    "DbgConsole_PrintfPaddingCharacter": [r"^DbgConsole_Putchar$"],
+    "CLOCK_SetFeiMode": [r"^CLOCK_FllStableDelay$"],
+    "CLOCK_SetFeeMode": [r"^CLOCK_FllStableDelay$"],
+    "CLOCK_SetFbiMode": [r"^CLOCK_FllStableDelay$"],
+    "CLOCK_SetFbeMode": [r"^CLOCK_FllStableDelay$"],
+    "FLASH_Erase": [],
+    "FLASH_Program": [],
+    "flash_command_sequence": [r"^flash_run_command$"],
+    "copy_flash_common_bit_operation": [r"^flash_common_bit_operation$"],
+    "mcm_flash_cache_clear": [r"^flash_common_bit_operation$"],
+}
+
+# Calls that do not go through C: Redlib's __main() calls main(), HardFault_Handler jumps to fault_capture()
+EXTRA_CALLS = {"__main": ["main"], "HardFault_Handler": ["fault_capture"]}
+
+# Frames GCC does not report: naked functions, and the position independent code fsl_flash.c copies to SRAM
+ASM_FRAMES = {
+    "data_init": 20,
+    "bss_init": 20,
+    "stack_fill": 12,
+    "HardFault_Handler": 0,
+    "flash_run_command": 0,
+    "flash_common_bit_operation": 8,
+}
+
+NODE = re.compile(r'^node: \{ title: "([^"]+)" label: "([^"]+)"')
+EDGE = re.compile(r'^edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+SU = re.compile(r"^(.*):(\d+):(\d+):(\S+)\t(\d+)\t(\S+)$")
+STACK_SIZE = re.compile(r"^\s*_StackSize\s*=\s*(0x[0-9a-fA-F]+|\d+)\s*;", re.M)
+
+
+class Function:
+    def __init__(self, title, name, location):
+        self.title = title
+        self.name = name
+        self.location = location
+        self.frame = None
+        self.qualifiers = ""
+        self.callees = set()
+
+
+def bare(title):
+    return title.rsplit(":", 1)[-1]
+
+
+def read_build(directory):
+    """Functions defined in the build, by .ci title, and the .su frames by location:name"""
+    functions = {}
+    edges = []
+    frames = {}
+    for root, _, files in os.walk(directory):
+        for name in sorted(files):
+            path = os.path.join(root, name)
+            if name.endswith(".ci"):
+                with open(path) as f:
+                    for line in f:
+                        node = NODE.match(line)
+                        if node and "shape : ellipse" not in line:
+                            label = node.group(2).split("\\n")
+                            functions[node.group(1)] = Function(node.group(1), label[0], label[1])
+                        edge = EDGE.match(line)
+                        if edge:
+                            edges.append((edge.group(1), edge.group(2)))
+            elif name.endswith(".su"):
+                with open(path) as f:
+                    for line in f:
+                        su = SU.match(line.rstrip("\n"))
+                        if su:
+                            key = "%s:%s:%s:%s" % su.group(1, 2, 3, 4)
+                            frames[key] = (int(su.group(5)), su.group(6))
+    return functions, edges, frames
+
+
+class Graph:
+    def __init__(self, functions, edges, frames, unknown):
+        self.unknown = unknown
+        self.problems = []
+        self.externals = set()
+        self.unresolved = set()
+
+        # The vector table: every handler the startup file defines, weak or not
+        self.vectors = {f.name for f in functions.values() if re.search(r"(^|/)startup/", f.location) and
+                        f.name.endswith("Handler")}
+
+        # A file-local title whose name is also defined globally is a weak default that lost to it
+        globals_ = {title for title in functions if ":" not in title}
+        self.functions = {title: f for title, f in functions.items() if ":" not in title or f.name not in globals_}
+        self.by_name = {}
+        for f in self.functions.values():
+            self.by_name.setdefault(f.name, []).append(f)
+            if f.name in ASM_FRAMES:
+                f.frame = ASM_FRAMES[f.name]
+            elif "%s:%s" % (f.location, f.name) in frames:
+                f.frame, f.qualifiers = frames["%s:%s" % (f.location, f.name)]
+            else:
+                self.problems.append("%s (%s): no .su entry" % (f.name, f.location))
+                f.frame = 0
+            if "dynamic" in f.qualifiers and "bounded" not in f.qualifiers:
+                self.problems.append("%s (%s): unbounded frame (%s)" % (f.name, f.location, f.qualifiers))
+
+        for source, target in edges:
+            caller = self.functions.get(source)
+            if caller is None:
+                continue
+            if target == "__indirect_call":
+                caller.callees.update(self.indirect(caller))
+            else:
+                caller.callees.add(self.resolve(target))
+        for name, targets in EXTRA_CALLS.items():
+            for target in targets:
+                self.node(name).callees.add(self.resolve(target))
+        self.callers = {}
+        for f in self.functions.values():
+            for callee in f.callees:
+                self.callers.setdefault(callee, set()).add(f.title)
+
+    def node(self, title):
+        """An external function, charged --unknown bytes, or one of ASM_FRAMES"""
+        if title not in self.functions:
+            f = Function(title, bare(title), "")
+            if f.name in ASM_FRAMES:
+                f.frame = ASM_FRAMES[f.name]
+            else:
+                f.frame = self.unknown
+                self.externals.add(f.name)
+            self.functions[title] = f
+        return self.functions[title]
+
+    def resolve(self, target):
+        if target in self.functions:
+            return target
+        name = bare(target)
+        if name in self.by_name and len(self.by_name[name]) == 1:
+            return self.by_name[name][0].title
+        if name.endswith("_DriverIRQHandler") and ":" in target:
+            # Not defined anywhere: the startup file aliases it to IntDefaultHandler
+            default = target.rsplit(":", 1)[0] + ":IntDefaultHandler"
+            if default in self.functions:
+                return default
+        return self.node(target).title
+
+    def indirect(self, caller):
+        if caller.name not in INDIRECT_CALLS:
+            self.unresolved.add(caller.name)
+            return set()
+        targets = set()
+        for pattern in INDIRECT_CALLS[caller.name]:
+            # A target not compiled into this configuration cannot be reached either
+            targets.update(f.title for f in self.functions.values() if f.location and re.search(pattern, f.name))
+        return targets
+
+    def depth(self, title, memo, stack=()):
+        """Deepest stack below and including title, and the chain that reaches it"""
+        if title in memo:
+            return memo[title]
+        if title in stack:
+            cycle = [self.functions[t].name for t in stack[stack.index(title):]] + [self.functions[title].name]
+            self.problems.append("recursion: " + " -> ".join(cycle))
+            return 0, []
+        f = self.functions[title]
+        deepest, chain = 0, []
+        for callee in sorted(f.callees):
+            d, c = self.depth(callee, memo, stack + (title,))
+            if d > deepest:
+                deepest, chain = d, c
+        memo[title] = (f.frame + deepest, [title] + chain)
+        return memo[title]
+
+    def handlers(self):
+        """Exception entry points: vector table handlers nothing calls (those that are called are the defaults)"""
+        return sorted(t for t, f in self.functions.items() if f.name in self.vectors and t not in self.callers)
+
+
+def budget_from_ld(path):
+    with open(path) as f:
+        match = STACK_SIZE.search(f.read())
+    if not match:
+        raise SystemExit("%s: no _StackSize" % path)
+    return int(match.group(1), 0)
+
+
+def chain_text(graph, chain):
+    return " -> ".join("%s(%d)" % (graph.functions[t].name, graph.functions[t].frame) for t in chain)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("build", help="build configuration directory, e.g. Blinkenlights/Debug")
+    parser.add_argument("--ld", help="linker script to take the budget from (_StackSize)")
+    parser.add_argument("--budget", type=lambda x: int(x, 0), help="stack budget in bytes, instead of --ld")
+    parser.add_argument("--unknown", type=int, default=DEFAULT_UNKNOWN,
+                        help="bytes charged for a function without a .su entry (default %d)" % DEFAULT_UNKNOWN)
+    parser.add_argument("--priority", action="append", default=[], metavar="HANDLER=LEVEL",
+                        help="priority of a handler when it is not 0 (lower preempts higher)")
+    parser.add_argument("--all", action="store_true", help="list every handler, not only the deepest per level")
+    args = parser.parse_args()
+
+    functions, edges, frames = read_build(args.build)
+    if not functions:
+        raise SystemExit("%s: no .ci files; build with -fcallgraph-info=su" % args.build)
+    graph = Graph(functions, edges, frames, args.unknown)
+    priorities = dict(PRIORITIES)
+    for item in args.priority:
+        name, level = item.split("=")
+        priorities[name] = int(level)
+
+    memo = {}
+    if MAIN_ENTRY not in graph.functions:
+        raise SystemExit("%s not found in the call graph" % MAIN_ENTRY)
+    main_depth, main_chain = graph.depth(MAIN_ENTRY, memo)
+    print("Stack report for %s" % os.path.basename(os.path.abspath(args.build)))
+    print("  %-28s %5d  %s" % (MAIN_ENTRY, main_depth, chain_text(graph, main_chain)))
+
+    levels = {}
+    for title in graph.handlers():
+        d, chain = graph.depth(title, memo)
+        level = priorities.get(graph.functions[title].name, 0)
+        if args.all:
+            print("  %-28s %5d  %s" % (graph.functions[title].name, d, chain_text(graph, chain)))
+        if level not in levels or d > levels[level][0]:
+            levels[level] = (d, chain)
+
+    total = main_depth
+    print("Interrupt nesting (%d bytes of exception frame per level):" % EXCEPTION_FRAME)
+    for level in sorted(levels, reverse=True):
+        d, chain = levels[level]
+        total += d + EXCEPTION_FRAME
+        print("  priority %-2d %-16s %5d  %s" % (level, graph.functions[chain[0]].name, d, chain_text(graph, chain)))
+
+    if graph.externals:
+        print("Charged %d bytes each (no .su): %s" % (args.unknown, ", ".join(sorted(graph.externals))))
+    if graph.unresolved:
+        print("Function pointer calls with no INDIRECT_CALLS entry (not followed): %s"
+              % ", ".join(sorted(graph.unresolved)))
+    for problem in graph.problems:
+        print("Problem: %s" % problem)
+
+    budget = args.budget
+    if budget is None and args.ld:
+        budget = budget_from_ld(args.ld)
+    if budget is None:
+        print("Worst case: %d bytes" % total)
+        status = 0
+    else:
+        print("Worst case: %d bytes of %d (%d to spare)" % (total, budget, budget - total))
+        status = 1 if total > budget else 0
+        if status:
+            print("Stack budget exceeded", file=sys.stderr)
+    if any(p.startswith("recursion") or "unbounded" in p for p in graph.problems):
+        print("Stack depth cannot be bounded", file=sys.stderr)
+        status = 1
+    sys.exit(status)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""
+Blinkenlights telemetry capture.
+
+Turns telemetry on, separates the binary frames from the console text and
+writes one row per record (see Blinkenlights/source/telemetry.h):
+
+    0x00 | COBS(record[12] | CRC-16/CCITT-FALSE little endian) | 0x00
+
+Sequence gaps (records dropped by the rate limiter or lost on the wire) and
+frames with a bad CRC are counted and reported on exit. Console text is
+passed through to stderr.
+
+Output is CSV, or a Parquet file (one column per field) when the name ends
+in .parquet and pyarrow is installed.
+
+Requires pyserial.
+
+    python3 tools/telemetry_capture.py /dev/ttyACM0 touch.csv
+    python3 tools/telemetry_capture.py /dev/ttyACM0 touch.parquet --seconds 60
+"""
+
+import argparse
+import csv
+import struct
+import sys
+import time
+
+import serial
+
+DEFAULT_BAUD = 115200
+RECORD = struct.Struct("<BxHIHH")
+TYPES = {1: "touch", 2: "led", 3: "stack"}
+COLUMNS = ("sequence", "tick", "type", "value0", "value1")
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, same as telemetry_crc16()."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    """Undo COBS; returns None if the frame is malformed."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data) + 1:
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def decode(frame):
+    """Return a record tuple in COLUMNS order, or None if the frame is not telemetry."""
+    payload = cobs_decode(frame)
+    if payload is None or len(payload) != RECORD.size + 2:
+        return None
+    record, crc = payload[:RECORD.size], payload[RECORD.size:]
+    if crc16(record) != int.from_bytes(crc, "little"):
+        return None
+    kind, sequence, tick, value0, value1 = RECORD.unpack(record)
+    return (sequence, tick, TYPES.get(kind, str(kind)), value0, value1)
+
+
+class Stats:
+    def __init__(self):
+        self.records = 0
+        self.bad = 0
+        self.lost = 0
+        self.last = None
+
+    def add(self, sequence):
+        if self.last is not None:
+            self.lost += (sequence - self.last - 1) & 0xFFFF
+        self.last = sequence
+        self.records += 1
+
+
+def capture(port, rows, stats, seconds):
+    deadline = time.monotonic() + seconds if seconds else None
+    chunk = bytearray()
+    while deadline is None or time.monotonic() < deadline:
+        data = port.read(port.in_waiting or 1)
+        for byte in data:
+            if byte:
+                chunk.append(byte)
+                continue
+            if chunk:
+                row = decode(bytes(chunk))
+                if row is not None:
+                    stats.add(row[0])
+                    rows.append(row)
+                elif len(chunk) == RECORD.size + 3:
+                    stats.bad += 1
+                else:
+                    sys.stderr.write(chunk.decode("ascii", errors="replace"))
+            chunk.clear()
+    if chunk:
+        sys.stderr.write(chunk.decode("ascii", errors="replace"))
+
+
+def write(path, rows):
+    if path.endswith(".parquet"):
+        import pyarrow
+        import pyarrow.parquet
+
+        columns = list(zip(*rows)) if rows else [[] for _ in COLUMNS]
+        table = pyarrow.table({name: list(values) for name, values in zip(COLUMNS, columns)})
+        pyarrow.parquet.write_table(table, path)
+        return
+    with open(path, "w", newline="") as out:
+        writer = csv.writer(out)
+        writer.writerow(COLUMNS)
+        writer.writerows(rows)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("port", help="serial device, e.g. /dev/ttyACM0")
+    parser.add_argument("output", help="output file, .csv or .parquet")
+    parser.add_argument("--baud", type=int, default=DEFAULT_BAUD,
+                        help="baud rate (default %(default)s)")
+    parser.add_argument("--seconds", type=float, default=0,
+                        help="stop after this long (default: until Ctrl-C)")
+    args = parser.parse_args()
+
+    port = serial.Serial(args.port, args.baud, timeout=0.1)
+    port.write(b"telemetry on\r")
+    rows = []
+    stats = Stats()
+    try:
+        capture(port, rows, stats, args.seconds)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        port.write(b"telemetry off\r")
+    write(args.output, rows)
+    sys.stderr.write("\n%d records, %d lost, %d bad CRC -> %s\n"
+                     % (stats.records, stats.lost, stats.bad, args.output))
+
+
+if __name__ == "__main__":
+    main()